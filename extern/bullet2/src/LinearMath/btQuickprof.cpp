@@ -17,6 +17,8 @@
 
 #ifndef BT_NO_PROFILE
 
+#include <thread>
+
 
 static btClock gProfileClock;
 
@@ -439,6 +441,16 @@ CProfileNode *	CProfileManager::CurrentNode = &CProfileManager::Root;
 int				CProfileManager::FrameCounter = 0;
 unsigned long int			CProfileManager::ResetTime = 0;
 
+/* The profile tree isn't thread safe, only the thread initializing the
+ * static data (the main thread) is profiled when several worlds are
+ * stepped concurrently. */
+static const std::thread::id gProfileThreadId = std::this_thread::get_id();
+
+static inline bool btIsProfileThread()
+{
+	return (std::this_thread::get_id() == gProfileThreadId);
+}
+
 
 /***********************************************************************************************
  * CProfileManager::Start_Profile -- Begin a named profile                                    *
@@ -455,6 +467,10 @@ unsigned long int			CProfileManager::ResetTime = 0;
  *=============================================================================================*/
 void	CProfileManager::Start_Profile( const char * name )
 {
+	if (!btIsProfileThread()) {
+		return;
+	}
+
 	if (name != CurrentNode->Get_Name()) {
 		CurrentNode = CurrentNode->Get_Sub_Node( name );
 	}
@@ -468,6 +484,10 @@ void	CProfileManager::Start_Profile( const char * name )
  *=============================================================================================*/
 void	CProfileManager::Stop_Profile( void )
 {
+	if (!btIsProfileThread()) {
+		return;
+	}
+
 	// Return will indicate whether we should back up to our parent (we may
 	// be profiling a recursive function)
 	if (CurrentNode->Return()) {
@@ -483,6 +503,10 @@ void	CProfileManager::Stop_Profile( void )
  *=============================================================================================*/
 void	CProfileManager::Reset( void )
 {
+	if (!btIsProfileThread()) {
+		return;
+	}
+
 	gProfileClock.reset();
 	Root.Reset();
     Root.Call();
@@ -496,6 +520,10 @@ void	CProfileManager::Reset( void )
  *=============================================================================================*/
 void CProfileManager::Increment_Frame_Counter( void )
 {
+	if (!btIsProfileThread()) {
+		return;
+	}
+
 	FrameCounter++;
 }
 
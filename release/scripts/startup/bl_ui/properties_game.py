@@ -449,6 +449,8 @@ class RENDER_PT_game_system(RenderButtonsPanel, Panel):
         col = split.column()
         col.prop(gs, "use_frame_rate")
         col.prop(gs, "use_deprecation_warnings")
+        col.prop(gs, "use_parallel_scenes")
+        col.prop(gs, "use_parallel_scenegraph")
 
         col = split.column()
         col.prop(gs, "vsync")
@@ -539,6 +541,7 @@ class SCENE_PT_game_physics(SceneButtonsPanel, Panel):
         layout.prop(gs, "physics_engine", text="Engine")
         if gs.physics_engine != 'NONE':
             layout.prop(gs, "physics_solver")
+            layout.prop(gs, "use_parallel_physics")
             layout.prop(gs, "physics_gravity", text="Gravity")
 
             split = layout.split()
@@ -39,8 +39,10 @@ struct BLI_mempool;
 
 /* Task Scheduler
  * 
- * Central scheduler that holds running threads ready to execute tasks. A single
- * queue holds the task from all pools.
+ * Central scheduler that holds running threads ready to execute tasks. Each
+ * thread holds the tasks it pushed in its own queue, idle threads steal tasks
+ * from the queues of other threads. A global queue holds the tasks pushed from
+ * threads not managed by the scheduler and the tasks of background pools.
  *
  * Init/exit must be called before/after any task pools are created/freed, and
  * must be called from the main threads. All other scheduler and pool functions
@@ -54,6 +56,7 @@ enum {
 };
 
 TaskScheduler *BLI_task_scheduler_create(int num_threads);
+TaskScheduler *BLI_task_scheduler_create_ex(int num_threads, const bool use_work_stealing);
 void BLI_task_scheduler_free(TaskScheduler *scheduler);
 
 int BLI_task_scheduler_num_threads(TaskScheduler *scheduler);
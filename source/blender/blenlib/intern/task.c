@@ -62,6 +62,15 @@
  */
 #define DELAYED_QUEUE_SIZE 4096
 
+/* Number of tasks a thread work stealing queue can hold, must be a power of two.
+ *
+ * Tasks which can't fit in the queue are pushed to the scheduler's global queue.
+ */
+#define STEALING_QUEUE_SIZE 4096
+
+/* Cache line size used to avoid false sharing of work stealing queue indices. */
+#define CACHE_LINE_SIZE 64
+
 #ifndef NDEBUG
 #  define ASSERT_THREAD_ID(scheduler, thread_id)                              \
 	do {                                                                      \
@@ -136,6 +145,32 @@ typedef struct TaskMemPoolStats {
 } TaskMemPoolStats;
 #endif
 
+/* This is a per-thread work stealing queue (Chase-Lev deque).
+ *
+ * Only the owner thread pushes and pops tasks at the bottom of the queue, without
+ * any lock. Other threads steal the oldest tasks from the top of the queue using a
+ * compare and swap on the top index. This way threads running fine grained tasks
+ * don't fight for the scheduler's global queue mutex.
+ *
+ * The indices only increase (except the bottom index which is temporarily
+ * decreased by a pop), a slot is never overwritten while it can be stolen as
+ * the owner doesn't push more than STEALING_QUEUE_SIZE tasks ahead of the top.
+ *
+ * The pool of each task is stored next to it, this allows threads waiting for a
+ * specific pool to steal only tasks of this pool.
+ */
+typedef struct TaskStealingQueue {
+	/* Index of the next task to steal. */
+	int64_t top;
+	char pad_top[CACHE_LINE_SIZE - sizeof(int64_t)];
+	/* Index of the next free slot, only modified by the owner thread. */
+	int64_t bottom;
+	char pad_bottom[CACHE_LINE_SIZE - sizeof(int64_t)];
+
+	struct Task *volatile tasks[STEALING_QUEUE_SIZE];
+	TaskPool *volatile pools[STEALING_QUEUE_SIZE];
+} TaskStealingQueue;
+
 typedef struct TaskThreadLocalStorage {
 	/* Memory pool for faster task allocation.
 	 * The idea is to re-use memory of finished/discarded tasks by this thread.
@@ -167,6 +202,8 @@ struct TaskPool {
 	volatile size_t num;
 	ThreadMutex num_mutex;
 	ThreadCondition num_cond;
+	/* Number of threads waiting on num_cond for new tasks or the pool to be done. */
+	int32_t num_waiting_threads;
 
 	void *userdata;
 	ThreadMutex user_mutex;
@@ -214,6 +251,16 @@ struct TaskScheduler {
 	ThreadMutex queue_mutex;
 	ThreadCondition queue_cond;
 
+	/* Use per-thread work stealing queues, the global queue is then only used for
+	 * tasks pushed from threads not managed by the scheduler, background pools,
+	 * suspended pools and overflowing tasks.
+	 */
+	bool use_work_stealing;
+	/* Number of worker threads waiting on queue_cond, pushing a task to a work
+	 * stealing queue wakes them up only when non zero.
+	 */
+	int32_t num_sleeping_threads;
+
 	volatile bool do_exit;
 
 	/* NOTE: In pthread's TLS we store the whole TaskThread structure. */
@@ -224,6 +271,8 @@ typedef struct TaskThread {
 	TaskScheduler *scheduler;
 	int id;
 	TaskThreadLocalStorage tls;
+	/* Only allocated for schedulers using work stealing. */
+	TaskStealingQueue *stealing_queue;
 } TaskThread;
 
 /* Helper */
@@ -330,13 +379,24 @@ static void task_free(TaskPool *pool, Task *task, const int thread_id)
 
 static void task_pool_num_decrease(TaskPool *pool, size_t done)
 {
+	size_t num = pool->num;
+
+	/* Decrease without lock as long as the pool isn't done. The last decrease
+	 * must happen under the lock: a waiter seeing the pool done can free it.
+	 */
+	while (num > done) {
+		const size_t prev_num = atomic_cas_z((size_t *)&pool->num, num, num - done);
+		if (prev_num == num) {
+			return;
+		}
+		num = prev_num;
+	}
+
 	BLI_mutex_lock(&pool->num_mutex);
 
 	BLI_assert(pool->num >= done);
 
-	pool->num -= done;
-
-	if (pool->num == 0)
+	if (atomic_sub_and_fetch_z((size_t *)&pool->num, done) == 0)
 		BLI_condition_notify_all(&pool->num_cond);
 
 	BLI_mutex_unlock(&pool->num_mutex);
@@ -344,12 +404,172 @@ static void task_pool_num_decrease(TaskPool *pool, size_t done)
 
 static void task_pool_num_increase(TaskPool *pool, size_t new)
 {
-	BLI_mutex_lock(&pool->num_mutex);
+	atomic_add_and_fetch_z((size_t *)&pool->num, new);
 
-	pool->num += new;
-	BLI_condition_notify_all(&pool->num_cond);
+	/* Wake up threads waiting in work_and_wait() so they can pick the new tasks. */
+	if (atomic_fetch_and_add_int32(&pool->num_waiting_threads, 0) != 0) {
+		BLI_mutex_lock(&pool->num_mutex);
+		BLI_condition_notify_all(&pool->num_cond);
+		BLI_mutex_unlock(&pool->num_mutex);
+	}
+}
 
-	BLI_mutex_unlock(&pool->num_mutex);
+/* Wait on the pool condition, pool->num_mutex must be locked. */
+static void task_pool_num_wait(TaskPool *pool)
+{
+	atomic_add_and_fetch_int32(&pool->num_waiting_threads, 1);
+	BLI_condition_wait(&pool->num_cond, &pool->num_mutex);
+	atomic_sub_and_fetch_int32(&pool->num_waiting_threads, 1);
+}
+
+/* Work stealing queue */
+
+static void task_stealing_queue_init(TaskStealingQueue *queue)
+{
+	queue->top = 0;
+	queue->bottom = 0;
+}
+
+/* Push a task to the bottom of the queue, only called from the owner thread.
+ * Return false if the queue is full.
+ */
+static bool task_stealing_queue_push(TaskStealingQueue *queue, Task *task)
+{
+	const int64_t bottom = queue->bottom;
+	/* A stale top only over-estimates the number of queued tasks. */
+	const int64_t top = queue->top;
+
+	if (bottom - top >= STEALING_QUEUE_SIZE) {
+		return false;
+	}
+
+	queue->tasks[bottom & (STEALING_QUEUE_SIZE - 1)] = task;
+	queue->pools[bottom & (STEALING_QUEUE_SIZE - 1)] = task->pool;
+	/* Full barrier: the task is visible before the new bottom. */
+	atomic_add_and_fetch_int64(&queue->bottom, 1);
+
+	return true;
+}
+
+/* Pop the most recently pushed task, only called from the owner thread. */
+static Task *task_stealing_queue_pop(TaskStealingQueue *queue)
+{
+	/* Full barrier: reserve the bottom slot before reading the top. */
+	const int64_t bottom = atomic_sub_and_fetch_int64(&queue->bottom, 1);
+	const int64_t top = atomic_fetch_and_add_int64(&queue->top, 0);
+	Task *task = NULL;
+
+	if (top <= bottom) {
+		task = queue->tasks[bottom & (STEALING_QUEUE_SIZE - 1)];
+		if (top == bottom) {
+			/* Last task, race against thieves. */
+			if (atomic_cas_int64(&queue->top, top, top + 1) != top) {
+				task = NULL;
+			}
+			atomic_add_and_fetch_int64(&queue->bottom, 1);
+		}
+	}
+	else {
+		/* Empty queue, restore bottom. */
+		atomic_add_and_fetch_int64(&queue->bottom, 1);
+	}
+
+	return task;
+}
+
+/* Steal the oldest task from any thread, when pool is not NULL
+ * the task is only stolen if it belongs to this pool.
+ */
+static Task *task_stealing_queue_steal(TaskStealingQueue *queue, TaskPool *pool)
+{
+	const int64_t top = atomic_fetch_and_add_int64(&queue->top, 0);
+	const int64_t bottom = atomic_fetch_and_add_int64(&queue->bottom, 0);
+
+	if (top >= bottom) {
+		return NULL;
+	}
+
+	/* The slot can't be overwritten as long as top isn't increased, the values
+	 * read are valid if the compare and swap succeed.
+	 */
+	Task *task = queue->tasks[top & (STEALING_QUEUE_SIZE - 1)];
+	if (pool && queue->pools[top & (STEALING_QUEUE_SIZE - 1)] != pool) {
+		return NULL;
+	}
+
+	if (atomic_cas_int64(&queue->top, top, top + 1) != top) {
+		return NULL;
+	}
+
+	return task;
+}
+
+BLI_INLINE bool task_stealing_queue_is_empty(TaskStealingQueue *queue)
+{
+	const int64_t top = atomic_fetch_and_add_int64(&queue->top, 0);
+	const int64_t bottom = atomic_fetch_and_add_int64(&queue->bottom, 0);
+	return (top >= bottom);
+}
+
+/* Steal a task from the queue of any other thread than thread_id. */
+static Task *task_scheduler_steal(TaskScheduler *scheduler, TaskPool *pool, int thread_id)
+{
+	const int num_queues = scheduler->num_threads + 1;
+
+	for (int i = 1; i < num_queues; ++i) {
+		TaskStealingQueue *queue = scheduler->task_threads[(thread_id + i) % num_queues].stealing_queue;
+		Task *task = task_stealing_queue_steal(queue, pool);
+		if (task) {
+			return task;
+		}
+	}
+
+	return NULL;
+}
+
+static bool task_scheduler_has_stealable_task(TaskScheduler *scheduler)
+{
+	for (int i = 0; i < scheduler->num_threads + 1; ++i) {
+		if (!task_stealing_queue_is_empty(scheduler->task_threads[i].stealing_queue)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Return the work stealing queue of the calling thread, or NULL if the
+ * thread isn't managed by this scheduler.
+ */
+static TaskStealingQueue *task_scheduler_thread_stealing_queue(TaskScheduler *scheduler, int thread_id)
+{
+	if (thread_id == -1) {
+		if (BLI_thread_is_main()) {
+			thread_id = 0;
+		}
+		else {
+			TaskThread *thread = pthread_getspecific(scheduler->tls_id_key);
+			if (thread == NULL) {
+				return NULL;
+			}
+			thread_id = thread->id;
+		}
+	}
+
+	return scheduler->task_threads[thread_id].stealing_queue;
+}
+
+/* Wake up a sleeping worker after a task was pushed to a work stealing queue. */
+static void task_scheduler_wake_up(TaskScheduler *scheduler)
+{
+	/* Pairs with the increment in task_scheduler_thread_wait(), either the worker
+	 * sees the new task before sleeping or we see it sleeping.
+	 */
+	if (atomic_fetch_and_add_int32(&scheduler->num_sleeping_threads, 0) != 0) {
+		BLI_mutex_lock(&scheduler->queue_mutex);
+		BLI_condition_notify_one(&scheduler->queue_cond);
+		BLI_mutex_unlock(&scheduler->queue_mutex);
+	}
 }
 
 static bool task_scheduler_thread_wait_pop(TaskScheduler *scheduler, Task **task)
@@ -422,6 +642,70 @@ BLI_INLINE void handle_local_queue(TaskThreadLocalStorage *tls,
 	BLI_assert(!tls->do_delayed_push);
 }
 
+/* Pop a task from the global queue without waiting, if pool is not NULL only
+ * a task of this pool is popped.
+ */
+static Task *task_scheduler_global_pop(TaskScheduler *scheduler, TaskPool *pool)
+{
+	Task *task;
+
+	/* Unlocked read, only used as a hint to avoid locking an empty queue. */
+	if (scheduler->queue.first == NULL) {
+		return NULL;
+	}
+
+	BLI_mutex_lock(&scheduler->queue_mutex);
+
+	for (task = scheduler->queue.first; task; task = task->next) {
+		if (pool == NULL || task->pool == pool) {
+			BLI_remlink(&scheduler->queue, task);
+			break;
+		}
+	}
+
+	BLI_mutex_unlock(&scheduler->queue_mutex);
+
+	return task;
+}
+
+/* Wait for new tasks, return false if the scheduler is exiting. */
+static bool task_scheduler_thread_wait(TaskScheduler *scheduler)
+{
+	bool do_exit;
+
+	BLI_mutex_lock(&scheduler->queue_mutex);
+
+	atomic_add_and_fetch_int32(&scheduler->num_sleeping_threads, 1);
+	while (!scheduler->do_exit && !scheduler->queue.first && !task_scheduler_has_stealable_task(scheduler)) {
+		BLI_condition_wait(&scheduler->queue_cond, &scheduler->queue_mutex);
+	}
+	atomic_sub_and_fetch_int32(&scheduler->num_sleeping_threads, 1);
+
+	do_exit = scheduler->do_exit;
+
+	BLI_mutex_unlock(&scheduler->queue_mutex);
+
+	return !do_exit;
+}
+
+/* Get the next task of a worker thread in a work stealing scheduler: first the
+ * most recent task pushed by this thread, then the global queue and finally the
+ * oldest task of any other thread.
+ */
+static bool task_scheduler_thread_wait_steal(TaskScheduler *scheduler, TaskThread *thread, Task **task)
+{
+	do {
+		if ((*task = task_stealing_queue_pop(thread->stealing_queue)) ||
+		    (*task = task_scheduler_global_pop(scheduler, NULL)) ||
+		    (*task = task_scheduler_steal(scheduler, NULL, thread->id)))
+		{
+			return true;
+		}
+	} while (task_scheduler_thread_wait(scheduler));
+
+	return false;
+}
+
 static void *task_scheduler_thread_run(void *thread_p)
 {
 	TaskThread *thread = (TaskThread *) thread_p;
@@ -433,12 +717,17 @@ static void *task_scheduler_thread_run(void *thread_p)
 	pthread_setspecific(scheduler->tls_id_key, thread);
 
 	/* keep popping off tasks */
-	while (task_scheduler_thread_wait_pop(scheduler, &task)) {
+	while (scheduler->use_work_stealing ?
+	       task_scheduler_thread_wait_steal(scheduler, thread, &task) :
+	       task_scheduler_thread_wait_pop(scheduler, &task))
+	{
 		TaskPool *pool = task->pool;
 
-		/* run task */
+		/* run task, tasks of canceled pools still in a work stealing queue are discarded */
 		BLI_assert(!tls->do_delayed_push);
-		task->run(pool, task->taskdata, thread_id);
+		if (!pool->do_cancel) {
+			task->run(pool, task->taskdata, thread_id);
+		}
 		BLI_assert(!tls->do_delayed_push);
 
 		/* delete task */
@@ -455,6 +744,18 @@ static void *task_scheduler_thread_run(void *thread_p)
 }
 
 TaskScheduler *BLI_task_scheduler_create(int num_threads)
+{
+	return BLI_task_scheduler_create_ex(num_threads, true);
+}
+
+/**
+ * Create a task scheduler.
+ *
+ * \param use_work_stealing: Use a lock-free work stealing queue per thread,
+ * otherwise all tasks go through a single global queue protected by a mutex.
+ * Work stealing is always disabled for a scheduler with a single background thread.
+ */
+TaskScheduler *BLI_task_scheduler_create_ex(int num_threads, const bool use_work_stealing)
 {
 	TaskScheduler *scheduler = MEM_callocN(sizeof(TaskScheduler), "TaskScheduler");
 
@@ -483,6 +784,20 @@ TaskScheduler *BLI_task_scheduler_create(int num_threads)
 	scheduler->task_threads = MEM_mallocN(sizeof(TaskThread) * (num_threads + 1),
 	                                      "TaskScheduler task threads");
 
+	/* Stealing queues are also needed before the threads are launched. */
+	scheduler->use_work_stealing = use_work_stealing && !scheduler->background_thread_only;
+	scheduler->num_sleeping_threads = 0;
+	for (int i = 0; i < num_threads + 1; i++) {
+		TaskThread *thread = &scheduler->task_threads[i];
+		if (scheduler->use_work_stealing) {
+			thread->stealing_queue = MEM_mallocN(sizeof(TaskStealingQueue), "TaskStealingQueue");
+			task_stealing_queue_init(thread->stealing_queue);
+		}
+		else {
+			thread->stealing_queue = NULL;
+		}
+	}
+
 	/* Initialize TLS for main thread. */
 	initialize_task_tls(&scheduler->task_threads[0].tls);
 
@@ -539,6 +854,16 @@ void BLI_task_scheduler_free(TaskScheduler *scheduler)
 		for (int i = 0; i < scheduler->num_threads + 1; ++i) {
 			TaskThreadLocalStorage *tls = &scheduler->task_threads[i].tls;
 			free_task_tls(tls);
+
+			/* delete leftover tasks */
+			TaskStealingQueue *stealing_queue = scheduler->task_threads[i].stealing_queue;
+			if (stealing_queue) {
+				while ((task = task_stealing_queue_pop(stealing_queue))) {
+					task_data_free(task, 0);
+					MEM_freeN(task);
+				}
+				MEM_freeN(stealing_queue);
+			}
 		}
 
 		MEM_freeN(scheduler->task_threads);
@@ -578,6 +903,59 @@ static void task_scheduler_push(TaskScheduler *scheduler, Task *task, TaskPriori
 	BLI_mutex_unlock(&scheduler->queue_mutex);
 }
 
+/* Move a task already counted in its pool to the global queue, used to give
+ * away tasks of other pools from the work stealing queue of a waiting thread.
+ */
+static void task_scheduler_push_global(TaskScheduler *scheduler, Task *task)
+{
+	TaskPool *pool = task->pool;
+
+	BLI_mutex_lock(&scheduler->queue_mutex);
+	BLI_addtail(&scheduler->queue, task);
+	BLI_condition_notify_one(&scheduler->queue_cond);
+	BLI_mutex_unlock(&scheduler->queue_mutex);
+
+	/* Threads waiting for this pool can now pick the task. */
+	if (atomic_fetch_and_add_int32(&pool->num_waiting_threads, 0) != 0) {
+		BLI_mutex_lock(&pool->num_mutex);
+		BLI_condition_notify_all(&pool->num_cond);
+		BLI_mutex_unlock(&pool->num_mutex);
+	}
+}
+
+/* Push a task to the work stealing queue of the calling thread,
+ * return false if it must go through the global queue.
+ */
+static bool task_scheduler_push_stealing(TaskScheduler *scheduler, Task *task, int thread_id)
+{
+	TaskPool *pool = task->pool;
+
+	/* Background pools must be picked by the background threads only, pools
+	 * created from a thread not managed by the scheduler have no queue.
+	 */
+	if (pool->run_in_background || (thread_id == 0 && pool->use_local_tls)) {
+		return false;
+	}
+
+	TaskStealingQueue *stealing_queue = task_scheduler_thread_stealing_queue(scheduler, thread_id);
+	if (stealing_queue == NULL) {
+		return false;
+	}
+
+	/* Count the task before any thief can run it. */
+	task_pool_num_increase(pool, 1);
+
+	if (!task_stealing_queue_push(stealing_queue, task)) {
+		/* Queue is full. */
+		task_scheduler_push_global(scheduler, task);
+		return true;
+	}
+
+	task_scheduler_wake_up(scheduler);
+
+	return true;
+}
+
 static void task_scheduler_push_all(TaskScheduler *scheduler,
                                     TaskPool *pool,
                                     Task **tasks,
@@ -604,6 +982,25 @@ static void task_scheduler_clear(TaskScheduler *scheduler, TaskPool *pool)
 	Task *task, *nexttask;
 	size_t done = 0;
 
+	/* Tasks in the stealing queue of other threads are discarded when popped,
+	 * as we may never return to our queue, discard its tasks of this pool now.
+	 */
+	if (scheduler->use_work_stealing) {
+		TaskStealingQueue *stealing_queue = task_scheduler_thread_stealing_queue(scheduler, -1);
+		if (stealing_queue) {
+			while ((task = task_stealing_queue_pop(stealing_queue))) {
+				if (task->pool == pool) {
+					task_data_free(task, pool->thread_id);
+					MEM_freeN(task);
+					done++;
+				}
+				else {
+					task_scheduler_push_global(scheduler, task);
+				}
+			}
+		}
+	}
+
 	BLI_mutex_lock(&scheduler->queue_mutex);
 
 	/* free all tasks from this pool from the queue */
@@ -654,6 +1051,7 @@ static TaskPool *task_pool_create_ex(TaskScheduler *scheduler,
 	pool->suspended_queue.first = pool->suspended_queue.last = NULL;
 	pool->run_in_background = is_background;
 	pool->use_local_tls = false;
+	pool->num_waiting_threads = 0;
 
 	BLI_mutex_init(&pool->num_mutex);
 	BLI_condition_init(&pool->num_cond);
@@ -794,8 +1192,14 @@ static void task_pool_push(
 		atomic_fetch_and_add_z(&pool->num_suspended, 1);
 		return;
 	}
+	/* With work stealing the thread's own queue is as cheap as the local queue. */
+	if (pool->scheduler->use_work_stealing) {
+		if (task_scheduler_push_stealing(pool->scheduler, task, thread_id)) {
+			return;
+		}
+	}
 	/* Populate to any local queue first, this is cheapest push ever. */
-	if (task_can_use_local_queues(pool, thread_id)) {
+	else if (task_can_use_local_queues(pool, thread_id)) {
 		ASSERT_THREAD_ID(pool->scheduler, thread_id);
 		TaskThreadLocalStorage *tls = get_task_tls(pool, thread_id);
 		/* Try to push to a local execution queue.
@@ -841,6 +1245,32 @@ void BLI_task_pool_push_from_thread(TaskPool *pool, TaskRunFunction run,
 	task_pool_push(pool, run, taskdata, free_taskdata, NULL, priority, thread_id);
 }
 
+/* Get a task of the pool for a thread waiting for it in a work stealing scheduler.
+ *
+ * Tasks of other pools found in the thread's own queue are moved to the global
+ * queue, they could otherwise never be run if the thread doesn't return to it.
+ */
+static Task *task_scheduler_wait_steal(TaskScheduler *scheduler, TaskPool *pool)
+{
+	Task *task;
+
+	if (!pool->use_local_tls) {
+		TaskStealingQueue *stealing_queue = scheduler->task_threads[pool->thread_id].stealing_queue;
+		while ((task = task_stealing_queue_pop(stealing_queue))) {
+			if (task->pool == pool) {
+				return task;
+			}
+			task_scheduler_push_global(scheduler, task);
+		}
+	}
+
+	if ((task = task_scheduler_global_pop(scheduler, pool))) {
+		return task;
+	}
+
+	return task_scheduler_steal(scheduler, pool, pool->thread_id);
+}
+
 void BLI_task_pool_work_and_wait(TaskPool *pool)
 {
 	TaskThreadLocalStorage *tls = get_task_tls(pool, pool->thread_id);
@@ -870,21 +1300,27 @@ void BLI_task_pool_work_and_wait(TaskPool *pool)
 
 		BLI_mutex_unlock(&pool->num_mutex);
 
-		BLI_mutex_lock(&scheduler->queue_mutex);
-
 		/* find task from this pool. if we get a task from another pool,
 		 * we can get into deadlock */
 
-		for (task = scheduler->queue.first; task; task = task->next) {
-			if (task->pool == pool) {
-				work_task = task;
-				found_task = true;
-				BLI_remlink(&scheduler->queue, task);
-				break;
-			}
+		if (scheduler->use_work_stealing) {
+			work_task = task_scheduler_wait_steal(scheduler, pool);
+			found_task = (work_task != NULL);
 		}
+		else {
+			BLI_mutex_lock(&scheduler->queue_mutex);
 
-		BLI_mutex_unlock(&scheduler->queue_mutex);
+			for (task = scheduler->queue.first; task; task = task->next) {
+				if (task->pool == pool) {
+					work_task = task;
+					found_task = true;
+					BLI_remlink(&scheduler->queue, task);
+					break;
+				}
+			}
+
+			BLI_mutex_unlock(&scheduler->queue_mutex);
+		}
 
 		/* if found task, do it, otherwise wait until other tasks are done */
 		if (found_task) {
@@ -894,7 +1330,7 @@ void BLI_task_pool_work_and_wait(TaskPool *pool)
 			BLI_assert(!tls->do_delayed_push);
 
 			/* delete task */
-			task_free(pool, task, pool->thread_id);
+			task_free(pool, work_task, pool->thread_id);
 
 			/* Handle all tasks from local queue. */
 			handle_local_queue(tls, pool->thread_id);
@@ -908,7 +1344,7 @@ void BLI_task_pool_work_and_wait(TaskPool *pool)
 			break;
 
 		if (!found_task)
-			BLI_condition_wait(&pool->num_cond, &pool->num_mutex);
+			task_pool_num_wait(pool);
 	}
 
 	BLI_mutex_unlock(&pool->num_mutex);
@@ -925,7 +1361,7 @@ void BLI_task_pool_cancel(TaskPool *pool)
 	/* wait until all entries are cleared */
 	BLI_mutex_lock(&pool->num_mutex);
 	while (pool->num)
-		BLI_condition_wait(&pool->num_cond, &pool->num_mutex);
+		task_pool_num_wait(pool);
 	BLI_mutex_unlock(&pool->num_mutex);
 
 	pool->do_cancel = false;
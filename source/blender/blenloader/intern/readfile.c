@@ -107,6 +107,7 @@
 
 #include "BLI_endian_switch.h"
 #include "BLI_blenlib.h"
+#include "BLI_ghash.h"
 #include "BLI_math.h"
 #include "BLI_threads.h"
 #include "BLI_mempool.h"
@@ -233,10 +234,13 @@ typedef struct OldNew {
 } OldNew;
 
 typedef struct OldNewMap {
+	/* Entries in insertion order, iterated by the callers. */
 	OldNew *entries;
-	int nentries, entriessize;
-	bool sorted;
-	int lasthit;
+	int nentries;
+	/* Open addressing hash of the old pointers, storing indices in entries (-1 for empty slots). */
+	int *map;
+	/* The entries capacity is (1 << capacity_exp), the map has twice more slots. */
+	int capacity_exp;
 } OldNewMap;
 
 
@@ -279,31 +283,61 @@ static const char *library_parent_filepath(Library *lib)
 	return lib->parent ? lib->parent->filepath : "<direct>";
 }
 
+#define OLDNEWMAP_DEFAULT_CAPACITY_EXP 10
+#define OLDNEWMAP_ENTRIES_CAPACITY(onm) (1 << (onm)->capacity_exp)
+#define OLDNEWMAP_MAP_CAPACITY(onm) (1 << ((onm)->capacity_exp + 1))
+#define OLDNEWMAP_PERTURB_SHIFT 5
+
+/* Loop over the map slots of the old address, using the probing of Python dicts:
+ * all the bits of the hash end up being used, so pointers aligned the same way don't collide. */
+#define OLDNEWMAP_ITER_SLOTS(onm, addr, slot) \
+	const uint _mask = (uint)OLDNEWMAP_MAP_CAPACITY(onm) - 1; \
+	uint _perturb = BLI_ghashutil_ptrhash(addr); \
+	uint slot = _perturb & _mask; \
+	for (;; slot = (5 * slot + 1 + _perturb) & _mask, _perturb >>= OLDNEWMAP_PERTURB_SHIFT)
+
+static void oldnewmap_alloc(OldNewMap *onm, int capacity_exp)
+{
+	onm->capacity_exp = capacity_exp;
+	onm->entries = MEM_mallocN(sizeof(*onm->entries) * OLDNEWMAP_ENTRIES_CAPACITY(onm), "OldNewMap.entries");
+	onm->map = MEM_mallocN(sizeof(*onm->map) * OLDNEWMAP_MAP_CAPACITY(onm), "OldNewMap.map");
+	copy_vn_i(onm->map, OLDNEWMAP_MAP_CAPACITY(onm), -1);
+}
+
 static OldNewMap *oldnewmap_new(void) 
 {
 	OldNewMap *onm= MEM_callocN(sizeof(*onm), "OldNewMap");
 	
-	onm->entriessize = 1024;
-	onm->entries = MEM_mallocN(sizeof(*onm->entries)*onm->entriessize, "OldNewMap.entries");
+	oldnewmap_alloc(onm, OLDNEWMAP_DEFAULT_CAPACITY_EXP);
 	
 	return onm;
 }
 
-static int verg_oldnewmap(const void *v1, const void *v2)
+/* Return the map slot of the old address, or of the empty slot where it would be inserted. */
+BLI_INLINE uint oldnewmap_lookup_slot(const OldNewMap *onm, const void *addr)
 {
-	const struct OldNew *x1=v1, *x2=v2;
-	
-	if (x1->old > x2->old) return 1;
-	else if (x1->old < x2->old) return -1;
-	return 0;
+	OLDNEWMAP_ITER_SLOTS(onm, addr, slot) {
+		const int index = onm->map[slot];
+		if (index == -1 || onm->entries[index].old == addr) {
+			return slot;
+		}
+	}
 }
 
-
-static void oldnewmap_sort(FileData *fd) 
+static void oldnewmap_grow(OldNewMap *onm)
 {
-	BLI_assert(fd->libmap->sorted == false);
-	qsort(fd->libmap->entries, fd->libmap->nentries, sizeof(OldNew), verg_oldnewmap);
-	fd->libmap->sorted = 1;
+	int i;
+	
+	onm->capacity_exp++;
+	onm->entries = MEM_reallocN(onm->entries, sizeof(*onm->entries) * OLDNEWMAP_ENTRIES_CAPACITY(onm));
+	MEM_freeN(onm->map);
+	onm->map = MEM_mallocN(sizeof(*onm->map) * OLDNEWMAP_MAP_CAPACITY(onm), "OldNewMap.map");
+	copy_vn_i(onm->map, OLDNEWMAP_MAP_CAPACITY(onm), -1);
+	
+	/* Re-insert in order, so the most recent entry of a duplicated old address stays the one found. */
+	for (i = 0; i < onm->nentries; i++) {
+		onm->map[oldnewmap_lookup_slot(onm, onm->entries[i].old)] = i;
+	}
 }
 
 /* nr is zero for data, and ID code for libdata */
@@ -313,11 +347,14 @@ static void oldnewmap_insert(OldNewMap *onm, const void *oldaddr, void *newaddr,
 	
 	if (oldaddr==NULL || newaddr==NULL) return;
 	
-	if (UNLIKELY(onm->nentries == onm->entriessize)) {
-		onm->entriessize *= 2;
-		onm->entries = MEM_reallocN(onm->entries, sizeof(*onm->entries) * onm->entriessize);
+	if (UNLIKELY(onm->nentries == OLDNEWMAP_ENTRIES_CAPACITY(onm))) {
+		oldnewmap_grow(onm);
 	}
 
+	/* An already inserted old address is shadowed by the new entry but kept in the entries,
+	 * so that oldnewmap_free_unused() still frees it. */
+	onm->map[oldnewmap_lookup_slot(onm, oldaddr)] = onm->nentries;
+
 	entry = &onm->entries[onm->nentries++];
 	entry->old = oldaddr;
 	entry->newp = newaddr;
@@ -329,77 +366,20 @@ void blo_do_versions_oldnewmap_insert(OldNewMap *onm, const void *oldaddr, void
 	oldnewmap_insert(onm, oldaddr, newaddr, nr);
 }
 
-/**
- * Do a full search (no state).
- *
- * \param lasthit: Use as a reference position to avoid a full search
- * from either end of the array, giving more efficient lookups.
- *
- * \note This would seem an ideal case for hash or btree lookups.
- * However the data is written in-order, using the \a lasthit will normally avoid calling this function.
- * Creating a btree/hash structure adds overhead for the common-case to optimize the corner-case
- * (since most entries will never be retrieved).
- * So just keep full lookups as a fall-back.
- */
-static int oldnewmap_lookup_entry_full(const OldNewMap *onm, const void *addr, int lasthit)
+static OldNew *oldnewmap_lookup_entry(const OldNewMap *onm, const void *addr)
 {
-	const int nentries = onm->nentries;
-	const OldNew *entries = onm->entries;
-	int i;
-
-	/* search relative to lasthit where possible */
-	if (lasthit >= 0 && lasthit < nentries) {
-
-		/* search forwards */
-		i = lasthit;
-		while (++i != nentries) {
-			if (entries[i].old == addr) {
-				return i;
-			}
-		}
-
-		/* search backwards */
-		i = lasthit + 1;
-		while (i--) {
-			if (entries[i].old == addr) {
-				return i;
-			}
-		}
-	}
-	else {
-		/* search backwards (full) */
-		i = nentries;
-		while (i--) {
-			if (entries[i].old == addr) {
-				return i;
-			}
-		}
-	}
-
-	return -1;
+	const int index = onm->map[oldnewmap_lookup_slot(onm, addr)];
+	return (index != -1) ? &onm->entries[index] : NULL;
 }
 
 static void *oldnewmap_lookup_and_inc(OldNewMap *onm, const void *addr, bool increase_users)
 {
-	int i;
+	OldNew *entry;
 	
 	if (addr == NULL) return NULL;
 	
-	if (onm->lasthit < onm->nentries-1) {
-		OldNew *entry = &onm->entries[++onm->lasthit];
-		
-		if (entry->old == addr) {
-			if (increase_users)
-				entry->nr++;
-			return entry->newp;
-		}
-	}
-	
-	i = oldnewmap_lookup_entry_full(onm, addr, onm->lasthit);
-	if (i != -1) {
-		OldNew *entry = &onm->entries[i];
-		BLI_assert(entry->old == addr);
-		onm->lasthit = i;
+	entry = oldnewmap_lookup_entry(onm, addr);
+	if (entry) {
 		if (increase_users)
 			entry->nr++;
 		return entry->newp;
@@ -411,32 +391,18 @@ static void *oldnewmap_lookup_and_inc(OldNewMap *onm, const void *addr, bool inc
 /* for libdata, nr has ID code, no increment */
 static void *oldnewmap_liblookup(OldNewMap *onm, const void *addr, const void *lib)
 {
+	OldNew *entry;
+
 	if (addr == NULL) {
 		return NULL;
 	}
 
-	/* lasthit works fine for non-libdata, linking there is done in same sequence as writing */
-	if (onm->sorted) {
-		const OldNew entry_s = {.old = addr};
-		OldNew *entry = bsearch(&entry_s, onm->entries, onm->nentries, sizeof(OldNew), verg_oldnewmap);
-		if (entry) {
-			ID *id = entry->newp;
+	entry = oldnewmap_lookup_entry(onm, addr);
+	if (entry) {
+		ID *id = entry->newp;
 
-			if (id && (!lib || id->lib)) {
-				return id;
-			}
-		}
-	}
-	else {
-		/* note, this can be a bottle neck when loading some files */
-		const int i = oldnewmap_lookup_entry_full(onm, addr, -1);
-		if (i != -1) {
-			OldNew *entry = &onm->entries[i];
-			ID *id = entry->newp;
-			BLI_assert(entry->old == addr);
-			if (id && (!lib || id->lib)) {
-				return id;
-			}
+		if (id && (!lib || id->lib)) {
+			return id;
 		}
 	}
 
@@ -458,16 +424,32 @@ static void oldnewmap_free_unused(OldNewMap *onm)
 
 static void oldnewmap_clear(OldNewMap *onm) 
 {
+	/* The data map is cleared after each ID, don't keep clearing a huge map
+	 * because a single ID had a lot of data. */
+	if (onm->capacity_exp != OLDNEWMAP_DEFAULT_CAPACITY_EXP) {
+		MEM_freeN(onm->entries);
+		MEM_freeN(onm->map);
+		oldnewmap_alloc(onm, OLDNEWMAP_DEFAULT_CAPACITY_EXP);
+	}
+	else if (onm->nentries != 0) {
+		copy_vn_i(onm->map, OLDNEWMAP_MAP_CAPACITY(onm), -1);
+	}
 	onm->nentries = 0;
-	onm->lasthit = 0;
 }
 
 static void oldnewmap_free(OldNewMap *onm) 
 {
 	MEM_freeN(onm->entries);
+	MEM_freeN(onm->map);
 	MEM_freeN(onm);
 }
 
+#undef OLDNEWMAP_DEFAULT_CAPACITY_EXP
+#undef OLDNEWMAP_ENTRIES_CAPACITY
+#undef OLDNEWMAP_MAP_CAPACITY
+#undef OLDNEWMAP_PERTURB_SHIFT
+#undef OLDNEWMAP_ITER_SLOTS
+
 /***/
 
 static void read_libraries(FileData *basefd, ListBase *mainlist);
@@ -1462,31 +1444,6 @@ static void *newdataadr(FileData *fd, const void *adr)		/* only direct databocks
 	return oldnewmap_lookup_and_inc(fd->datamap, adr, true);
 }
 
-/* This is a special version of newdataadr() which allows us to keep lasthit of
- * map unchanged. In certain cases this makes file loading time significantly
- * faster.
- *
- * Use this function in cases like restoring pointer from one list element to
- * another list element, but keep lasthit value so we can continue restoring
- * pointers efficiently.
- *
- * Example of this could be found in direct_link_fcurves() which restores the
- * fcurve group pointer and keeps lasthit optimal for linking all further
- * fcurves.
- */
-static void *newdataadr_ex(FileData *fd, const void *adr, bool increase_lasthit)		/* only direct databocks */
-{
-	if (increase_lasthit) {
-		return newdataadr(fd, adr);
-	}
-	else {
-		int lasthit = fd->datamap->lasthit;
-		void *newadr = newdataadr(fd, adr);
-		fd->datamap->lasthit = lasthit;
-		return newadr;
-	}
-}
-
 static void *newdataadr_no_us(FileData *fd, const void *adr)		/* only direct databocks */
 {
 	return oldnewmap_lookup_and_inc(fd->datamap, adr, false);
@@ -1564,9 +1521,6 @@ static void change_idid_adr_fd(FileData *fd, const void *old, void *new)
 {
 	int i;
 	
-	/* use a binary search if we have a sorted libmap, for now it's not needed. */
-	BLI_assert(fd->libmap->sorted == false);
-
 	for (i = 0; i < fd->libmap->nentries; i++) {
 		OldNew *entry = &fd->libmap->entries[i];
 		
@@ -2524,7 +2478,7 @@ static void direct_link_fcurves(FileData *fd, ListBase *list)
 		fcu->rna_path = newdataadr(fd, fcu->rna_path);
 		
 		/* group */
-		fcu->grp = newdataadr_ex(fd, fcu->grp, false);
+		fcu->grp = newdataadr(fd, fcu->grp);
 		
 		/* clear disabled flag - allows disabled drivers to be tried again ([#32155]),
 		 * but also means that another method for "reviving disabled F-Curves" exists
@@ -8538,8 +8492,6 @@ static void do_versions_after_linking(Main *main)
 
 static void lib_link_all(FileData *fd, Main *main)
 {
-	oldnewmap_sort(fd);
-	
 	/* No load UI for undo memfiles */
 	if (fd->memfile == NULL) {
 		lib_link_windowmanager(fd, main);
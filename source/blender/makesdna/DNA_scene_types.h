@@ -908,6 +908,9 @@ typedef struct GameData {
 #define GAME_PYTHON_CONSOLE					(1 << 20)
 #define GAME_GLSL_NO_ENV_LIGHTING			(1 << 21)
 #define GAME_SHOW_RENDER_QUERIES			(1 << 22)
+#define GAME_PARALLEL_SCENES				(1 << 23)
+#define GAME_PARALLEL_SCENEGRAPH			(1 << 24)
+#define GAME_PARALLEL_PHYSICS				(1 << 25)
 /* Note: GameData.flag is now an int (max 32 flags). A short could only take 16 flags */
 
 #define GAME_DEBUG_DISABLE	0
@@ -4669,6 +4669,11 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
 	RNA_def_property_enum_items(prop, solver_items);
 	RNA_def_property_ui_text(prop, "Physics Solver", "Physics constraint solver");
 
+	prop = RNA_def_property(srna, "use_parallel_physics", PROP_BOOLEAN, PROP_NONE);
+	RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_PARALLEL_PHYSICS);
+	RNA_def_property_ui_text(prop, "Parallel Physics",
+	                         "Process the collision pairs and solve the independent simulation islands concurrently");
+
 	prop = RNA_def_property(srna, "occlusion_culling_resolution", PROP_INT, PROP_PIXEL);
 	RNA_def_property_int_sdna(prop, NULL, "occlusionRes");
 	RNA_def_property_range(prop, 128.0, 1024.0);
@@ -4810,6 +4815,17 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
 	                         "Restrict the number of animation updates to the animation FPS (this is "
 	                         "better for performance, but can cause issues with smooth playback)");
 
+	prop = RNA_def_property(srna, "use_parallel_scenes", PROP_BOOLEAN, PROP_NONE);
+	RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_PARALLEL_SCENES);
+	RNA_def_property_ui_text(prop, "Parallel Scenes",
+	                         "Proceed the physics of all the scenes concurrently once their logic is done "
+	                         "(logic and Python stay on the main thread)");
+
+	prop = RNA_def_property(srna, "use_parallel_scenegraph", PROP_BOOLEAN, PROP_NONE);
+	RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_PARALLEL_SCENEGRAPH);
+	RNA_def_property_ui_text(prop, "Parallel Scene Graph",
+	                         "Update the transforms of independent object hierarchies concurrently");
+
 
 	prop = RNA_def_property(srna, "show_bounding_box", PROP_ENUM, PROP_NONE);
 	RNA_def_property_enum_sdna(prop, NULL, "showBoundingBox");
@@ -0,0 +1,125 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file CM_IndexedSet.h
+ *  \ingroup common
+ */
+
+#ifndef __CM_INDEXED_SET_H__
+#define __CM_INDEXED_SET_H__
+
+#include <vector>
+#include <unordered_map>
+
+/** Unordered set of items stored contiguously. The index of each item is
+ * stored to add, search and remove an item in constant time, a removed
+ * item is replaced by the last item.
+ */
+template <class Item>
+class CM_IndexedSet
+{
+public:
+	using const_iterator = typename std::vector<Item>::const_iterator;
+
+private:
+	std::vector<Item> m_items;
+	std::unordered_map<Item, unsigned int> m_indices;
+
+public:
+	CM_IndexedSet() = default;
+	~CM_IndexedSet() = default;
+
+	/// Return false if the item was already in the set.
+	bool Add(const Item& item)
+	{
+		if (!m_indices.emplace(item, m_items.size()).second) {
+			return false;
+		}
+
+		m_items.push_back(item);
+		return true;
+	}
+
+	/// Return false if the item was not in the set.
+	bool Remove(const Item& item)
+	{
+		const typename std::unordered_map<Item, unsigned int>::iterator it = m_indices.find(item);
+		if (it == m_indices.end()) {
+			return false;
+		}
+
+		const unsigned int index = it->second;
+		m_indices.erase(it);
+
+		const Item& last = m_items.back();
+		if (index != (m_items.size() - 1)) {
+			m_items[index] = last;
+			m_indices[last] = index;
+		}
+		m_items.pop_back();
+
+		return true;
+	}
+
+	bool Contains(const Item& item) const
+	{
+		return (m_indices.find(item) != m_indices.end());
+	}
+
+	void Clear()
+	{
+		m_items.clear();
+		m_indices.clear();
+	}
+
+	bool Empty() const
+	{
+		return m_items.empty();
+	}
+
+	unsigned int Size() const
+	{
+		return m_items.size();
+	}
+
+	const Item& Front() const
+	{
+		return m_items.front();
+	}
+
+	const Item& operator[](unsigned int index) const
+	{
+		return m_items[index];
+	}
+
+	const_iterator begin() const
+	{
+		return m_items.begin();
+	}
+
+	const_iterator end() const
+	{
+		return m_items.end();
+	}
+};
+
+#endif  // __CM_INDEXED_SET_H__
@@ -0,0 +1,62 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): Tristan Porteries.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+/** \file gameengine/Common/CM_PropertyTable.cpp
+ *  \ingroup common
+ */
+
+#include "CM_PropertyTable.h"
+#include "CM_Thread.h"
+
+#include <unordered_set>
+
+/// Pool of the interned names, the nodes of the set are never moved.
+static std::unordered_set<std::string>& GetNamePool()
+{
+	static std::unordered_set<std::string> pool;
+	return pool;
+}
+
+static CM_ThreadMutex& GetNamePoolMutex()
+{
+	static CM_ThreadMutex mutex;
+	return mutex;
+}
+
+CM_PropertyName::CM_PropertyName(const std::string& name)
+{
+	CM_ThreadMutex& mutex = GetNamePoolMutex();
+	mutex.Lock();
+	m_string = &(*GetNamePool().insert(name).first);
+	mutex.Unlock();
+}
+
+CM_PropertyName CM_PropertyName::Find(const std::string& name)
+{
+	CM_ThreadMutex& mutex = GetNamePoolMutex();
+	mutex.Lock();
+	const std::unordered_set<std::string>& pool = GetNamePool();
+	const std::unordered_set<std::string>::const_iterator it = pool.find(name);
+	const std::string *string = (it == pool.end()) ? nullptr : &(*it);
+	mutex.Unlock();
+
+	return CM_PropertyName(string);
+}
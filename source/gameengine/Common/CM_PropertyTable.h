@@ -0,0 +1,217 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file CM_PropertyTable.h
+ *  \ingroup common
+ */
+
+#ifndef __CM_PROPERTY_TABLE_H__
+#define __CM_PROPERTY_TABLE_H__
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+/** Interned property name. All the names with the same text share the same
+ * string, two names are compared by their pointer. The interned strings are
+ * never freed, their number is bounded by the different property names used.
+ */
+class CM_PropertyName
+{
+private:
+	const std::string *m_string;
+
+	explicit CM_PropertyName(const std::string *string)
+		:m_string(string)
+	{
+	}
+
+public:
+	/// Null name, matching no property.
+	CM_PropertyName()
+		:m_string(nullptr)
+	{
+	}
+
+	/// Intern a name, thread safe.
+	explicit CM_PropertyName(const std::string& name);
+
+	/// Return the interned name of a text or a null name if the text was never interned.
+	static CM_PropertyName Find(const std::string& name);
+
+	inline const std::string& GetString() const
+	{
+		return *m_string;
+	}
+
+	inline bool IsNull() const
+	{
+		return (m_string == nullptr);
+	}
+
+	inline bool operator==(const CM_PropertyName& other) const
+	{
+		return (m_string == other.m_string);
+	}
+
+	inline bool operator!=(const CM_PropertyName& other) const
+	{
+		return (m_string != other.m_string);
+	}
+};
+
+/** Table of values indexed by property names, stored in a vector sorted by name.
+ * The usual number of properties is small enough for a linear search to be faster
+ * than a tree or a hash table: a lookup by text compares the hashes of the names
+ * stored contiguously and a lookup by interned name compares the name pointers.
+ * The iteration order is the alphabetical order of the names.
+ */
+template <class Value>
+class CM_PropertyTable
+{
+public:
+	struct Entry
+	{
+		CM_PropertyName name;
+		Value value;
+	};
+
+	typedef typename std::vector<Entry>::iterator iterator;
+	typedef typename std::vector<Entry>::const_iterator const_iterator;
+
+private:
+	std::vector<Entry> m_entries;
+	/// Hashes of the names of the entries at the same index.
+	std::vector<size_t> m_hashes;
+
+	static size_t Hash(const std::string& name)
+	{
+		return std::hash<std::string>()(name);
+	}
+
+	/// Return the index of a property or -1.
+	int Index(const std::string& name, size_t hash) const
+	{
+		for (unsigned int i = 0, size = m_hashes.size(); i < size; ++i) {
+			if (m_hashes[i] == hash && m_entries[i].name.GetString() == name) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	static bool LessName(const Entry& entry, const std::string& name)
+	{
+		return (entry.name.GetString() < name);
+	}
+
+public:
+	CM_PropertyTable() = default;
+	~CM_PropertyTable() = default;
+
+	/// Return the value of a property or nullptr.
+	Value Find(const std::string& name) const
+	{
+		const int index = Index(name, Hash(name));
+		return (index == -1) ? nullptr : m_entries[index].value;
+	}
+
+	Value Find(const CM_PropertyName& name) const
+	{
+		for (const Entry& entry : m_entries) {
+			if (entry.name == name) {
+				return entry.value;
+			}
+		}
+		return nullptr;
+	}
+
+	/// Set the value of a property, return the previous value or nullptr.
+	Value Set(const std::string& name, Value value)
+	{
+		const size_t hash = Hash(name);
+		const int index = Index(name, hash);
+		if (index != -1) {
+			Value old = m_entries[index].value;
+			m_entries[index].value = value;
+			return old;
+		}
+
+		const iterator it = std::lower_bound(m_entries.begin(), m_entries.end(), name, LessName);
+		m_hashes.insert(m_hashes.begin() + (it - m_entries.begin()), hash);
+		m_entries.insert(it, {CM_PropertyName(name), value});
+		return nullptr;
+	}
+
+	/// Remove a property and return its value or nullptr.
+	Value Remove(const std::string& name)
+	{
+		const int index = Index(name, Hash(name));
+		if (index == -1) {
+			return nullptr;
+		}
+
+		Value old = m_entries[index].value;
+		m_entries.erase(m_entries.begin() + index);
+		m_hashes.erase(m_hashes.begin() + index);
+		return old;
+	}
+
+	void Clear()
+	{
+		m_entries.clear();
+		m_hashes.clear();
+	}
+
+	unsigned int Size() const
+	{
+		return m_entries.size();
+	}
+
+	Entry& operator[](unsigned int index)
+	{
+		return m_entries[index];
+	}
+
+	iterator begin()
+	{
+		return m_entries.begin();
+	}
+
+	iterator end()
+	{
+		return m_entries.end();
+	}
+
+	const_iterator begin() const
+	{
+		return m_entries.begin();
+	}
+
+	const_iterator end() const
+	{
+		return m_entries.end();
+	}
+};
+
+#endif  // __CM_PROPERTY_TABLE_H__
@@ -156,6 +156,7 @@ bool BL_ActionActuator::Update(double curtime)
 			EXP_Value* newval = new EXP_FloatValue(obj->GetActionFrame(m_layer));
 			if (oldprop) {
 				oldprop->SetValue(newval);
+				obj->NotifyPropertyChange();
 			}
 			else {
 				obj->SetProperty(m_framepropname, newval);
@@ -63,6 +63,7 @@
 
 #include "RAS_Rasterizer.h"
 #include "RAS_ILightObject.h"
+#include "RAS_OpenGLLight.h"
 
 #include "RAS_ICanvas.h"
 #include "RAS_Vertex.h"
@@ -393,7 +394,9 @@ static RAS_MaterialBucket *BL_ConvertMaterial(Material *ma, int lightlayer, KX_S
 			name = "MA";
 		}
 
-		mat = new KX_BlenderMaterial(ma, name, lightlayer);
+		// Without rasterizer (headless player) no GPU data is created for the material.
+		const bool useGpu = (KX_GetActiveEngine()->GetRasterizer() != nullptr);
+		mat = new KX_BlenderMaterial(ma, name, lightlayer, useGpu);
 
 		// this is needed to free up memory afterwards.
 		converter.RegisterMaterial(mat, ma);
@@ -733,7 +736,8 @@ static KX_GameObject::ActivityCullingInfo activityCullingInfoFromBlenderObject(O
 
 static KX_LightObject *BL_GameLightFromBlenderLamp(Lamp *la, unsigned int layerflag, KX_Scene *kxscene, RAS_Rasterizer *rasterizer)
 {
-	RAS_ILightObject *lightobj = rasterizer->CreateLight();
+	// Without rasterizer the light is kept for the logic but never rendered.
+	RAS_ILightObject *lightobj = rasterizer ? rasterizer->CreateLight() : new RAS_OpenGLLight(nullptr);
 
 	lightobj->m_att1 = la->att1;
 	lightobj->m_att2 = (la->mode & LA_QUAD) ? la->att2 : 0.0f;
@@ -1264,8 +1268,10 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
 
 	// Convert world.
 	KX_WorldInfo *worldinfo = new KX_WorldInfo(blenderscene, blenderscene->world);
-	worldinfo->UpdateWorldSettings(rendertools);
-	worldinfo->UpdateBackGround(rendertools);
+	if (rendertools) {
+		worldinfo->UpdateWorldSettings(rendertools);
+		worldinfo->UpdateBackGround(rendertools);
+	}
 	kxscene->SetWorldInfo(worldinfo);
 
 	const bool showObstacleSimulation = (blenderscene->gm.flag & GAME_SHOW_OBSTACLE_SIMULATION) != 0;
@@ -1683,10 +1689,8 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
 		if (blenderobject->type == OB_MESH && (blenderobject->gameflag & OB_NAVMESH)) {
 			KX_NavMeshObject *navmesh = static_cast<KX_NavMeshObject *>(gameobj);
 			navmesh->SetVisible(false, true);
-			navmesh->BuildNavMesh();
-			if (obssimulation) {
-				obssimulation->AddObstaclesForNavMesh(navmesh);
-			}
+			// The obstacles are added once the navigation mesh is built.
+			navmesh->BuildNavMeshAsync();
 		}
 	}
 	for (KX_GameObject *gameobj : inactivelist) {
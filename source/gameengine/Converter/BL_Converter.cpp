@@ -42,6 +42,7 @@
 #include "KX_KetsjiEngine.h"
 #include "KX_PythonInit.h" // So we can handle adding new text datablocks for Python to import
 #include "KX_LibLoadStatus.h"
+#include "KX_TraceProfiler.h"
 #include "BL_ScalarInterpolator.h"
 #include "BL_Converter.h"
 #include "BL_SceneConverter.h"
@@ -83,6 +84,7 @@ extern "C" {
 }
 
 #include "BLI_task.h"
+#include "PIL_time.h"
 #include "CM_Message.h"
 
 #include <cstring>
@@ -251,6 +253,20 @@ void BL_Converter::FinalizeSceneData(const BL_SceneConverter& converter, KX_Scen
 
 void BL_Converter::RemoveScene(KX_Scene *scene)
 {
+	// Complete the partial merges into this scene to not leave objects referencing it.
+	for (std::vector<KX_LibLoadStatus *>::iterator it = m_merging.begin(); it != m_merging.end();) {
+		KX_LibLoadStatus *libload = *it;
+		if (libload->GetMergeScene() == scene) {
+			while (!MergeAsyncLoadStep(libload)) {
+			}
+			libload->Finish();
+			it = m_merging.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+
 	KX_WorldInfo *world = scene->GetWorldInfo();
 	if (world) {
 		delete world;
@@ -320,26 +336,144 @@ Main *BL_Converter::GetMainDynamicPath(const std::string& path) const
 	return nullptr;
 }
 
-void BL_Converter::MergeAsyncLoads()
+bool BL_Converter::MergeAsyncLoadStep(KX_LibLoadStatus *libload)
 {
-	m_threadinfo.m_mutex.Lock();
+	const std::vector<BL_SceneConverter>& converters = libload->GetSceneConverters();
+	if (libload->GetMergeConverter() >= converters.size()) {
+		return true;
+	}
 
-	for (KX_LibLoadStatus *libload : m_mergequeue) {
-		KX_Scene *mergeScene = libload->GetMergeScene();
-		for (const BL_SceneConverter& converter : libload->GetSceneConverters()) {
-			KX_Scene *scene = converter.GetScene();
-			MergeScene(mergeScene, scene);
-			// Finalize material and mesh conversion.
-			FinalizeSceneData(converter, mergeScene);
-			delete scene;
+	const BL_SceneConverter& converter = converters[libload->GetMergeConverter()];
+	KX_Scene *mergeScene = libload->GetMergeScene();
+	KX_Scene *scene = converter.GetScene();
+	const KX_LibLoadStatus::MergeStage stage = libload->GetMergeStage();
+	const unsigned int item = libload->GetMergeItem();
+
+	if (stage == KX_LibLoadStatus::MERGE_OBJECTS && item == 0 && !mergeScene->CanMergeScene(scene)) {
+		// Finalize material and mesh conversion as the objects are not merged.
+		FinalizeSceneData(converter, mergeScene);
+		MergeSceneSlot(mergeScene, scene);
+		delete scene;
+		libload->NextMergeConverter();
+		return (libload->GetMergeConverter() == converters.size());
+	}
+
+	// The objects are iterated in the active list and then in the inactive list.
+	EXP_ListValue<KX_GameObject> *objects = scene->GetObjectList();
+	EXP_ListValue<KX_GameObject> *inactiveObjects = scene->GetInactiveList();
+	const unsigned int numActiveObjects = objects->GetCount();
+	const unsigned int numObjects = numActiveObjects + inactiveObjects->GetCount();
+	KX_GameObject *gameobj = nullptr;
+	if (item < numObjects) {
+		gameobj = (item < numActiveObjects) ? objects->GetValue(item) : inactiveObjects->GetValue(item - numActiveObjects);
+	}
+
+	unsigned int numItems = 1;
+	switch (stage) {
+		case KX_LibLoadStatus::MERGE_OBJECTS:
+		case KX_LibLoadStatus::MERGE_LOGIC:
+		{
+			numItems = numObjects;
+			break;
+		}
+		case KX_LibLoadStatus::MERGE_MESHES:
+		{
+			numItems = converter.m_meshobjects.size();
+			break;
 		}
+		case KX_LibLoadStatus::MERGE_MATERIALS:
+		{
+			numItems = converter.m_materials.size();
+			break;
+		}
+		default:
+		{
+			break;
+		}
+	}
 
-		libload->Finish();
+	if (item < numItems) {
+		switch (stage) {
+			case KX_LibLoadStatus::MERGE_OBJECTS:
+			{
+				mergeScene->MergeSceneObject(gameobj, scene);
+				break;
+			}
+			case KX_LibLoadStatus::MERGE_MESHES:
+			{
+				converter.m_meshobjects[item]->ReplaceScene(mergeScene);
+				break;
+			}
+			case KX_LibLoadStatus::MERGE_MATERIALS:
+			{
+				// Done after the objects so materials can use the lights in shaders.
+				converter.m_materials[item]->InitScene(mergeScene);
+				break;
+			}
+			case KX_LibLoadStatus::MERGE_LOGIC:
+			{
+				mergeScene->MergeSceneLogic(gameobj);
+				break;
+			}
+			case KX_LibLoadStatus::MERGE_FINISH:
+			{
+				mergeScene->MergeSceneFinish(scene);
+				MergeSceneSlot(mergeScene, scene);
+				delete scene;
+				break;
+			}
+			default:
+			{
+				break;
+			}
+		}
+		libload->NextMergeItem();
 	}
 
-	m_mergequeue.clear();
+	if (libload->GetMergeItem() >= numItems) {
+		libload->NextMergeStage();
+	}
+
+	return (libload->GetMergeConverter() == converters.size());
+}
 
+void BL_Converter::MergeAsyncLoads(bool useBudget)
+{
+	KX_TRACE_SCOPE("BL_Converter::MergeAsyncLoads");
+
+	// Only hold the lock to take the converted libraries, the merge is done by the main thread only.
+	m_threadinfo.m_mutex.Lock();
+	m_merging.insert(m_merging.end(), m_mergequeue.begin(), m_mergequeue.end());
+	m_mergequeue.clear();
 	m_threadinfo.m_mutex.Unlock();
+
+	const double startTime = PIL_check_seconds_timer();
+
+	while (!m_merging.empty()) {
+		KX_LibLoadStatus *libload = m_merging.front();
+		// The budget is in milliseconds, zero for no limit.
+		const double budget = useBudget ? libload->GetMergeBudget() * 0.001 : 0.0;
+
+		bool finished;
+		bool exceeded = false;
+		do {
+			// At least one item is merged per call to always progress.
+			finished = MergeAsyncLoadStep(libload);
+			exceeded = (budget > 0.0) && ((PIL_check_seconds_timer() - startTime) >= budget);
+		} while (!finished && !exceeded);
+
+		if (!finished) {
+			libload->UpdateMergeProgress();
+			break;
+		}
+
+		libload->Finish();
+		m_merging.erase(m_merging.begin());
+
+		if (exceeded) {
+			break;
+		}
+	}
 }
 
 void BL_Converter::FinalizeAsyncLoads()
@@ -347,7 +481,7 @@ void BL_Converter::FinalizeAsyncLoads()
 	// Finish all loading libraries.
 	BLI_task_pool_work_and_wait(m_threadinfo.m_pool);
 	// Merge all libraries data in the current scene, to avoid memory leak of unmerged scenes.
-	MergeAsyncLoads();
+	MergeAsyncLoads(false);
 }
 
 void BL_Converter::AddScenesToMergeQueue(KX_LibLoadStatus *status)
@@ -756,7 +890,11 @@ bool BL_Converter::FreeBlendFile(const std::string& path)
 void BL_Converter::MergeScene(KX_Scene *to, KX_Scene *from)
 {
 	to->MergeScene(from);
+	MergeSceneSlot(to, from);
+}
 
+void BL_Converter::MergeSceneSlot(KX_Scene *to, KX_Scene *from)
+{
 	m_sceneSlots[to].Merge(m_sceneSlots[from]);
 	m_sceneSlots.erase(from);
 
@@ -98,6 +98,8 @@ private:
 	// Saved KX_LibLoadStatus objects
 	std::map<std::string, KX_LibLoadStatus *> m_status_map;
 	std::vector<KX_LibLoadStatus *> m_mergequeue;
+	/// Libraries taken from m_mergequeue and being merged, only used by the main thread.
+	std::vector<KX_LibLoadStatus *> m_merging;
 
 	Main *m_maggie;
 	std::vector<Main *> m_DynamicMaggie;
@@ -153,8 +155,20 @@ public:
 	KX_Mesh *ConvertMeshSpecial(KX_Scene *kx_scene, Main *maggie, const std::string& name);
 
 	void MergeScene(KX_Scene *to, KX_Scene *from);
+	/** Move the converted data of a scene to the slot of another scene and delete its world info,
+	 * the objects are merged separately.
+	 */
+	void MergeSceneSlot(KX_Scene *to, KX_Scene *from);
 
-	void MergeAsyncLoads();
+	/** Merge one item of the current stage of an async libload.
+	 * \return True when all the scenes of the libload are merged.
+	 */
+	bool MergeAsyncLoadStep(KX_LibLoadStatus *libload);
+	/** Merge the converted scenes of the async libloads.
+	 * \param useBudget Stop merging when the merge budget of a libload is exceeded
+	 * and resume at the next call, else merge everything.
+	 */
+	void MergeAsyncLoads(bool useBudget);
 	void FinalizeAsyncLoads();
 	void AddScenesToMergeQueue(KX_LibLoadStatus *status);
 
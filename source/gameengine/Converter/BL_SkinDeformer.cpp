@@ -33,10 +33,6 @@
 #  pragma warning (disable:4786)
 #endif
 
-// Eigen3 stuff used for BGEDeformVerts
-#include <Eigen/Core>
-#include <Eigen/LU>
-
 #include "BL_SkinDeformer.h"
 #include <string>
 #include "RAS_IPolygonMaterial.h"
@@ -47,6 +43,7 @@
 
 //#include "BL_ArmatureController.h"
 #include "BL_DeformableGameObject.h"
+#include "KX_TraceProfiler.h"
 #include "DNA_armature_types.h"
 #include "DNA_action_types.h"
 #include "DNA_mesh_types.h"
@@ -64,6 +61,18 @@ extern "C" {
 
 #include "BLI_blenlib.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
+
+#include <algorithm>
+
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
+/// Number of vertices skinned by a task.
+static const unsigned int skinChunkSize = 2048;
+/// Minimum number of vertices to skin a mesh in parallel.
+static const unsigned int skinParallelVertices = 8192;
 
 static short get_deformflags(Object *bmeshobj)
 {
@@ -163,11 +172,167 @@ void BL_SkinDeformer::BlenderDeformVerts()
 	RecalcNormals();
 }
 
+void BL_SkinDeformer::BuildInfluenceTable()
+{
+	struct Influence
+	{
+		unsigned short bone;
+		float weight;
+	};
+
+	const unsigned short defbase_tot = m_dfnrToPC.size();
+	const MDeformVert *dverts = m_bmesh->dvert;
+
+	m_influences = std::make_shared<InfluenceTable>();
+	InfluenceTable& table = *m_influences;
+
+	// Only the weights of deforming bones are used.
+	auto isValid = [this, defbase_tot](const MDeformWeight& dw) {
+		return (dw.def_nr < defbase_tot && m_dfnrToPC[dw.def_nr] && dw.weight != 0.0f);
+	};
+
+	std::vector<unsigned short> counts(m_bmesh->totvert, 0);
+	unsigned short maxCount = 0;
+	for (int i = 0; i < m_bmesh->totvert; ++i) {
+		const MDeformVert& dv = dverts[i];
+		for (unsigned int j = 0; j < dv.totweight; ++j) {
+			if (isValid(dv.dw[j])) {
+				++counts[i];
+			}
+		}
+		maxCount = std::max(maxCount, counts[i]);
+	}
+
+	std::vector<Influence> influences;
+	for (unsigned short count = 1; count <= maxCount; ++count) {
+		InfluenceGroup group = {count, (unsigned int)table.vertices.size(), 0, (unsigned int)table.bones.size()};
+
+		for (int i = 0; i < m_bmesh->totvert; ++i) {
+			if (counts[i] != count) {
+				continue;
+			}
+
+			const MDeformVert& dv = dverts[i];
+			float contrib = 0.0f;
+			influences.clear();
+			for (unsigned int j = 0; j < dv.totweight; ++j) {
+				const MDeformWeight& dw = dv.dw[j];
+				if (isValid(dw)) {
+					influences.push_back({(unsigned short)dw.def_nr, dw.weight});
+					contrib += dw.weight;
+				}
+			}
+
+			// The normal is rotated by the first most influential bone.
+			std::stable_sort(influences.begin(), influences.end(), [](const Influence& inf1, const Influence& inf2) {
+				return inf1.weight > inf2.weight;
+			});
+
+			table.vertices.push_back(i);
+			for (const Influence& inf : influences) {
+				table.bones.push_back(inf.bone);
+				table.weights.push_back(inf.weight / contrib);
+			}
+		}
+
+		group.end = table.vertices.size();
+		if (group.end != group.begin) {
+			table.groups.push_back(group);
+		}
+	}
+}
+
+/** Skin the position and the normal of a vertex, the position is the sum of the weighted
+ * bone matrices applied to the original position and the normal is rotated by the most
+ * influential bone.
+ */
+static void skin_vertex(const BL_SkinDeformer::BoneMatrices *matrices, const unsigned short *bones, const float *weights,
+		unsigned short count, const short orignormal[3], float position[3], float normal[3])
+{
+	float no[3];
+	normal_short_to_float_v3(no, orignormal);
+
+#ifdef __SSE2__
+	const float (*mat)[4] = matrices[bones[0]].position;
+	__m128 weight = _mm_set1_ps(weights[0]);
+	__m128 col0 = _mm_mul_ps(weight, _mm_loadu_ps(mat[0]));
+	__m128 col1 = _mm_mul_ps(weight, _mm_loadu_ps(mat[1]));
+	__m128 col2 = _mm_mul_ps(weight, _mm_loadu_ps(mat[2]));
+	__m128 col3 = _mm_mul_ps(weight, _mm_loadu_ps(mat[3]));
+
+	for (unsigned short i = 1; i < count; ++i) {
+		mat = matrices[bones[i]].position;
+		weight = _mm_set1_ps(weights[i]);
+		col0 = _mm_add_ps(col0, _mm_mul_ps(weight, _mm_loadu_ps(mat[0])));
+		col1 = _mm_add_ps(col1, _mm_mul_ps(weight, _mm_loadu_ps(mat[1])));
+		col2 = _mm_add_ps(col2, _mm_mul_ps(weight, _mm_loadu_ps(mat[2])));
+		col3 = _mm_add_ps(col3, _mm_mul_ps(weight, _mm_loadu_ps(mat[3])));
+	}
+
+	float result[4];
+	_mm_storeu_ps(result, _mm_add_ps(_mm_add_ps(_mm_mul_ps(col0, _mm_set1_ps(position[0])),
+	                                            _mm_mul_ps(col1, _mm_set1_ps(position[1]))),
+	                                 _mm_add_ps(_mm_mul_ps(col2, _mm_set1_ps(position[2])), col3)));
+	copy_v3_v3(position, result);
+
+	const float (*nmat)[4] = matrices[bones[0]].normal;
+	_mm_storeu_ps(result, _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(nmat[0]), _mm_set1_ps(no[0])),
+	                                            _mm_mul_ps(_mm_loadu_ps(nmat[1]), _mm_set1_ps(no[1]))),
+	                                 _mm_mul_ps(_mm_loadu_ps(nmat[2]), _mm_set1_ps(no[2]))));
+	copy_v3_v3(normal, result);
+#else
+	float mat[4][4] = {{0.0f}};
+	for (unsigned short i = 0; i < count; ++i) {
+		for (unsigned short j = 0; j < 4; ++j) {
+			madd_v4_v4fl(mat[j], matrices[bones[i]].position[j], weights[i]);
+		}
+	}
+
+	mul_m4_v3(mat, position);
+	mul_v3_mat3_m4v3(normal, (float (*)[4])matrices[bones[0]].normal, no);
+#endif
+}
+
+struct SkinTaskData
+{
+	const BL_SkinDeformer::InfluenceTable *table;
+	const BL_SkinDeformer::BoneMatrices *matrices;
+	const MVert *mverts;
+	std::array<float, 3> *positions;
+	std::array<float, 3> *normals;
+};
+
+/// Skin the vertices from begin to end in the sorted vertices of the influence table.
+static void skin_vertices(const SkinTaskData& data, unsigned int begin, unsigned int end)
+{
+	const BL_SkinDeformer::InfluenceTable& table = *data.table;
+
+	for (const BL_SkinDeformer::InfluenceGroup& group : table.groups) {
+		const unsigned int groupBegin = std::max(begin, group.begin);
+		const unsigned int groupEnd = std::min(end, group.end);
+
+		for (unsigned int i = groupBegin; i < groupEnd; ++i) {
+			const unsigned int offset = group.offset + (i - group.begin) * group.count;
+			const unsigned int index = table.vertices[i];
+			skin_vertex(data.matrices, &table.bones[offset], &table.weights[offset], group.count,
+			            data.mverts[index].no, data.positions[index].data(), data.normals[index].data());
+		}
+	}
+}
+
+static void skin_vertices_task(void *userdata, const int iter)
+{
+	const SkinTaskData& data = *(SkinTaskData *)userdata;
+	const unsigned int begin = iter * skinChunkSize;
+	const unsigned int end = std::min(begin + skinChunkSize, (unsigned int)data.table->vertices.size());
+
+	skin_vertices(data, begin, end);
+}
+
 void BL_SkinDeformer::BGEDeformVerts()
 {
 	Object *par_arma = m_armobj->GetArmatureObject();
 	MDeformVert *dverts = m_bmesh->dvert;
-	Eigen::Matrix4f pre_mat, post_mat, chan_mat, norm_chan_mat;
 
 	if (!dverts)
 		return;
@@ -187,66 +352,37 @@ void BL_SkinDeformer::BGEDeformVerts()
 		}
 	}
 
-	post_mat = Eigen::Matrix4f::Map((float *)m_obmat).inverse() * Eigen::Matrix4f::Map((float *)m_armobj->GetArmatureObject()->obmat);
-	pre_mat = post_mat.inverse();
-
-	MDeformVert *dv = dverts;
-	MDeformWeight *dw;
-
-	for (int i = 0; i < m_bmesh->totvert; ++i, dv++) {
-		float contrib = 0.0f, weight, max_weight = -1.0f;
-		bPoseChannel *pchan = nullptr;
-		Eigen::Vector3f normorg(m_bmesh->mvert[i].no[0], m_bmesh->mvert[i].no[1], m_bmesh->mvert[i].no[2]);
-		Eigen::Map<Eigen::Vector3f> norm = Eigen::Vector3f::Map(m_transnors[i].data());
-		Eigen::Vector4f vec(0.0f, 0.0f, 0.0f, 1.0f);
-		Eigen::Vector4f co(m_transverts[i][0],
-		                   m_transverts[i][1],
-		                   m_transverts[i][2],
-		                   1.0f);
-
-		if (!dv->totweight)
-			continue;
-
-		co = pre_mat * co;
-
-		dw = dv->dw;
-
-		for (unsigned int j = dv->totweight; j != 0; j--, dw++) {
-			const int index = dw->def_nr;
-
-			if (index < defbase_tot && (pchan = m_dfnrToPC[index])) {
-				weight = dw->weight;
-
-				if (weight) {
-					chan_mat = Eigen::Matrix4f::Map((float *)pchan->chan_mat);
-
-					// Update Vertex Position
-					vec.noalias() += (chan_mat * co - co) * weight;
-
-					// Save the most influential channel so we can use it to update the vertex normal
-					if (weight > max_weight)
-					{
-						max_weight = weight;
-						norm_chan_mat = chan_mat;
-					}
+	// The table only depends on the mesh and the bone names, it's kept for the replicas.
+	if (!m_influences) {
+		BuildInfluenceTable();
+	}
 
-					contrib += weight;
-				}
-			}
+	float imat[4][4], post_mat[4][4], pre_mat[4][4];
+	invert_m4_m4(imat, m_obmat);
+	mul_m4_m4m4(post_mat, imat, par_arma->obmat);
+	invert_m4_m4(pre_mat, post_mat);
+
+	// Concatenate the pose of each deform group with the mesh to armature space conversions.
+	m_boneMatrices.resize(defbase_tot);
+	for (unsigned short i = 0; i < defbase_tot; ++i) {
+		bPoseChannel *pchan = m_dfnrToPC[i];
+		if (pchan) {
+			mul_m4_series(m_boneMatrices[i].position, post_mat, pchan->chan_mat, pre_mat);
+			copy_m4_m4(m_boneMatrices[i].normal, pchan->chan_mat);
 		}
+	}
 
-		// Update Vertex Normal
-		norm = norm_chan_mat.topLeftCorner<3, 3>() * normorg;
-
-		co.noalias() += vec / contrib;
-		co[3] = 1.0f; // Make sure we have a 1 for the w component!
-
-		co = post_mat * co;
+	SkinTaskData data = {m_influences.get(), m_boneMatrices.data(), m_bmesh->mvert, m_transverts.data(), m_transnors.data()};
+	const unsigned int numVertices = m_influences->vertices.size();
 
-		m_transverts[i][0] = co[0];
-		m_transverts[i][1] = co[1];
-		m_transverts[i][2] = co[2];
+	// Deformers are already updated in parallel, only big meshes are split.
+	if (numVertices >= skinParallelVertices) {
+		BLI_task_parallel_range(0, (numVertices + skinChunkSize - 1) / skinChunkSize, &data, skin_vertices_task, true);
+	}
+	else {
+		skin_vertices(data, 0, numVertices);
 	}
+
 	m_copyNormals = true;
 }
 
@@ -326,5 +462,7 @@ bool BL_SkinDeformer::UpdateInternal(bool shape_applied)
 
 bool BL_SkinDeformer::Update(void)
 {
+	KX_TRACE_SCOPE("BL_SkinDeformer::Update");
+
 	return UpdateInternal(false);
 }
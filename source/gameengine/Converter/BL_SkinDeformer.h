@@ -46,6 +46,8 @@
 
 #include "RAS_Deformer.h"
 
+#include <memory>
+
 struct Object;
 struct bPoseChannel;
 class RAS_Mesh;
@@ -54,6 +56,41 @@ class RAS_IPolyMaterial;
 class BL_SkinDeformer : public BL_MeshDeformer
 {
 public:
+	/// A range of vertices using the same number of bone influences.
+	struct InfluenceGroup
+	{
+		/// Number of influences of each vertex.
+		unsigned short count;
+		/// Range of the group in InfluenceTable::vertices.
+		unsigned int begin;
+		unsigned int end;
+		/// Index of the first influence of the group in InfluenceTable::bones and weights.
+		unsigned int offset;
+	};
+
+	/** Compact table of the valid bone influences of the mesh vertices used by BGEDeformVerts.
+	 * The vertices are sorted by number of influences, the weights are normalized and
+	 * the first influence of a vertex is the most important.
+	 */
+	struct InfluenceTable
+	{
+		std::vector<InfluenceGroup> groups;
+		/// Index of the deformed vertices, vertices without influences are not deformed.
+		std::vector<unsigned int> vertices;
+		/// Deform group index of each influence.
+		std::vector<unsigned short> bones;
+		std::vector<float> weights;
+	};
+
+	/// Matrices of a deform group for the current pose.
+	struct BoneMatrices
+	{
+		/// Deformation of the vertex positions in the mesh space.
+		float position[4][4];
+		/// Pose channel matrix rotating the vertex normals.
+		float normal[4][4];
+	};
+
 	virtual void Relink(std::map<SCA_IObject *, SCA_IObject *>& map);
 
 	BL_SkinDeformer(BL_DeformableGameObject *gameobj,
@@ -94,8 +131,14 @@ protected:
 	bool m_copyNormals; // dirty flag so we know if Apply() needs to copy normal information (used for BGEDeformVerts())
 	std::vector<bPoseChannel *> m_dfnrToPC;
 	short m_deformflags;
+	/// Influences of the vertices, built with m_dfnrToPC and shared with the replicas.
+	std::shared_ptr<InfluenceTable> m_influences;
+	/// Matrices of each deform group, updated before every BGE deformation.
+	std::vector<BoneMatrices> m_boneMatrices;
 
 	void BlenderDeformVerts();
+	/// Build m_influences from the mesh deform vertices.
+	void BuildInfluenceTable();
 	void BGEDeformVerts();
 
 	virtual void UpdateTransverts();
@@ -21,6 +21,8 @@
 
 #include "EXP_Value.h"
 
+#include <unordered_map>
+
 class EXP_BaseListValue : public EXP_PropValue
 {
 	Py_Header
@@ -31,9 +33,46 @@ public:
 	typedef VectorType::const_iterator VectorTypeConstIterator;
 
 protected:
-	VectorType m_valueArray;
+	/// Mutable to remove the holes left by RemoveValue in const functions, see Compact.
+	mutable VectorType m_valueArray;
 	bool m_bReleaseContents;
 
+	/// Use m_positions in SearchValue and RemoveValue.
+	bool m_usePositionIndex;
+	/// True when m_positions matches m_valueArray, it's rebuilt on the next use otherwise.
+	mutable bool m_positionsValid;
+	/// Position of each value in m_valueArray.
+	mutable std::unordered_map<EXP_Value *, unsigned int> m_positions;
+	/// Number of null slots left in m_valueArray by RemoveValue.
+	mutable unsigned int m_numHoles;
+	/// Lowest position of the null slots.
+	mutable unsigned int m_firstHole;
+
+	/// Use m_nameIndex in FindValue.
+	bool m_useNameIndex;
+	/// True when m_nameIndex matches m_valueArray, it's rebuilt on the next FindValue otherwise.
+	mutable bool m_nameIndexValid;
+	/// All the values of a name, in the list order.
+	mutable std::unordered_map<std::string, VectorType> m_nameIndex;
+	/// Name of the indexed values, the values could be already freed when removed.
+	mutable std::unordered_map<EXP_Value *, const std::string *> m_nameIndexKeys;
+
+	/// Add a value at the end of the name index.
+	void AddNameIndex(EXP_Value *value) const;
+	void InvalidateNameIndex();
+
+	void BuildPositionIndex() const;
+	void InvalidatePositionIndex();
+	/// Remove the null slots of m_valueArray, the values keep their order.
+	void CompactHoles() const;
+	/// Must be called before any access to m_valueArray by index or iterator.
+	inline void Compact() const
+	{
+		if (m_numHoles > 0) {
+			CompactHoles();
+		}
+	}
+
 	void SetValue(int i, EXP_Value *val);
 	EXP_Value *GetValue(int i);
 	EXP_Value *FindValue(const std::string& name) const;
@@ -52,6 +91,20 @@ public:
 	virtual std::string GetText();
 
 	void SetReleaseOnDestruct(bool bReleaseContents);
+	/** Find the values by name with a hash instead of a linear search. The index is
+	 * updated by Add and RemoveValue and rebuilt after other modifications.
+	 * The owner of the list must call NotifyNameChanged when a value is renamed.
+	 */
+	void SetUseNameIndex(bool useNameIndex);
+	/// Invalidate the name index if it contains the renamed value.
+	void NotifyNameChanged(EXP_Value *value);
+	/** Search and remove the values with their position instead of a linear search.
+	 * A removed value leaves a null slot which is compacted on the next access to
+	 * the list, so many removals in a frame cost a single pass over the list.
+	 * The list iterators skip the null slots of the values removed while iterating.
+	 * The values must be unique and not null.
+	 */
+	void SetUsePositionIndex(bool usePositionIndex);
 
 	void Remove(int i);
 	void Resize(int num);
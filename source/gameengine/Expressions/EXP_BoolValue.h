@@ -38,6 +38,7 @@ public:
 	virtual double GetNumber();
 	virtual int GetValueType();
 	bool GetBool();
+	void SetBool(bool b);
 	virtual void SetValue(EXP_Value *newval);
 
 	virtual EXP_Value *Calc(VALUE_OPERATOR op, EXP_Value *val);
@@ -0,0 +1,182 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file EXP_Bytecode.h
+ *  \ingroup expressions
+ */
+
+#ifndef __EXP_BYTECODE_H__
+#define __EXP_BYTECODE_H__
+
+#include "EXP_IntValue.h" // For cInt.
+
+#include <vector>
+
+class EXP_Expression;
+
+/// Identifier resolved by the context of a compiled expression.
+struct EXP_BytecodeSymbol
+{
+	enum Type {
+		/// Unsupported identifier, the expression is evaluated with its tree.
+		SYMBOL_NONE,
+		/// Property named as the identifier in the owner.
+		SYMBOL_PROPERTY,
+		/// Boolean returned by the context for the index.
+		SYMBOL_BOOLEAN
+	} type;
+
+	EXP_Value *owner;
+	unsigned int index;
+};
+
+/// Interface of the objects resolving the identifiers of a compiled expression.
+class EXP_IBytecodeContext
+{
+public:
+	virtual ~EXP_IBytecodeContext() = default;
+
+	/// Resolve an identifier at compilation.
+	virtual EXP_BytecodeSymbol ResolveSymbol(const std::string& name) = 0;
+	/// Get the value of a boolean symbol at evaluation.
+	virtual bool GetBooleanSymbol(unsigned int index) = 0;
+};
+
+/** Register based bytecode of an expression tree. Each node is compiled into one
+ * instruction writing an unboxed int, float or bool register, the constants are
+ * stored in registers at compilation and the properties are loaded through slots
+ * resolved at compilation.
+ *
+ * The compilation fails for the constructs having no unboxed equivalent (strings,
+ * errors, mismatching types) and the execution fails when the tree would return an
+ * error (division by zero) or when a property changed of type. In both cases the
+ * caller must evaluate the tree to get the exact same result and error messages.
+ */
+class EXP_Bytecode
+{
+public:
+	enum OpCode {
+		OP_LOAD_PROPERTY,
+		OP_LOAD_BOOLEAN,
+		OP_INT_TO_FLOAT,
+		OP_SELECT,
+
+		OP_ADD_INT,
+		OP_SUB_INT,
+		OP_MUL_INT,
+		OP_DIV_INT,
+		OP_MOD_INT,
+		OP_NEG_INT,
+		OP_NOT_INT,
+		OP_EQL_INT,
+		OP_NEQ_INT,
+		OP_GRE_INT,
+		OP_LES_INT,
+		OP_GEQ_INT,
+		OP_LEQ_INT,
+
+		OP_ADD_FLOAT,
+		OP_SUB_FLOAT,
+		OP_MUL_FLOAT,
+		OP_DIV_FLOAT,
+		OP_MOD_FLOAT,
+		OP_NEG_FLOAT,
+		OP_NOT_FLOAT,
+		OP_EQL_FLOAT,
+		OP_NEQ_FLOAT,
+		OP_GRE_FLOAT,
+		OP_LES_FLOAT,
+		OP_GEQ_FLOAT,
+		OP_LEQ_FLOAT,
+
+		OP_NOT_BOOL,
+		OP_AND_BOOL,
+		OP_OR_BOOL,
+		OP_EQL_BOOL,
+		OP_NEQ_BOOL
+	};
+
+private:
+	union Register {
+		cInt i;
+		float f;
+		bool b;
+	};
+
+	struct Instruction {
+		OpCode op;
+		unsigned int dst;
+		unsigned int a;
+		unsigned int b;
+		unsigned int c;
+	};
+
+	struct PropertySlot {
+		EXP_Value *owner;
+		CM_PropertyName name;
+		VALUE_DATA_TYPE type;
+		/// Cached property, valid while the properties version of the owner is unchanged.
+		EXP_Value *value;
+		unsigned int version;
+	};
+
+	EXP_IBytecodeContext *m_context;
+
+	std::vector<Instruction> m_instructions;
+	std::vector<Register> m_registers;
+	std::vector<VALUE_DATA_TYPE> m_registerTypes;
+	std::vector<PropertySlot> m_propertySlots;
+	/// Register of the expression result, -1 when the compilation failed.
+	int m_result;
+
+	int AddRegister(VALUE_DATA_TYPE type);
+	int Emit(OpCode op, VALUE_DATA_TYPE type, int a, int b = 0, int c = 0);
+	/// Convert an int register to float, leave other registers unchanged.
+	int ToFloat(int reg);
+	/// Update the cached property of a slot, return false if the property is missing or changed of type.
+	bool UpdatePropertySlot(PropertySlot& slot);
+
+public:
+	EXP_Bytecode(EXP_IBytecodeContext *context);
+	~EXP_Bytecode();
+
+	/// Compile an expression tree, return false if the tree contains unsupported constructs.
+	bool Compile(EXP_Expression *expr);
+	bool IsValid() const;
+
+	/** Functions used by the expressions in EXP_Expression::Compile, return the
+	 * register of the result or -1 for an unsupported construct.
+	 */
+	int EmitConstant(EXP_Value *value);
+	int EmitIdentifier(const std::string& name);
+	int EmitOperator1(VALUE_OPERATOR op, int operand);
+	int EmitOperator2(VALUE_OPERATOR op, int lhs, int rhs);
+	int EmitIf(int guard, int e1, int e2);
+
+	/** Evaluate the compiled expression.
+	 * \param result The number of the result as returned by EXP_Value::GetNumber.
+	 * \return False if the tree must be evaluated instead.
+	 */
+	bool Execute(double& result);
+};
+
+#endif  // __EXP_BYTECODE_H__
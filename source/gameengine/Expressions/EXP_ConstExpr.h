@@ -32,6 +32,7 @@ public:
 	virtual unsigned char GetExpressionID();
 	virtual double GetNumber();
 	virtual EXP_Value *Calculate();
+	virtual int Compile(EXP_Bytecode& bytecode);
 
 private:
 	EXP_Value *m_value;
@@ -21,6 +21,8 @@
 
 #include "EXP_Value.h"
 
+class EXP_Bytecode;
+
 class EXP_Expression : public CM_RefCount<EXP_Expression>
 {
 public:
@@ -41,6 +43,10 @@ public:
 
 	virtual EXP_Value *Calculate() = 0;
 	virtual unsigned char GetExpressionID() = 0;
+	/** Compile the expression into the bytecode, return the register of the result
+	 * or -1 if the expression can't be compiled.
+	 */
+	virtual int Compile(EXP_Bytecode& bytecode);
 };
 
 #endif  // __EXP_EXPRESSION_H__
@@ -45,6 +45,7 @@ public:
 	virtual ~EXP_IdentifierExpr();
 
 	virtual EXP_Value *Calculate();
+	virtual int Compile(EXP_Bytecode& bytecode);
 	virtual unsigned char GetExpressionID();
 };
 
@@ -35,6 +35,7 @@ public:
 
 	virtual unsigned char GetExpressionID();
 	virtual EXP_Value *Calculate();
+	virtual int Compile(EXP_Bytecode& bytecode);
 };
 
 #endif  // __EXP_IFEXPR_H__
@@ -30,19 +30,33 @@ template <class ItemType>
 class EXP_ListValue : public EXP_BaseListValue
 {
 public:
+	/** Iterator over the values, skipping the null slots left by the values removed
+	 * while iterating. Any other modification of the list invalidates the iterators.
+	 */
 	class const_iterator
 	{
 	public:
 		VectorTypeConstIterator m_it;
+		VectorTypeConstIterator m_end;
 
-		const_iterator(VectorTypeConstIterator it)
-		: m_it(it)
+		const_iterator(VectorTypeConstIterator it, VectorTypeConstIterator end)
+			:m_it(it),
+			m_end(end)
 		{
+			SkipHoles();
+		}
+
+		inline void SkipHoles()
+		{
+			while (m_it != m_end && !*m_it) {
+				++m_it;
+			}
 		}
 
 		inline void operator++()
 		{
 			++m_it;
+			SkipHoles();
 		}
 
 		inline ItemType *operator*() const
@@ -70,11 +84,14 @@ public:
 
 	virtual EXP_ListValue<ItemType> *GetReplica()
 	{
+		Compact();
 		EXP_ListValue<ItemType> *replica = new EXP_ListValue<ItemType>(*this);
 
 		replica->ProcessReplica();
 
 		replica->m_bReleaseContents = true; // For copy, complete array is copied for now...
+		replica->InvalidateNameIndex();
+		replica->InvalidatePositionIndex();
 		// Copy all values.
 		const int numelements = m_valueArray.size();
 		replica->m_valueArray.resize(numelements);
@@ -97,6 +114,7 @@ public:
 
 	ItemType *FindIf(std::function<bool (ItemType *)> function)
 	{
+		Compact();
 		for (EXP_Value *val : m_valueArray) {
 			ItemType *item = static_cast<ItemType *>(val);
 			if (function(item)) {
@@ -151,20 +169,24 @@ public:
 
 	ItemType *GetFront()
 	{
+		Compact();
 		return static_cast<ItemType *>(m_valueArray.front());
 	}
 	ItemType *GetBack()
 	{
+		Compact();
 		return static_cast<ItemType *>(m_valueArray.back());
 	}
 
 	const_iterator begin()
 	{
-		return const_iterator(m_valueArray.begin());
+		Compact();
+		return const_iterator(m_valueArray.begin(), m_valueArray.end());
 	}
 	const_iterator end()
 	{
-		return const_iterator(m_valueArray.end());
+		Compact();
+		return const_iterator(m_valueArray.end(), m_valueArray.end());
 	}
 };
 
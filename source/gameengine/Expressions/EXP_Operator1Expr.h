@@ -30,6 +30,7 @@ public:
 
 	virtual unsigned char GetExpressionID();
 	virtual EXP_Value *Calculate();
+	virtual int Compile(EXP_Bytecode& bytecode);
 
 private:
 	VALUE_OPERATOR m_op;
@@ -31,6 +31,7 @@ public:
 
 	virtual unsigned char GetExpressionID();
 	virtual EXP_Value *Calculate();
+	virtual int Compile(EXP_Bytecode& bytecode);
 
 protected:
 	EXP_Expression *m_rhs;
@@ -41,6 +41,9 @@ public:
 	virtual void SetValue(EXP_Value *newval);
 	virtual EXP_Value *GetReplica();
 
+	const std::string& GetString() const;
+	void SetString(const std::string& str);
+
 #ifdef WITH_PYTHON
 	virtual PyObject *ConvertValueToPython()
 	{
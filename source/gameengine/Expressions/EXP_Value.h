@@ -24,6 +24,7 @@
 #endif
 
 #include "CM_RefCount.h"
+#include "CM_PropertyTable.h"
 
 #include <map> // Array functionality for the property list.
 #include <vector>
@@ -126,6 +127,8 @@ public:
 	/// Set property <ioProperty>, overwrites and releases a previous property with the same name if needed.
 	virtual void SetProperty(const std::string& name, EXP_Value *ioProperty);
 	virtual EXP_Value *GetProperty(const std::string & inName);
+	/// Get pointer to a property from its interned name, faster for the callers looking up the same name repeatedly.
+	EXP_Value *GetProperty(const CM_PropertyName& inName) const;
 	/// Get text description of property with name <inName>, returns an empty string if there is no property named <inName>.
 	const std::string GetPropertyText(const std::string & inName);
 	float GetPropertyNumber(const std::string& inName, float defnumber);
@@ -137,8 +140,14 @@ public:
 
 	/// Get property number <inIndex>.
 	virtual EXP_Value *GetProperty(int inIndex);
+	/// Get the name of the property number <inIndex>, the index must be valid.
+	const std::string& GetPropertyName(int inIndex);
 	/// Get the amount of properties assiocated with this value.
 	virtual int GetPropertyCount();
+	/** Get a counter incremented each time a property is added, replaced or removed,
+	 * used to validate cached property pointers.
+	 */
+	unsigned int GetPropertiesVersion() const;
 
 	virtual EXP_Value *FindIdentifier(const std::string& identifiername);
 
@@ -166,8 +175,9 @@ protected:
 	virtual void DestructFromPython();
 
 private:
-	/// Properties for user/game etc.
-	std::map<std::string, EXP_Value *> m_properties;
+	/// Properties for user/game etc, sorted by name.
+	CM_PropertyTable<EXP_Value *> m_properties;
+	unsigned int m_propertiesVersion;
 };
 
 /** EXP_PropValue is a EXP_Value derived class, that implements the identification (String name)
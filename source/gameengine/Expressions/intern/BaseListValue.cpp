@@ -28,12 +28,19 @@
 #include "BLI_sys_types.h" // For intptr_t support.
 
 EXP_BaseListValue::EXP_BaseListValue()
-	:m_bReleaseContents(true)
+	:m_bReleaseContents(true),
+	m_usePositionIndex(false),
+	m_positionsValid(false),
+	m_numHoles(0),
+	m_firstHole(0),
+	m_useNameIndex(false),
+	m_nameIndexValid(false)
 {
 }
 
 EXP_BaseListValue::~EXP_BaseListValue()
 {
+	Compact();
 	if (m_bReleaseContents) {
 		for (EXP_Value *item : m_valueArray) {
 			item->Release();
@@ -41,18 +48,90 @@ EXP_BaseListValue::~EXP_BaseListValue()
 	}
 }
 
+void EXP_BaseListValue::AddNameIndex(EXP_Value *value) const
+{
+	const auto it = m_nameIndex.emplace(value->GetName(), VectorType()).first;
+	it->second.push_back(value);
+	m_nameIndexKeys[value] = &it->first;
+}
+
+void EXP_BaseListValue::InvalidateNameIndex()
+{
+	if (m_nameIndexValid) {
+		m_nameIndexValid = false;
+		m_nameIndex.clear();
+		m_nameIndexKeys.clear();
+	}
+}
+
+void EXP_BaseListValue::BuildPositionIndex() const
+{
+	Compact();
+	m_positions.clear();
+	for (unsigned int i = 0, size = m_valueArray.size(); i < size; ++i) {
+		m_positions[m_valueArray[i]] = i;
+	}
+	m_positionsValid = true;
+}
+
+void EXP_BaseListValue::InvalidatePositionIndex()
+{
+	if (m_positionsValid) {
+		m_positionsValid = false;
+		m_positions.clear();
+	}
+}
+
+void EXP_BaseListValue::CompactHoles() const
+{
+	unsigned int dst = m_firstHole;
+	for (unsigned int src = m_firstHole + 1, size = m_valueArray.size(); src < size; ++src) {
+		EXP_Value *item = m_valueArray[src];
+		if (item) {
+			m_valueArray[dst] = item;
+			if (m_positionsValid) {
+				m_positions[item] = dst;
+			}
+			++dst;
+		}
+	}
+
+	m_valueArray.resize(dst);
+	m_numHoles = 0;
+}
+
 void EXP_BaseListValue::SetValue(int i, EXP_Value *val)
 {
+	Compact();
 	m_valueArray[i] = val;
+	InvalidateNameIndex();
+	InvalidatePositionIndex();
 }
 
 EXP_Value *EXP_BaseListValue::GetValue(int i)
 {
+	Compact();
 	return m_valueArray[i];
 }
 
 EXP_Value *EXP_BaseListValue::FindValue(const std::string& name) const
 {
+	if (m_useNameIndex) {
+		if (!m_nameIndexValid) {
+			m_nameIndex.clear();
+			m_nameIndexKeys.clear();
+			Compact();
+			for (EXP_Value *item : m_valueArray) {
+				AddNameIndex(item);
+			}
+			m_nameIndexValid = true;
+		}
+
+		const auto it = m_nameIndex.find(name);
+		return (it != m_nameIndex.end()) ? it->second.front() : nullptr;
+	}
+
+	Compact();
 	const VectorTypeConstIterator it = std::find_if(m_valueArray.begin(), m_valueArray.end(),
 										 [&name](EXP_Value *item) { return item->GetName() == name; });
 	
@@ -64,31 +143,80 @@ EXP_Value *EXP_BaseListValue::FindValue(const std::string& name) const
 
 bool EXP_BaseListValue::SearchValue(EXP_Value *val) const
 {
+	if (m_usePositionIndex) {
+		if (!m_positionsValid) {
+			BuildPositionIndex();
+		}
+		return (m_positions.find(val) != m_positions.end());
+	}
+
+	Compact();
 	return (std::find(m_valueArray.begin(), m_valueArray.end(), val) != m_valueArray.end());
 }
 
 void EXP_BaseListValue::Add(EXP_Value *value)
 {
+	// The holes are compacted later, the position is updated at this moment.
+	if (m_positionsValid) {
+		m_positions[value] = m_valueArray.size();
+	}
 	m_valueArray.push_back(value);
+	if (m_nameIndexValid) {
+		AddNameIndex(value);
+	}
 }
 
 void EXP_BaseListValue::Insert(unsigned int i, EXP_Value *value)
 {
+	Compact();
 	m_valueArray.insert(m_valueArray.begin() + i, value);
+	InvalidateNameIndex();
+	InvalidatePositionIndex();
 }
 
 bool EXP_BaseListValue::RemoveValue(EXP_Value *val)
 {
 	bool result = false;
-	for (VectorTypeIterator it = m_valueArray.begin(); it != m_valueArray.end();) {
-		if (*it == val) {
-			it = m_valueArray.erase(it);
+	if (m_usePositionIndex) {
+		if (!m_positionsValid) {
+			BuildPositionIndex();
+		}
+
+		const auto it = m_positions.find(val);
+		if (it != m_positions.end()) {
+			// Leave a hole to keep the order of the values without shifting the list.
+			const unsigned int pos = it->second;
+			m_valueArray[pos] = nullptr;
+			m_firstHole = (m_numHoles == 0) ? pos : std::min(m_firstHole, pos);
+			++m_numHoles;
+			m_positions.erase(it);
 			result = true;
 		}
-		else {
-			++it;
+	}
+	else {
+		for (VectorTypeIterator it = m_valueArray.begin(); it != m_valueArray.end();) {
+			if (*it == val) {
+				it = m_valueArray.erase(it);
+				result = true;
+			}
+			else {
+				++it;
+			}
+		}
+	}
+
+	if (result && m_nameIndexValid) {
+		// The value can't be used to get its name, it could be already freed.
+		const auto keyIt = m_nameIndexKeys.find(val);
+		const auto it = m_nameIndex.find(*keyIt->second);
+		VectorType& values = it->second;
+		values.erase(std::remove(values.begin(), values.end(), val), values.end());
+		if (values.empty()) {
+			m_nameIndex.erase(it);
 		}
+		m_nameIndexKeys.erase(keyIt);
 	}
+
 	return result;
 }
 
@@ -112,6 +240,7 @@ std::string EXP_BaseListValue::GetText()
 	std::string strListRep = "[";
 	std::string commastr = "";
 
+	Compact();
 	for (EXP_Value *item : m_valueArray) {
 		strListRep += commastr;
 		strListRep += item->GetText();
@@ -132,26 +261,61 @@ void EXP_BaseListValue::SetReleaseOnDestruct(bool bReleaseContents)
 	m_bReleaseContents = bReleaseContents;
 }
 
+void EXP_BaseListValue::SetUseNameIndex(bool useNameIndex)
+{
+	m_useNameIndex = useNameIndex;
+	if (!m_useNameIndex) {
+		InvalidateNameIndex();
+	}
+}
+
+void EXP_BaseListValue::NotifyNameChanged(EXP_Value *value)
+{
+	// The index is rebuilt to keep the values of a name in the list order.
+	if (m_nameIndexValid && m_nameIndexKeys.find(value) != m_nameIndexKeys.end()) {
+		InvalidateNameIndex();
+	}
+}
+
+void EXP_BaseListValue::SetUsePositionIndex(bool usePositionIndex)
+{
+	m_usePositionIndex = usePositionIndex;
+	if (!m_usePositionIndex) {
+		Compact();
+		InvalidatePositionIndex();
+	}
+}
+
 void EXP_BaseListValue::Remove(int i)
 {
+	Compact();
 	m_valueArray.erase(m_valueArray.begin() + i);
+	InvalidateNameIndex();
+	InvalidatePositionIndex();
 }
 
 void EXP_BaseListValue::Resize(int num)
 {
+	Compact();
 	m_valueArray.resize(num);
+	InvalidateNameIndex();
+	InvalidatePositionIndex();
 }
 
 void EXP_BaseListValue::ReleaseAndRemoveAll()
 {
+	Compact();
 	for (EXP_Value *item : m_valueArray) {
 		item->Release();
 	}
 	m_valueArray.clear();
+	InvalidateNameIndex();
+	InvalidatePositionIndex();
 }
 
 int EXP_BaseListValue::GetCount() const
 {
+	Compact();
 	return m_valueArray.size();
 }
 
@@ -462,7 +626,10 @@ PyObject *EXP_BaseListValue::Pyreverse()
 		return nullptr;
 	}
 
+	Compact();
 	std::reverse(m_valueArray.begin(), m_valueArray.end());
+	InvalidateNameIndex();
+	InvalidatePositionIndex();
 	Py_RETURN_NONE;
 }
 
@@ -568,6 +735,7 @@ PyObject *EXP_BaseListValue::Pyfilter(PyObject *args)
 	EXP_ListValue<EXP_Value> *result = new EXP_ListValue<EXP_Value>();
 	result->SetReleaseOnDestruct(false);
 
+	Compact();
 	for (EXP_Value *item : m_valueArray) {
 		if (strlen(namestr) == 0 || std::regex_match(item->GetName(), namereg)) {
 			if (strlen(propstr) == 0) {
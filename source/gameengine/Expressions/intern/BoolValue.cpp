@@ -139,6 +139,11 @@ bool EXP_BoolValue::GetBool()
 	return m_bool;
 }
 
+void EXP_BoolValue::SetBool(bool b)
+{
+	m_bool = b;
+}
+
 double EXP_BoolValue::GetNumber()
 {
 	return (double)m_bool;
@@ -0,0 +1,577 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Expressions/intern/Bytecode.cpp
+ *  \ingroup expressions
+ */
+
+#include "EXP_Bytecode.h"
+#include "EXP_Expression.h"
+#include "EXP_FloatValue.h"
+#include "EXP_BoolValue.h"
+
+#include <cmath>
+
+EXP_Bytecode::EXP_Bytecode(EXP_IBytecodeContext *context)
+	:m_context(context),
+	m_result(-1)
+{
+}
+
+EXP_Bytecode::~EXP_Bytecode()
+{
+}
+
+bool EXP_Bytecode::Compile(EXP_Expression *expr)
+{
+	m_instructions.clear();
+	m_registers.clear();
+	m_registerTypes.clear();
+	m_propertySlots.clear();
+
+	m_result = expr->Compile(*this);
+	return (m_result != -1);
+}
+
+bool EXP_Bytecode::IsValid() const
+{
+	return (m_result != -1);
+}
+
+int EXP_Bytecode::AddRegister(VALUE_DATA_TYPE type)
+{
+	m_registers.push_back(Register());
+	m_registerTypes.push_back(type);
+	return m_registers.size() - 1;
+}
+
+int EXP_Bytecode::Emit(OpCode op, VALUE_DATA_TYPE type, int a, int b, int c)
+{
+	const int dst = AddRegister(type);
+	m_instructions.push_back({op, (unsigned int)dst, (unsigned int)a, (unsigned int)b, (unsigned int)c});
+	return dst;
+}
+
+int EXP_Bytecode::ToFloat(int reg)
+{
+	if (m_registerTypes[reg] == VALUE_INT_TYPE) {
+		return Emit(OP_INT_TO_FLOAT, VALUE_FLOAT_TYPE, reg);
+	}
+	return reg;
+}
+
+int EXP_Bytecode::EmitConstant(EXP_Value *value)
+{
+	const VALUE_DATA_TYPE type = (VALUE_DATA_TYPE)value->GetValueType();
+	int reg;
+	switch (type) {
+		case VALUE_INT_TYPE:
+		{
+			reg = AddRegister(type);
+			m_registers[reg].i = static_cast<EXP_IntValue *>(value)->GetInt();
+			break;
+		}
+		case VALUE_FLOAT_TYPE:
+		{
+			reg = AddRegister(type);
+			m_registers[reg].f = static_cast<EXP_FloatValue *>(value)->GetFloat();
+			break;
+		}
+		case VALUE_BOOL_TYPE:
+		{
+			reg = AddRegister(type);
+			m_registers[reg].b = static_cast<EXP_BoolValue *>(value)->GetBool();
+			break;
+		}
+		default:
+		{
+			reg = -1;
+			break;
+		}
+	}
+
+	return reg;
+}
+
+int EXP_Bytecode::EmitIdentifier(const std::string& name)
+{
+	const EXP_BytecodeSymbol symbol = m_context->ResolveSymbol(name);
+	switch (symbol.type) {
+		case EXP_BytecodeSymbol::SYMBOL_PROPERTY:
+		{
+			EXP_Value *value = symbol.owner->GetProperty(name);
+			if (!value) {
+				return -1;
+			}
+
+			const VALUE_DATA_TYPE type = (VALUE_DATA_TYPE)value->GetValueType();
+			if (type != VALUE_INT_TYPE && type != VALUE_FLOAT_TYPE && type != VALUE_BOOL_TYPE) {
+				return -1;
+			}
+
+			m_propertySlots.push_back({symbol.owner, CM_PropertyName(name), type, value, symbol.owner->GetPropertiesVersion()});
+			return Emit(OP_LOAD_PROPERTY, type, m_propertySlots.size() - 1);
+		}
+		case EXP_BytecodeSymbol::SYMBOL_BOOLEAN:
+		{
+			return Emit(OP_LOAD_BOOLEAN, VALUE_BOOL_TYPE, symbol.index);
+		}
+		default:
+		{
+			return -1;
+		}
+	}
+}
+
+int EXP_Bytecode::EmitOperator1(VALUE_OPERATOR op, int operand)
+{
+	if (operand == -1) {
+		return -1;
+	}
+
+	const VALUE_DATA_TYPE type = m_registerTypes[operand];
+	switch (op) {
+		case VALUE_POS_OPERATOR:
+		{
+			// The positive operator returns a copy of the value.
+			return (type == VALUE_BOOL_TYPE) ? -1 : operand;
+		}
+		case VALUE_NEG_OPERATOR:
+		{
+			if (type == VALUE_INT_TYPE) {
+				return Emit(OP_NEG_INT, type, operand);
+			}
+			else if (type == VALUE_FLOAT_TYPE) {
+				return Emit(OP_NEG_FLOAT, type, operand);
+			}
+			return -1;
+		}
+		case VALUE_NOT_OPERATOR:
+		{
+			static const OpCode opcodes[] = {OP_NOT_INT, OP_NOT_FLOAT, OP_NOT_BOOL};
+			const int index = (type == VALUE_INT_TYPE) ? 0 : (type == VALUE_FLOAT_TYPE) ? 1 : 2;
+			return Emit(opcodes[index], VALUE_BOOL_TYPE, operand);
+		}
+		default:
+		{
+			return -1;
+		}
+	}
+}
+
+int EXP_Bytecode::EmitOperator2(VALUE_OPERATOR op, int lhs, int rhs)
+{
+	if (lhs == -1 || rhs == -1) {
+		return -1;
+	}
+
+	const VALUE_DATA_TYPE ltype = m_registerTypes[lhs];
+	const VALUE_DATA_TYPE rtype = m_registerTypes[rhs];
+
+	// Booleans only operate with booleans.
+	if (ltype == VALUE_BOOL_TYPE || rtype == VALUE_BOOL_TYPE) {
+		if (ltype != rtype) {
+			return -1;
+		}
+
+		switch (op) {
+			case VALUE_AND_OPERATOR:
+			{
+				return Emit(OP_AND_BOOL, VALUE_BOOL_TYPE, lhs, rhs);
+			}
+			case VALUE_OR_OPERATOR:
+			{
+				return Emit(OP_OR_BOOL, VALUE_BOOL_TYPE, lhs, rhs);
+			}
+			case VALUE_EQL_OPERATOR:
+			{
+				return Emit(OP_EQL_BOOL, VALUE_BOOL_TYPE, lhs, rhs);
+			}
+			case VALUE_NEQ_OPERATOR:
+			{
+				return Emit(OP_NEQ_BOOL, VALUE_BOOL_TYPE, lhs, rhs);
+			}
+			default:
+			{
+				return -1;
+			}
+		}
+	}
+
+	// Numbers operate as integers or as floats when one of the operand is a float.
+	const bool isfloat = (ltype == VALUE_FLOAT_TYPE || rtype == VALUE_FLOAT_TYPE);
+	if (isfloat) {
+		lhs = ToFloat(lhs);
+		rhs = ToFloat(rhs);
+	}
+
+	const VALUE_DATA_TYPE type = isfloat ? VALUE_FLOAT_TYPE : VALUE_INT_TYPE;
+	OpCode opcode;
+	VALUE_DATA_TYPE restype = type;
+	switch (op) {
+		case VALUE_ADD_OPERATOR:
+		{
+			opcode = isfloat ? OP_ADD_FLOAT : OP_ADD_INT;
+			break;
+		}
+		case VALUE_SUB_OPERATOR:
+		{
+			opcode = isfloat ? OP_SUB_FLOAT : OP_SUB_INT;
+			break;
+		}
+		case VALUE_MUL_OPERATOR:
+		{
+			opcode = isfloat ? OP_MUL_FLOAT : OP_MUL_INT;
+			break;
+		}
+		case VALUE_DIV_OPERATOR:
+		{
+			opcode = isfloat ? OP_DIV_FLOAT : OP_DIV_INT;
+			break;
+		}
+		case VALUE_MOD_OPERATOR:
+		{
+			opcode = isfloat ? OP_MOD_FLOAT : OP_MOD_INT;
+			break;
+		}
+		case VALUE_EQL_OPERATOR:
+		{
+			opcode = isfloat ? OP_EQL_FLOAT : OP_EQL_INT;
+			restype = VALUE_BOOL_TYPE;
+			break;
+		}
+		case VALUE_NEQ_OPERATOR:
+		{
+			opcode = isfloat ? OP_NEQ_FLOAT : OP_NEQ_INT;
+			restype = VALUE_BOOL_TYPE;
+			break;
+		}
+		case VALUE_GRE_OPERATOR:
+		{
+			opcode = isfloat ? OP_GRE_FLOAT : OP_GRE_INT;
+			restype = VALUE_BOOL_TYPE;
+			break;
+		}
+		case VALUE_LES_OPERATOR:
+		{
+			opcode = isfloat ? OP_LES_FLOAT : OP_LES_INT;
+			restype = VALUE_BOOL_TYPE;
+			break;
+		}
+		case VALUE_GEQ_OPERATOR:
+		{
+			opcode = isfloat ? OP_GEQ_FLOAT : OP_GEQ_INT;
+			restype = VALUE_BOOL_TYPE;
+			break;
+		}
+		case VALUE_LEQ_OPERATOR:
+		{
+			opcode = isfloat ? OP_LEQ_FLOAT : OP_LEQ_INT;
+			restype = VALUE_BOOL_TYPE;
+			break;
+		}
+		default:
+		{
+			// And and or operators are only allowed on booleans.
+			return -1;
+		}
+	}
+
+	return Emit(opcode, restype, lhs, rhs);
+}
+
+int EXP_Bytecode::EmitIf(int guard, int e1, int e2)
+{
+	if (guard == -1 || e1 == -1 || e2 == -1) {
+		return -1;
+	}
+
+	/* The result type must be known at compilation, the branches of different
+	 * types are left to the tree. */
+	if (m_registerTypes[guard] != VALUE_BOOL_TYPE || m_registerTypes[e1] != m_registerTypes[e2]) {
+		return -1;
+	}
+
+	return Emit(OP_SELECT, m_registerTypes[e1], guard, e1, e2);
+}
+
+bool EXP_Bytecode::UpdatePropertySlot(PropertySlot& slot)
+{
+	const unsigned int version = slot.owner->GetPropertiesVersion();
+	if (version == slot.version) {
+		return true;
+	}
+
+	EXP_Value *value = slot.owner->GetProperty(slot.name);
+	if (!value || value->GetValueType() != slot.type) {
+		return false;
+	}
+
+	slot.value = value;
+	slot.version = version;
+	return true;
+}
+
+bool EXP_Bytecode::Execute(double& result)
+{
+	if (m_result == -1) {
+		return false;
+	}
+
+	Register *regs = m_registers.data();
+	for (const Instruction& inst : m_instructions) {
+		Register& dst = regs[inst.dst];
+		const Register& a = regs[inst.a];
+		const Register& b = regs[inst.b];
+
+		switch (inst.op) {
+			case OP_LOAD_PROPERTY:
+			{
+				PropertySlot& slot = m_propertySlots[inst.a];
+				if (!UpdatePropertySlot(slot)) {
+					return false;
+				}
+				switch (slot.type) {
+					case VALUE_INT_TYPE:
+					{
+						dst.i = static_cast<EXP_IntValue *>(slot.value)->GetInt();
+						break;
+					}
+					case VALUE_FLOAT_TYPE:
+					{
+						dst.f = static_cast<EXP_FloatValue *>(slot.value)->GetFloat();
+						break;
+					}
+					default:
+					{
+						dst.b = static_cast<EXP_BoolValue *>(slot.value)->GetBool();
+						break;
+					}
+				}
+				break;
+			}
+			case OP_LOAD_BOOLEAN:
+			{
+				dst.b = m_context->GetBooleanSymbol(inst.a);
+				break;
+			}
+			case OP_INT_TO_FLOAT:
+			{
+				dst.f = (float)a.i;
+				break;
+			}
+			case OP_SELECT:
+			{
+				dst = a.b ? b : regs[inst.c];
+				break;
+			}
+
+			case OP_ADD_INT:
+			{
+				dst.i = a.i + b.i;
+				break;
+			}
+			case OP_SUB_INT:
+			{
+				dst.i = a.i - b.i;
+				break;
+			}
+			case OP_MUL_INT:
+			{
+				dst.i = a.i * b.i;
+				break;
+			}
+			case OP_DIV_INT:
+			{
+				if (b.i == 0) {
+					return false;
+				}
+				dst.i = a.i / b.i;
+				break;
+			}
+			case OP_MOD_INT:
+			{
+				if (b.i == 0) {
+					return false;
+				}
+				dst.i = a.i % b.i;
+				break;
+			}
+			case OP_NEG_INT:
+			{
+				dst.i = -a.i;
+				break;
+			}
+			case OP_NOT_INT:
+			{
+				dst.b = (a.i == 0);
+				break;
+			}
+			case OP_EQL_INT:
+			{
+				dst.b = (a.i == b.i);
+				break;
+			}
+			case OP_NEQ_INT:
+			{
+				dst.b = (a.i != b.i);
+				break;
+			}
+			case OP_GRE_INT:
+			{
+				dst.b = (a.i > b.i);
+				break;
+			}
+			case OP_LES_INT:
+			{
+				dst.b = (a.i < b.i);
+				break;
+			}
+			case OP_GEQ_INT:
+			{
+				dst.b = (a.i >= b.i);
+				break;
+			}
+			case OP_LEQ_INT:
+			{
+				dst.b = (a.i <= b.i);
+				break;
+			}
+
+			case OP_ADD_FLOAT:
+			{
+				dst.f = a.f + b.f;
+				break;
+			}
+			case OP_SUB_FLOAT:
+			{
+				dst.f = a.f - b.f;
+				break;
+			}
+			case OP_MUL_FLOAT:
+			{
+				dst.f = a.f * b.f;
+				break;
+			}
+			case OP_DIV_FLOAT:
+			{
+				if (b.f == 0.0f) {
+					return false;
+				}
+				dst.f = a.f / b.f;
+				break;
+			}
+			case OP_MOD_FLOAT:
+			{
+				dst.f = fmod(a.f, b.f);
+				break;
+			}
+			case OP_NEG_FLOAT:
+			{
+				dst.f = -a.f;
+				break;
+			}
+			case OP_NOT_FLOAT:
+			{
+				dst.b = (a.f == 0.0f);
+				break;
+			}
+			case OP_EQL_FLOAT:
+			{
+				dst.b = (a.f == b.f);
+				break;
+			}
+			case OP_NEQ_FLOAT:
+			{
+				dst.b = (a.f != b.f);
+				break;
+			}
+			case OP_GRE_FLOAT:
+			{
+				dst.b = (a.f > b.f);
+				break;
+			}
+			case OP_LES_FLOAT:
+			{
+				dst.b = (a.f < b.f);
+				break;
+			}
+			case OP_GEQ_FLOAT:
+			{
+				dst.b = (a.f >= b.f);
+				break;
+			}
+			case OP_LEQ_FLOAT:
+			{
+				dst.b = (a.f <= b.f);
+				break;
+			}
+
+			case OP_NOT_BOOL:
+			{
+				dst.b = !a.b;
+				break;
+			}
+			case OP_AND_BOOL:
+			{
+				dst.b = (a.b && b.b);
+				break;
+			}
+			case OP_OR_BOOL:
+			{
+				dst.b = (a.b || b.b);
+				break;
+			}
+			case OP_EQL_BOOL:
+			{
+				dst.b = (a.b == b.b);
+				break;
+			}
+			case OP_NEQ_BOOL:
+			{
+				dst.b = (a.b != b.b);
+				break;
+			}
+		}
+	}
+
+	const Register& res = regs[m_result];
+	switch (m_registerTypes[m_result]) {
+		case VALUE_INT_TYPE:
+		{
+			result = (double)res.i;
+			break;
+		}
+		case VALUE_FLOAT_TYPE:
+		{
+			result = (double)res.f;
+			break;
+		}
+		default:
+		{
+			result = res.b ? 1.0 : 0.0;
+			break;
+		}
+	}
+
+	return true;
+}
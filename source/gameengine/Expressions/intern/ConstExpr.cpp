@@ -18,6 +18,7 @@
 
 #include "EXP_Value.h"
 #include "EXP_ConstExpr.h"
+#include "EXP_Bytecode.h"
 
 EXP_ConstExpr::EXP_ConstExpr()
 {
@@ -45,6 +46,11 @@ EXP_Value *EXP_ConstExpr::Calculate()
 	return m_value->AddRef();
 }
 
+int EXP_ConstExpr::Compile(EXP_Bytecode& bytecode)
+{
+	return bytecode.EmitConstant(m_value);
+}
+
 double EXP_ConstExpr::GetNumber()
 {
 	return -1.0;
@@ -31,6 +31,7 @@
 
 
 #include "EXP_IdentifierExpr.h"
+#include "EXP_Bytecode.h"
 
 EXP_IdentifierExpr::EXP_IdentifierExpr(const std::string& identifier, EXP_Value *id_context)
 	:m_identifier(identifier)
@@ -60,6 +61,11 @@ EXP_Value *EXP_IdentifierExpr::Calculate()
 	return result;
 }
 
+int EXP_IdentifierExpr::Compile(EXP_Bytecode& bytecode)
+{
+	return bytecode.EmitIdentifier(m_identifier);
+}
+
 unsigned char EXP_IdentifierExpr::GetExpressionID()
 {
 	return CIDENTIFIEREXPRESSIONID;
@@ -19,6 +19,7 @@
 #include "EXP_EmptyValue.h"
 #include "EXP_ErrorValue.h"
 #include "EXP_BoolValue.h"
+#include "EXP_Bytecode.h"
 
 EXP_IfExpr::EXP_IfExpr()
 {
@@ -63,6 +64,14 @@ EXP_Value *EXP_IfExpr::Calculate()
 	}
 }
 
+int EXP_IfExpr::Compile(EXP_Bytecode& bytecode)
+{
+	const int guard = m_guard->Compile(bytecode);
+	const int e1 = m_e1->Compile(bytecode);
+	const int e2 = m_e2->Compile(bytecode);
+	return bytecode.EmitIf(guard, e1, e2);
+}
+
 unsigned char EXP_IfExpr::GetExpressionID()
 {
 	return CIFEXPRESSIONID;
@@ -300,6 +300,11 @@ cInt EXP_IntValue::GetInt()
 	return m_int;
 }
 
+void EXP_IntValue::SetInt(cInt i)
+{
+	m_int = i;
+}
+
 double EXP_IntValue::GetNumber()
 {
 	return (double)m_int;
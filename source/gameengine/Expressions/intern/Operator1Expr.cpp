@@ -17,6 +17,7 @@
 
 #include "EXP_Operator1Expr.h"
 #include "EXP_EmptyValue.h"
+#include "EXP_Bytecode.h"
 
 EXP_Operator1Expr::EXP_Operator1Expr()
 	:m_lhs(nullptr)
@@ -52,3 +53,8 @@ EXP_Value *EXP_Operator1Expr::Calculate()
 
 	return ret;
 }
+
+int EXP_Operator1Expr::Compile(EXP_Bytecode& bytecode)
+{
+	return bytecode.EmitOperator1(m_op, m_lhs->Compile(bytecode));
+}
@@ -17,6 +17,7 @@
 
 #include "EXP_Operator2Expr.h"
 #include "EXP_StringValue.h"
+#include "EXP_Bytecode.h"
 
 EXP_Operator2Expr::EXP_Operator2Expr(VALUE_OPERATOR op, EXP_Expression *lhs, EXP_Expression *rhs)
 	:m_rhs(rhs),
@@ -59,3 +60,10 @@ EXP_Value *EXP_Operator2Expr::Calculate()
 
 	return calculate;
 }
+
+int EXP_Operator2Expr::Compile(EXP_Bytecode& bytecode)
+{
+	const int lhs = m_lhs->Compile(bytecode);
+	const int rhs = m_rhs->Compile(bytecode);
+	return bytecode.EmitOperator2(m_op, lhs, rhs);
+}
@@ -114,6 +114,16 @@ std::string EXP_StringValue::GetText()
 	return m_strString;
 }
 
+const std::string& EXP_StringValue::GetString() const
+{
+	return m_strString;
+}
+
+void EXP_StringValue::SetString(const std::string& str)
+{
+	m_strString = str;
+}
+
 bool EXP_StringValue::IsEqual(const std::string & other)
 {
 	return (m_strString == other);
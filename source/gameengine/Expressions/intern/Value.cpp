@@ -59,6 +59,7 @@ PyMethodDef EXP_Value::Methods[] = {
 #endif  // WITH_PYTHON
 
 EXP_Value::EXP_Value()
+	:m_propertiesVersion(0)
 {
 }
 
@@ -153,24 +154,23 @@ void EXP_Value::SetProperty(const std::string & name, EXP_Value *ioProperty)
 		return;
 	}
 
-	// Try to replace property (if so -> exit as soon as we replaced it).
-	EXP_Value *oldval = m_properties[name];
+	// Replace or insert the property, the new value is referenced first in case it is also the old one.
+	EXP_Value *oldval = m_properties.Set(name, ioProperty->AddRef());
 	if (oldval) {
 		oldval->Release();
 	}
-
-	// Add property at end of array.
-	m_properties[name] = ioProperty->AddRef();
+	++m_propertiesVersion;
 }
 
 /// Get pointer to a property with name <inName>, returns nullptr if there is no property named <inName>.
 EXP_Value *EXP_Value::GetProperty(const std::string & inName)
 {
-	std::map<std::string, EXP_Value *>::iterator it = m_properties.find(inName);
-	if (it != m_properties.end()) {
-		return it->second;
-	}
-	return nullptr;
+	return m_properties.Find(inName);
+}
+
+EXP_Value *EXP_Value::GetProperty(const CM_PropertyName& inName) const
+{
+	return m_properties.Find(inName);
 }
 
 /// Get text description of property with name <inName>, returns an empty string if there is no property named <inName>.
@@ -199,10 +199,10 @@ float EXP_Value::GetPropertyNumber(const std::string& inName, float defnumber)
 /// Remove the property named <inName>, returns true if the property was succesfully removed, false if property was not found or could not be removed.
 bool EXP_Value::RemoveProperty(const std::string& inName)
 {
-	std::map<std::string, EXP_Value *>::iterator it = m_properties.find(inName);
-	if (it != m_properties.end()) {
-		(*it).second->Release();
-		m_properties.erase(it);
+	EXP_Value *oldval = m_properties.Remove(inName);
+	if (oldval) {
+		oldval->Release();
+		++m_propertiesVersion;
 		return true;
 	}
 
@@ -212,12 +212,12 @@ bool EXP_Value::RemoveProperty(const std::string& inName)
 /// Get Property Names.
 std::vector<std::string> EXP_Value::GetPropertyNames()
 {
-	const unsigned short size = m_properties.size();
+	const unsigned short size = m_properties.Size();
 	std::vector<std::string> result(size);
 
 	unsigned short i = 0;
-	for (const auto& pair : m_properties) {
-		result[i++] = pair.first;
+	for (const auto& entry : m_properties) {
+		result[i++] = entry.name.GetString();
 	}
 	return result;
 }
@@ -226,28 +226,36 @@ std::vector<std::string> EXP_Value::GetPropertyNames()
 void EXP_Value::ClearProperties()
 {
 	// Remove all properties.
-	for (const auto& pair : m_properties) {
-		pair.second->Release();
+	for (const auto& entry : m_properties) {
+		entry.value->Release();
 	}
-	m_properties.clear();
+	m_properties.Clear();
+	++m_propertiesVersion;
 }
 
 /// Get property number <inIndex>.
 EXP_Value *EXP_Value::GetProperty(int inIndex)
 {
-	int count = 0;
-	for (const auto& pair : m_properties) {
-		if (count++ == inIndex) {
-			return pair.second;
-		}
+	if (inIndex < 0 || inIndex >= (int)m_properties.Size()) {
+		return nullptr;
 	}
-	return nullptr;
+	return m_properties[inIndex].value;
+}
+
+const std::string& EXP_Value::GetPropertyName(int inIndex)
+{
+	return m_properties[inIndex].name.GetString();
 }
 
 /// Get the amount of properties assiocated with this value.
 int EXP_Value::GetPropertyCount()
 {
-	return m_properties.size();
+	return m_properties.Size();
+}
+
+unsigned int EXP_Value::GetPropertiesVersion() const
+{
+	return m_propertiesVersion;
 }
 
 void EXP_Value::DestructFromPython()
@@ -264,8 +272,8 @@ void EXP_Value::ProcessReplica()
 	EXP_PyObjectPlus::ProcessReplica();
 
 	// Copy all props.
-	for (auto& pair : m_properties) {
-		pair.second = pair.second->GetReplica();
+	for (auto& entry : m_properties) {
+		entry.value = entry.value->GetReplica();
 	}
 }
 
@@ -361,11 +369,11 @@ EXP_Value *EXP_Value::ConvertPythonToValue(PyObject *pyobj, const bool do_type_e
 
 PyObject *EXP_Value::ConvertKeysToPython(void)
 {
-	PyObject *pylist = PyList_New(m_properties.size());
+	PyObject *pylist = PyList_New(m_properties.Size());
 
 	Py_ssize_t i = 0;
-	for (const auto& pair : m_properties) {
-		PyList_SET_ITEM(pylist, i++, PyUnicode_FromStdString(pair.first));
+	for (const auto& entry : m_properties) {
+		PyList_SET_ITEM(pylist, i++, PyUnicode_FromStdString(entry.name.GetString()));
 	}
 
 	return pylist;
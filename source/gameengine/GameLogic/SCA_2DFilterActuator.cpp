@@ -79,6 +79,11 @@ bool SCA_2DFilterActuator::Update()
 	if (bNegativeEvent)
 		return false; // do nothing on negative events
 
+	// 2D filters are only rendering, nothing to do without rasterizer.
+	if (!m_rasterizer) {
+		return false;
+	}
+
 	RAS_2DFilter *filter = m_filterManager->GetFilterPass(m_int_arg);
 	switch (m_type) {
 		case RAS_2DFilterManager::FILTER_ENABLED:
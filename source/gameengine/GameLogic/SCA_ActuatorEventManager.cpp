@@ -50,15 +50,17 @@ SCA_ActuatorEventManager::~SCA_ActuatorEventManager()
 void SCA_ActuatorEventManager::NextFrame()
 {
 	// check for changed actuator
-	for (SCA_ISensor *sensor : m_sensors) {
-		sensor->Activate(m_logicmgr);
-	}
+	ActivateSensors();
 }
 
 void SCA_ActuatorEventManager::UpdateFrame()
 {
-	// update the state of actuator before executing them
-	for (SCA_ISensor *sensor : m_sensors) {
+	/* Update the state of actuator before executing them, the sensors of the
+	 * inactive actuators are not woken up and their state is unchanged. */
+	for (SCA_ISensor *sensor : m_polledSensors) {
+		static_cast<SCA_ActuatorSensor *>(sensor)->Update();
+	}
+	for (SCA_ISensor *sensor : m_pendingSensors) {
 		static_cast<SCA_ActuatorSensor *>(sensor)->Update();
 	}
 }
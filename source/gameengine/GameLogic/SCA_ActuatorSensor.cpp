@@ -90,6 +90,27 @@ SCA_ActuatorSensor::~SCA_ActuatorSensor()
 
 
 
+bool SCA_ActuatorSensor::IsEventDriven() const
+{
+	return true;
+}
+
+void SCA_ActuatorSensor::RegisterToManager()
+{
+	SCA_ISensor::RegisterToManager();
+	if (m_actuator) {
+		m_actuator->RegisterActuatorSensor(this);
+	}
+}
+
+void SCA_ActuatorSensor::UnregisterToManager()
+{
+	if (m_actuator) {
+		m_actuator->UnregisterActuatorSensor(this);
+	}
+	SCA_ISensor::UnregisterToManager();
+}
+
 bool SCA_ActuatorSensor::Evaluate()
 {
 	if (m_actuator)
@@ -98,6 +119,10 @@ bool SCA_ActuatorSensor::Evaluate()
 		bool reset = m_reset && m_level;
 		
 		m_reset = false;
+		// The events of an active actuator change every frame, keep evaluating.
+		if (result) {
+			Wake();
+		}
 		if (m_lastresult != result || m_midresult != result)
 		{
 			m_lastresult = m_midresult = result;
@@ -159,6 +184,14 @@ int SCA_ActuatorSensor::CheckActuator(EXP_PyObjectPlus *self, const PyAttributeD
 	SCA_ActuatorSensor* sensor = reinterpret_cast<SCA_ActuatorSensor*>(self);
 	SCA_IActuator* act = sensor->GetParent()->FindActuator(sensor->m_checkactname);
 	if (act) {
+		if (!sensor->IsNoLink()) {
+			// Move the wake up of the sensor to the new actuator.
+			if (sensor->m_actuator) {
+				sensor->m_actuator->UnregisterActuatorSensor(sensor);
+			}
+			act->RegisterActuatorSensor(sensor);
+			sensor->Wake();
+		}
 		sensor->m_actuator = act;
 		return 0;
 	}
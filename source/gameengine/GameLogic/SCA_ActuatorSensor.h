@@ -54,6 +54,9 @@ public:
 	virtual bool Evaluate();
 	virtual bool	IsPositiveTrigger();
 	virtual void	ReParent(SCA_IObject* parent);
+	virtual bool	IsEventDriven() const;
+	virtual void	RegisterToManager();
+	virtual void	UnregisterToManager();
 	void Update();
 
 #ifdef WITH_PYTHON
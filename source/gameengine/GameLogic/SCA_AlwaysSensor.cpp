@@ -84,6 +84,12 @@ bool SCA_AlwaysSensor::IsPositiveTrigger()
 
 
 
+bool SCA_AlwaysSensor::IsEventDriven() const
+{
+	// Without pulse mode the sensor only triggers at its first evaluation.
+	return true;
+}
+
 bool SCA_AlwaysSensor::Evaluate()
 {
 	/* Nice! :) */
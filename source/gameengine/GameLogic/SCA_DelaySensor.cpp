@@ -65,6 +65,7 @@ void SCA_DelaySensor::Init()
 {
 	m_lastResult = false;
 	m_frameCount = -1;
+	m_sleepTicks = 0;
 	m_reset = true;
 }
 
@@ -89,11 +90,58 @@ bool SCA_DelaySensor::IsPositiveTrigger()
 	return (m_invert ? !m_lastResult : m_lastResult);
 }
 
+bool SCA_DelaySensor::IsEventDriven() const
+{
+	return true;
+}
+
+int SCA_DelaySensor::GetSleepTicks() const
+{
+	if (m_frameCount == -1) {
+		return 1;
+	}
+	if (m_frameCount < m_delay) {
+		// The result is negative until the end of the delay.
+		return (m_lastResult) ? 1 : m_delay - m_frameCount + 1;
+	}
+	if (m_duration > 0 && m_frameCount < m_delay + m_duration) {
+		// The result is positive until the end of the duration.
+		return (m_lastResult) ? m_delay + m_duration - m_frameCount + 1 : 1;
+	}
+	if (m_repeat) {
+		return 1;
+	}
+	// Without repeat the last result is kept forever.
+	return (m_lastResult == (m_duration == 0)) ? 0 : 1;
+}
+
+int SCA_DelaySensor::GetElapsedSleepTicks() const
+{
+	return m_sleepTicks - m_eventmgr->GetSensorTimer(this);
+}
+
+void SCA_DelaySensor::Suspend()
+{
+	// Count the frames elapsed before the suspension, the sensor is woken up on resume.
+	if (m_sleepTicks > 0) {
+		m_frameCount += GetElapsedSleepTicks();
+		m_sleepTicks = 0;
+		m_eventmgr->SetSensorTimer(this, 0);
+	}
+	SCA_ISensor::Suspend();
+}
+
 bool SCA_DelaySensor::Evaluate()
 {
 	bool trigger = false;
 	bool result;
 
+	if (m_sleepTicks > 0) {
+		// The frames skipped while sleeping would only have incremented the frame count.
+		m_frameCount += GetElapsedSleepTicks() - 1;
+		m_sleepTicks = 0;
+	}
+
 	if (m_frameCount==-1) {
 		// this is needed to ensure ON trigger in case delay==0
 		// and avoid spurious OFF trigger when duration==0
@@ -122,6 +170,11 @@ bool SCA_DelaySensor::Evaluate()
 		trigger = true;
 	m_reset = false;
 	m_lastResult = result;
+
+	// Sleep until the next change of the result.
+	m_sleepTicks = (IsPolled()) ? 0 : GetSleepTicks();
+	m_eventmgr->SetSensorTimer(this, m_sleepTicks);
+
 	return trigger;
 }
 
@@ -159,9 +212,9 @@ PyMethodDef SCA_DelaySensor::Methods[] = {
 };
 
 PyAttributeDef SCA_DelaySensor::Attributes[] = {
-	EXP_PYATTRIBUTE_INT_RW("delay",0,100000,true,SCA_DelaySensor,m_delay),
-	EXP_PYATTRIBUTE_INT_RW("duration",0,100000,true,SCA_DelaySensor,m_duration),
-	EXP_PYATTRIBUTE_BOOL_RW("repeat",SCA_DelaySensor,m_repeat),
+	EXP_PYATTRIBUTE_INT_RW_CHECK("delay",0,100000,true,SCA_DelaySensor,m_delay,pyattr_check_wake),
+	EXP_PYATTRIBUTE_INT_RW_CHECK("duration",0,100000,true,SCA_DelaySensor,m_duration,pyattr_check_wake),
+	EXP_PYATTRIBUTE_BOOL_RW_CHECK("repeat",SCA_DelaySensor,m_repeat,pyattr_check_wake),
 	EXP_PYATTRIBUTE_NULL	//Sentinel
 };
 
@@ -44,6 +44,16 @@ class SCA_DelaySensor : public SCA_ISensor
 	int				m_delay; 
 	int				m_duration;
 	int				m_frameCount;
+	/// Number of frames between the last evaluation and the planned wake up, 0 when not sleeping.
+	int				m_sleepTicks;
+
+	/** Return the number of frames between the last evaluation and the next evaluation
+	 * changing the result, the evaluations in between only increment the frame count.
+	 * Return 0 if the result never changes.
+	 */
+	int GetSleepTicks() const;
+	/// Return the number of frames elapsed since the last evaluation while sleeping.
+	int GetElapsedSleepTicks() const;
 
 public:
 	SCA_DelaySensor(class SCA_EventManager* eventmgr,
@@ -56,6 +66,8 @@ public:
 	virtual bool Evaluate();
 	virtual bool IsPositiveTrigger();
 	virtual void Init();
+	virtual bool IsEventDriven() const;
+	virtual void Suspend();
 
 
 	/* --------------------------------------------------------------------- */
@@ -37,6 +37,7 @@
 
 SCA_EventManager::SCA_EventManager(SCA_LogicManager* logicmgr, EVENT_MANAGER_TYPE mgrtype)
 	:m_logicmgr(logicmgr),
+	m_tick(0),
 	m_mgrtype(mgrtype)
 {
 }
@@ -51,12 +52,120 @@ SCA_EventManager::~SCA_EventManager()
 
 bool SCA_EventManager::RegisterSensor(class SCA_ISensor* sensor)
 {
-	return CM_ListAddIfNotFound(m_sensors, sensor);
+	if (!CM_ListAddIfNotFound(m_sensors, sensor)) {
+		return false;
+	}
+
+	if (sensor->IsPolled()) {
+		sensor->m_polled = true;
+		m_polledSensors.push_back(sensor);
+	}
+	else {
+		// Initial evaluation of the event driven sensor.
+		WakeSensor(sensor);
+	}
+
+	return true;
 }
 
 bool SCA_EventManager::RemoveSensor(class SCA_ISensor* sensor)
 {
-	return CM_ListRemoveIfFound(m_sensors, sensor);
+	if (!CM_ListRemoveIfFound(m_sensors, sensor)) {
+		return false;
+	}
+
+	if (sensor->m_polled) {
+		CM_ListRemoveIfFound(m_polledSensors, sensor);
+		sensor->m_polled = false;
+	}
+	if (sensor->m_pending) {
+		CM_ListRemoveIfFound(m_pendingSensors, sensor);
+		sensor->m_pending = false;
+	}
+	SetSensorTimer(sensor, 0);
+
+	return true;
+}
+
+void SCA_EventManager::WakeSensor(SCA_ISensor *sensor)
+{
+	if (!sensor->m_polled && !sensor->m_pending) {
+		sensor->m_pending = true;
+		m_pendingSensors.push_back(sensor);
+	}
+}
+
+void SCA_EventManager::SetSensorTimer(SCA_ISensor *sensor, unsigned int ticks)
+{
+	if (sensor->m_wakeTick != 0) {
+		const auto range = m_sensorTimers.equal_range(sensor->m_wakeTick);
+		for (auto it = range.first; it != range.second; ++it) {
+			if (it->second == sensor) {
+				m_sensorTimers.erase(it);
+				break;
+			}
+		}
+		sensor->m_wakeTick = 0;
+	}
+
+	if (ticks > 0) {
+		sensor->m_wakeTick = m_tick + ticks;
+		m_sensorTimers.emplace(sensor->m_wakeTick, sensor);
+	}
+}
+
+unsigned int SCA_EventManager::GetSensorTimer(const SCA_ISensor *sensor) const
+{
+	return (sensor->m_wakeTick == 0) ? 0 : sensor->m_wakeTick - m_tick;
+}
+
+void SCA_EventManager::UpdateSensorWakeMode(SCA_ISensor *sensor)
+{
+	const bool polled = sensor->IsPolled();
+	if (polled == sensor->m_polled) {
+		return;
+	}
+
+	sensor->m_polled = polled;
+	if (polled) {
+		if (sensor->m_pending) {
+			CM_ListRemoveIfFound(m_pendingSensors, sensor);
+			sensor->m_pending = false;
+		}
+		m_polledSensors.push_back(sensor);
+	}
+	else {
+		CM_ListRemoveIfFound(m_polledSensors, sensor);
+		WakeSensor(sensor);
+	}
+}
+
+void SCA_EventManager::ActivateSensors()
+{
+	++m_tick;
+
+	// Wake up the sensors whose timer expired.
+	while (!m_sensorTimers.empty() && m_sensorTimers.begin()->first <= m_tick) {
+		SCA_ISensor *sensor = m_sensorTimers.begin()->second;
+		m_sensorTimers.erase(m_sensorTimers.begin());
+		sensor->m_wakeTick = 0;
+		WakeSensor(sensor);
+	}
+
+	for (SCA_ISensor *sensor : m_polledSensors) {
+		sensor->Activate(m_logicmgr);
+	}
+
+	/* A sensor can wake itself up for the next frame during its evaluation,
+	 * the woken up sensors are moved out of the pending list before. */
+	m_activeSensors.swap(m_pendingSensors);
+	for (SCA_ISensor *sensor : m_activeSensors) {
+		sensor->m_pending = false;
+	}
+	for (SCA_ISensor *sensor : m_activeSensors) {
+		sensor->Activate(m_logicmgr);
+	}
+	m_activeSensors.clear();
 }
 
 void SCA_EventManager::NextFrame(double curtime, double fixedtime)
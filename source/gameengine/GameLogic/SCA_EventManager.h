@@ -34,6 +34,7 @@
 
 #include <vector>
 #include <set>
+#include <map>
 #include <algorithm>
 
 class SCA_ISensor;
@@ -45,6 +46,24 @@ protected:
 
 	std::vector<SCA_ISensor *> m_sensors;
 
+	/** Sensors evaluated every frame by ActivateSensors, the other sensors are
+	 * event driven and evaluated only when they are woken up.
+	 */
+	std::vector<SCA_ISensor *> m_polledSensors;
+	/// Event driven sensors woken up since the last call to ActivateSensors.
+	std::vector<SCA_ISensor *> m_pendingSensors;
+	/// Woken up sensors evaluated by ActivateSensors.
+	std::vector<SCA_ISensor *> m_activeSensors;
+	/// Event driven sensors sorted by the tick they are woken up at.
+	std::multimap<unsigned int, SCA_ISensor *> m_sensorTimers;
+	/// Number of calls to ActivateSensors.
+	unsigned int m_tick;
+
+	/** Evaluate the polled sensors and the event driven sensors woken up since the last
+	 * call, used in NextFrame by the managers of event driven sensors.
+	 */
+	void ActivateSensors();
+
 public:
 	enum EVENT_MANAGER_TYPE {
 		KEYBOARD_EVENTMGR = 0,
@@ -72,6 +91,15 @@ public:
 	virtual bool	RegisterSensor(class SCA_ISensor* sensor);
 	int		GetType();
 
+	/// Evaluate an event driven sensor at the next call to ActivateSensors.
+	void WakeSensor(SCA_ISensor *sensor);
+	/// Wake up an event driven sensor after a number of ticks, 0 removes the timer of the sensor.
+	void SetSensorTimer(SCA_ISensor *sensor, unsigned int ticks);
+	/// Return the number of ticks before the timer of a sensor expires, 0 without timer.
+	unsigned int GetSensorTimer(const SCA_ISensor *sensor) const;
+	/// Move a sensor between the polled and event driven sensors, see SCA_ISensor::IsPolled.
+	void UpdateSensorWakeMode(SCA_ISensor *sensor);
+
 protected:
 	EVENT_MANAGER_TYPE		m_mgrtype;
 };
@@ -50,7 +50,8 @@ SCA_ExpressionController::SCA_ExpressionController(SCA_IObject* gameobj,
 												   const std::string& exprtext)
 	:SCA_IController(gameobj),
 	m_exprText(exprtext),
-	m_exprCache(nullptr)
+	m_exprCache(nullptr),
+	m_bytecode(nullptr)
 {
 }
 
@@ -60,6 +61,8 @@ SCA_ExpressionController::~SCA_ExpressionController()
 {
 	if (m_exprCache)
 		m_exprCache->Release();
+	if (m_bytecode)
+		delete m_bytecode;
 }
 
 
@@ -69,6 +72,8 @@ EXP_Value* SCA_ExpressionController::GetReplica()
 	SCA_ExpressionController* replica = new SCA_ExpressionController(*this);
 	replica->m_exprText = m_exprText;
 	replica->m_exprCache = nullptr;
+	replica->m_bytecode = nullptr;
+	replica->m_bytecodeSensors.clear();
 	// this will copy properties and so on...
 	replica->ProcessReplica();
 
@@ -85,6 +90,11 @@ void SCA_ExpressionController::Delete()
 		m_exprCache->Release();
 		m_exprCache = nullptr;
 	}
+	if (m_bytecode)
+	{
+		delete m_bytecode;
+		m_bytecode = nullptr;
+	}
 	Release();
 }
 
@@ -100,6 +110,20 @@ void SCA_ExpressionController::Trigger(SCA_LogicManager* logicmgr)
 		m_exprCache = parser.ProcessText(m_exprText);
 	}
 	if (m_exprCache)
+	{
+		// The sensors are compiled by index, compile again when the links changed.
+		if (!m_bytecode || m_bytecodeSensors != m_linkedsensors)
+		{
+			CompileBytecode();
+		}
+	}
+
+	double number;
+	if (m_bytecode && m_bytecode->Execute(number))
+	{
+		expressionresult = !mt::FuzzyZero((float)number);
+	}
+	else if (m_exprCache)
 	{
 		EXP_Value* value = m_exprCache->Calculate();
 		if (value)
@@ -156,3 +180,39 @@ EXP_Value* SCA_ExpressionController::FindIdentifier(const std::string& identifie
 	return  GetParent()->FindIdentifier(identifiername);
 
 }
+
+void SCA_ExpressionController::CompileBytecode()
+{
+	if (!m_bytecode)
+	{
+		m_bytecode = new EXP_Bytecode(this);
+	}
+
+	m_bytecodeSensors = m_linkedsensors;
+	m_bytecode->Compile(m_exprCache);
+}
+
+EXP_BytecodeSymbol SCA_ExpressionController::ResolveSymbol(const std::string& name)
+{
+	// Same lookup order than FindIdentifier.
+	for (unsigned int i = 0, size = m_linkedsensors.size(); i < size; ++i)
+	{
+		if (m_linkedsensors[i]->GetName() == name)
+		{
+			return {EXP_BytecodeSymbol::SYMBOL_BOOLEAN, nullptr, i};
+		}
+	}
+
+	// Identifiers of sub values are left to the tree.
+	if (name.find('.') != std::string::npos)
+	{
+		return {EXP_BytecodeSymbol::SYMBOL_NONE, nullptr, 0};
+	}
+
+	return {EXP_BytecodeSymbol::SYMBOL_PROPERTY, GetParent(), 0};
+}
+
+bool SCA_ExpressionController::GetBooleanSymbol(unsigned int index)
+{
+	return m_linkedsensors[index]->GetState();
+}
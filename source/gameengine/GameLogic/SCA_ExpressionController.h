@@ -36,14 +36,21 @@
 #define __SCA_EXPRESSIONCONTROLLER_H__
 
 #include "SCA_IController.h"
+#include "EXP_Bytecode.h"
 
 class EXP_Expression;
 
-class SCA_ExpressionController : public SCA_IController
+class SCA_ExpressionController : public SCA_IController, public EXP_IBytecodeContext
 {
 //	Py_Header
 	std::string			m_exprText;
 	EXP_Expression*		m_exprCache;
+	/// Compiled expression, the tree is used when the bytecode can't be executed.
+	EXP_Bytecode*		m_bytecode;
+	/// Linked sensors when compiling the bytecode, the sensors identifiers are resolved by index.
+	std::vector<SCA_ISensor *>	m_bytecodeSensors;
+
+	void CompileBytecode();
 
 public:
 	SCA_ExpressionController(SCA_IObject* gameobj,
@@ -53,6 +60,9 @@ public:
 	virtual EXP_Value* GetReplica();
 	virtual void Trigger(SCA_LogicManager* logicmgr);
 	virtual EXP_Value*		FindIdentifier(const std::string& identifiername);
+
+	virtual EXP_BytecodeSymbol ResolveSymbol(const std::string& name);
+	virtual bool GetBooleanSymbol(unsigned int index);
 	/** 
 	 *  used to release the expression cache
 	 *  so that self references are removed before the controller itself is released
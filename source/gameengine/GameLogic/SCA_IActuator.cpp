@@ -31,6 +31,7 @@
 
 
 #include "SCA_IActuator.h"
+#include "SCA_ISensor.h"
 
 #include "CM_Message.h"
 #include "CM_List.h"
@@ -112,6 +113,7 @@ void SCA_IActuator::ProcessReplica()
 	SCA_ILogicBrick::ProcessReplica();
 	RemoveAllEvents();
 	m_linkedcontrollers.clear();
+	m_actuatorSensors.clear();
 }
 
 SCA_IActuator::~SCA_IActuator()
@@ -166,3 +168,20 @@ void SCA_IActuator::UnlinkAllControllers()
 	}
 	m_linkedcontrollers.clear();
 }
+
+void SCA_IActuator::RegisterActuatorSensor(SCA_ISensor *sensor)
+{
+	CM_ListAddIfNotFound(m_actuatorSensors, sensor);
+}
+
+void SCA_IActuator::UnregisterActuatorSensor(SCA_ISensor *sensor)
+{
+	CM_ListRemoveIfFound(m_actuatorSensors, sensor);
+}
+
+void SCA_IActuator::WakeActuatorSensors()
+{
+	for (SCA_ISensor *sensor : m_actuatorSensors) {
+		sensor->Wake();
+	}
+}
@@ -52,6 +52,9 @@ protected:
 
 	std::vector<SCA_IController *> m_linkedcontrollers;
 
+	/// Actuator sensors woken up when this actuator is activated or deactivated.
+	std::vector<SCA_ISensor *> m_actuatorSensors;
+
 	void RemoveAllEvents();
 
 public:
@@ -141,6 +144,11 @@ public:
 	void UnlinkController(SCA_IController *cont);
 	void UnlinkAllControllers();
 
+	void RegisterActuatorSensor(SCA_ISensor *sensor);
+	void UnregisterActuatorSensor(SCA_ISensor *sensor);
+	/// Wake up the actuator sensors after a change of the actuator state.
+	void WakeActuatorSensors();
+
 	void ClrLink();
 	void IncLink();
 	virtual void DecLink();
@@ -169,11 +169,62 @@ void SCA_IObject::UnregisterObject(SCA_IObject *obj)
 	CM_ListRemoveIfFound(m_registeredObjects, obj);
 }
 
+void SCA_IObject::RegisterPropertySensor(SCA_ISensor *sensor)
+{
+	CM_ListAddIfNotFound(m_propertySensors, sensor);
+}
+
+void SCA_IObject::UnregisterPropertySensor(SCA_ISensor *sensor)
+{
+	CM_ListRemoveIfFound(m_propertySensors, sensor);
+}
+
+void SCA_IObject::NotifyPropertyChange()
+{
+	for (SCA_ISensor *sensor : m_propertySensors) {
+		sensor->Wake();
+	}
+}
+
+void SCA_IObject::SetProperty(const std::string& name, EXP_Value *ioProperty)
+{
+	EXP_Value::SetProperty(name, ioProperty);
+	NotifyPropertyChange();
+}
+
+bool SCA_IObject::RemoveProperty(const std::string& inName)
+{
+	if (EXP_Value::RemoveProperty(inName)) {
+		NotifyPropertyChange();
+		return true;
+	}
+	return false;
+}
+
+void SCA_IObject::ClearProperties()
+{
+	EXP_Value::ClearProperties();
+	NotifyPropertyChange();
+}
+
 bool SCA_IObject::UnlinkObject(SCA_IObject *clientobj)
 {
 	return false;
 }
 
+void SCA_IObject::UnlinkRegistered()
+{
+	for (SCA_IActuator *actuator : m_registeredActuators) {
+		actuator->UnlinkObject(this);
+	}
+	m_registeredActuators.clear();
+
+	for (SCA_IObject *object : m_registeredObjects) {
+		object->UnlinkObject(this);
+	}
+	m_registeredObjects.clear();
+}
+
 void SCA_IObject::ReParentLogic()
 {
 	SCA_ActuatorList& oldactuators = GetActuators();
@@ -61,6 +61,8 @@ protected:
 	SCA_ActuatorList m_registeredActuators;
 	/// Objects that hold reference to this object.
 	SCA_ObjectList m_registeredObjects;
+	/// Property sensors woken up when a property of this object changes.
+	SCA_SensorList m_propertySensors;
 
 	/** SG_Dlist: element of objects with active actuators
 	 *            Head: SCA_LogicManager::m_activeActuators
@@ -118,12 +120,25 @@ public:
 
 	void RegisterObject(SCA_IObject *objs);
 	void UnregisterObject(SCA_IObject *objs);
+
+	void RegisterPropertySensor(SCA_ISensor *sensor);
+	void UnregisterPropertySensor(SCA_ISensor *sensor);
+	/** Wake up the property sensors of this object, must be called after
+	 * a property value is modified in place with EXP_Value::SetValue.
+	 */
+	void NotifyPropertyChange();
+
+	virtual void SetProperty(const std::string& name, EXP_Value *ioProperty);
+	virtual bool RemoveProperty(const std::string& inName);
+	virtual void ClearProperties();
 	/**
 	 * UnlinkObject(...)
 	 * this object is informed that one of the object to which it holds a reference is deleted
 	 * returns true if there was indeed a reference.
 	 */
 	virtual bool UnlinkObject(SCA_IObject *clientobj);
+	/// Inform the registered actuators and objects that this object is deleted or deactivated.
+	void UnlinkRegistered();
 
 	SCA_ISensor *FindSensor(const std::string& sensorname);
 	SCA_IActuator *FindActuator(const std::string& actuatorname);
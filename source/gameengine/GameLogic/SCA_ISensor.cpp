@@ -61,7 +61,10 @@ SCA_ISensor::SCA_ISensor(SCA_IObject *gameobj, SCA_EventManager *eventmgr)
 	m_suspended(false),
 	m_links(0),
 	m_state(false),
-	m_prev_state(false)
+	m_prev_state(false),
+	m_pending(false),
+	m_polled(false),
+	m_wakeTick(0)
 {
 }
 
@@ -73,6 +76,10 @@ void SCA_ISensor::ProcessReplica()
 {
 	SCA_ILogicBrick::ProcessReplica();
 	m_linkedcontrollers.clear();
+	// The replica is not registered in any event manager.
+	m_pending = false;
+	m_polled = false;
+	m_wakeTick = 0;
 }
 
 bool SCA_ISensor::IsPositiveTrigger()
@@ -94,21 +101,50 @@ void SCA_ISensor::SetPulseMode(bool posmode, bool negmode, int skippedticks)
 	m_pos_pulsemode = posmode;
 	m_neg_pulsemode = negmode;
 	m_skipped_ticks = skippedticks;
+	UpdateWakeMode();
 }
 
 void SCA_ISensor::SetInvert(bool inv)
 {
 	m_invert = inv;
+	Wake();
 }
 
 void SCA_ISensor::SetLevel(bool lvl)
 {
 	m_level = lvl;
+	UpdateWakeMode();
 }
 
 void SCA_ISensor::SetTap(bool tap)
 {
 	m_tap = tap;
+	UpdateWakeMode();
+}
+
+bool SCA_ISensor::IsEventDriven() const
+{
+	return false;
+}
+
+bool SCA_ISensor::IsPolled() const
+{
+	return (!IsEventDriven() || m_pos_pulsemode || m_neg_pulsemode || m_level || m_tap);
+}
+
+void SCA_ISensor::Wake()
+{
+	// Only the sensors registered in the event manager are evaluated.
+	if (m_links) {
+		m_eventmgr->WakeSensor(this);
+	}
+}
+
+void SCA_ISensor::UpdateWakeMode()
+{
+	if (m_links) {
+		m_eventmgr->UpdateSensorWakeMode(this);
+	}
 }
 
 double SCA_ISensor::GetNumber()
@@ -134,6 +170,8 @@ bool SCA_ISensor::IsSuspended()
 void SCA_ISensor::Resume()
 {
 	m_suspended = false;
+	// The inputs may have changed during the suspension.
+	Wake();
 }
 
 bool SCA_ISensor::GetState()
@@ -203,9 +241,12 @@ void SCA_ISensor::Replace_EventManager(class SCA_LogicManager *logicmgr)
 {
 	// True if we're used currently.
 	if (m_links) {
+		// Keep the timer of the sensor in the new event manager.
+		const unsigned int timer = m_eventmgr->GetSensorTimer(this);
 		m_eventmgr->RemoveSensor(this);
 		m_eventmgr = logicmgr->FindEventManager(m_eventmgr->GetType());
 		m_eventmgr->RegisterSensor(this);
+		m_eventmgr->SetSensorTimer(this, timer);
 	}
 	else {
 		m_eventmgr = logicmgr->FindEventManager(m_eventmgr->GetType());
@@ -334,6 +375,7 @@ EXP_PYMETHODDEF_DOC_NOARGS(SCA_ISensor, reset,
 {
 	Init();
 	m_prev_state = false;
+	Wake();
 	Py_RETURN_NONE;
 }
 
@@ -369,10 +411,10 @@ PyMethodDef SCA_ISensor::Methods[] = {
 };
 
 PyAttributeDef SCA_ISensor::Attributes[] = {
-	EXP_PYATTRIBUTE_BOOL_RW("usePosPulseMode", SCA_ISensor, m_pos_pulsemode),
-	EXP_PYATTRIBUTE_BOOL_RW("useNegPulseMode", SCA_ISensor, m_neg_pulsemode),
+	EXP_PYATTRIBUTE_BOOL_RW_CHECK("usePosPulseMode", SCA_ISensor, m_pos_pulsemode, pyattr_check_pulse_mode),
+	EXP_PYATTRIBUTE_BOOL_RW_CHECK("useNegPulseMode", SCA_ISensor, m_neg_pulsemode, pyattr_check_pulse_mode),
 	EXP_PYATTRIBUTE_INT_RW("skippedTicks", 0, 100000, true, SCA_ISensor, m_skipped_ticks),
-	EXP_PYATTRIBUTE_BOOL_RW("invert", SCA_ISensor, m_invert),
+	EXP_PYATTRIBUTE_BOOL_RW_CHECK("invert", SCA_ISensor, m_invert, pyattr_check_wake),
 	EXP_PYATTRIBUTE_BOOL_RW_CHECK("level", SCA_ISensor, m_level, pyattr_check_level),
 	EXP_PYATTRIBUTE_BOOL_RW_CHECK("tap", SCA_ISensor, m_tap, pyattr_check_tap),
 	EXP_PYATTRIBUTE_RO_FUNCTION("triggered", SCA_ISensor, pyattr_get_triggered),
@@ -437,6 +479,7 @@ int SCA_ISensor::pyattr_check_level(EXP_PyObjectPlus *self_v, const EXP_PYATTRIB
 	if (self->m_level) {
 		self->m_tap = false;
 	}
+	self->UpdateWakeMode();
 	return 0;
 }
 
@@ -446,6 +489,21 @@ int SCA_ISensor::pyattr_check_tap(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUT
 	if (self->m_tap) {
 		self->m_level = false;
 	}
+	self->UpdateWakeMode();
+	return 0;
+}
+
+int SCA_ISensor::pyattr_check_pulse_mode(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+	SCA_ISensor *self = static_cast<SCA_ISensor *>(self_v);
+	self->UpdateWakeMode();
+	return 0;
+}
+
+int SCA_ISensor::pyattr_check_wake(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+	SCA_ISensor *self = static_cast<SCA_ISensor *>(self_v);
+	self->Wake();
 	return 0;
 }
 
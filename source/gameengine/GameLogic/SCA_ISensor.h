@@ -48,6 +48,8 @@ class SCA_ISensor : public SCA_ILogicBrick
 {
 	Py_Header
 
+	friend class SCA_EventManager;
+
 protected:
 	SCA_EventManager *m_eventmgr;
 
@@ -90,6 +92,15 @@ protected:
 	/// Previous state (for tap option).
 	bool m_prev_state;
 
+	/// Sensor is in the list of the sensors woken up of its event manager.
+	bool m_pending;
+
+	/// Sensor is in the list of the sensors evaluated every frame of its event manager.
+	bool m_polled;
+
+	/// Tick of the event manager at which the sensor is woken up, 0 without timer.
+	unsigned int m_wakeTick;
+
 	std::vector<SCA_IController *> m_linkedcontrollers;
 
 public:
@@ -116,6 +127,19 @@ public:
 	virtual bool IsPositiveTrigger();
 	virtual void Init();
 
+	/** Return true if the sensor calls Wake() each time one of its inputs changes,
+	 * the event manager then evaluates it only after a wake up instead of every frame.
+	 */
+	virtual bool IsEventDriven() const;
+	/** Return true if the sensor must be evaluated every frame: the sensor is not event
+	 * driven or its pulse, level or tap options generate events without input changes.
+	 */
+	bool IsPolled() const;
+	/// Request an evaluation of the sensor at the next frame.
+	void Wake();
+	/// Move the sensor between the polled and woken up sensors after a change of its options.
+	void UpdateWakeMode();
+
 	virtual EXP_Value *GetReplica() = 0;
 
 	/** Set parameters for the pulsing behavior.
@@ -146,7 +170,7 @@ public:
 	virtual sensortype GetSensorType();
 
 	/// Stop sensing for a while.
-	void Suspend();
+	virtual void Suspend();
 
 	/// Is this sensor switched off?
 	bool IsSuspended();
@@ -164,7 +188,7 @@ public:
 	int GetNegTicks();
 
 	/// Resume sensing.
-	void Resume();
+	virtual void Resume();
 
 	void ClrLink();
 	void IncLink();
@@ -184,6 +208,9 @@ public:
 
 	static int pyattr_check_level(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
 	static int pyattr_check_tap(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
+	static int pyattr_check_pulse_mode(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
+	/// Wake up the sensor after a change of an attribute used in its evaluation.
+	static int pyattr_check_wake(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
 
 	enum SensorStatus {
 		KX_SENSOR_INACTIVE = 0,
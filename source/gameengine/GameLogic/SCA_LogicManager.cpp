@@ -133,6 +133,7 @@ void SCA_LogicManager::RemoveActuator(SCA_IActuator* actuator)
 	actuator->UnlinkAllControllers();
 	actuator->Deactivate();
 	actuator->SetActive(false);
+	actuator->WakeActuatorSensors();
 }
 
 
@@ -198,6 +199,7 @@ void SCA_LogicManager::UpdateFrame(double curtime)
 				// this actuator is not active anymore, remove
 				actua->QDelink(); 
 				actua->SetActive(false); 
+				actua->WakeActuatorSensors();
 			} else if (actua->IsNoLink())
 			{
 				// This actuator has no more links but it still active
@@ -103,6 +103,7 @@ public:
 		actua->SetActive(true);
 		actua->Activate(m_activeActuators);
 		actua->AddEvent(event);
+		actua->WakeActuatorSensors();
 	}
 
 	void	AddTriggeredController(SCA_IController* controller, SCA_ISensor* sensor);
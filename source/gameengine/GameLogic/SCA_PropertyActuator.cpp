@@ -80,6 +80,7 @@ bool SCA_PropertyActuator::Update()
 			if (oldprop)
 			{
 				oldprop->SetValue(newval);
+				GetParent()->NotifyPropertyChange();
 			}
 			newval->Release();
 		}
@@ -184,7 +185,10 @@ bool SCA_PropertyActuator::Update()
 
 		userexpr->Release();
 	}
-	
+
+	// Wake up the property sensors after the values modified in place.
+	GetParent()->NotifyPropertyChange();
+
 	return result;
 }
 
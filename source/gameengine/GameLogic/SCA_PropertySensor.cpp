@@ -106,12 +106,36 @@ SCA_PropertySensor::~SCA_PropertySensor()
 
 
 
+bool SCA_PropertySensor::IsEventDriven() const
+{
+	return true;
+}
+
+void SCA_PropertySensor::RegisterToManager()
+{
+	SCA_ISensor::RegisterToManager();
+	GetParent()->RegisterPropertySensor(this);
+}
+
+void SCA_PropertySensor::UnregisterToManager()
+{
+	GetParent()->UnregisterPropertySensor(this);
+	SCA_ISensor::UnregisterToManager();
+}
+
 bool SCA_PropertySensor::Evaluate()
 {
 	bool result = CheckPropertyCondition();
 	bool reset = m_reset && m_level;
 	
 	m_reset = false;
+
+	// Timer properties are updated every frame without notification, keep evaluating.
+	EXP_Value *prop = GetParent()->GetProperty(m_checkpropname);
+	if (prop && prop->GetProperty("timer")) {
+		Wake();
+	}
+
 	if (m_lastresult!=result)
 	{
 		m_lastresult = result;
@@ -268,9 +292,19 @@ int SCA_PropertySensor::validValueForProperty(EXP_PyObjectPlus *self, const PyAt
 	 * function directly */
 
 	/*  There is no type checking at this moment, unfortunately...           */
+	static_cast<SCA_PropertySensor *>(self)->Wake();
 	return 0;
 }
 
+int SCA_PropertySensor::CheckPropertyName(EXP_PyObjectPlus *self, const PyAttributeDef *attrdef)
+{
+	const int ret = CheckProperty(self, attrdef);
+	if (ret == 0) {
+		static_cast<SCA_PropertySensor *>(self)->Wake();
+	}
+	return ret;
+}
+
 /* Integration hooks ------------------------------------------------------- */
 PyTypeObject SCA_PropertySensor::Type = {
 	PyVarObject_HEAD_INIT(nullptr, 0)
@@ -299,8 +333,8 @@ PyMethodDef SCA_PropertySensor::Methods[] = {
 };
 
 PyAttributeDef SCA_PropertySensor::Attributes[] = {
-	EXP_PYATTRIBUTE_INT_RW("mode",KX_PROPSENSOR_NODEF,KX_PROPSENSOR_MAX-1,false,SCA_PropertySensor,m_checktype),
-	EXP_PYATTRIBUTE_STRING_RW_CHECK("propName",0,MAX_PROP_NAME,false,SCA_PropertySensor,m_checkpropname,CheckProperty),
+	EXP_PYATTRIBUTE_INT_RW_CHECK("mode",KX_PROPSENSOR_NODEF,KX_PROPSENSOR_MAX-1,false,SCA_PropertySensor,m_checktype,pyattr_check_wake),
+	EXP_PYATTRIBUTE_STRING_RW_CHECK("propName",0,MAX_PROP_NAME,false,SCA_PropertySensor,m_checkpropname,CheckPropertyName),
 	EXP_PYATTRIBUTE_STRING_RW_CHECK("value",0,100,false,SCA_PropertySensor,m_checkpropval,validValueForProperty),
 	EXP_PYATTRIBUTE_STRING_RW_CHECK("min",0,100,false,SCA_PropertySensor,m_checkpropval,validValueForProperty),
 	EXP_PYATTRIBUTE_STRING_RW_CHECK("max",0,100,false,SCA_PropertySensor,m_checkpropmaxval,validValueForProperty),
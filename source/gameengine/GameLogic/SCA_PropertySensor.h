@@ -79,6 +79,9 @@ public:
 	virtual bool Evaluate();
 	virtual bool	IsPositiveTrigger();
 	virtual EXP_Value*		FindIdentifier(const std::string& identifiername);
+	virtual bool	IsEventDriven() const;
+	virtual void	RegisterToManager();
+	virtual void	UnregisterToManager();
 
 #ifdef WITH_PYTHON
 
@@ -90,6 +93,7 @@ public:
 	 * Test whether this is a sensible value (type check)
 	 */
 	static int validValueForProperty(EXP_PyObjectPlus *self, const PyAttributeDef*);
+	static int CheckPropertyName(EXP_PyObjectPlus *self, const PyAttributeDef *attrdef);
 
 #endif
 };
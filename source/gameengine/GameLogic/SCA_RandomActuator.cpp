@@ -247,6 +247,7 @@ bool SCA_RandomActuator::Update()
 	EXP_Value *prop = GetParent()->GetProperty(m_propname);
 	if (prop) {
 		prop->SetValue(tmpval);
+		GetParent()->NotifyPropertyChange();
 	}
 	tmpval->Release();
 
@@ -0,0 +1,177 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/GamePlayer/GPG_HeadlessCanvas.cpp
+ *  \ingroup player
+ */
+
+#include "GPG_HeadlessCanvas.h"
+
+#include "CM_Message.h"
+
+GPG_HeadlessCanvas::GPG_HeadlessCanvas(int width, int height)
+	:RAS_ICanvas(nullptr)
+{
+	Resize(width, height);
+	SetViewPort(0, 0, width, height);
+}
+
+GPG_HeadlessCanvas::~GPG_HeadlessCanvas()
+{
+}
+
+int GPG_HeadlessCanvas::GetWidth() const
+{
+	return m_width;
+}
+
+int GPG_HeadlessCanvas::GetHeight() const
+{
+	return m_height;
+}
+
+int GPG_HeadlessCanvas::GetMaxX() const
+{
+	return (m_width - 1);
+}
+
+int GPG_HeadlessCanvas::GetMaxY() const
+{
+	return (m_height - 1);
+}
+
+RAS_Rect &GPG_HeadlessCanvas::GetWindowArea()
+{
+	return m_area;
+}
+
+void GPG_HeadlessCanvas::BeginFrame()
+{
+}
+
+void GPG_HeadlessCanvas::EndFrame()
+{
+}
+
+void GPG_HeadlessCanvas::BeginDraw()
+{
+}
+
+void GPG_HeadlessCanvas::EndDraw()
+{
+}
+
+void GPG_HeadlessCanvas::Resize(int width, int height)
+{
+	m_width = width;
+	m_height = height;
+
+	m_area.SetLeft(0);
+	m_area.SetBottom(0);
+	m_area.SetRight(width - 1);
+	m_area.SetTop(height - 1);
+}
+
+void GPG_HeadlessCanvas::SetViewPort(int x, int y, int width, int height)
+{
+	m_viewport[0] = x;
+	m_viewport[1] = y;
+	m_viewport[2] = width;
+	m_viewport[3] = height;
+}
+
+void GPG_HeadlessCanvas::UpdateViewPort(int x, int y, int width, int height)
+{
+	SetViewPort(x, y, width, height);
+}
+
+const int *GPG_HeadlessCanvas::GetViewPort()
+{
+	return m_viewport;
+}
+
+void GPG_HeadlessCanvas::MakeScreenShot(const std::string& filename)
+{
+	CM_Warning("screenshot \"" << filename << "\" ignored, nothing is rendered in headless mode");
+}
+
+void GPG_HeadlessCanvas::Init()
+{
+}
+
+void GPG_HeadlessCanvas::SetMousePosition(int x, int y)
+{
+}
+
+void GPG_HeadlessCanvas::SetMouseState(RAS_MouseState mousestate)
+{
+	m_mousestate = mousestate;
+}
+
+void GPG_HeadlessCanvas::SwapBuffers()
+{
+}
+
+void GPG_HeadlessCanvas::SetSwapInterval(int interval)
+{
+}
+
+bool GPG_HeadlessCanvas::GetSwapInterval(int& intervalOut)
+{
+	return false;
+}
+
+void GPG_HeadlessCanvas::GetDisplayDimensions(int &width, int &height)
+{
+	width = m_width;
+	height = m_height;
+}
+
+void GPG_HeadlessCanvas::ResizeWindow(int width, int height)
+{
+	Resize(width, height);
+}
+
+void GPG_HeadlessCanvas::SetFullScreen(bool enable)
+{
+}
+
+bool GPG_HeadlessCanvas::GetFullScreen()
+{
+	return false;
+}
+
+void GPG_HeadlessCanvas::ConvertMousePosition(int x, int y, int &r_x, int &r_y, bool screen)
+{
+	r_x = x;
+	r_y = y;
+}
+
+float GPG_HeadlessCanvas::GetMouseNormalizedX(int x)
+{
+	return float(x) / GetMaxX();
+}
+
+float GPG_HeadlessCanvas::GetMouseNormalizedY(int y)
+{
+	return float(y) / GetMaxY();
+}
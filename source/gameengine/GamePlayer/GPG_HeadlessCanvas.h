@@ -0,0 +1,92 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file GPG_HeadlessCanvas.h
+ *  \ingroup player
+ */
+
+#ifndef __GPG_HEADLESSCANVAS_H__
+#define __GPG_HEADLESSCANVAS_H__
+
+#include "RAS_ICanvas.h"
+#include "RAS_Rect.h"
+
+/** Canvas without window and GL context used by the headless player.
+ * It only keeps a virtual size for the game logic (camera aspect, mouse
+ * coordinates, window size python functions), nothing is ever drawn.
+ */
+class GPG_HeadlessCanvas : public RAS_ICanvas
+{
+protected:
+	/// Width of the virtual context.
+	int m_width;
+	/// Height of the virtual context.
+	int m_height;
+	RAS_Rect m_area;
+
+	int m_viewport[4];
+
+public:
+	GPG_HeadlessCanvas(int width, int height);
+	virtual ~GPG_HeadlessCanvas();
+
+	/**
+	 * \section Methods inherited from abstract base class RAS_ICanvas.
+	 */
+
+	virtual int GetWidth() const;
+	virtual int GetHeight() const;
+	virtual int GetMaxX() const;
+	virtual int GetMaxY() const;
+	virtual RAS_Rect &GetWindowArea();
+	virtual void BeginFrame();
+	virtual void EndFrame();
+
+	virtual void SetViewPort(int x, int y, int width, int height);
+	virtual void UpdateViewPort(int x, int y, int width, int height);
+	virtual const int *GetViewPort();
+
+	virtual void MakeScreenShot(const std::string& filename);
+
+	virtual void Init();
+	virtual void SetMousePosition(int x, int y);
+	virtual void SetMouseState(RAS_MouseState mousestate);
+	virtual void SwapBuffers();
+	virtual void SetSwapInterval(int interval);
+	virtual bool GetSwapInterval(int& intervalOut);
+
+	virtual void ConvertMousePosition(int x, int y, int &r_x, int &r_y, bool screen);
+	virtual float GetMouseNormalizedX(int x);
+	virtual float GetMouseNormalizedY(int y);
+
+	virtual void GetDisplayDimensions(int &width, int &height);
+
+	virtual void Resize(int width, int height);
+	virtual void ResizeWindow(int width, int height);
+	virtual void SetFullScreen(bool enable);
+	virtual bool GetFullScreen();
+
+	virtual void BeginDraw();
+	virtual void EndDraw();
+};
+
+#endif  // __GPG_HEADLESSCANVAS_H__
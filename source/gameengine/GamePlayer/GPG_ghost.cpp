@@ -97,6 +97,7 @@ extern "C"
 
 #include "LA_SystemCommandLine.h"
 #include "LA_PlayerLauncher.h"
+#include "LA_HeadlessLauncher.h"
 
 #include "GHOST_ISystem.h"
 
@@ -444,7 +445,7 @@ static void usage(const std::string& program, bool isBlenderPlayer)
 	CM_Message(std::endl)
 	CM_Message("usage:   " << program << " [--options] " << example_filename << std::endl);
 	CM_Message("Available options are: [-w [w h l t]] [-f [fw fh fb ff]] " << consoleoption << "[-g gamengineoptions] "
-		<< "[-s stereomode] [-m aasamples]");
+		<< "[-s stereomode] [-m aasamples] [-headless [frames]]");
 	CM_Message("Optional parameters must be passed in order.");
 	CM_Message("Default values are set in the blend file." << std::endl);
 	CM_Message("  -h: Prints this command summary" << std::endl);
@@ -498,8 +499,20 @@ static void usage(const std::string& program, bool isBlenderPlayer)
 	CM_Message("       show_armatures                 0         Show debug armatures");
 	CM_Message("       show_camera_frustum            0         Show debug camera frustum volume");
 	CM_Message("       show_shadow_frustum            0         Show debug light shadow frustum volume");
+	CM_Message("       parallel_scenes                0         Proceed scenes physics in parallel");
+	CM_Message("       parallel_scenegraph            0         Update scene graph hierarchies in parallel");
+	CM_Message("       headless_realtime              1         Follow the real time in headless mode, else run as fast as possible");
+	CM_Message("       headless_deform                0         Pose armatures and deform meshes in headless mode");
+	CM_Message("       trace_file                               Write a Chrome trace of the engine events to this file");
+	CM_Message("       trace_start                    0         Number of frames to skip before recording the trace");
+	CM_Message("       trace_frames                   100       Number of frames recorded in the trace");
 	CM_Message("       ignore_deprecation_warnings    1         Ignore deprecation warnings" << std::endl);
 	CM_Message("  -p: override python main loop script");
+	CM_Message("  -headless: run without window and rendering (logic, physics, animations and python only)");
+	CM_Message("       --Optional parameters--");
+	CM_Message("       frames = number of frames to run before exiting (default: 0, no limit)");
+	CM_Message("       Note: The -w size is used for the virtual canvas size.");
+	CM_Message("       Example: -headless  or  -headless 1000 -g headless_realtime = 0" << std::endl);
 	CM_Message(std::endl);
 	CM_Message("  - : all arguments after this are ignored, allowing python to access them from sys.argv");
 	CM_Message(std::endl);
@@ -670,6 +683,8 @@ int main(
 	std::string pythonControllerFile;
 	GHOST_TUns16 aasamples = 0;
 	int alphaBackground = 0;
+	bool headless = false;
+	int headlessFrames = 0;
 	
 #ifdef WIN32
 	char **argv;
@@ -825,6 +840,16 @@ int main(
 				argc_py_clamped= i;
 				break;
 			}
+
+			// Checked before the single letter options as it starts like -h.
+			if (strcmp(argv[i], "-headless") == 0) {
+				i++;
+				headless = true;
+				if ((i + 1) <= validArguments && argv[i][0] != '-') {
+					headlessFrames = atoi(argv[i++]);
+				}
+				continue;
+			}
 			
 			switch (argv[i][1])
 			{
@@ -1110,18 +1135,25 @@ int main(
 	if (scr_saver_mode != SCREEN_SAVER_MODE_CONFIGURATION)
 #endif
 	{
-		// Create the system
-		if (GHOST_ISystem::createSystem() == GHOST_kSuccess) {
-			GHOST_ISystem* system = GHOST_ISystem::getSystem();
-			BLI_assert(system);
-			
-			if (!fullScreenWidth || !fullScreenHeight)
-				system->getMainDisplayDimensions(fullScreenWidth, fullScreenHeight);
-			// process first batch of events. If the user
-			// drops a file on top off the blenderplayer icon, we
-			// receive an event with the filename
-			
-			system->processEvents(0);
+		if (headless) {
+			// No audio device is needed for a server.
+			BKE_sound_force_device("Null");
+		}
+
+		// Create the system, the headless mode runs without any GHOST system.
+		if (headless || GHOST_ISystem::createSystem() == GHOST_kSuccess) {
+			GHOST_ISystem* system = headless ? nullptr : GHOST_ISystem::getSystem();
+			BLI_assert(system || headless);
+
+			if (system) {
+				if (!fullScreenWidth || !fullScreenHeight)
+					system->getMainDisplayDimensions(fullScreenWidth, fullScreenHeight);
+				// process first batch of events. If the user
+				// drops a file on top off the blenderplayer icon, we
+				// receive an event with the filename
+
+				system->processEvents(0);
+			}
 
 #ifdef WITH_PYTHON
 			// Initialize python and the global dictionary.
@@ -1206,7 +1238,7 @@ int main(
 						/* Setting options according to the blend file if not overriden in the command line */
 #ifdef WIN32
 #if !defined(DEBUG)
-						if (closeConsole) {
+						if (closeConsole && system) {
 							system->toggleConsole(0); // Close a console window
 						}
 #endif // !defined(DEBUG)
@@ -1298,9 +1330,7 @@ int main(
 							aasamples = scene->gm.aasamples;
 
 						BLI_strncpy(pathname, maggie->name, sizeof(pathname));
-						if (firstTimeRunning) {
-							firstTimeRunning = false;
-
+						if (firstTimeRunning && !headless) {
 							if (fullScreen) {
 #ifdef WIN32
 								if (scr_saver_mode == SCREEN_SAVER_MODE_SAVER)
@@ -1377,25 +1407,34 @@ int main(
 							GPU_set_gpu_mipmapping(U.use_gpu_mipmap);
 							GPU_set_linear_mipmap(true);
 						}
+						firstTimeRunning = false;
 
 						// This argc cant be argc_py_clamped, since python uses it.
-						LA_PlayerLauncher launcher(system, window, maggie, scene, &gs, stereomode, aasamples,
-												   argc, argv, pythonControllerFile);
+						LA_Launcher *launcher;
+						if (headless) {
+							launcher = new LA_HeadlessLauncher(maggie, scene, &gs, windowWidth, windowHeight, headlessFrames,
+															   argc, argv, pythonControllerFile);
+						}
+						else {
+							launcher = new LA_PlayerLauncher(system, window, maggie, scene, &gs, stereomode, aasamples,
+															 argc, argv, pythonControllerFile);
+						}
 
 #ifdef WITH_PYTHON
-						launcher.SetPythonGlobalDict(globalDict);
+						launcher->SetPythonGlobalDict(globalDict);
 #endif  // WITH_PYTHON
 
-						launcher.InitEngine();
+						launcher->InitEngine();
 
 						// Enter main loop
-						launcher.EngineMainLoop();
+						launcher->EngineMainLoop();
 
-						exitcode = launcher.GetExitRequested();
-						exitstring = launcher.GetExitString();
-						gs = *launcher.GetGlobalSettings();
+						exitcode = launcher->GetExitRequested();
+						exitstring = launcher->GetExitString();
+						gs = *launcher->GetGlobalSettings();
 
-						launcher.ExitEngine();
+						launcher->ExitEngine();
+						delete launcher;
 
 						BLO_blendfiledata_free(bfd);
 						/* G.main == bfd->main, it gets referenced in free_nodesystem so we can't have a dangling pointer */
@@ -1404,7 +1443,9 @@ int main(
 				} while (!quitGame(exitcode));
 			}
 
-			GPU_exit();
+			if (!headless) {
+				GPU_exit();
+			}
 
 #ifdef WITH_PYTHON
 			PyDict_Clear(globalDict);
@@ -1420,7 +1461,9 @@ int main(
 			}
 
 			// Dispose the system
-			GHOST_ISystem::disposeSystem();
+			if (system) {
+				GHOST_ISystem::disposeSystem();
+			}
 		}
 		else {
 			error = true;
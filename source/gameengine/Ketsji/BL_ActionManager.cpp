@@ -141,6 +141,13 @@ bool BL_ActionManager::IsActionDone(short layer)
 	return action ? action->IsDone() : true;
 }
 
+void BL_ActionManager::GetActionLayers(std::vector<short>& layers) const
+{
+	for (const BL_ActionMap::value_type& pair : m_layers) {
+		layers.push_back(pair.first);
+	}
+}
+
 void BL_ActionManager::Suspend()
 {
 	m_suspended = true;
@@ -28,6 +28,7 @@
 #define __BL_ACTIONMANAGER_H__
 
 #include <map>
+#include <vector>
 
 // Currently, we use the max value of a short.
 // We should switch to unsigned short; doesn't make sense to support negative layers.
@@ -110,6 +111,11 @@ public:
 	 */
 	bool IsActionDone(short layer);
 
+	/**
+	 * Append the layers playing an action
+	 */
+	void GetActionLayers(std::vector<short>& layers) const;
+
 	void Suspend();
 	void Resume();
 	bool IsSuspended() const;
@@ -49,28 +49,37 @@ void KX_NetworkMessageManager::AddMessage(KX_NetworkMessageManager::Message mess
 	m_messages[m_currentList][message.to][message.subject].push_back(message);
 }
 
-const std::vector<KX_NetworkMessageManager::Message> KX_NetworkMessageManager::GetMessages(std::string to, std::string subject)
+const std::vector<KX_NetworkMessageManager::Message> KX_NetworkMessageManager::GetMessages(const std::string& to, const std::string& subject)
 {
 	std::vector<KX_NetworkMessageManager::Message> messages;
 
-	// look at messages without receiver.
-	std::map<std::string, std::vector<Message> >& messagesNoReceiver = m_messages[1 - m_currentList][""];
-	std::map<std::string, std::vector<Message> >& messagesReceiver = m_messages[1 - m_currentList][to];
-	if (subject.empty()) {
-		// Add all message without receiver and subject.
-		for (const auto& pair : messagesNoReceiver) {
-			messages.insert(messages.end(), pair.second.begin(), pair.second.end());
+	/* The lists are searched without operator[] to not insert empty entries
+	 * for each receiver and subject polled by the sensors. */
+	const std::map<std::string, std::map<std::string, std::vector<Message> > >& receivers = m_messages[1 - m_currentList];
+	const auto addMessages = [&messages, &subject](const std::map<std::string, std::vector<Message> >& subjects) {
+		if (subject.empty()) {
+			for (const auto& pair : subjects) {
+				messages.insert(messages.end(), pair.second.begin(), pair.second.end());
+			}
 		}
-		// Add all message with the given receiver and no subject.
-		for (const auto& pair : messagesReceiver) {
-			messages.insert(messages.end(), pair.second.begin(), pair.second.end());
+		else {
+			const auto it = subjects.find(subject);
+			if (it != subjects.end()) {
+				messages.insert(messages.end(), it->second.begin(), it->second.end());
+			}
 		}
+	};
+
+	// Look at messages without receiver and then with the given receiver.
+	const auto noReceiverIt = receivers.find("");
+	if (noReceiverIt != receivers.end()) {
+		addMessages(noReceiverIt->second);
 	}
-	else {
-		std::vector<KX_NetworkMessageManager::Message>& messagesNoReceiverSubject = messagesNoReceiver[subject];
-		messages.insert(messages.end(), messagesNoReceiverSubject.begin(), messagesNoReceiverSubject.end());
-		std::vector<KX_NetworkMessageManager::Message>& messagesReceiverSubject = messagesReceiver[subject];
-		messages.insert(messages.end(), messagesReceiverSubject.begin(), messagesReceiverSubject.end());
+	if (!to.empty()) {
+		const auto receiverIt = receivers.find(to);
+		if (receiverIt != receivers.end()) {
+			addMessages(receiverIt->second);
+		}
 	}
 
 	return messages;
@@ -80,7 +80,7 @@ public:
 	 * \param to The object(s) name.
 	 * \param subject The message subject/filter.
 	 */
-	const std::vector<Message> GetMessages(std::string to, std::string subject);
+	const std::vector<Message> GetMessages(const std::string& to, const std::string& subject);
 
 	/// Clear all messages
 	void ClearMessages();
@@ -53,7 +53,7 @@ void KX_NetworkMessageScene::SendMessage(std::string to, SCA_IObject *from, std:
 	m_messageManager->AddMessage(message);
 }
 
-const std::vector<KX_NetworkMessageManager::Message> KX_NetworkMessageScene::FindMessages(std::string to, std::string subject)
+const std::vector<KX_NetworkMessageManager::Message> KX_NetworkMessageScene::FindMessages(const std::string& to, const std::string& subject)
 {
 	return m_messageManager->GetMessages(to, subject);
 }
@@ -67,7 +67,7 @@ public:
 	 * \param to The object(s) name.
 	 * \param subject The message subject/filter.
 	 */
-	const std::vector<KX_NetworkMessageManager::Message> FindMessages(std::string to, std::string subject);
+	const std::vector<KX_NetworkMessageManager::Message> FindMessages(const std::string& to, const std::string& subject);
 };
 
 #endif // __KX_NETWORKMESSAGESCENE_H__
@@ -0,0 +1,211 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KXNetwork/KX_NetworkSocket.cpp
+ *  \ingroup ketsjinet
+ */
+
+#include "KX_NetworkSocket.h"
+
+#include "CM_Message.h"
+
+#include <cstring>
+
+#ifdef WIN32
+#  include <winsock2.h>
+#  include <ws2tcpip.h>
+typedef int socklen_t;
+#  define INVALID_HANDLE ((intptr_t)INVALID_SOCKET)
+#else
+#  include <sys/types.h>
+#  include <sys/socket.h>
+#  include <netinet/in.h>
+#  include <netdb.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#  define INVALID_HANDLE ((intptr_t)-1)
+#endif
+
+KX_NetworkAddress::KX_NetworkAddress()
+	:m_host(0),
+	m_port(0)
+{
+}
+
+bool KX_NetworkAddress::Resolve(const std::string& host, unsigned short port, KX_NetworkAddress& address)
+{
+#ifdef WIN32
+	WSADATA data;
+	if (WSAStartup(MAKEWORD(2, 2), &data) != 0) {
+		return false;
+	}
+#endif
+
+	addrinfo hints;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_DGRAM;
+
+	addrinfo *result = nullptr;
+	const bool found = (getaddrinfo(host.c_str(), nullptr, &hints, &result) == 0 && result);
+	if (found) {
+		address.m_host = ((sockaddr_in *)result->ai_addr)->sin_addr.s_addr;
+		address.m_port = port;
+	}
+
+	if (result) {
+		freeaddrinfo(result);
+	}
+
+#ifdef WIN32
+	WSACleanup();
+#endif
+
+	return found;
+}
+
+std::string KX_NetworkAddress::GetText() const
+{
+	const unsigned char *bytes = (const unsigned char *)&m_host;
+	return std::to_string(bytes[0]) + "." + std::to_string(bytes[1]) + "." + std::to_string(bytes[2]) + "." +
+	       std::to_string(bytes[3]) + ":" + std::to_string(m_port);
+}
+
+KX_NetworkSocket::KX_NetworkSocket()
+	:m_socket(INVALID_HANDLE),
+	m_port(0)
+{
+}
+
+KX_NetworkSocket::~KX_NetworkSocket()
+{
+	Close();
+}
+
+bool KX_NetworkSocket::Open(unsigned short port)
+{
+	Close();
+
+#ifdef WIN32
+	// Winsock is initialized for each opened socket and released when the socket is closed.
+	WSADATA data;
+	if (WSAStartup(MAKEWORD(2, 2), &data) != 0) {
+		CM_Error("failed to initialize winsock");
+		return false;
+	}
+#endif
+
+	m_socket = (intptr_t)socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (m_socket == INVALID_HANDLE) {
+		CM_Error("failed to create an UDP socket");
+#ifdef WIN32
+		WSACleanup();
+#endif
+		return false;
+	}
+
+	sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	addr.sin_port = htons(port);
+
+	if (bind(m_socket, (sockaddr *)&addr, sizeof(addr)) != 0) {
+		CM_Error("failed to bind an UDP socket to the port " << port);
+		Close();
+		return false;
+	}
+
+	socklen_t addrlen = sizeof(addr);
+	getsockname(m_socket, (sockaddr *)&addr, &addrlen);
+	m_port = ntohs(addr.sin_port);
+
+#ifdef WIN32
+	u_long nonblocking = 1;
+	ioctlsocket(m_socket, FIONBIO, &nonblocking);
+#else
+	fcntl(m_socket, F_SETFL, fcntl(m_socket, F_GETFL, 0) | O_NONBLOCK);
+#endif
+
+	return true;
+}
+
+void KX_NetworkSocket::Close()
+{
+#ifdef WIN32
+	if (m_socket != INVALID_HANDLE) {
+		closesocket(m_socket);
+		WSACleanup();
+	}
+#else
+	if (m_socket != INVALID_HANDLE) {
+		close(m_socket);
+	}
+#endif
+
+	m_socket = INVALID_HANDLE;
+	m_port = 0;
+}
+
+bool KX_NetworkSocket::IsOpen() const
+{
+	return (m_socket != INVALID_HANDLE);
+}
+
+unsigned short KX_NetworkSocket::GetPort() const
+{
+	return m_port;
+}
+
+bool KX_NetworkSocket::Send(const KX_NetworkAddress& to, const void *data, unsigned int size)
+{
+	if (m_socket == INVALID_HANDLE) {
+		return false;
+	}
+
+	sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = to.m_host;
+	addr.sin_port = htons(to.m_port);
+
+	return (sendto(m_socket, (const char *)data, size, 0, (sockaddr *)&addr, sizeof(addr)) == (int)size);
+}
+
+int KX_NetworkSocket::Receive(void *data, unsigned int size, KX_NetworkAddress& from)
+{
+	if (m_socket == INVALID_HANDLE) {
+		return -1;
+	}
+
+	sockaddr_in addr;
+	socklen_t addrlen = sizeof(addr);
+	const int received = recvfrom(m_socket, (char *)data, size, 0, (sockaddr *)&addr, &addrlen);
+	if (received < 0) {
+		return -1;
+	}
+
+	from.m_host = addr.sin_addr.s_addr;
+	from.m_port = ntohs(addr.sin_port);
+
+	return received;
+}
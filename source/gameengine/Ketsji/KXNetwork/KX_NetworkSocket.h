@@ -0,0 +1,98 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_NetworkSocket.h
+ *  \ingroup ketsjinet
+ *  \brief Non-blocking UDP socket used by the scene replication.
+ */
+
+#ifndef __KX_NETWORKSOCKET_H__
+#define __KX_NETWORKSOCKET_H__
+
+#include <string>
+#include <cstdint>
+
+/// IPv4 address and port of a datagram peer.
+struct KX_NetworkAddress
+{
+	/// Host address in network byte order.
+	uint32_t m_host;
+	/// Port in host byte order.
+	unsigned short m_port;
+
+	KX_NetworkAddress();
+
+	/** Resolve a host name or a numeric address.
+	 * \return False if the host can't be resolved.
+	 */
+	static bool Resolve(const std::string& host, unsigned short port, KX_NetworkAddress& address);
+
+	/// Return the address as "a.b.c.d:port".
+	std::string GetText() const;
+
+	inline bool operator==(const KX_NetworkAddress& other) const
+	{
+		return (m_host == other.m_host && m_port == other.m_port);
+	}
+
+	inline bool operator!=(const KX_NetworkAddress& other) const
+	{
+		return !(*this == other);
+	}
+};
+
+/** Non-blocking UDP socket bound to all the interfaces. The datagrams are sent and
+ * received without waiting, Receive returns -1 when no datagram is pending.
+ */
+class KX_NetworkSocket
+{
+private:
+	/// Platform socket handle, -1 when closed.
+	intptr_t m_socket;
+	unsigned short m_port;
+
+public:
+	KX_NetworkSocket();
+	~KX_NetworkSocket();
+
+	/** Open the socket.
+	 * \param port The port to bind, 0 to bind any free port.
+	 * \return False if the socket can't be created or bound.
+	 */
+	bool Open(unsigned short port);
+	void Close();
+	bool IsOpen() const;
+
+	/// Return the bound port.
+	unsigned short GetPort() const;
+
+	/// Send a datagram, return false if it wasn't sent.
+	bool Send(const KX_NetworkAddress& to, const void *data, unsigned int size);
+	/** Receive one pending datagram.
+	 * \param data The buffer receiving the datagram, larger datagrams are truncated.
+	 * \param from The sender address.
+	 * \return The datagram size or -1 when no datagram is pending.
+	 */
+	int Receive(void *data, unsigned int size, KX_NetworkAddress& from);
+};
+
+#endif  // __KX_NETWORKSOCKET_H__
@@ -0,0 +1,231 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_NetworkStream.h
+ *  \ingroup ketsjinet
+ *  \brief Byte streams of the network datagrams.
+ */
+
+#ifndef __KX_NETWORKSTREAM_H__
+#define __KX_NETWORKSTREAM_H__
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+
+/** Write the values of a datagram in little endian order. The integers can be written
+ * as variable length integers, using 7 bits per byte, the signed ones being zigzag
+ * encoded to keep the small negative deltas short.
+ */
+class KX_NetworkWriter
+{
+private:
+	std::vector<unsigned char>& m_data;
+
+public:
+	KX_NetworkWriter(std::vector<unsigned char>& data)
+		:m_data(data)
+	{
+	}
+
+	unsigned int GetSize() const
+	{
+		return m_data.size();
+	}
+
+	void WriteByte(unsigned char value)
+	{
+		m_data.push_back(value);
+	}
+
+	void WriteUInt16(uint16_t value)
+	{
+		m_data.push_back(value & 0xFF);
+		m_data.push_back(value >> 8);
+	}
+
+	void WriteUInt32(uint32_t value)
+	{
+		for (unsigned short i = 0; i < 4; ++i) {
+			m_data.push_back((value >> (i * 8)) & 0xFF);
+		}
+	}
+
+	void WriteFloat(float value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		WriteUInt32(bits);
+	}
+
+	void WriteVarInt(uint64_t value)
+	{
+		while (value >= 0x80) {
+			m_data.push_back((value & 0x7F) | 0x80);
+			value >>= 7;
+		}
+		m_data.push_back(value);
+	}
+
+	void WriteSignedVarInt(int64_t value)
+	{
+		WriteVarInt(((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+	}
+
+	void WriteString(const std::string& str)
+	{
+		WriteVarInt(str.size());
+		m_data.insert(m_data.end(), str.begin(), str.end());
+	}
+
+	void WriteData(const void *data, unsigned int size)
+	{
+		const unsigned char *bytes = (const unsigned char *)data;
+		m_data.insert(m_data.end(), bytes, bytes + size);
+	}
+
+	/// Overwrite a byte written previously.
+	void SetByte(unsigned int offset, unsigned char value)
+	{
+		m_data[offset] = value;
+	}
+};
+
+/// Bounds checked reader of the values written by KX_NetworkWriter, all the reads fail after an invalid read.
+class KX_NetworkReader
+{
+private:
+	const unsigned char *m_data;
+	const unsigned char *m_end;
+	bool m_valid;
+
+	bool Check(unsigned int size)
+	{
+		if (!m_valid || (unsigned int)(m_end - m_data) < size) {
+			m_valid = false;
+		}
+		return m_valid;
+	}
+
+public:
+	KX_NetworkReader(const void *data, unsigned int size)
+		:m_data((const unsigned char *)data),
+		m_end((const unsigned char *)data + size),
+		m_valid(true)
+	{
+	}
+
+	bool IsValid() const
+	{
+		return m_valid;
+	}
+
+	/// Return true when all the data was read.
+	bool IsEnd() const
+	{
+		return (m_data == m_end);
+	}
+
+	bool ReadByte(unsigned char& value)
+	{
+		if (!Check(1)) {
+			return false;
+		}
+		value = *m_data++;
+		return true;
+	}
+
+	bool ReadUInt16(uint16_t& value)
+	{
+		if (!Check(2)) {
+			return false;
+		}
+		value = m_data[0] | (m_data[1] << 8);
+		m_data += 2;
+		return true;
+	}
+
+	bool ReadUInt32(uint32_t& value)
+	{
+		if (!Check(4)) {
+			return false;
+		}
+		value = 0;
+		for (unsigned short i = 0; i < 4; ++i) {
+			value |= (uint32_t)m_data[i] << (i * 8);
+		}
+		m_data += 4;
+		return true;
+	}
+
+	bool ReadFloat(float& value)
+	{
+		uint32_t bits;
+		if (!ReadUInt32(bits)) {
+			return false;
+		}
+		memcpy(&value, &bits, sizeof(value));
+		return true;
+	}
+
+	bool ReadVarInt(uint64_t& value)
+	{
+		value = 0;
+		for (unsigned short shift = 0; shift < 64; shift += 7) {
+			unsigned char byte;
+			if (!ReadByte(byte)) {
+				return false;
+			}
+			value |= (uint64_t)(byte & 0x7F) << shift;
+			if (!(byte & 0x80)) {
+				return true;
+			}
+		}
+		m_valid = false;
+		return false;
+	}
+
+	bool ReadSignedVarInt(int64_t& value)
+	{
+		uint64_t zigzag;
+		if (!ReadVarInt(zigzag)) {
+			return false;
+		}
+		value = (int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1);
+		return true;
+	}
+
+	bool ReadString(std::string& str)
+	{
+		uint64_t size;
+		if (!ReadVarInt(size) || size > (uint64_t)(m_end - m_data)) {
+			m_valid = false;
+			return false;
+		}
+		str.assign((const char *)m_data, size);
+		m_data += size;
+		return true;
+	}
+};
+
+#endif  // __KX_NETWORKSTREAM_H__
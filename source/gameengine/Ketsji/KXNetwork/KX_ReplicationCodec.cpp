@@ -0,0 +1,575 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KXNetwork/KX_ReplicationCodec.cpp
+ *  \ingroup ketsjinet
+ */
+
+#include "KX_ReplicationCodec.h"
+#include "KX_NetworkStream.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+enum RecordFlag {
+	RECORD_REMOVED = (1 << 0),
+	RECORD_FULL = (1 << 1),
+	RECORD_POSITION = (1 << 2),
+	RECORD_ORIENTATION = (1 << 3),
+	RECORD_SCALE = (1 << 4),
+	RECORD_PROPERTIES = (1 << 5)
+};
+
+/// Maximum size of the variable length id delta preceding a record.
+const unsigned int MAX_ID_SIZE = 5;
+/// Quantization steps per unit of the positions and scales.
+const float POSITION_PRECISION = 1024.0f;
+/// Range of the three smallest components of a normalized quaternion.
+const float ORIENTATION_RANGE = 0.70710678f;
+const unsigned int ORIENTATION_STEPS = (1 << 10) - 1;
+
+void WritePropertyValue(KX_NetworkWriter& writer, unsigned char type, const long long number,
+                        const std::string& text, long long base)
+{
+	switch (type) {
+		case KX_ReplicationCodec::PROPERTY_FLOAT:
+		{
+			writer.WriteUInt32(number);
+			break;
+		}
+		case KX_ReplicationCodec::PROPERTY_STRING:
+		{
+			writer.WriteString(text);
+			break;
+		}
+		default:
+		{
+			writer.WriteSignedVarInt(number - base);
+			break;
+		}
+	}
+}
+
+bool ReadPropertyValue(KX_NetworkReader& reader, unsigned char type, long long& number, std::string& text,
+                       long long base)
+{
+	switch (type) {
+		case KX_ReplicationCodec::PROPERTY_FLOAT:
+		{
+			uint32_t bits;
+			if (!reader.ReadUInt32(bits)) {
+				return false;
+			}
+			number = bits;
+			return true;
+		}
+		case KX_ReplicationCodec::PROPERTY_STRING:
+		{
+			return reader.ReadString(text);
+		}
+		default:
+		{
+			int64_t delta;
+			if (!reader.ReadSignedVarInt(delta)) {
+				return false;
+			}
+			number = base + delta;
+			return true;
+		}
+	}
+}
+
+}
+
+KX_ReplicationCodec::History::History()
+{
+	Clear();
+}
+
+void KX_ReplicationCodec::History::Clear()
+{
+	for (Snapshot& snapshot : m_snapshots) {
+		snapshot.id = 0;
+		snapshot.entities.clear();
+	}
+}
+
+KX_ReplicationCodec::Snapshot& KX_ReplicationCodec::History::Add(unsigned int id, double time)
+{
+	Snapshot& snapshot = m_snapshots[id % HISTORY_SIZE];
+	snapshot.id = id;
+	snapshot.time = time;
+	snapshot.entities.clear();
+	return snapshot;
+}
+
+const KX_ReplicationCodec::Snapshot *KX_ReplicationCodec::History::Find(unsigned int id) const
+{
+	const Snapshot& snapshot = m_snapshots[id % HISTORY_SIZE];
+	return (id != 0 && snapshot.id == id) ? &snapshot : nullptr;
+}
+
+void KX_ReplicationCodec::QuantizeVector(const mt::vec3& vec, int quantized[3])
+{
+	for (unsigned short i = 0; i < 3; ++i) {
+		const float value = std::max(-2.0e9f, std::min(2.0e9f, vec[i] * POSITION_PRECISION));
+		quantized[i] = (int)std::lround(value);
+	}
+}
+
+mt::vec3 KX_ReplicationCodec::DequantizeVector(const int quantized[3])
+{
+	return mt::vec3(quantized[0], quantized[1], quantized[2]) / POSITION_PRECISION;
+}
+
+unsigned int KX_ReplicationCodec::QuantizeOrientation(const mt::mat3& mat)
+{
+	float quat[4];
+	mt::quat::FromMatrix(mat).Normalized().Pack(quat);
+
+	unsigned short largest = 0;
+	for (unsigned short i = 1; i < 4; ++i) {
+		if (std::fabs(quat[i]) > std::fabs(quat[largest])) {
+			largest = i;
+		}
+	}
+
+	const float sign = (quat[largest] < 0.0f) ? -1.0f : 1.0f;
+	unsigned int packed = largest;
+	unsigned short shift = 2;
+	for (unsigned short i = 0; i < 4; ++i) {
+		if (i == largest) {
+			continue;
+		}
+		const float factor = (quat[i] * sign / ORIENTATION_RANGE + 1.0f) * 0.5f;
+		const unsigned int value = std::min(ORIENTATION_STEPS, (unsigned int)std::max(0.0f, factor * ORIENTATION_STEPS + 0.5f));
+		packed |= value << shift;
+		shift += 10;
+	}
+
+	return packed;
+}
+
+mt::mat3 KX_ReplicationCodec::DequantizeOrientation(unsigned int packed)
+{
+	const unsigned short largest = packed & 0x3;
+	float quat[4];
+	float sum = 0.0f;
+	unsigned short shift = 2;
+	for (unsigned short i = 0; i < 4; ++i) {
+		if (i == largest) {
+			continue;
+		}
+		const unsigned int value = (packed >> shift) & ORIENTATION_STEPS;
+		quat[i] = ((float)value / ORIENTATION_STEPS * 2.0f - 1.0f) * ORIENTATION_RANGE;
+		sum += quat[i] * quat[i];
+		shift += 10;
+	}
+	quat[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+
+	return mt::quat(quat[0], quat[1], quat[2], quat[3]).Normalized().ToMatrix();
+}
+
+bool KX_ReplicationCodec::IsInInterest(const EntityState& state, const mt::vec3& position, float radius)
+{
+	if (radius <= 0.0f) {
+		return true;
+	}
+
+	return ((state.worldPosition - position).LengthSquared() <= (radius * radius));
+}
+
+unsigned int KX_ReplicationCodec::UpdateAck(const History& history, unsigned int ackedId, unsigned int receivedId)
+{
+	if (receivedId == 0) {
+		return 0;
+	}
+
+	if (receivedId > ackedId && history.Find(receivedId)) {
+		return receivedId;
+	}
+
+	return ackedId;
+}
+
+const KX_ReplicationCodec::Snapshot *KX_ReplicationCodec::SelectBaseline(const History& history, unsigned int ackedId,
+                                                                         unsigned int id)
+{
+	if ((id - ackedId) >= HISTORY_SIZE) {
+		return nullptr;
+	}
+
+	return history.Find(ackedId);
+}
+
+void KX_ReplicationCodec::WriteFullRecord(KX_NetworkWriter& writer, const EntityState& state)
+{
+	const EntityLayout& layout = *state.layout;
+	writer.WriteByte(RECORD_FULL);
+	writer.WriteString(layout.name);
+	writer.WriteVarInt(layout.propertyNames.size());
+	for (unsigned int k = 0, size = layout.propertyNames.size(); k < size; ++k) {
+		writer.WriteString(layout.propertyNames[k]);
+		writer.WriteByte(layout.propertyTypes[k]);
+	}
+	for (unsigned short k = 0; k < 3; ++k) {
+		writer.WriteSignedVarInt(state.position[k]);
+	}
+	writer.WriteUInt32(state.orientation);
+	for (unsigned short k = 0; k < 3; ++k) {
+		writer.WriteSignedVarInt(state.scale[k]);
+	}
+	for (unsigned int k = 0, size = state.properties.size(); k < size; ++k) {
+		const PropertyValue& value = state.properties[k];
+		WritePropertyValue(writer, layout.propertyTypes[k], value.number, value.text, 0);
+	}
+}
+
+bool KX_ReplicationCodec::AddRecord(unsigned int id, unsigned int& previousId)
+{
+	if (m_packets.empty() || (m_packets.back().size() + MAX_ID_SIZE + m_record.size()) > MAX_DATAGRAM_SIZE) {
+		if (m_packets.size() == MAX_PARTS || (HEADER_SIZE + MAX_ID_SIZE + m_record.size()) > MAX_DATAGRAM_SIZE) {
+			return false;
+		}
+
+		// The header is written once the number of packets is known.
+		m_packets.emplace_back(HEADER_SIZE, 0);
+		previousId = 0;
+	}
+
+	KX_NetworkWriter writer(m_packets.back());
+	writer.WriteVarInt(id - previousId);
+	writer.WriteData(m_record.data(), m_record.size());
+	previousId = id;
+
+	return true;
+}
+
+void KX_ReplicationCodec::Encode(const std::vector<EntityState>& states, const Snapshot *baseline,
+                                 const mt::vec3& interestPosition, float interestRadius, Snapshot& snapshot)
+{
+	const std::vector<EntityState> noEntities;
+	const std::vector<EntityState>& baseEntities = baseline ? baseline->entities : noEntities;
+
+	snapshot.entities.clear();
+	m_packets.clear();
+	KX_NetworkWriter recordWriter(m_record);
+	unsigned int previousId = 0;
+
+	// Merge the current states with the baseline states, both sorted by id.
+	for (unsigned int i = 0, j = 0, curSize = states.size(), baseSize = baseEntities.size(); i < curSize || j < baseSize;) {
+		const EntityState *state = (i < curSize) ? &states[i] : nullptr;
+		const EntityState *base = (j < baseSize) ? &baseEntities[j] : nullptr;
+		m_record.clear();
+
+		if (state && (!base || state->id < base->id)) {
+			// New object for the client.
+			++i;
+			if (!IsInInterest(*state, interestPosition, interestRadius)) {
+				continue;
+			}
+
+			WriteFullRecord(recordWriter, *state);
+			if (AddRecord(state->id, previousId)) {
+				snapshot.entities.push_back(*state);
+			}
+			continue;
+		}
+
+		if (!state || base->id < state->id || !IsInInterest(*state, interestPosition, interestRadius)) {
+			if (state && state->id == base->id) {
+				++i;
+			}
+			++j;
+
+			// Object removed or out of interest.
+			recordWriter.WriteByte(RECORD_REMOVED);
+			if (!AddRecord(base->id, previousId)) {
+				snapshot.entities.push_back(*base);
+			}
+			continue;
+		}
+
+		++i;
+		++j;
+
+		// The objects with a changed name or properties are sent again entirely.
+		if (state->layout != base->layout) {
+			WriteFullRecord(recordWriter, *state);
+			snapshot.entities.push_back(AddRecord(state->id, previousId) ? *state : *base);
+			continue;
+		}
+
+		unsigned char flag = 0;
+		if (memcmp(state->position, base->position, sizeof(state->position)) != 0) {
+			flag |= RECORD_POSITION;
+		}
+		if (state->orientation != base->orientation) {
+			flag |= RECORD_ORIENTATION;
+		}
+		if (memcmp(state->scale, base->scale, sizeof(state->scale)) != 0) {
+			flag |= RECORD_SCALE;
+		}
+
+		const unsigned int numProperties = state->properties.size();
+		m_changedProperties.assign((numProperties + 7) / 8, 0);
+		for (unsigned int k = 0; k < numProperties; ++k) {
+			const PropertyValue& value = state->properties[k];
+			const PropertyValue& baseValue = base->properties[k];
+			if (value.number != baseValue.number || value.text != baseValue.text) {
+				m_changedProperties[k / 8] |= (1 << (k % 8));
+				flag |= RECORD_PROPERTIES;
+			}
+		}
+
+		// Unchanged objects are not sent.
+		if (flag == 0) {
+			snapshot.entities.push_back(*state);
+			continue;
+		}
+
+		recordWriter.WriteByte(flag);
+		if (flag & RECORD_POSITION) {
+			for (unsigned short k = 0; k < 3; ++k) {
+				recordWriter.WriteSignedVarInt((int64_t)state->position[k] - base->position[k]);
+			}
+		}
+		if (flag & RECORD_ORIENTATION) {
+			recordWriter.WriteUInt32(state->orientation);
+		}
+		if (flag & RECORD_SCALE) {
+			for (unsigned short k = 0; k < 3; ++k) {
+				recordWriter.WriteSignedVarInt((int64_t)state->scale[k] - base->scale[k]);
+			}
+		}
+		if (flag & RECORD_PROPERTIES) {
+			recordWriter.WriteData(m_changedProperties.data(), m_changedProperties.size());
+			for (unsigned int k = 0; k < numProperties; ++k) {
+				if (m_changedProperties[k / 8] & (1 << (k % 8))) {
+					const PropertyValue& value = state->properties[k];
+					WritePropertyValue(recordWriter, state->layout->propertyTypes[k], value.number, value.text,
+					                   base->properties[k].number);
+				}
+			}
+		}
+
+		snapshot.entities.push_back(AddRecord(state->id, previousId) ? *state : *base);
+	}
+
+	// An empty snapshot is still sent to be acknowledged.
+	if (m_packets.empty()) {
+		m_packets.emplace_back(HEADER_SIZE, 0);
+	}
+}
+
+std::vector<std::vector<unsigned char> >& KX_ReplicationCodec::GetPackets()
+{
+	return m_packets;
+}
+
+void KX_ReplicationCodec::WriteHeader(KX_NetworkWriter& writer, const Header& header)
+{
+	writer.WriteUInt32(header.id);
+	writer.WriteUInt32(header.baselineId);
+	writer.WriteUInt32(header.session);
+	writer.WriteByte(header.part);
+	writer.WriteByte(header.count);
+	writer.WriteUInt16(header.roundTripTime);
+}
+
+bool KX_ReplicationCodec::ReadHeader(KX_NetworkReader& reader, Header& header)
+{
+	uint32_t id;
+	uint32_t baselineId;
+	uint32_t session;
+	uint16_t roundTripTime;
+	if (!reader.ReadUInt32(id) || !reader.ReadUInt32(baselineId) || !reader.ReadUInt32(session) ||
+	    !reader.ReadByte(header.part) || !reader.ReadByte(header.count) || !reader.ReadUInt16(roundTripTime) ||
+	    header.part >= header.count)
+	{
+		return false;
+	}
+
+	header.id = id;
+	header.baselineId = baselineId;
+	header.session = session;
+	header.roundTripTime = roundTripTime;
+
+	return true;
+}
+
+bool KX_ReplicationCodec::DecodeRecords(KX_NetworkReader& reader, const Snapshot *baseline, std::vector<Record>& records)
+{
+	unsigned int previousId = 0;
+	while (!reader.IsEnd()) {
+		uint64_t delta;
+		unsigned char flag;
+		if (!reader.ReadVarInt(delta) || !reader.ReadByte(flag)) {
+			return false;
+		}
+
+		records.emplace_back();
+		Record& record = records.back();
+		EntityState& state = record.state;
+		record.removed = (flag & RECORD_REMOVED);
+		previousId += delta;
+
+		if (record.removed) {
+			state.id = previousId;
+		}
+		else if (flag & RECORD_FULL) {
+			std::shared_ptr<EntityLayout> layout = std::make_shared<EntityLayout>();
+			uint64_t numProperties;
+			if (!reader.ReadString(layout->name) || !reader.ReadVarInt(numProperties) || numProperties > MAX_PROPERTIES) {
+				return false;
+			}
+
+			layout->propertyNames.resize(numProperties);
+			layout->propertyTypes.resize(numProperties);
+			for (unsigned int i = 0; i < numProperties; ++i) {
+				if (!reader.ReadString(layout->propertyNames[i]) || !reader.ReadByte(layout->propertyTypes[i]) ||
+				    layout->propertyTypes[i] >= PROPERTY_MAX)
+				{
+					return false;
+				}
+			}
+
+			int64_t values[6] = {0};
+			for (unsigned short i = 0; i < 3; ++i) {
+				reader.ReadSignedVarInt(values[i]);
+			}
+			reader.ReadUInt32(state.orientation);
+			for (unsigned short i = 3; i < 6; ++i) {
+				reader.ReadSignedVarInt(values[i]);
+			}
+			for (unsigned short i = 0; i < 3; ++i) {
+				state.position[i] = values[i];
+				state.scale[i] = values[i + 3];
+			}
+
+			state.properties.resize(numProperties);
+			for (unsigned int i = 0; i < numProperties; ++i) {
+				PropertyValue& value = state.properties[i];
+				if (!ReadPropertyValue(reader, layout->propertyTypes[i], value.number, value.text, 0)) {
+					return false;
+				}
+			}
+
+			state.id = previousId;
+			state.layout = layout;
+		}
+		else {
+			// Delta against the baseline state.
+			if (!baseline) {
+				return false;
+			}
+			const std::vector<EntityState>& entities = baseline->entities;
+			const unsigned int id = previousId;
+			const std::vector<EntityState>::const_iterator it = std::lower_bound(entities.begin(), entities.end(), id,
+				[](const EntityState& base, unsigned int id) {
+				return base.id < id;
+			});
+			if (it == entities.end() || it->id != id) {
+				return false;
+			}
+
+			state = *it;
+			if (flag & RECORD_POSITION) {
+				for (unsigned short i = 0; i < 3; ++i) {
+					int64_t delta = 0;
+					reader.ReadSignedVarInt(delta);
+					state.position[i] += delta;
+				}
+			}
+			if (flag & RECORD_ORIENTATION) {
+				reader.ReadUInt32(state.orientation);
+			}
+			if (flag & RECORD_SCALE) {
+				for (unsigned short i = 0; i < 3; ++i) {
+					int64_t delta = 0;
+					reader.ReadSignedVarInt(delta);
+					state.scale[i] += delta;
+				}
+			}
+			if (flag & RECORD_PROPERTIES) {
+				const unsigned int numProperties = state.properties.size();
+				std::vector<unsigned char> changedProperties((numProperties + 7) / 8);
+				for (unsigned char& byte : changedProperties) {
+					reader.ReadByte(byte);
+				}
+				for (unsigned int i = 0; i < numProperties; ++i) {
+					if (changedProperties[i / 8] & (1 << (i % 8))) {
+						PropertyValue& value = state.properties[i];
+						if (!ReadPropertyValue(reader, state.layout->propertyTypes[i], value.number, value.text, value.number)) {
+							return false;
+						}
+					}
+				}
+			}
+		}
+
+		// All the reads fail after an invalid read.
+		if (!reader.IsValid()) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void KX_ReplicationCodec::SortRecords(std::vector<Record>& records)
+{
+	std::sort(records.begin(), records.end(), [](const Record& a, const Record& b) {
+		return a.state.id < b.state.id;
+	});
+}
+
+void KX_ReplicationCodec::MergeRecords(std::vector<Record>& records, const Snapshot *baseline,
+                                       std::vector<EntityState>& entities)
+{
+	const std::vector<EntityState> noEntities;
+	const std::vector<EntityState>& baseEntities = baseline ? baseline->entities : noEntities;
+	entities.clear();
+	entities.reserve(baseEntities.size() + records.size());
+	for (unsigned int i = 0, j = 0, recordSize = records.size(), baseSize = baseEntities.size();
+	     i < recordSize || j < baseSize;)
+	{
+		Record *record = (i < recordSize) ? &records[i] : nullptr;
+		const EntityState *base = (j < baseSize) ? &baseEntities[j] : nullptr;
+		if (record && (!base || record->state.id <= base->id)) {
+			if (base && record->state.id == base->id) {
+				++j;
+			}
+			++i;
+			if (!record->removed) {
+				entities.push_back(std::move(record->state));
+			}
+		}
+		else {
+			++j;
+			entities.push_back(*base);
+		}
+	}
+}
@@ -0,0 +1,201 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_ReplicationCodec.h
+ *  \ingroup ketsjinet
+ *  \brief Encoding of the snapshots sent by the scene replication.
+ */
+
+#ifndef __KX_REPLICATIONCODEC_H__
+#define __KX_REPLICATIONCODEC_H__
+
+#include "mathfu.h"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+class KX_NetworkWriter;
+class KX_NetworkReader;
+
+/** Quantization and delta encoding of the snapshots of the replicated objects,
+ * independent of the scene to be used by the server and the clients.
+ *
+ * A snapshot is split in packets of at most MAX_DATAGRAM_SIZE bytes, each packet
+ * starts with a header followed by the records of the objects sorted by id. A
+ * record is either a full object, a removed object or the changed values of an
+ * object of the baseline snapshot.
+ */
+class KX_ReplicationCodec
+{
+public:
+	enum PropertyType {
+		PROPERTY_INT = 0,
+		PROPERTY_FLOAT,
+		PROPERTY_BOOL,
+		PROPERTY_STRING,
+		PROPERTY_MAX
+	};
+
+	enum {
+		/// Number of snapshots kept to decode the deltas.
+		HISTORY_SIZE = 32,
+		MAX_DATAGRAM_SIZE = 1200,
+		/// Packet type and snapshot header.
+		HEADER_SIZE = 20,
+		MAX_PARTS = 255,
+		MAX_PROPERTIES = 1024
+	};
+
+	/// Name and properties of a replicated object, shared by the states while unchanged.
+	struct EntityLayout
+	{
+		std::string name;
+		std::vector<std::string> propertyNames;
+		/// Values of PropertyType.
+		std::vector<unsigned char> propertyTypes;
+	};
+
+	struct PropertyValue
+	{
+		/// Integer, boolean or float bits.
+		long long number;
+		std::string text;
+	};
+
+	struct EntityState
+	{
+		unsigned int id;
+		int position[3];
+		unsigned int orientation;
+		int scale[3];
+		/// Used for the interest management on the server.
+		mt::vec3 worldPosition;
+		std::shared_ptr<EntityLayout> layout;
+		std::vector<PropertyValue> properties;
+	};
+
+	struct Snapshot
+	{
+		unsigned int id;
+		double time;
+		/// States sorted by id.
+		std::vector<EntityState> entities;
+	};
+
+	/// Decoded record of a snapshot packet.
+	struct Record
+	{
+		bool removed;
+		EntityState state;
+	};
+
+	struct Header
+	{
+		unsigned int id;
+		/// Id of the snapshot the records are delta encoded against, 0 for none.
+		unsigned int baselineId;
+		/// Random id of the server run, the snapshot ids start again with a new session.
+		unsigned int session;
+		unsigned char part;
+		unsigned char count;
+		/// Round trip time in milliseconds.
+		unsigned short roundTripTime;
+	};
+
+	/// Last snapshots indexed by id.
+	class History
+	{
+	private:
+		Snapshot m_snapshots[HISTORY_SIZE];
+
+	public:
+		History();
+
+		void Clear();
+		/// Return the cleared slot of a new snapshot, it replaces the snapshot HISTORY_SIZE ids older.
+		Snapshot& Add(unsigned int id, double time);
+		/// Return a kept snapshot or nullptr.
+		const Snapshot *Find(unsigned int id) const;
+	};
+
+private:
+	std::vector<std::vector<unsigned char> > m_packets;
+	std::vector<unsigned char> m_record;
+	std::vector<unsigned char> m_changedProperties;
+
+	bool AddRecord(unsigned int id, unsigned int& previousId);
+	void WriteFullRecord(KX_NetworkWriter& writer, const EntityState& state);
+
+public:
+	/// Quantize a position or a scale in 1/1024 units.
+	static void QuantizeVector(const mt::vec3& vec, int quantized[3]);
+	static mt::vec3 DequantizeVector(const int quantized[3]);
+
+	/** Pack a rotation in 32 bits: the index of the largest quaternion component in 2 bits
+	 * followed by the three other components in 10 bits, the largest component is computed back
+	 * from the normalization and its sign is made positive.
+	 */
+	static unsigned int QuantizeOrientation(const mt::mat3& mat);
+	static mt::mat3 DequantizeOrientation(unsigned int packed);
+
+	/// Return true if a state is in the interest radius of a position, a radius of 0 has no limit.
+	static bool IsInInterest(const EntityState& state, const mt::vec3& position, float radius);
+
+	/** Return the acknowledged snapshot id of a client after receiving an acknowledgment.
+	 * The acknowledgments of older or unsent snapshots are ignored, 0 is the acknowledgment
+	 * of a restarted client and resets it to full snapshots.
+	 */
+	static unsigned int UpdateAck(const History& history, unsigned int ackedId, unsigned int receivedId);
+	/** Return the baseline of a new snapshot for a client, nullptr when the acknowledged snapshot is
+	 * not kept or its slot is the one of the new snapshot.
+	 */
+	static const Snapshot *SelectBaseline(const History& history, unsigned int ackedId, unsigned int id);
+
+	/** Encode the states of a snapshot in packets.
+	 * \param states The current states sorted by id.
+	 * \param baseline The last snapshot acknowledged by the client or nullptr.
+	 * \param snapshot The states as received by the client, used as baseline of the next snapshots.
+	 * The states not fitting in the packets are kept to their baseline value, or omitted when new.
+	 */
+	void Encode(const std::vector<EntityState>& states, const Snapshot *baseline, const mt::vec3& interestPosition,
+	            float interestRadius, Snapshot& snapshot);
+	/// Return the encoded packets, their first HEADER_SIZE bytes are reserved for the header.
+	std::vector<std::vector<unsigned char> >& GetPackets();
+
+	/// Write the header after the packet type.
+	static void WriteHeader(KX_NetworkWriter& writer, const Header& header);
+	/// Read the header after the packet type.
+	static bool ReadHeader(KX_NetworkReader& reader, Header& header);
+
+	/** Decode the records following the header of a packet.
+	 * \return False for an invalid packet or a delta without its baseline state.
+	 */
+	static bool DecodeRecords(KX_NetworkReader& reader, const Snapshot *baseline, std::vector<Record>& records);
+	/// Sort the records of all the packets of a snapshot by id.
+	static void SortRecords(std::vector<Record>& records);
+	/// Merge the sorted records with the baseline states, the record states are moved.
+	static void MergeRecords(std::vector<Record>& records, const Snapshot *baseline, std::vector<EntityState>& entities);
+};
+
+#endif  // __KX_REPLICATIONCODEC_H__
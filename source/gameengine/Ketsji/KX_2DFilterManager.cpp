@@ -27,6 +27,8 @@
 #include "KX_2DFilterManager.h"
 #include "KX_2DFilter.h"
 #include "KX_2DFilterOffScreen.h"
+#include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
 
 #include "CM_Message.h"
 
@@ -106,6 +108,12 @@ EXP_PYMETHODDEF_DOC(KX_2DFilterManager, addFilter, " addFilter(index, type, frag
 		return nullptr;
 	}
 
+	// The filters shaders can't be compiled without rasterizer.
+	if (!KX_GetActiveEngine()->GetRasterizer()) {
+		PyErr_SetString(PyExc_RuntimeError, "filterManager.addFilter(index, type, fragmentProgram): KX_2DFilterManager, Rasterizer not available");
+		return nullptr;
+	}
+
 	if (GetFilterPass(index)) {
 		PyErr_Format(PyExc_ValueError, "filterManager.addFilter(index, type, fragmentProgram): KX_2DFilterManager, found existing filter in index (%i)", index);
 		return nullptr;
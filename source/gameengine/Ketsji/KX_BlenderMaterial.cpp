@@ -41,14 +41,15 @@
 #include "DNA_material_types.h"
 #include "DNA_scene_types.h"
 
-KX_BlenderMaterial::KX_BlenderMaterial(Material *mat, const std::string& name, int lightlayer)
+KX_BlenderMaterial::KX_BlenderMaterial(Material *mat, const std::string& name, int lightlayer, bool useGpu)
 	:RAS_IPolyMaterial(name),
 	m_material(mat),
 	m_shader(nullptr),
 	m_blenderShader(nullptr),
 	m_scene(nullptr),
 	m_userDefBlend(false),
-	m_lightLayer(lightlayer)
+	m_lightLayer(lightlayer),
+	m_useGpu(useGpu)
 {
 	// Save material data to restore on exit
 	m_savedData.r = m_material->r;
@@ -119,7 +120,9 @@ KX_BlenderMaterial::KX_BlenderMaterial(Material *mat, const std::string& name, i
 	m_blendFunc[0] = RAS_Rasterizer::RAS_ZERO;
 	m_blendFunc[1] = RAS_Rasterizer::RAS_ZERO;
 
-	InitTextures();
+	if (m_useGpu) {
+		InitTextures();
+	}
 }
 
 KX_BlenderMaterial::~KX_BlenderMaterial()
@@ -215,6 +218,10 @@ void KX_BlenderMaterial::InitScene(KX_Scene *scene)
 {
 	m_scene = scene;
 
+	if (!m_useGpu) {
+		return;
+	}
+
 	if (!m_blenderShader) {
 		m_blenderShader = new BL_BlenderShader(m_scene, m_material, m_lightLayer, this);
 	}
@@ -851,6 +858,10 @@ EXP_PYMETHODDEF_DOC(KX_BlenderMaterial, getShader, "getShader()")
 	// returns Py_None on error
 	// the calling script will need to check
 
+	if (!m_useGpu) {
+		Py_RETURN_NONE;
+	}
+
 	if (!m_shader) {
 		m_shader = new BL_Shader(this);
 	}
@@ -26,7 +26,10 @@ class KX_BlenderMaterial : public EXP_Value, public RAS_IPolyMaterial
 	Py_Header
 
 public:
-	KX_BlenderMaterial(Material *mat, const std::string& name, int lightlayer);
+	/** \param useGpu Set to false when the engine runs without rasterizer,
+	 * no textures or shaders are created in this case.
+	 */
+	KX_BlenderMaterial(Material *mat, const std::string& name, int lightlayer, bool useGpu);
 
 	virtual ~KX_BlenderMaterial();
 
@@ -50,7 +53,7 @@ public:
 	virtual void ReloadMaterial();
 
 	/** Set scene owning this material and generate blender shader using
-	 * scene lights.
+	 * scene lights, the shader is not generated without GPU.
 	 * \param scene The scene material owner.
 	 */
 	void InitScene(KX_Scene *scene);
@@ -107,6 +110,8 @@ private:
 	bool m_userDefBlend;
 	RAS_Rasterizer::BlendFunc m_blendFunc[2];
 	int m_lightLayer;
+	/// False when running without rasterizer.
+	bool m_useGpu;
 
 	struct {
 		float r, g, b, a;
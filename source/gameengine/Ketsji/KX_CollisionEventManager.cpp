@@ -53,13 +53,15 @@ KX_CollisionEventManager::~KX_CollisionEventManager()
 
 void KX_CollisionEventManager::RemoveNewCollisions()
 {
+	// Keep the capacity for the next frame.
 	m_newCollisions.clear();
+	m_physEnv->ReleaseCollisionData();
 }
 
 bool KX_CollisionEventManager::NewHandleCollision(PHY_IPhysicsController *ctrl1, PHY_IPhysicsController *ctrl2,
 		const PHY_ICollData *coll_data, bool first)
 {
-	m_newCollisions.insert(NewCollision(ctrl1, ctrl2, coll_data, first));
+	m_newCollisions.emplace_back(ctrl1, ctrl2, coll_data, first);
 
 	return false;
 }
@@ -204,9 +206,7 @@ void KX_CollisionEventManager::NextFrame()
 		kxObj2->RunCollisionCallbacks(kxObj1, contactPointList1);
 	}
 
-	for (SCA_ISensor *sensor : m_sensors) {
-		sensor->Activate(m_logicmgr);
-	}
+	ActivateSensors();
 
 	RemoveNewCollisions();
 }
@@ -237,18 +237,3 @@ KX_CollisionEventManager::NewCollision::NewCollision(const NewCollision &to_copy
 	isFirst(to_copy.isFirst)
 {
 }
-
-bool KX_CollisionEventManager::NewCollision::operator<(const NewCollision &other) const
-{
-	// See strict weak ordering: https://support.microsoft.com/en-us/kb/949171.
-	if (first == other.first) {
-		if (second == other.second) {
-			if (colldata == other.colldata) {
-				return isFirst < other.isFirst;
-			}
-			return colldata < other.colldata;
-		}
-		return second < other.second;
-	}
-	return first < other.first;
-}
@@ -38,7 +38,6 @@
 #include "KX_GameObject.h"
 
 #include <vector>
-#include <set>
 
 class SCA_ISensor;
 class PHY_IPhysicsEnvironment;
@@ -57,19 +56,16 @@ class KX_CollisionEventManager : public SCA_EventManager
 		bool isFirst;
 
 		/**
-		 * Creates a copy of the given PHY_ICollData; freeing that copy should be done by the owner of
-		 * the NewCollision object.
-		 *
-		 * This allows us to efficiently store NewCollision objects in a std::set without creating more
-		 * copies of colldata, as the NewCollision copy constructor reuses the pointer and doesn't clone
-		 * it again. */
+		 * The PHY_ICollData is owned by the physics environment and valid until
+		 * PHY_IPhysicsEnvironment::ReleaseCollisionData is called after the dispatch.
+		 */
 		NewCollision(PHY_IPhysicsController *first, PHY_IPhysicsController *second, const PHY_ICollData *colldata, bool isFirst);
 		NewCollision(const NewCollision &to_copy);
-		bool operator<(const NewCollision &other) const;
 	};
 
 	PHY_IPhysicsEnvironment *m_physEnv;
-	std::set<NewCollision> m_newCollisions;
+	/// Collisions of the last physics step, the physics environment reports a manifold only once.
+	std::vector<NewCollision> m_newCollisions;
 
 	static bool newCollisionResponse(void *client_data, PHY_IPhysicsController *ctrl1, PHY_IPhysicsController *ctrl2,
 									 const PHY_ICollData *coll_data, bool first);
@@ -71,6 +71,11 @@ void KX_CollisionSensor::UnregisterToManager()
 	SCA_ISensor::UnregisterToManager();
 }
 
+bool KX_CollisionSensor::IsEventDriven() const
+{
+	return true;
+}
+
 bool KX_CollisionSensor::Evaluate()
 {
 	bool result = false;
@@ -97,6 +102,12 @@ bool KX_CollisionSensor::Evaluate()
 			result = true;
 		}
 	}
+
+	// Detect the end of the collision at the next frame.
+	if (m_bTriggered) {
+		Wake();
+	}
+
 	return result;
 }
 
@@ -270,6 +281,7 @@ bool KX_CollisionSensor::NewHandleCollision(PHY_IPhysicsController *ctrl1, PHY_I
 			m_bTriggered = true;
 			m_hitObject = gameobj;
 			m_hitMaterial = hitMaterial;
+			Wake();
 		}
 
 	}
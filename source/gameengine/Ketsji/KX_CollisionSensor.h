@@ -88,6 +88,7 @@ public:
 	virtual void SynchronizeTransform();
 	virtual bool Evaluate();
 	virtual void Init();
+	virtual bool IsEventDriven() const;
 	virtual void ReParent(SCA_IObject *parent);
 
 	virtual void RegisterSumo(KX_CollisionEventManager *collisionman);
@@ -3,37 +3,195 @@
 
 #include "SG_Node.h"
 
+#include "BLI_task.h"
+
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
+/// Minimum number of packets to test them in parallel.
+static const unsigned int parallelPackets = 256;
+
 KX_CullingHandler::KX_CullingHandler(std::vector<KX_GameObject *>& objects, const SG_Frustum& frustum)
 	:m_activeObjects(objects),
 	m_frustum(frustum)
 {
 }
 
-void KX_CullingHandler::Process(KX_GameObject *object)
+bool KX_CullingHandler::TestAabb(KX_GameObject *object) const
+{
+	const mt::mat3x4 trans = object->GetSGNode()->GetWorldTransform();
+	const SG_BBox& aabb = object->GetCullingNode()->GetAabb();
+
+	const mt::mat4 mat = mt::mat4::FromAffineTransform(trans);
+	return (m_frustum.AabbInsideFrustum(aabb.GetMin(), aabb.GetMax(), mat) == SG_Frustum::OUTSIDE);
+}
+
+void KX_CullingHandler::Add(KX_GameObject *object)
 {
 	SG_Node *sgnode = object->GetSGNode();
 	SG_CullingNode *node = object->GetCullingNode();
 
-	const mt::mat3x4 trans = sgnode->GetWorldTransform();
-	const mt::vec3 &scale = sgnode->GetWorldScaling();
-	const SG_BBox& aabb = node->GetAabb();
+	// The world box is only updated for moved objects or modified bounding boxes.
+	if (node->GetAabbModified() || sgnode->IsDirty(SG_Node::DIRTY_CULLING)) {
+		node->UpdateWorldBox(sgnode->GetWorldTransform());
+		sgnode->ClearDirty(SG_Node::DIRTY_CULLING);
+	}
 
-	bool culled = true;
-	const float maxscale = std::max(std::max(fabs(scale.x), fabs(scale.y)), fabs(scale.z));
-	const SG_Frustum::TestType sphereTest = m_frustum.SphereInsideFrustum(trans * aabb.GetCenter(), maxscale * aabb.GetRadius());
+	const unsigned int lane = m_objects.size() % 4;
+	if (lane == 0) {
+		m_packets.push_back(BoxPacket());
+	}
 
-	// First test if the sphere is in the frustum as it is faster to test than box.
-	if (sphereTest == SG_Frustum::INSIDE) {
-		culled = false;
+	BoxPacket& packet = m_packets.back();
+	const mt::vec3& center = node->GetWorldCenter();
+	for (unsigned short i = 0; i < 3; ++i) {
+		packet.center[i][lane] = center[i];
+	}
+	for (unsigned short axis = 0; axis < 3; ++axis) {
+		const mt::vec3& vec = node->GetWorldAxis(axis);
+		for (unsigned short i = 0; i < 3; ++i) {
+			packet.axes[axis][i][lane] = vec[i];
+		}
 	}
-	// If the sphere intersects we made a box test because the box could be not homogeneous.
-	else if (sphereTest == SG_Frustum::INTERSECT) {
-		const mt::mat4 mat = mt::mat4::FromAffineTransform(trans);
-		culled = (m_frustum.AabbInsideFrustum(aabb.GetMin(), aabb.GetMax(), mat) == SG_Frustum::OUTSIDE);
+
+	m_objects.push_back(object);
+}
+
+/** Test four world boxes against the frustum planes. A box is outside if its center is
+ * behind a plane by more than the projection of its half axes on the plane normal, and
+ * inside if its center is in front of all the planes by at least this projection.
+ */
+static void test_packet(const std::array<mt::vec4, 6>& planes, const KX_CullingHandler::BoxPacket& packet,
+		unsigned char *results)
+{
+#ifdef __SSE2__
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	__m128 outside = zero;
+	__m128 inside = _mm_cmpeq_ps(zero, zero);
+
+	for (const mt::vec4& plane : planes) {
+		const __m128 nx = _mm_set1_ps(plane.x);
+		const __m128 ny = _mm_set1_ps(plane.y);
+		const __m128 nz = _mm_set1_ps(plane.z);
+
+		const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, _mm_load_ps(packet.center[0])),
+				_mm_mul_ps(ny, _mm_load_ps(packet.center[1]))),
+				_mm_add_ps(_mm_mul_ps(nz, _mm_load_ps(packet.center[2])), _mm_set1_ps(plane.w)));
+
+		__m128 radius = zero;
+		for (unsigned short axis = 0; axis < 3; ++axis) {
+			const __m128 proj = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, _mm_load_ps(packet.axes[axis][0])),
+					_mm_mul_ps(ny, _mm_load_ps(packet.axes[axis][1]))),
+					_mm_mul_ps(nz, _mm_load_ps(packet.axes[axis][2])));
+			radius = _mm_add_ps(radius, _mm_andnot_ps(signMask, proj));
+		}
+
+		outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+		inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_sub_ps(distance, radius), zero));
 	}
 
-	node->SetCulled(culled);
-	if (!culled) {
-		m_activeObjects.push_back(object);
+	const int outsideMask = _mm_movemask_ps(outside);
+	const int insideMask = _mm_movemask_ps(inside);
+	for (unsigned short lane = 0; lane < 4; ++lane) {
+		if (outsideMask & (1 << lane)) {
+			results[lane] = SG_Frustum::OUTSIDE;
+		}
+		else if (insideMask & (1 << lane)) {
+			results[lane] = SG_Frustum::INSIDE;
+		}
+		else {
+			results[lane] = SG_Frustum::INTERSECT;
+		}
 	}
+#else
+	for (unsigned short lane = 0; lane < 4; ++lane) {
+		SG_Frustum::TestType result = SG_Frustum::INSIDE;
+		for (const mt::vec4& plane : planes) {
+			const float distance = plane.x * packet.center[0][lane] + plane.y * packet.center[1][lane] +
+			                       plane.z * packet.center[2][lane] + plane.w;
+
+			float radius = 0.0f;
+			for (unsigned short axis = 0; axis < 3; ++axis) {
+				radius += fabs(plane.x * packet.axes[axis][0][lane] + plane.y * packet.axes[axis][1][lane] +
+				               plane.z * packet.axes[axis][2][lane]);
+			}
+
+			if ((distance + radius) < 0.0f) {
+				result = SG_Frustum::OUTSIDE;
+				break;
+			}
+			else if ((distance - radius) < 0.0f) {
+				result = SG_Frustum::INTERSECT;
+			}
+		}
+
+		results[lane] = result;
+	}
+#endif
+}
+
+struct CullingTaskData
+{
+	const std::array<mt::vec4, 6> *planes;
+	const KX_CullingHandler::BoxPacket *packets;
+	unsigned char *results;
+};
+
+static void test_packet_task(void *userdata, const int iter)
+{
+	CullingTaskData *data = (CullingTaskData *)userdata;
+	test_packet(*data->planes, data->packets[iter], &data->results[iter * 4]);
+}
+
+void KX_CullingHandler::Process()
+{
+	const std::array<mt::vec4, 6>& planes = m_frustum.GetPlanes();
+	const unsigned int numPackets = m_packets.size();
+
+	m_results.resize(numPackets * 4);
+
+	if (numPackets >= parallelPackets) {
+		CullingTaskData data = {&planes, m_packets.data(), m_results.data()};
+		BLI_task_parallel_range(0, numPackets, &data, test_packet_task, true);
+	}
+	else {
+		for (unsigned int i = 0; i < numPackets; ++i) {
+			test_packet(planes, m_packets[i], &m_results[i * 4]);
+		}
+	}
+
+	for (unsigned int i = 0, size = m_objects.size(); i < size; ++i) {
+		KX_GameObject *object = m_objects[i];
+
+		bool culled;
+		switch (m_results[i]) {
+			case SG_Frustum::INSIDE:
+			{
+				culled = false;
+				break;
+			}
+			case SG_Frustum::OUTSIDE:
+			{
+				culled = true;
+				break;
+			}
+			default:
+			{
+				/* The world box is not exact for big objects intersecting two planes
+				 * outside of the frustum, the box test is able to cull them. */
+				culled = TestAabb(object);
+				break;
+			}
+		}
+
+		object->GetCullingNode()->SetCulled(culled);
+		if (!culled) {
+			m_activeObjects.push_back(object);
+		}
+	}
+
+	m_objects.clear();
+	m_packets.clear();
 }
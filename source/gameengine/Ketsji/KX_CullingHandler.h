@@ -8,20 +8,45 @@ class KX_GameObject;
 
 class KX_CullingHandler
 {
+public:
+	/// World bounding boxes of four objects, stored per component for the SIMD test.
+	struct BoxPacket
+	{
+		float center[3][4];
+		float axes[3][3][4];
+	};
+
 private:
 	/// List of all objects to render after the culling pass.
 	std::vector<KX_GameObject *>& m_activeObjects;
 	/// The camera frustum data.
 	const SG_Frustum& m_frustum;
 
+	/// Objects added for the batched culling test.
+	std::vector<KX_GameObject *> m_objects;
+	/// World boxes of m_objects, the last packet is padded with empty boxes.
+	std::vector<BoxPacket, mt::simd_allocator<BoxPacket> > m_packets;
+	/// Result of the test of each object of m_objects, a SG_Frustum::TestType.
+	std::vector<unsigned char> m_results;
+
+	/** Test the AABB of an object in its own space, used for the objects
+	 * intersecting the frustum planes after the world box test.
+	 * \return True if the object is culled.
+	 */
+	bool TestAabb(KX_GameObject *object) const;
+
 public:
 	KX_CullingHandler(std::vector<KX_GameObject *>& objects, const SG_Frustum& frustum);
 	~KX_CullingHandler() = default;
 
-	/** Process the culling of a new object, if the culling succeeded the
-	 * object is added in m_activeObjects.
+	/** Add an object to the culling pass, its world box is updated if
+	 * the object moved or its bounding box changed.
+	 */
+	void Add(KX_GameObject *object);
+	/** Process the culling of all the added objects by packets of four, if
+	 * the culling succeeded the object is added in m_activeObjects.
 	 */
-	void Process(KX_GameObject *object);
+	void Process();
 };
 
 #endif  // __KX_CULLING_HANDLER_H__
@@ -93,6 +93,7 @@
 #include "KX_NodeRelationships.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "CM_Message.h"
 
@@ -117,6 +118,8 @@ KX_GameObject::KX_GameObject(
 	m_bVisible(true),
 	m_bOccluder(false),
 	m_autoUpdateBounds(false),
+	m_replicated(false),
+	m_replicationId(0),
 	m_physicsController(nullptr),
 	m_graphicController(nullptr),
 	m_sgNode(new SG_Node(this,sgReplicationInfo,callbacks)),
@@ -150,6 +153,8 @@ KX_GameObject::KX_GameObject(const KX_GameObject& other)
 	m_bOccluder(other.m_bOccluder),
 	m_activityCullingInfo(other.m_activityCullingInfo),
 	m_autoUpdateBounds(other.m_autoUpdateBounds),
+	m_replicated(other.m_replicated),
+	m_replicationId(0),
 	m_physicsController(nullptr),
 	m_graphicController(nullptr),
 	m_sgNode(nullptr),
@@ -233,6 +238,13 @@ std::string KX_GameObject::GetName()
 void KX_GameObject::SetName(const std::string& name)
 {
 	m_name = name;
+	// The scene lists indexing the objects by name must be updated.
+	if (m_sgNode) {
+		KX_Scene *scene = GetScene();
+		if (scene) {
+			scene->NotifyObjectRenamed(this);
+		}
+	}
 }
 
 PHY_IPhysicsController* KX_GameObject::GetPhysicsController()
@@ -489,6 +501,13 @@ bool KX_GameObject::IsActionDone(short layer)
 	return GetActionManager()->IsActionDone(layer);
 }
 
+void KX_GameObject::GetActionLayers(std::vector<short>& layers) const
+{
+	if (m_actionManager) {
+		m_actionManager->GetActionLayers(layers);
+	}
+}
+
 bool KX_GameObject::IsActionsSuspended()
 {
 	return GetActionManager()->IsSuspended();
@@ -499,6 +518,11 @@ void KX_GameObject::UpdateActionManager(float curtime, bool applyToObject)
 	GetActionManager()->Update(curtime, applyToObject);
 }
 
+void KX_GameObject::RemoveActionManager()
+{
+	m_actionManager.reset(nullptr);
+}
+
 float KX_GameObject::GetActionFrame(short layer)
 {
 	return GetActionManager()->GetActionFrame(layer);
@@ -586,6 +610,44 @@ EXP_Value* KX_GameObject::GetReplica()
 	return replica;
 }
 
+void KX_GameObject::ResetReplica(KX_GameObject *templateobj)
+{
+	m_layer = templateobj->m_layer;
+	m_objectColor = templateobj->m_objectColor;
+
+	// Restore the meshes replaced by replaceMesh or the level of details.
+	m_currentLodLevel = 0;
+	if (m_meshes != templateobj->m_meshes && !templateobj->m_meshes.empty()) {
+		ReplaceMesh(templateobj->m_meshes.front(), true, false);
+	}
+
+	// The collision filter is applied when the physics is restored.
+	if (m_physicsController) {
+		m_physicsController->SetCollisionGroup(templateobj->GetCollisionGroup());
+		m_physicsController->SetCollisionMask(templateobj->GetCollisionMask());
+	}
+
+#ifdef WITH_PYTHON
+	// The python attributes are copied and the collision callbacks shared as in the copy constructor.
+	if (m_attr_dict) {
+		PyDict_Clear(m_attr_dict);
+		Py_CLEAR(m_attr_dict);
+	}
+	if (templateobj->m_attr_dict) {
+		m_attr_dict = PyDict_Copy(templateobj->m_attr_dict);
+	}
+
+	if (m_collisionCallbacks != templateobj->m_collisionCallbacks) {
+		if (m_collisionCallbacks) {
+			UnregisterCollisionCallbacks();
+			Py_CLEAR(m_collisionCallbacks);
+		}
+		m_collisionCallbacks = templateobj->m_collisionCallbacks;
+		Py_XINCREF(m_collisionCallbacks);
+	}
+#endif  // WITH_PYTHON
+}
+
 bool KX_GameObject::IsDynamic() const
 {
 	if (m_physicsController) {
@@ -1407,7 +1469,7 @@ void KX_GameObject::UpdateBounds(bool force)
 void KX_GameObject::SetBoundsAabb(const mt::vec3 &aabbMin, const mt::vec3 &aabbMax)
 {
 	// Set the AABB in culling node box.
-	m_cullingNode.GetAabb().Set(aabbMin, aabbMax);
+	m_cullingNode.SetAabb(aabbMin, aabbMax);
 
 	// Synchronize the AABB with the graphic controller.
 	if (m_graphicController) {
@@ -1894,6 +1956,7 @@ PyMethodDef KX_GameObject::Methods[] = {
 
 	EXP_PYMETHODTABLE_KEYWORDS(KX_GameObject, rayCastTo),
 	EXP_PYMETHODTABLE_KEYWORDS(KX_GameObject, rayCast),
+	EXP_PYMETHODTABLE_KEYWORDS(KX_GameObject, rayCastBatch),
 	EXP_PYMETHODTABLE_O(KX_GameObject, getDistanceTo),
 	EXP_PYMETHODTABLE_O(KX_GameObject, getVectTo),
 	EXP_PYMETHODTABLE_KEYWORDS(KX_GameObject, sendMessage),
@@ -1932,6 +1995,7 @@ PyAttributeDef KX_GameObject::Attributes[] = {
 	EXP_PYATTRIBUTE_RO_FUNCTION("culled", KX_GameObject, pyattr_get_culled),
 	EXP_PYATTRIBUTE_RO_FUNCTION("cullingBox",	KX_GameObject, pyattr_get_cullingBox),
 	EXP_PYATTRIBUTE_BOOL_RW    ("occlusion", KX_GameObject, m_bOccluder),
+	EXP_PYATTRIBUTE_BOOL_RW("replicated", KX_GameObject, m_replicated),
 	EXP_PYATTRIBUTE_RW_FUNCTION("physicsCullingRadius", KX_GameObject, pyattr_get_physicsCullingRadius, pyattr_set_physicsCullingRadius),
 	EXP_PYATTRIBUTE_RW_FUNCTION("logicCullingRadius", KX_GameObject, pyattr_get_logicCullingRadius, pyattr_set_logicCullingRadius),
 	EXP_PYATTRIBUTE_RW_FUNCTION("physicsCulling", KX_GameObject, pyattr_get_physicsCulling, pyattr_set_physicsCulling),
@@ -2126,8 +2190,10 @@ static int Map_SetItem(PyObject *self_v, PyObject *key, PyObject *val)
 			if (vallie) {
 				EXP_Value* oldprop = self->GetProperty(attr_str);
 				
-				if (oldprop)
+				if (oldprop) {
 					oldprop->SetValue(vallie);
+					self->NotifyPropertyChange();
+				}
 				else
 					self->SetProperty(attr_str, vallie);
 				
@@ -4116,6 +4182,294 @@ EXP_PYMETHODDEF_DOC(KX_GameObject, rayCast,
 		return none_tuple_3();
 }
 
+/** Points of a batched ray cast. A C contiguous buffer of floats or doubles is read
+ * without copy, a sequence of vectors is converted.
+ */
+class RayCastBatchPoints
+{
+private:
+	Py_buffer m_buffer;
+	bool m_hasBuffer;
+	std::vector<float> m_copy;
+	const float *m_floats;
+	const double *m_doubles;
+	unsigned int m_size;
+
+public:
+	RayCastBatchPoints()
+		:m_hasBuffer(false),
+		m_floats(nullptr),
+		m_doubles(nullptr),
+		m_size(0)
+	{
+	}
+
+	~RayCastBatchPoints()
+	{
+		if (m_hasBuffer) {
+			PyBuffer_Release(&m_buffer);
+		}
+	}
+
+	bool Parse(PyObject *value, const char *errorPrefix)
+	{
+		if (PyObject_CheckBuffer(value)) {
+			if (PyObject_GetBuffer(value, &m_buffer, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == -1) {
+				return false;
+			}
+			m_hasBuffer = true;
+
+			const char *format = m_buffer.format ? m_buffer.format : "B";
+			// Native byte order.
+			if (ELEM(format[0], '@', '=')) {
+				++format;
+			}
+
+			if (STREQ(format, "f") && m_buffer.itemsize == sizeof(float)) {
+				m_floats = (const float *)m_buffer.buf;
+			}
+			else if (STREQ(format, "d") && m_buffer.itemsize == sizeof(double)) {
+				m_doubles = (const double *)m_buffer.buf;
+			}
+			else {
+				PyErr_Format(PyExc_TypeError, "%s, expected a buffer of float or double, not \"%s\"", errorPrefix, format);
+				return false;
+			}
+
+			const Py_ssize_t numItems = m_buffer.len / m_buffer.itemsize;
+			if ((numItems % 3) != 0) {
+				PyErr_Format(PyExc_ValueError, "%s, expected a buffer of 3D points, got %i values", errorPrefix, (int)numItems);
+				return false;
+			}
+			m_size = numItems / 3;
+
+			return true;
+		}
+
+		PyObject *fast = PySequence_Fast(value, errorPrefix);
+		if (!fast) {
+			return false;
+		}
+
+		const Py_ssize_t size = PySequence_Fast_GET_SIZE(fast);
+		m_copy.resize(size * 3);
+		for (Py_ssize_t i = 0; i < size; ++i) {
+			mt::vec3 point;
+			if (!PyVecTo(PySequence_Fast_GET_ITEM(fast, i), point)) {
+				Py_DECREF(fast);
+				return false;
+			}
+			point.Pack(&m_copy[i * 3]);
+		}
+		Py_DECREF(fast);
+
+		m_floats = m_copy.data();
+		m_size = size;
+
+		return true;
+	}
+
+	unsigned int Size() const
+	{
+		return m_size;
+	}
+
+	mt::vec3 operator[](unsigned int index) const
+	{
+		if (m_doubles) {
+			const double *point = &m_doubles[index * 3];
+			return mt::vec3(point[0], point[1], point[2]);
+		}
+		return mt::vec3(&m_floats[index * 3]);
+	}
+};
+
+struct RayCastBatchData
+{
+	KX_GameObject *m_object;
+	PHY_IPhysicsEnvironment *m_physicsEnvironment;
+	PHY_IPhysicsController *m_ignoreController;
+	const RayCastBatchPoints *m_to;
+	/// Nullptr to cast from the object position.
+	const RayCastBatchPoints *m_from;
+	mt::vec3 m_position;
+	std::string m_prop;
+	bool m_face;
+	bool m_xray;
+	unsigned int m_mask;
+
+	std::vector<KX_GameObject *> m_hitObjects;
+	float *m_hitPoints;
+	float *m_hitNormals;
+};
+
+/// Number of rays tested by a task of a batched ray cast.
+static const unsigned int rayCastBatchTaskSize = 32;
+
+static void ray_cast_batch_range(RayCastBatchData *data, unsigned int start)
+{
+	const unsigned int end = std::min(start + rayCastBatchTaskSize, data->m_to->Size());
+
+	for (unsigned int i = start; i < end; ++i) {
+		const mt::vec3 fromPoint = data->m_from ? (*data->m_from)[i] : data->m_position;
+		const mt::vec3 toPoint = (*data->m_to)[i];
+
+		mt::vec3 hitPoint = mt::zero3;
+		mt::vec3 hitNormal = mt::zero3;
+
+		if (!mt::FuzzyZero((toPoint - fromPoint).LengthSquared())) {
+			KX_GameObject::RayCastData rayData(data->m_prop, data->m_xray, data->m_mask);
+			KX_RayCast::Callback<KX_GameObject, KX_GameObject::RayCastData> callback(data->m_object, data->m_ignoreController, &rayData, data->m_face);
+			callback.m_concurrent = true;
+
+			if (KX_RayCast::RayTest(data->m_physicsEnvironment, fromPoint, toPoint, callback) && rayData.m_hitObject) {
+				data->m_hitObjects[i] = rayData.m_hitObject;
+				hitPoint = callback.m_hitPoint;
+				hitNormal = callback.m_hitNormal;
+			}
+		}
+
+		hitPoint.Pack(&data->m_hitPoints[i * 3]);
+		hitNormal.Pack(&data->m_hitNormals[i * 3]);
+	}
+}
+
+static void ray_cast_batch_task_func(TaskPool *pool, void *taskdata, int UNUSED(threadid))
+{
+	RayCastBatchData *data = (RayCastBatchData *)BLI_task_pool_userdata(pool);
+	ray_cast_batch_range(data, (unsigned int)(intptr_t)taskdata);
+}
+
+/// Return a (size, 3) float memory view of a bytearray, steal the bytearray reference.
+static PyObject *ray_cast_batch_array(PyObject *bytes, unsigned int size)
+{
+	PyObject *view = PyMemoryView_FromObject(bytes);
+	Py_DECREF(bytes);
+	if (!view) {
+		return nullptr;
+	}
+
+	PyObject *shapedView = (size > 0) ? PyObject_CallMethod(view, "cast", "s(ii)", "f", size, 3) :
+	                       PyObject_CallMethod(view, "cast", "s", "f");
+	Py_DECREF(view);
+
+	return shapedView;
+}
+
+EXP_PYMETHODDEF_DOC(KX_GameObject, rayCastBatch,
+"rayCastBatch(to,from,prop,face,xray,mask): cast several rays concurrently and return a 3-tuple (objects,hits,normals).\n"
+" objects is a list of the hit objects or None, hits and normals are memory views of floats of shape (n, 3), zero for no hit.\n"
+" to   = buffer of floats or doubles (numpy array) or sequence of vectors for the destinations of the rays\n"
+" from = same as to for the origins of the rays, can be None or omitted => start from self object center\n"
+" prop, face, xray, mask = same as rayCast\n")
+{
+	PyObject *pyto;
+	PyObject *pyfrom = Py_None;
+	const char *propName = "";
+	int face = 0, xray = 0;
+	int mask = (1 << OB_MAX_COL_MASKS) - 1;
+
+	if (!EXP_ParseTupleArgsAndKeywords(args, kwds, "O|Osiii:rayCastBatch",
+			{"objto", "objfrom", "prop", "face", "xray", "mask", 0},
+			&pyto, &pyfrom, &propName, &face, &xray, &mask))
+	{
+		return nullptr;
+	}
+
+	if (mask == 0 || mask & ~((1 << OB_MAX_COL_MASKS) - 1)) {
+		PyErr_Format(PyExc_TypeError, "gameOb.rayCastBatch(to,from,prop,face,xray,mask): KX_GameObject, mask argument to rayCastBatch must be a int bitfield, 0 < mask < %i", (1 << OB_MAX_COL_MASKS));
+		return nullptr;
+	}
+
+	RayCastBatchPoints toPoints;
+	if (!toPoints.Parse(pyto, "gameOb.rayCastBatch(to,from,prop,face,xray,mask): KX_GameObject, to argument")) {
+		return nullptr;
+	}
+
+	RayCastBatchPoints fromPoints;
+	if (pyfrom != Py_None) {
+		if (!fromPoints.Parse(pyfrom, "gameOb.rayCastBatch(to,from,prop,face,xray,mask): KX_GameObject, from argument")) {
+			return nullptr;
+		}
+		if (fromPoints.Size() != toPoints.Size()) {
+			PyErr_Format(PyExc_ValueError, "gameOb.rayCastBatch(to,from,prop,face,xray,mask): KX_GameObject, "
+			             "expected the same number of points for to and from, got %i and %i", toPoints.Size(), fromPoints.Size());
+			return nullptr;
+		}
+	}
+
+	const unsigned int size = toPoints.Size();
+
+	PyObject *pyhitPoints = PyByteArray_FromStringAndSize(nullptr, size * 3 * sizeof(float));
+	PyObject *pyhitNormals = PyByteArray_FromStringAndSize(nullptr, size * 3 * sizeof(float));
+	if (!pyhitPoints || !pyhitNormals) {
+		Py_XDECREF(pyhitPoints);
+		Py_XDECREF(pyhitNormals);
+		return nullptr;
+	}
+
+	PHY_IPhysicsController *spc = GetPhysicsController();
+	KX_GameObject *parent = GetParent();
+	if (!spc && parent) {
+		spc = parent->GetPhysicsController();
+	}
+
+	RayCastBatchData data;
+	data.m_object = this;
+	data.m_physicsEnvironment = GetScene()->GetPhysicsEnvironment();
+	data.m_ignoreController = spc;
+	data.m_to = &toPoints;
+	data.m_from = (pyfrom != Py_None) ? &fromPoints : nullptr;
+	data.m_position = NodeGetWorldPosition();
+	data.m_prop = propName;
+	data.m_face = face;
+	data.m_xray = xray;
+	data.m_mask = mask;
+	data.m_hitObjects.resize(size, nullptr);
+	data.m_hitPoints = (float *)PyByteArray_AS_STRING(pyhitPoints);
+	data.m_hitNormals = (float *)PyByteArray_AS_STRING(pyhitNormals);
+
+	// The physics is not updated during the logic, the ray tests are read only.
+	if (size > rayCastBatchTaskSize) {
+		TaskPool *pool = BLI_task_pool_create(KX_GetActiveEngine()->GetTaskScheduler(), &data);
+		for (unsigned int i = 0; i < size; i += rayCastBatchTaskSize) {
+			BLI_task_pool_push(pool, ray_cast_batch_task_func, (void *)(intptr_t)i, false, TASK_PRIORITY_HIGH);
+		}
+		BLI_task_pool_work_and_wait(pool);
+		BLI_task_pool_free(pool);
+	}
+	else {
+		ray_cast_batch_range(&data, 0);
+	}
+
+	PyObject *pyhitObjects = PyList_New(size);
+	for (unsigned int i = 0; i < size; ++i) {
+		KX_GameObject *hitObject = data.m_hitObjects[i];
+		PyList_SET_ITEM(pyhitObjects, i, hitObject ? hitObject->GetProxy() : Py_INCREF_RET(Py_None));
+	}
+
+	PyObject *returnValue = PyTuple_New(3);
+	PyTuple_SET_ITEM(returnValue, 0, pyhitObjects);
+
+	// The memory views steal the bytearray references.
+	PyObject *pyhitPointsView = ray_cast_batch_array(pyhitPoints, size);
+	if (!pyhitPointsView) {
+		Py_DECREF(pyhitNormals);
+		Py_DECREF(returnValue);
+		return nullptr;
+	}
+	PyTuple_SET_ITEM(returnValue, 1, pyhitPointsView);
+
+	PyObject *pyhitNormalsView = ray_cast_batch_array(pyhitNormals, size);
+	if (!pyhitNormalsView) {
+		Py_DECREF(returnValue);
+		return nullptr;
+	}
+	PyTuple_SET_ITEM(returnValue, 2, pyhitNormalsView);
+
+	return returnValue;
+}
+
 EXP_PYMETHODDEF_DOC(KX_GameObject, sendMessage,
 						   "sendMessage(subject, [body, to])\n"
 "sends a message in same manner as a message actuator"
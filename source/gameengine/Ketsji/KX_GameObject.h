@@ -124,6 +124,11 @@ protected:
 
 	bool								m_autoUpdateBounds;
 
+	/// The object is sent by the scene replication server.
+	bool m_replicated;
+	/// Id of the object in the scene replication, 0 when not replicated.
+	unsigned int m_replicationId;
+
 	std::unique_ptr<PHY_IPhysicsController> m_physicsController;
 	std::unique_ptr<PHY_IGraphicController> m_graphicController;
 
@@ -305,6 +310,11 @@ public:
 	 */
 	bool IsActionDone(short layer);
 
+	/**
+	 * Append the layers playing an action, doesn't create the action manager
+	 */
+	void GetActionLayers(std::vector<short>& layers) const;
+
 	bool IsActionsSuspended();
 
 	/**
@@ -314,6 +324,11 @@ public:
 	 */
 	void UpdateActionManager(float curtime, bool applyObject);
 
+	/**
+	 * Stop all the actions and delete the action manager, it is created again when needed.
+	 */
+	void RemoveActionManager();
+
 	/*********************************
 	 * End Animation API
 	 *********************************/
@@ -360,6 +375,12 @@ public:
 	 * object belongs with the caller.
 	 */
 	virtual EXP_Value *GetReplica();
+
+	/**
+	 * Reset the state a pooled replica changed at runtime to the one of a new replica of templateobj:
+	 * color, layer, meshes, collision group and mask, python attributes and collision callbacks.
+	 */
+	void ResetReplica(KX_GameObject *templateobj);
 	
 	/** 
 	 * Return the linear velocity of the game object.
@@ -798,6 +819,26 @@ public:
 		return m_autoUpdateBounds;
 	}
 
+	inline bool IsReplicated() const
+	{
+		return m_replicated;
+	}
+
+	inline void SetReplicated(bool replicated)
+	{
+		m_replicated = replicated;
+	}
+
+	inline unsigned int GetReplicationId() const
+	{
+		return m_replicationId;
+	}
+
+	inline void SetReplicationId(unsigned int id)
+	{
+		m_replicationId = id;
+	}
+
 	/** Update the game object bounding box (AABB) by using the one existing in the
 	 * mesh or the mesh deformer.
 	 * \param force Force the AABB update even if the object doesn't allow auto update or if the mesh is
@@ -912,6 +953,7 @@ public:
 	EXP_PYMETHOD_NOARGS(KX_GameObject,EndObject);
 	EXP_PYMETHOD_DOC(KX_GameObject,rayCastTo);
 	EXP_PYMETHOD_DOC(KX_GameObject,rayCast);
+	EXP_PYMETHOD_DOC(KX_GameObject,rayCastBatch);
 	EXP_PYMETHOD_DOC_O(KX_GameObject,getDistanceTo);
 	EXP_PYMETHOD_DOC_O(KX_GameObject,getVectTo);
 	EXP_PYMETHOD_DOC(KX_GameObject, sendMessage);
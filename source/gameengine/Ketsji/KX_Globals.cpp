@@ -86,5 +86,8 @@ const std::string& KX_GetOrigPath()
 
 void KX_RasterizerDrawDebugLine(const mt::vec3& from,const mt::vec3& to,const mt::vec4& color)
 {
-	g_engine->GetRasterizer()->GetDebugDraw(g_scene).DrawLine(from, to, color);
+	RAS_Rasterizer *rasty = g_engine->GetRasterizer();
+	if (rasty) {
+		rasty->GetDebugDraw(g_scene).DrawLine(from, to, color);
+	}
 }
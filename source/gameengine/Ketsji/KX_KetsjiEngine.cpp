@@ -57,6 +57,7 @@
 #include "KX_Camera.h"
 #include "KX_LightObject.h"
 #include "KX_Globals.h"
+#include "KX_TraceProfiler.h"
 #include "KX_PyConstraintBinding.h"
 #include "PHY_IPhysicsEnvironment.h"
 
@@ -173,18 +174,15 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system)
 	m_showShadowFrustum(KX_DebugOption::DISABLE)
 {
 	for (int i = tc_first; i < tc_numCategories; i++) {
-		m_logger.AddCategory((KX_TimeCategory)i);
+		m_logger.AddCategory((KX_TimeCategory)i, m_profileLabels[i]);
 	}
 
-	m_renderQueries.push_back(RAS_Query(RAS_Query::SAMPLES));
-	m_renderQueries.push_back(RAS_Query(RAS_Query::PRIMITIVES));
-	m_renderQueries.push_back(RAS_Query(RAS_Query::TIME));
-
 #ifdef WITH_PYTHON
 	m_pyprofiledict = PyDict_New();
 #endif
 
 	m_taskscheduler = BLI_task_scheduler_create(TASK_SCHEDULER_AUTO_THREADS);
+	m_scenePool = BLI_task_pool_create(m_taskscheduler, &m_scenePoolData);
 
 	m_scenes = new EXP_ListValue<KX_Scene>();
 }
@@ -198,6 +196,8 @@ KX_KetsjiEngine::~KX_KetsjiEngine()
 	Py_CLEAR(m_pyprofiledict);
 #endif
 
+	BLI_task_pool_free(m_scenePool);
+
 	if (m_taskscheduler)
 		BLI_task_scheduler_free(m_taskscheduler);
 
@@ -220,6 +220,11 @@ void KX_KetsjiEngine::SetRasterizer(RAS_Rasterizer *rasterizer)
 {
 	BLI_assert(rasterizer);
 	m_rasterizer = rasterizer;
+
+	// The queries use the GL context, they are created only when rendering.
+	m_renderQueries.push_back(RAS_Query(RAS_Query::SAMPLES));
+	m_renderQueries.push_back(RAS_Query(RAS_Query::PRIMITIVES));
+	m_renderQueries.push_back(RAS_Query(RAS_Query::TIME));
 }
 
 void KX_KetsjiEngine::SetNetworkMessageManager(KX_NetworkMessageManager *manager)
@@ -265,23 +270,8 @@ void KX_KetsjiEngine::BeginFrame()
 	m_canvas->BeginDraw();
 }
 
-void KX_KetsjiEngine::EndFrame()
+void KX_KetsjiEngine::NextProfileMeasurement()
 {
-	m_rasterizer->MotionBlur();
-
-	m_logger.StartLog(tc_overhead, m_kxsystem->GetTimeInSeconds());
-
-	if (m_flags & SHOW_RENDER_QUERIES) {
-		for (RAS_Query& query : m_renderQueries) {
-			query.End();
-		}
-	}
-
-	// Show profiling info
-	if (m_flags & (SHOW_PROFILE | SHOW_FRAMERATE | SHOW_DEBUG_PROPERTIES | SHOW_RENDER_QUERIES)) {
-		RenderDebugProperties();
-	}
-
 	double tottime = m_logger.GetAverage();
 	if (tottime < 1e-6)
 		tottime = 1e-6;
@@ -302,6 +292,26 @@ void KX_KetsjiEngine::EndFrame()
 
 	// Go to next profiling measurement, time spent after this call is shown in the next frame.
 	m_logger.NextMeasurement(m_kxsystem->GetTimeInSeconds());
+}
+
+void KX_KetsjiEngine::EndFrame()
+{
+	m_rasterizer->MotionBlur();
+
+	m_logger.StartLog(tc_overhead, m_kxsystem->GetTimeInSeconds());
+
+	if (m_flags & SHOW_RENDER_QUERIES) {
+		for (RAS_Query& query : m_renderQueries) {
+			query.End();
+		}
+	}
+
+	// Show profiling info
+	if (m_flags & (SHOW_PROFILE | SHOW_FRAMERATE | SHOW_DEBUG_PROPERTIES | SHOW_RENDER_QUERIES)) {
+		RenderDebugProperties();
+	}
+
+	NextProfileMeasurement();
 
 	m_logger.StartLog(tc_rasterizer, m_kxsystem->GetTimeInSeconds());
 	m_rasterizer->EndFrame();
@@ -366,6 +376,9 @@ bool KX_KetsjiEngine::NextFrame()
 		return false;
 	}
 
+	KX_TraceProfiler::NextFrame();
+	KX_TRACE_SCOPE("KX_KetsjiEngine::NextFrame");
+
 	// In case of non-fixed framerate, we always proceed one frame.
 	int frames = 1;
 
@@ -391,9 +404,11 @@ bool KX_KetsjiEngine::NextFrame()
 	}
 
 	for (unsigned short i = 0; i < frames; ++i) {
+		KX_TRACE_SCOPE("Logic frame");
+
 		m_frameTime += framestep;
 
-		m_converter->MergeAsyncLoads();
+		m_converter->MergeAsyncLoads(true);
 
 		if (m_inputDevice) {
 			m_inputDevice->ReleaseMoveEvent();
@@ -408,6 +423,9 @@ bool KX_KetsjiEngine::NextFrame()
 		}
 #endif  // WITH_SDL
 
+		// Scenes waiting their physics to be proceeded in parallel.
+		std::vector<KX_Scene *> physicsScenes;
+
 		// for each scene, call the proceed functions
 		for (KX_Scene *scene : m_scenes) {
 			/* Suspension holds the physics and logic processing for an
@@ -447,19 +465,35 @@ bool KX_KetsjiEngine::NextFrame()
 				m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
 				scene->UpdateParents();
 
-				m_logger.StartLog(tc_physics, m_kxsystem->GetTimeInSeconds());
+				// The physics is proceeded for all the scenes at once after their logic.
+				if (m_flags & PARALLEL_SCENES) {
+					physicsScenes.push_back(scene);
+				}
+				else {
+					m_logger.StartLog(tc_physics, m_kxsystem->GetTimeInSeconds());
 
-				// Perform physics calculations on the scene. This can involve
-				// many iterations of the physics solver.
-				scene->GetPhysicsEnvironment()->ProceedDeltaTime(m_frameTime, timestep, framestep);//m_deltatimerealDeltaTime);
+					// Perform physics calculations on the scene. This can involve
+					// many iterations of the physics solver.
+					{
+						KX_TRACE_SCOPE("PHY_IPhysicsEnvironment::ProceedDeltaTime");
+						scene->GetPhysicsEnvironment()->ProceedDeltaTime(m_frameTime, timestep, framestep);//m_deltatimerealDeltaTime);
+					}
 
-				m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
-				scene->UpdateParents();
+					m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
+					scene->UpdateParents();
+				}
 			}
 
 			m_logger.StartLog(tc_services, m_kxsystem->GetTimeInSeconds());
 		}
 
+		if (!physicsScenes.empty()) {
+			// Physics and scene graph time can't be distinguished as they are proceeded in the same tasks.
+			m_logger.StartLog(tc_physics, m_kxsystem->GetTimeInSeconds());
+			ProceedScenesPhysics(physicsScenes, timestep, framestep);
+			m_logger.StartLog(tc_services, m_kxsystem->GetTimeInSeconds());
+		}
+
 		m_logger.StartLog(tc_network, m_kxsystem->GetTimeInSeconds());
 		m_networkMessageManager->ClearMessages();
 
@@ -480,6 +514,31 @@ bool KX_KetsjiEngine::NextFrame()
 	return doRender && m_doRender;
 }
 
+static void proceed_scene_physics_thread_func(TaskPool *pool, void *taskdata, int UNUSED(threadid))
+{
+	KX_KetsjiEngine::ScenePoolData *data = (KX_KetsjiEngine::ScenePoolData *)BLI_task_pool_userdata(pool);
+	KX_Scene *scene = (KX_Scene *)taskdata;
+
+	KX_TRACE_SCOPE("Scene physics task");
+	scene->GetPhysicsEnvironment()->ProceedDeltaTime(data->frameTime, data->timestep, data->framestep);
+	// The scene graph of a scene is independent of the other scenes.
+	scene->UpdateParents();
+}
+
+void KX_KetsjiEngine::ProceedScenesPhysics(const std::vector<KX_Scene *>& scenes, double timestep, double framestep)
+{
+	m_scenePoolData.frameTime = m_frameTime;
+	m_scenePoolData.timestep = timestep;
+	m_scenePoolData.framestep = framestep;
+
+	for (KX_Scene *scene : scenes) {
+		BLI_task_pool_push(m_scenePool, proceed_scene_physics_thread_func, scene, false, TASK_PRIORITY_HIGH);
+	}
+
+	// Join all the scenes before any rendering or scene scheduling.
+	BLI_task_pool_work_and_wait(m_scenePool);
+}
+
 void KX_KetsjiEngine::UpdateSuspendedScenes(double framestep)
 {
 	for (KX_Scene *scene : m_scenes) {
@@ -627,6 +686,8 @@ KX_KetsjiEngine::RenderData KX_KetsjiEngine::GetRenderData()
 
 void KX_KetsjiEngine::Render()
 {
+	KX_TRACE_SCOPE("KX_KetsjiEngine::Render");
+
 	m_logger.StartLog(tc_rasterizer, m_kxsystem->GetTimeInSeconds());
 
 	BeginFrame();
@@ -838,8 +899,35 @@ void KX_KetsjiEngine::UpdateAnimations(KX_Scene *scene)
 	scene->UpdateAnimations(m_frameTime, m_flags & RESTRICT_ANIMATION);
 }
 
+void KX_KetsjiEngine::UpdateHeadlessFrame(bool deform)
+{
+	KX_TRACE_SCOPE("KX_KetsjiEngine::UpdateHeadlessFrame");
+
+	m_logger.StartLog(tc_animations, m_kxsystem->GetTimeInSeconds());
+
+	for (KX_Scene *scene : m_scenes) {
+		/* Nothing is culled without rendering, all the objects are then invisible
+		 * and armatures are not posed unless they are considered as visible. */
+		if (deform) {
+			for (KX_GameObject *gameobj : *scene->GetObjectList()) {
+				gameobj->SetCulled(false);
+			}
+		}
+
+		UpdateAnimations(scene);
+	}
+
+	m_logger.StartLog(tc_overhead, m_kxsystem->GetTimeInSeconds());
+
+	NextProfileMeasurement();
+
+	m_logger.StartLog(tc_outside, m_kxsystem->GetTimeInSeconds());
+}
+
 void KX_KetsjiEngine::RenderShadowBuffers(KX_Scene *scene)
 {
+	KX_TRACE_SCOPE("KX_KetsjiEngine::RenderShadowBuffers");
+
 	EXP_ListValue<KX_LightObject> *lightlist = scene->GetLightList();
 
 	m_rasterizer->SetAuxilaryClientInfo(scene);
@@ -963,6 +1051,8 @@ mt::mat4 KX_KetsjiEngine::GetCameraProjectionMatrix(KX_Scene *scene, KX_Camera *
 void KX_KetsjiEngine::RenderCamera(KX_Scene *scene, const CameraRenderData& cameraFrameData, RAS_OffScreen *offScreen,
 								  unsigned short pass, bool isFirstScene)
 {
+	KX_TRACE_SCOPE("KX_KetsjiEngine::RenderCamera");
+
 	KX_Camera *rendercam = cameraFrameData.m_renderCamera;
 	KX_Camera *cullingcam = cameraFrameData.m_cullingCamera;
 	const RAS_Rect &area = cameraFrameData.m_area;
@@ -1043,6 +1133,8 @@ void KX_KetsjiEngine::RenderCamera(KX_Scene *scene, const CameraRenderData& came
  */
 RAS_OffScreen *KX_KetsjiEngine::PostRenderScene(KX_Scene *scene, RAS_OffScreen *inputofs, RAS_OffScreen *targetofs)
 {
+	KX_TRACE_SCOPE("KX_KetsjiEngine::PostRenderScene");
+
 	KX_SetActiveScene(scene);
 
 	m_rasterizer->FlushDebugDraw(scene, m_canvas);
@@ -1071,6 +1163,8 @@ RAS_OffScreen *KX_KetsjiEngine::PostRenderScene(KX_Scene *scene, RAS_OffScreen *
 
 void KX_KetsjiEngine::StopEngine()
 {
+	KX_TraceProfiler::Finish();
+
 	if (m_bInitialized) {
 		m_converter->FinalizeAsyncLoads();
 
@@ -1082,7 +1176,9 @@ void KX_KetsjiEngine::StopEngine()
 		}
 
 		// cleanup all the stuff
-		m_rasterizer->Exit();
+		if (m_rasterizer) {
+			m_rasterizer->Exit();
+		}
 	}
 }
 
@@ -1194,6 +1290,22 @@ void KX_KetsjiEngine::RenderDebugProperties()
 			debugDraw.RenderBox2d(mt::vec2(xcoord + (int)(2.2 * profile_indent), ycoord), boxSize, white);
 			ycoord += const_ysize;
 		}
+
+		// Object pools usage of all the scenes.
+		unsigned int pooled = 0;
+		unsigned int hits = 0;
+		unsigned int misses = 0;
+		for (KX_Scene *scene : m_scenes) {
+			scene->GetObjectPoolStats(pooled, hits, misses);
+		}
+
+		if ((hits + misses) > 0) {
+			debugDraw.RenderText2d("Object pools:", mt::vec2(xcoord + const_xindent, ycoord), white);
+
+			debugtxt = (boost::format("%d | %d%% hits") % pooled % (int)((float)hits / (float)(hits + misses) * 100.f)).str();
+			debugDraw.RenderText2d(debugtxt, mt::vec2(xcoord + const_xindent + profile_indent, ycoord), white);
+			ycoord += const_ysize;
+		}
 	}
 
 	if (m_flags & SHOW_RENDER_QUERIES) {
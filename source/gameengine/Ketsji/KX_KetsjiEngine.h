@@ -43,6 +43,7 @@
 #include <vector>
 
 struct TaskScheduler;
+struct TaskPool;
 class KX_Scene;
 class KX_Camera;
 class KX_ISystem;
@@ -104,7 +105,19 @@ public:
 		/// Automatic add debug properties to the debug list.
 		AUTO_ADD_DEBUG_PROPERTIES = (1 << 7),
 		/// Use override camera?
-		CAMERA_OVERRIDE = (1 << 8)
+		CAMERA_OVERRIDE = (1 << 8),
+		/// Proceed the physics of all the scenes concurrently once their logic is done.
+		PARALLEL_SCENES = (1 << 9),
+		/// Update the independent hierarchies of the scene graph concurrently.
+		PARALLEL_SCENEGRAPH = (1 << 10)
+	};
+
+	/// Data shared by the tasks proceeding the scenes physics in parallel.
+	struct ScenePoolData
+	{
+		double frameTime;
+		double timestep;
+		double framestep;
 	};
 
 private:
@@ -259,6 +272,9 @@ private:
 
 	/// Task scheduler for multi-threading
 	TaskScheduler *m_taskscheduler;
+	/// Task pool used to proceed the scenes physics in parallel.
+	TaskPool *m_scenePool;
+	ScenePoolData m_scenePoolData;
 
 	/** Set scene's total pause duration for animations process.
 	 * This is done in a separate loop to get the proper state of each scenes.
@@ -272,6 +288,12 @@ private:
 	 */
 	void UpdateSuspendedScenes(double framestep);
 
+	/** Proceed concurrently the physics and the following scene graph update of
+	 * scenes which logic was already proceeded, used when PARALLEL_SCENES is enabled.
+	 * The function returns once all the scenes are proceeded.
+	 */
+	void ProceedScenesPhysics(const std::vector<KX_Scene *>& scenes, double timestep, double framestep);
+
 	/// Update and return the projection matrix of a camera depending on the viewport.
 	mt::mat4 GetCameraProjectionMatrix(KX_Scene *scene, KX_Camera *cam, RAS_Rasterizer::StereoMode stereoMode,
 			RAS_Rasterizer::StereoEye eye, const RAS_Rect& viewport, const RAS_Rect& area) const;
@@ -305,6 +327,8 @@ private:
 	void PostProcessScene(KX_Scene *scene);
 
 	void BeginFrame();
+	/// Update the python profile dictionary and the average framerate, then start a new measurement.
+	void NextProfileMeasurement();
 	void EndFrame();
 
 public:
@@ -384,6 +408,11 @@ public:
 
 	// Update animations for object in this scene
 	void UpdateAnimations(KX_Scene *scene);
+	/** Update animations of all the scenes and end the profiling measurement of the frame,
+	 * used instead of Render when there's no rasterizer.
+	 * \param deform Pose the armatures and deform the meshes as if all the objects were visible.
+	 */
+	void UpdateHeadlessFrame(bool deform);
 
 	bool GetFlag(FlagType flag) const;
 	/// Enable or disable a set of flags.
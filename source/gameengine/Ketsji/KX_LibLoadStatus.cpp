@@ -33,7 +33,11 @@ KX_LibLoadStatus::KX_LibLoadStatus(BL_Converter *converter, KX_KetsjiEngine *eng
 	m_mergescene(merge_scene),
 	m_libname(path),
 	m_progress(0.0f),
-	m_finished(false)
+	m_finished(false),
+	m_mergeBudget(0.0f),
+	m_mergeConverter(0),
+	m_mergeStage(MERGE_OBJECTS),
+	m_mergeItem(0)
 #ifdef WITH_PYTHON
 	,
 	m_finish_cb(nullptr),
@@ -130,6 +134,64 @@ void KX_LibLoadStatus::AddProgress(float progress)
 	RunProgressCallback();
 }
 
+float KX_LibLoadStatus::GetMergeBudget() const
+{
+	return m_mergeBudget;
+}
+
+void KX_LibLoadStatus::SetMergeBudget(float budget)
+{
+	m_mergeBudget = budget;
+}
+
+unsigned int KX_LibLoadStatus::GetMergeConverter() const
+{
+	return m_mergeConverter;
+}
+
+KX_LibLoadStatus::MergeStage KX_LibLoadStatus::GetMergeStage() const
+{
+	return m_mergeStage;
+}
+
+unsigned int KX_LibLoadStatus::GetMergeItem() const
+{
+	return m_mergeItem;
+}
+
+void KX_LibLoadStatus::NextMergeItem()
+{
+	++m_mergeItem;
+}
+
+void KX_LibLoadStatus::NextMergeStage()
+{
+	m_mergeItem = 0;
+	m_mergeStage = (MergeStage)(m_mergeStage + 1);
+	if (m_mergeStage == MERGE_STAGE_MAX) {
+		NextMergeConverter();
+	}
+}
+
+void KX_LibLoadStatus::NextMergeConverter()
+{
+	m_mergeItem = 0;
+	m_mergeStage = MERGE_OBJECTS;
+	++m_mergeConverter;
+}
+
+void KX_LibLoadStatus::UpdateMergeProgress()
+{
+	const unsigned int numConverters = m_sceneConvertes.size();
+	if (numConverters == 0) {
+		return;
+	}
+
+	// Conversion is 90% of the progress.
+	const float merged = (float)m_mergeConverter + (float)m_mergeStage / (float)MERGE_STAGE_MAX;
+	SetProgress(0.9f + 0.1f * merged / (float)numConverters);
+}
+
 #ifdef WITH_PYTHON
 
 PyMethodDef KX_LibLoadStatus::Methods[] = {
@@ -140,6 +202,7 @@ PyAttributeDef KX_LibLoadStatus::Attributes[] = {
 	EXP_PYATTRIBUTE_RW_FUNCTION("onFinish", KX_LibLoadStatus, pyattr_get_onfinish, pyattr_set_onfinish),
 	// EXP_PYATTRIBUTE_RW_FUNCTION("onProgress", KX_LibLoadStatus, pyattr_get_onprogress, pyattr_set_onprogress),
 	EXP_PYATTRIBUTE_FLOAT_RO("progress", KX_LibLoadStatus, m_progress),
+	EXP_PYATTRIBUTE_FLOAT_RW("mergeBudget", 0.0f, FLT_MAX, KX_LibLoadStatus, m_mergeBudget),
 	EXP_PYATTRIBUTE_STRING_RO("libraryName", KX_LibLoadStatus, m_libname),
 	EXP_PYATTRIBUTE_RO_FUNCTION("timeTaken", KX_LibLoadStatus, pyattr_get_timetaken),
 	EXP_PYATTRIBUTE_BOOL_RO("finished", KX_LibLoadStatus, m_finished),
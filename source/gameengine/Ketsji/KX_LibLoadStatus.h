@@ -38,6 +38,17 @@ struct Scene;
 class KX_LibLoadStatus : public EXP_PyObjectPlus
 {
 	Py_Header
+public:
+	/// Steps of the merge of a converted scene, a step can be resumed at any item.
+	enum MergeStage {
+		MERGE_OBJECTS = 0,
+		MERGE_MESHES,
+		MERGE_MATERIALS,
+		MERGE_LOGIC,
+		MERGE_FINISH,
+		MERGE_STAGE_MAX
+	};
+
 private:
 	BL_Converter *m_converter;
 	KX_KetsjiEngine *m_engine;
@@ -53,6 +64,14 @@ private:
 	/// The current status of this libload, used by the scene converter.
 	bool m_finished;
 
+	/// Maximum time in milliseconds spent per frame to merge the converted scenes, 0 for no limit.
+	float m_mergeBudget;
+	/// Index of the scene converter being merged.
+	unsigned int m_mergeConverter;
+	MergeStage m_mergeStage;
+	/// Index of the next item to merge in the current stage.
+	unsigned int m_mergeItem;
+
 #ifdef WITH_PYTHON
 	PyObject *m_finish_cb;
 	PyObject *m_progress_cb;
@@ -81,6 +100,19 @@ public:
 	float GetProgress() const;
 	void AddProgress(float progress);
 
+	float GetMergeBudget() const;
+	void SetMergeBudget(float budget);
+
+	unsigned int GetMergeConverter() const;
+	MergeStage GetMergeStage() const;
+	unsigned int GetMergeItem() const;
+	void NextMergeItem();
+	/// Go to the next stage or the first stage of the next scene converter.
+	void NextMergeStage();
+	void NextMergeConverter();
+	/// Set the progress of the merge, merging is the last 10% of the progress.
+	void UpdateMergeProgress();
+
 #ifdef WITH_PYTHON
 	static PyObject *pyattr_get_onfinish(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
 	static int pyattr_set_onfinish(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef, PyObject *value);
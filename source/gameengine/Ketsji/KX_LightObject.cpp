@@ -62,7 +62,9 @@ KX_LightObject::KX_LightObject(void *sgReplicationInfo, SG_Callbacks callbacks,
 	m_lightobj = lightobj;
 	m_lightobj->m_scene = sgReplicationInfo;
 	m_lightobj->m_light = this;
-	m_rasterizer->AddLight(m_lightobj);
+	if (m_rasterizer) {
+		m_rasterizer->AddLight(m_lightobj);
+	}
 	m_blenderscene = ((KX_Scene *)sgReplicationInfo)->GetBlenderScene();
 	m_base = nullptr;
 }
@@ -70,7 +72,9 @@ KX_LightObject::KX_LightObject(void *sgReplicationInfo, SG_Callbacks callbacks,
 KX_LightObject::~KX_LightObject()
 {
 	if (m_lightobj) {
-		m_rasterizer->RemoveLight(m_lightobj);
+		if (m_rasterizer) {
+			m_rasterizer->RemoveLight(m_lightobj);
+		}
 		delete(m_lightobj);
 	}
 
@@ -88,7 +92,9 @@ EXP_Value *KX_LightObject::GetReplica()
 
 	replica->m_lightobj = m_lightobj->Clone();
 	replica->m_lightobj->m_light = replica;
-	m_rasterizer->AddLight(replica->m_lightobj);
+	if (m_rasterizer) {
+		m_rasterizer->AddLight(replica->m_lightobj);
+	}
 	if (m_base)
 		m_base = nullptr;
 
@@ -278,11 +278,16 @@ bool KX_MouseFocusSensor::ParentObjectHasFocusCamera(KX_Camera *cam)
 	 * calculations don't bomb. Maybe we should explicitly guard for
 	 * division by 0.0...*/
 	
+	RAS_Rasterizer *rasty = m_kxengine->GetRasterizer();
+	// Without rasterizer there is no render area to hit.
+	if (!rasty) {
+		return false;
+	}
+
 	RAS_Rect area, viewport;
 	RAS_ICanvas *canvas = m_kxengine->GetCanvas();
 	short m_y_inv = canvas->GetHeight()-m_y;
 
-	RAS_Rasterizer *rasty = m_kxengine->GetRasterizer();
 	const RAS_Rect displayArea = rasty->GetRenderArea(canvas, rasty->GetStereoMode(), RAS_Rasterizer::RAS_STEREO_LEFTEYE);
 	m_kxengine->GetSceneViewport(m_kxscene, cam, displayArea, area, viewport);
 	
@@ -53,10 +53,15 @@ extern "C" {
 #include "DetourStatNavMeshBuilder.h"
 #include "KX_ObstacleSimulation.h"
 
+#include "BLI_task.h"
+#include "BLI_threads.h"
+
 #include "CM_Message.h"
 
 #define MAX_PATH_LEN 256
 static const float polyPickExt[3] = {2, 4, 2};
+/// Number of polygon corridors kept in the path cache.
+static const unsigned int pathCacheSize = 32;
 
 static void calcMeshBounds(const float *vert, int nverts, float *bmin, float *bmax)
 {
@@ -96,17 +101,82 @@ inline void flipAxes(float vec[3])
 	std::swap(vec[1], vec[2]);
 }
 
+#ifdef WITH_PYTHON
+static PyObject *pathToPyList(const KX_NavMeshObject::PathType& path)
+{
+	const unsigned int pathLen = path.size();
+	PyObject *pathList = PyList_New(pathLen);
+	for (unsigned int i = 0; i < pathLen; ++i) {
+		PyList_SET_ITEM(pathList, i, PyObjectFrom(path[i]));
+	}
+
+	return pathList;
+}
+#endif  // WITH_PYTHON
+
+struct KX_NavMeshObject::BuildData
+{
+	float *m_vertices;
+	float *m_dvertices;
+	unsigned short *m_polys;
+	unsigned short *m_dtris;
+	unsigned short *m_dmeshes;
+	int m_nverts;
+	int m_npolys;
+	int m_ndvertsuniq;
+	int m_ndtris;
+	int m_vertsPerPoly;
+
+	/// The built navigation mesh, nullptr if the build failed.
+	dtStatNavMesh *m_navMesh;
+
+	BuildData();
+	~BuildData();
+
+	/// Build the navigation mesh from the arrays, doesn't use the game object.
+	void Build();
+};
+
+static void build_navmesh_task_func(TaskPool *UNUSED(pool), void *taskdata, int UNUSED(threadid))
+{
+	KX_NavMeshObject::BuildData *data = (KX_NavMeshObject::BuildData *)taskdata;
+	data->Build();
+}
+
+static void find_path_task_func(TaskPool *pool, void *taskdata, int threadid)
+{
+	KX_NavMeshObject *navmesh = (KX_NavMeshObject *)BLI_task_pool_userdata(pool);
+	KX_NavMeshObject::PathRequest *request = (KX_NavMeshObject::PathRequest *)taskdata;
+	navmesh->FindRequestedPath(request, threadid);
+}
+
 KX_NavMeshObject::KX_NavMeshObject(void *sgReplicationInfo, SG_Callbacks callbacks)
 	:KX_GameObject(sgReplicationInfo, callbacks),
-	m_navMesh(nullptr)
+	m_navMesh(nullptr),
+	m_pathCacheClock(0),
+	m_taskPool(nullptr),
+	m_buildData(nullptr)
 {
 }
 
 KX_NavMeshObject::~KX_NavMeshObject()
 {
-	if (m_navMesh) {
-		delete m_navMesh;
+	if (m_taskPool) {
+		BLI_task_pool_work_and_wait(m_taskPool);
+		BLI_task_pool_free(m_taskPool);
 	}
+
+	if (m_buildData) {
+		delete m_buildData;
+	}
+
+#ifdef WITH_PYTHON
+	for (PathRequestPtr& request : m_pathRequests) {
+		Py_XDECREF(request->m_callback);
+	}
+#endif  // WITH_PYTHON
+
+	SetNavMesh(nullptr);
 }
 
 EXP_Value *KX_NavMeshObject::GetReplica()
@@ -120,6 +190,12 @@ void KX_NavMeshObject::ProcessReplica()
 {
 	KX_GameObject::ProcessReplica();
 	m_navMesh = nullptr;
+	m_threadNavMeshes.clear();
+	m_pathCache.clear();
+	m_pathCacheClock = 0;
+	m_taskPool = nullptr;
+	m_buildData = nullptr;
+	m_pathRequests.clear();
 
 	if (!BuildNavMesh()) {
 		CM_FunctionError("unable to build navigation mesh");
@@ -305,79 +381,87 @@ bool KX_NavMeshObject::BuildVertIndArrays(float *&vertices, int& nverts,
 }
 
 
-bool KX_NavMeshObject::BuildNavMesh()
+KX_NavMeshObject::BuildData::BuildData()
+	:m_vertices(nullptr),
+	m_dvertices(nullptr),
+	m_polys(nullptr),
+	m_dtris(nullptr),
+	m_dmeshes(nullptr),
+	m_nverts(0),
+	m_npolys(0),
+	m_ndvertsuniq(0),
+	m_ndtris(0),
+	m_vertsPerPoly(0),
+	m_navMesh(nullptr)
 {
-	if (m_navMesh) {
-		delete m_navMesh;
-		m_navMesh = nullptr;
+}
+
+KX_NavMeshObject::BuildData::~BuildData()
+{
+	if (m_vertices) {
+		delete[] m_vertices;
+	}
+	if (m_dvertices) {
+		delete[] m_dvertices;
 	}
 
-	if (m_meshes.empty()) {
-		CM_Error("can't find mesh for navmesh object: " << m_name);
-		return false;
+	// Navmesh conversion is using C guarded alloc for memory allocaitons.
+	if (m_polys) {
+		MEM_freeN(m_polys);
+	}
+	if (m_dmeshes) {
+		MEM_freeN(m_dmeshes);
+	}
+	if (m_dtris) {
+		MEM_freeN(m_dtris);
 	}
 
-	float *vertices = nullptr, *dvertices = nullptr;
-	unsigned short *polys = nullptr, *dtris = nullptr, *dmeshes = nullptr;
-	int nverts = 0, npolys = 0, ndvertsuniq = 0, ndtris = 0;
-	int vertsPerPoly = 0;
-	if (!BuildVertIndArrays(vertices, nverts, polys, npolys, dmeshes, dvertices, ndvertsuniq, dtris, ndtris, vertsPerPoly) ||
-		vertsPerPoly < 3)
-	{
-		CM_Error("can't build navigation mesh data for object: " << m_name);
-		if (vertices) {
-			delete[] vertices;
-		}
-		if (dvertices) {
-			delete[] dvertices;
-		}
-		return false;
+	if (m_navMesh) {
+		delete m_navMesh;
 	}
+}
 
-	mt::vec3 pos;
-	if (dmeshes == nullptr) {
-		for (int i = 0; i < nverts; i++) {
-			flipAxes(&vertices[i * 3]);
+void KX_NavMeshObject::BuildData::Build()
+{
+	if (m_dmeshes == nullptr) {
+		for (int i = 0; i < m_nverts; i++) {
+			flipAxes(&m_vertices[i * 3]);
 		}
-		for (int i = 0; i < ndvertsuniq; i++) {
-			flipAxes(&dvertices[i * 3]);
+		for (int i = 0; i < m_ndvertsuniq; i++) {
+			flipAxes(&m_dvertices[i * 3]);
 		}
 	}
 
-	if (!buildMeshAdjacency(polys, npolys, nverts, vertsPerPoly)) {
+	if (!buildMeshAdjacency(m_polys, m_npolys, m_nverts, m_vertsPerPoly)) {
 		CM_FunctionError("unable to build mesh adjacency information.");
-		delete[] vertices;
-		return false;
+		return;
 	}
 
 	float cs = 0.2f;
 
-	if (!nverts || !npolys) {
-		if (vertices) {
-			delete[] vertices;
-		}
-		return false;
+	if (!m_nverts || !m_npolys) {
+		return;
 	}
 
 	float bmin[3], bmax[3];
-	calcMeshBounds(vertices, nverts, bmin, bmax);
+	calcMeshBounds(m_vertices, m_nverts, bmin, bmax);
 	//quantize vertex pos
-	unsigned short *vertsi = new unsigned short[3 * nverts];
+	unsigned short *vertsi = new unsigned short[3 * m_nverts];
 	float ics = 1.f / cs;
-	for (int i = 0; i < nverts; i++) {
-		vertsi[3 * i + 0] = static_cast<unsigned short>((vertices[3 * i + 0] - bmin[0]) * ics);
-		vertsi[3 * i + 1] = static_cast<unsigned short>((vertices[3 * i + 1] - bmin[1]) * ics);
-		vertsi[3 * i + 2] = static_cast<unsigned short>((vertices[3 * i + 2] - bmin[2]) * ics);
+	for (int i = 0; i < m_nverts; i++) {
+		vertsi[3 * i + 0] = static_cast<unsigned short>((m_vertices[3 * i + 0] - bmin[0]) * ics);
+		vertsi[3 * i + 1] = static_cast<unsigned short>((m_vertices[3 * i + 1] - bmin[1]) * ics);
+		vertsi[3 * i + 2] = static_cast<unsigned short>((m_vertices[3 * i + 2] - bmin[2]) * ics);
 	}
 
 	// Calculate data size
 	const int headerSize = sizeof(dtStatNavMeshHeader);
-	const int vertsSize = sizeof(float) * 3 * nverts;
-	const int polysSize = sizeof(dtStatPoly) * npolys;
-	const int nodesSize = sizeof(dtStatBVNode) * npolys * 2;
-	const int detailMeshesSize = sizeof(dtStatPolyDetail) * npolys;
-	const int detailVertsSize = sizeof(float) * 3 * ndvertsuniq;
-	const int detailTrisSize = sizeof(unsigned char) * 4 * ndtris;
+	const int vertsSize = sizeof(float) * 3 * m_nverts;
+	const int polysSize = sizeof(dtStatPoly) * m_npolys;
+	const int nodesSize = sizeof(dtStatBVNode) * m_npolys * 2;
+	const int detailMeshesSize = sizeof(dtStatPolyDetail) * m_npolys;
+	const int detailVertsSize = sizeof(float) * 3 * m_ndvertsuniq;
+	const int detailTrisSize = sizeof(unsigned char) * 4 * m_ndtris;
 
 	const int dataSize = headerSize + vertsSize + polysSize + nodesSize +
 	                     detailMeshesSize + detailVertsSize + detailTrisSize;
@@ -397,8 +481,8 @@ bool KX_NavMeshObject::BuildNavMesh()
 	// Store header
 	header->magic = DT_STAT_NAVMESH_MAGIC;
 	header->version = DT_STAT_NAVMESH_VERSION;
-	header->npolys = npolys;
-	header->nverts = nverts;
+	header->npolys = m_npolys;
+	header->nverts = m_nverts;
 	header->cs = cs;
 	header->bmin[0] = bmin[0];
 	header->bmin[1] = bmin[1];
@@ -406,12 +490,12 @@ bool KX_NavMeshObject::BuildNavMesh()
 	header->bmax[0] = bmax[0];
 	header->bmax[1] = bmax[1];
 	header->bmax[2] = bmax[2];
-	header->ndmeshes = npolys;
-	header->ndverts = ndvertsuniq;
-	header->ndtris = ndtris;
+	header->ndmeshes = m_npolys;
+	header->ndverts = m_ndvertsuniq;
+	header->ndtris = m_ndtris;
 
 	// Store vertices
-	for (int i = 0; i < nverts; ++i) {
+	for (int i = 0; i < m_nverts; ++i) {
 		const unsigned short *iv = &vertsi[i * 3];
 		float *v = &navVerts[i * 3];
 		v[0] = bmin[0] + iv[0] * cs;
@@ -420,26 +504,26 @@ bool KX_NavMeshObject::BuildNavMesh()
 	}
 
 	// Store polygons.
-	const unsigned short *src = polys;
-	for (int i = 0; i < npolys; ++i) {
+	const unsigned short *src = m_polys;
+	for (int i = 0; i < m_npolys; ++i) {
 		dtStatPoly *p = &navPolys[i];
 		p->nv = 0;
-		for (int j = 0; j < vertsPerPoly; ++j) {
+		for (int j = 0; j < m_vertsPerPoly; ++j) {
 			if (src[j] == 0xffff) {
 				break;
 			}
 			p->v[j] = src[j];
-			p->n[j] = src[vertsPerPoly + j] + 1;
+			p->n[j] = src[m_vertsPerPoly + j] + 1;
 			p->nv++;
 		}
-		src += vertsPerPoly * 2;
+		src += m_vertsPerPoly * 2;
 	}
 
-	header->nnodes = createBVTree(vertsi, nverts, polys, npolys, vertsPerPoly, cs, cs, npolys * 2, navNodes);
+	header->nnodes = createBVTree(vertsi, m_nverts, m_polys, m_npolys, m_vertsPerPoly, cs, cs, m_npolys * 2, navNodes);
 
-	if (!dmeshes) {
+	if (!m_dmeshes) {
 		// Create fake detail meshes.
-		for (int i = 0; i < npolys; ++i) {
+		for (int i = 0; i < m_npolys; ++i) {
 			dtStatPolyDetail& dtl = navDMeshes[i];
 			dtl.vbase = 0;
 			dtl.nverts = 0;
@@ -448,7 +532,7 @@ bool KX_NavMeshObject::BuildNavMesh()
 		}
 		// Setup triangles.
 		unsigned char *tri = navDTris;
-		for (unsigned int i = 0; i < ndtris; i++) {
+		for (unsigned int i = 0; i < m_ndtris; i++) {
 			for (unsigned int j = 0; j < 3; j++) {
 				tri[4 * i + j] = j;
 			}
@@ -456,56 +540,206 @@ bool KX_NavMeshObject::BuildNavMesh()
 	}
 	else {
 		// Vertices.
-		memcpy(navDVerts, dvertices, ndvertsuniq * 3 * sizeof(float));
+		memcpy(navDVerts, m_dvertices, m_ndvertsuniq * 3 * sizeof(float));
 		// Triangles.
 		unsigned char *tri = navDTris;
-		for (unsigned int i = 0; i < ndtris; i++) {
+		for (unsigned int i = 0; i < m_ndtris; i++) {
 			for (unsigned int j = 0; j < 3; j++) {
-				tri[4 * i + j] = dtris[6 * i + j];
+				tri[4 * i + j] = m_dtris[6 * i + j];
 			}
 		}
 		// Detailed meshes.
-		for (int i = 0; i < npolys; ++i) {
+		for (int i = 0; i < m_npolys; ++i) {
 			dtStatPolyDetail& dtl = navDMeshes[i];
-			dtl.vbase = dmeshes[i * 4 + 0];
-			dtl.nverts = dmeshes[i * 4 + 1];
-			dtl.tbase = dmeshes[i * 4 + 2];
-			dtl.ntris = dmeshes[i * 4 + 3];
+			dtl.vbase = m_dmeshes[i * 4 + 0];
+			dtl.nverts = m_dmeshes[i * 4 + 1];
+			dtl.tbase = m_dmeshes[i * 4 + 2];
+			dtl.ntris = m_dmeshes[i * 4 + 3];
 		}
 	}
 
 	m_navMesh = new dtStatNavMesh();
 	m_navMesh->init(data, dataSize, true);
 
-	delete[] vertices;
+	delete[] vertsi;
+}
 
-	// Navmesh conversion is using C guarded alloc for memory allocaitons.
-	MEM_freeN(polys);
-	if (dmeshes) {
-		MEM_freeN(dmeshes);
+
+KX_NavMeshObject::BuildData *KX_NavMeshObject::CreateBuildData()
+{
+	if (m_meshes.empty()) {
+		CM_Error("can't find mesh for navmesh object: " << m_name);
+		return nullptr;
+	}
+
+	BuildData *data = new BuildData();
+	if (!BuildVertIndArrays(data->m_vertices, data->m_nverts, data->m_polys, data->m_npolys, data->m_dmeshes,
+	                        data->m_dvertices, data->m_ndvertsuniq, data->m_dtris, data->m_ndtris, data->m_vertsPerPoly) ||
+		data->m_vertsPerPoly < 3)
+	{
+		CM_Error("can't build navigation mesh data for object: " << m_name);
+		delete data;
+		return nullptr;
+	}
+
+	return data;
+}
+
+void KX_NavMeshObject::SetNavMesh(dtStatNavMesh *navMesh)
+{
+	for (dtStatNavMesh *threadNavMesh : m_threadNavMeshes) {
+		delete threadNavMesh;
+	}
+	m_threadNavMeshes.clear();
+
+	if (m_navMesh) {
+		delete m_navMesh;
+	}
+	m_navMesh = navMesh;
+
+	// The polygon references are not valid anymore.
+	m_pathCache.clear();
+}
+
+void KX_NavMeshObject::ScheduleUpdate()
+{
+	GetScene()->ScheduleNavMeshUpdate(this);
+}
+
+TaskPool *KX_NavMeshObject::GetTaskPool()
+{
+	if (!m_taskPool) {
+		m_taskPool = BLI_task_pool_create(KX_GetActiveEngine()->GetTaskScheduler(), this);
+	}
+	return m_taskPool;
+}
+
+void KX_NavMeshObject::WaitBuild()
+{
+	if (!m_taskPool) {
+		return;
+	}
+
+	BLI_task_pool_work_and_wait(m_taskPool);
+
+	if (!m_buildData) {
+		return;
 	}
-	if (dtris) {
-		MEM_freeN(dtris);
+
+	dtStatNavMesh *navMesh = m_buildData->m_navMesh;
+	m_buildData->m_navMesh = nullptr;
+	delete m_buildData;
+	m_buildData = nullptr;
+
+	if (!navMesh) {
+		CM_Error("unable to build navigation mesh for object: " << m_name);
+		return;
 	}
 
-	if (dvertices) {
-		delete[] dvertices;
+	SetNavMesh(navMesh);
+
+	KX_ObstacleSimulation *obssimulation = GetScene()->GetObstacleSimulation();
+	if (obssimulation) {
+		obssimulation->AddObstaclesForNavMesh(this);
 	}
+}
+
+bool KX_NavMeshObject::BuildNavMesh()
+{
+	WaitBuild();
+	SetNavMesh(nullptr);
 
-	if (vertsi) {
-		delete[] vertsi;
+	BuildData *data = CreateBuildData();
+	if (!data) {
+		return false;
 	}
 
+	data->Build();
+	dtStatNavMesh *navMesh = data->m_navMesh;
+	data->m_navMesh = nullptr;
+	delete data;
+
+	if (!navMesh) {
+		return false;
+	}
+
+	SetNavMesh(navMesh);
 	return true;
 }
 
-dtStatNavMesh *KX_NavMeshObject::GetNavMesh() const
+void KX_NavMeshObject::BuildNavMeshAsync()
 {
-	return m_navMesh;
+	// The conversion of a scene in a thread is already not blocking the game.
+	if (!BLI_thread_is_main()) {
+		if (BuildNavMesh()) {
+			KX_ObstacleSimulation *obssimulation = GetScene()->GetObstacleSimulation();
+			if (obssimulation) {
+				obssimulation->AddObstaclesForNavMesh(this);
+			}
+		}
+		return;
+	}
+
+	WaitBuild();
+	SetNavMesh(nullptr);
+
+	// The mesh is converted in the main thread, only the navigation mesh is built in the task.
+	m_buildData = CreateBuildData();
+	if (!m_buildData) {
+		return;
+	}
+
+	BLI_task_pool_push(GetTaskPool(), build_navmesh_task_func, m_buildData, false, TASK_PRIORITY_LOW);
+	ScheduleUpdate();
+}
+
+void KX_NavMeshObject::UpdateTasks()
+{
+	WaitBuild();
+
+	// The callbacks can request new paths.
+	std::vector<PathRequestPtr> requests;
+	requests.swap(m_pathRequests);
+
+	for (PathRequestPtr& request : requests) {
+		const unsigned int pathLen = request->m_points.size() / 3;
+		request->m_path.resize(pathLen);
+		for (unsigned int i = 0; i < pathLen; ++i) {
+			mt::vec3 waypoint(&request->m_points[i * 3]);
+			flipAxes(waypoint);
+			request->m_path[i] = TransformToWorldCoords(waypoint);
+		}
+		request->m_points.clear();
+		request->m_done = true;
+
+#ifdef WITH_PYTHON
+		if (request->m_callback) {
+			PyObject *args = Py_BuildValue("(N)", pathToPyList(request->m_path));
+			PyObject *ret = PyObject_Call(request->m_callback, args, nullptr);
+			if (ret) {
+				Py_DECREF(ret);
+			}
+			else {
+				PyErr_Print();
+				PyErr_Clear();
+			}
+
+			Py_DECREF(args);
+			Py_DECREF(request->m_callback);
+			request->m_callback = nullptr;
+		}
+#endif  // WITH_PYTHON
+	}
 }
 
-void KX_NavMeshObject::DrawNavMesh(NavMeshRenderMode renderMode) const
+dtStatNavMesh *KX_NavMeshObject::GetNavMesh()
+{
+	WaitBuild();
+	return m_navMesh;
+}
+void KX_NavMeshObject::DrawNavMesh(NavMeshRenderMode renderMode)
 {
+	WaitBuild();
 	if (!m_navMesh) {
 		return;
 	}
@@ -585,10 +819,71 @@ mt::vec3 KX_NavMeshObject::TransformToWorldCoords(const mt::vec3& lpos) const
 	return (NodeGetWorldTransform() * lpos);
 }
 
-KX_NavMeshObject::PathType KX_NavMeshObject::FindPath(const mt::vec3& from, const mt::vec3& to, unsigned int maxPathLen) const
+unsigned int KX_NavMeshObject::FindPolyPath(dtStatNavMesh *navMesh, dtStatPolyRef startRef, dtStatPolyRef endRef,
+                                            const float *from, const float *to, dtStatPolyRef *polys, unsigned int maxPathLen)
+{
+	m_pathCacheLock.Lock();
+	for (CachedPath& cachedPath : m_pathCache) {
+		if (cachedPath.m_start == startRef && cachedPath.m_end == endRef) {
+			cachedPath.m_lastUse = ++m_pathCacheClock;
+			const unsigned int npolys = std::min((unsigned int)cachedPath.m_polys.size(), maxPathLen);
+			std::copy_n(cachedPath.m_polys.begin(), npolys, polys);
+			m_pathCacheLock.Unlock();
+			return npolys;
+		}
+	}
+	m_pathCacheLock.Unlock();
+
+	const unsigned int npolys = navMesh->findPath(startRef, endRef, from, to, polys, maxPathLen);
+	// A path truncated to the maximum length is not cached, a longer path can be requested.
+	if (npolys == 0 || npolys == maxPathLen) {
+		return npolys;
+	}
+
+	m_pathCacheLock.Lock();
+	CachedPath *cachedPath;
+	if (m_pathCache.size() < pathCacheSize) {
+		m_pathCache.emplace_back();
+		cachedPath = &m_pathCache.back();
+	}
+	else {
+		// Replace the least recently used path.
+		cachedPath = &*std::min_element(m_pathCache.begin(), m_pathCache.end(),
+			[](const CachedPath& path1, const CachedPath& path2) { return path1.m_lastUse < path2.m_lastUse; });
+	}
+	cachedPath->m_start = startRef;
+	cachedPath->m_end = endRef;
+	cachedPath->m_polys.assign(polys, polys + npolys);
+	cachedPath->m_lastUse = ++m_pathCacheClock;
+	m_pathCacheLock.Unlock();
+
+	return npolys;
+}
+
+unsigned int KX_NavMeshObject::FindLocalPath(dtStatNavMesh *navMesh, const mt::vec3& localfrom, const mt::vec3& localto,
+                                             float *points, unsigned int maxPathLen)
+{
+	const dtStatPolyRef sPolyRef = navMesh->findNearestPoly(localfrom.Data(), polyPickExt);
+	const dtStatPolyRef ePolyRef = navMesh->findNearestPoly(localto.Data(), polyPickExt);
+
+	if (!sPolyRef || !ePolyRef) {
+		return 0;
+	}
+
+	dtStatPolyRef *polys = (dtStatPolyRef *)BLI_array_alloca(polys, maxPathLen);
+	const unsigned int npolys = FindPolyPath(navMesh, sPolyRef, ePolyRef, localfrom.Data(), localto.Data(), polys, maxPathLen);
+	if (npolys == 0) {
+		return 0;
+	}
+
+	return navMesh->findStraightPath(localfrom.Data(), localto.Data(), polys, npolys, points, maxPathLen);
+}
+
+KX_NavMeshObject::PathType KX_NavMeshObject::FindPath(const mt::vec3& from, const mt::vec3& to, unsigned int maxPathLen)
 {
 	PathType path;
 
+	WaitBuild();
 	if (!m_navMesh) {
 		return path;
 	}
@@ -597,31 +892,69 @@ KX_NavMeshObject::PathType KX_NavMeshObject::FindPath(const mt::vec3& from, cons
 	mt::vec3 localto = TransformToLocalCoords(to);
 	flipAxes(localfrom);
 	flipAxes(localto);
-	dtStatPolyRef sPolyRef = m_navMesh->findNearestPoly(localfrom.Data(), polyPickExt);
-	dtStatPolyRef ePolyRef = m_navMesh->findNearestPoly(localto.Data(), polyPickExt);
-
-	if (sPolyRef && ePolyRef) {
-		dtStatPolyRef *polys = (dtStatPolyRef *)BLI_array_alloca(polys, maxPathLen);
-		const unsigned int npolys = m_navMesh->findPath(sPolyRef, ePolyRef, localfrom.Data(), localto.Data(), polys, maxPathLen);
-		if (npolys > 0) {
-			float(*points)[3] = (float(*)[3])BLI_array_alloca(points, maxPathLen);
-			const unsigned int pathLen = m_navMesh->findStraightPath(localfrom.Data(), localto.Data(), polys, npolys,
-					&points[0][0], maxPathLen);
-
-			path.resize(pathLen);
-			for (unsigned int i = 0; i < pathLen; ++i) {
-				mt::vec3 waypoint(points[i]);
-				flipAxes(waypoint);
-				path[i] = TransformToWorldCoords(waypoint);
+
+	float(*points)[3] = (float(*)[3])BLI_array_alloca(points, maxPathLen);
+	const unsigned int pathLen = FindLocalPath(m_navMesh, localfrom, localto, &points[0][0], maxPathLen);
+
+	path.resize(pathLen);
+	for (unsigned int i = 0; i < pathLen; ++i) {
+		mt::vec3 waypoint(points[i]);
+		flipAxes(waypoint);
+		path[i] = TransformToWorldCoords(waypoint);
+	}
+
+	return path;
+}
+
+KX_NavMeshObject::PathRequestPtr KX_NavMeshObject::RequestPath(const mt::vec3& from, const mt::vec3& to, unsigned int maxPathLen)
+{
+	// The path must not be found in a navigation mesh being built.
+	WaitBuild();
+
+	PathRequestPtr request(new PathRequest());
+	request->m_from = TransformToLocalCoords(from);
+	request->m_to = TransformToLocalCoords(to);
+	flipAxes(request->m_from);
+	flipAxes(request->m_to);
+	request->m_maxPathLen = maxPathLen;
+	request->m_done = false;
+#ifdef WITH_PYTHON
+	request->m_callback = nullptr;
+#endif  // WITH_PYTHON
+
+	m_pathRequests.push_back(request);
+	ScheduleUpdate();
+
+	// Without navigation mesh the request is done with an empty path.
+	if (m_navMesh) {
+		/* The navigation meshes store the search nodes, each thread uses its own navigation
+		 * mesh sharing the data of m_navMesh, including the main thread waiting for the tasks. */
+		if (m_threadNavMeshes.empty()) {
+			const unsigned int numThreads = BLI_task_scheduler_num_threads(KX_GetActiveEngine()->GetTaskScheduler()) + 1;
+			m_threadNavMeshes.resize(numThreads);
+			for (dtStatNavMesh *&threadNavMesh : m_threadNavMeshes) {
+				threadNavMesh = new dtStatNavMesh();
+				threadNavMesh->init(m_navMesh->getData(), m_navMesh->getDataSize(), false);
 			}
 		}
+
+		BLI_task_pool_push(GetTaskPool(), find_path_task_func, request.get(), false, TASK_PRIORITY_LOW);
 	}
 
-	return path;
+	return request;
+}
+
+void KX_NavMeshObject::FindRequestedPath(PathRequest *request, int threadid)
+{
+	request->m_points.resize(request->m_maxPathLen * 3);
+	const unsigned int pathLen = FindLocalPath(m_threadNavMeshes[threadid], request->m_from, request->m_to,
+	                                           request->m_points.data(), request->m_maxPathLen);
+	request->m_points.resize(pathLen * 3);
 }
 
-float KX_NavMeshObject::Raycast(const mt::vec3& from, const mt::vec3& to) const
+float KX_NavMeshObject::Raycast(const mt::vec3& from, const mt::vec3& to)
 {
+	WaitBuild();
 	if (!m_navMesh) {
 		return 0.f;
 	}
@@ -634,7 +967,7 @@ float KX_NavMeshObject::Raycast(const mt::vec3& from, const mt::vec3& to) const
 	dtStatPolyRef sPolyRef = m_navMesh->findNearestPoly(localfrom.Data(), polyPickExt);
 
 	float t = 0.0f;
-	static dtStatPolyRef polys[MAX_PATH_LEN];
+	dtStatPolyRef polys[MAX_PATH_LEN];
 	m_navMesh->raycast(sPolyRef, localfrom.Data(), localto.Data(), t, polys, MAX_PATH_LEN);
 	return t;
 }
@@ -679,6 +1012,7 @@ PyAttributeDef KX_NavMeshObject::Attributes[] = {
 
 PyMethodDef KX_NavMeshObject::Methods[] = {
 	EXP_PYMETHODTABLE(KX_NavMeshObject, findPath),
+	EXP_PYMETHODTABLE(KX_NavMeshObject, findPathAsync),
 	EXP_PYMETHODTABLE(KX_NavMeshObject, raycast),
 	EXP_PYMETHODTABLE(KX_NavMeshObject, draw),
 	EXP_PYMETHODTABLE(KX_NavMeshObject, rebuild),
@@ -699,13 +1033,31 @@ EXP_PYMETHODDEF_DOC(KX_NavMeshObject, findPath,
 	}
 
 	const PathType path = FindPath(from, to, MAX_PATH_LEN);
-	const unsigned int pathLen = path.size();
-	PyObject *pathList = PyList_New(pathLen);
-	for (unsigned int i = 0; i < pathLen; ++i) {
-		PyList_SET_ITEM(pathList, i, PyObjectFrom(path[i]));
+	return pathToPyList(path);
+}
+
+EXP_PYMETHODDEF_DOC(KX_NavMeshObject, findPathAsync,
+                    "findPathAsync(start, goal, callback): find path from start to goal points in a worker thread\n"
+                    "callback is called with the path as list of points at the next logic frame\n")
+{
+	PyObject *ob_from, *ob_to, *callback;
+	if (!PyArg_ParseTuple(args, "OOO:findPathAsync", &ob_from, &ob_to, &callback)) {
+		return nullptr;
+	}
+	mt::vec3 from, to;
+	if (!PyVecTo(ob_from, from) || !PyVecTo(ob_to, to)) {
+		return nullptr;
+	}
+	if (!PyCallable_Check(callback)) {
+		PyErr_SetString(PyExc_TypeError, "navmesh.findPathAsync(start, goal, callback): KX_NavMeshObject, callback is not callable");
+		return nullptr;
 	}
 
-	return pathList;
+	PathRequestPtr request = RequestPath(from, to, MAX_PATH_LEN);
+	Py_INCREF(callback);
+	request->m_callback = callback;
+
+	Py_RETURN_NONE;
 }
 
 EXP_PYMETHODDEF_DOC(KX_NavMeshObject, raycast,
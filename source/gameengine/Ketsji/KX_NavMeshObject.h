@@ -31,21 +31,41 @@
 #include "DetourStatNavMesh.h"
 #include "KX_GameObject.h"
 
+#include "CM_Thread.h"
+
+#include <memory>
+
+struct TaskPool;
+
 class KX_NavMeshObject : public KX_GameObject
 {
 	Py_Header
 
-protected:
-	dtStatNavMesh *m_navMesh;
-
-	bool BuildVertIndArrays(float *&vertices, int& nverts,
-	                        unsigned short * &polys, int& npolys, unsigned short *&dmeshes,
-	                        float *&dvertices, int &ndvertsuniq, unsigned short * &dtris,
-	                        int& ndtris, int &vertsPerPoly);
-
 public:
 	using PathType = std::vector<mt::vec3, mt::simd_allocator<mt::vec3> >;
 
+	/// Path query found by a worker thread and completed at the next logic frame.
+	struct PathRequest : public mt::SimdClassAllocator
+	{
+		/// Start and goal points in the navigation mesh space.
+		mt::vec3 m_from;
+		mt::vec3 m_to;
+		unsigned int m_maxPathLen;
+		/// Path points in the navigation mesh space, written by the worker thread.
+		std::vector<float> m_points;
+		/// Path in world space, valid once the request is done.
+		PathType m_path;
+		bool m_done;
+#ifdef WITH_PYTHON
+		/// Python function called with the path once the request is done.
+		PyObject *m_callback;
+#endif  // WITH_PYTHON
+	};
+	using PathRequestPtr = std::shared_ptr<PathRequest>;
+
+	/// Arrays converted from the mesh to build the navigation mesh.
+	struct BuildData;
+
 	enum NavMeshRenderMode
 	{
 		RM_WALLS,
@@ -54,6 +74,62 @@ public:
 		RM_MAX
 	};
 
+protected:
+	/// Polygon corridor found between two polygons.
+	struct CachedPath
+	{
+		dtStatPolyRef m_start;
+		dtStatPolyRef m_end;
+		std::vector<dtStatPolyRef> m_polys;
+		/// Value of the cache clock at the last use of the path.
+		unsigned int m_lastUse;
+	};
+
+	dtStatNavMesh *m_navMesh;
+	/// Navigation meshes using the data of m_navMesh for the path requests, indexed by the task thread id.
+	std::vector<dtStatNavMesh *> m_threadNavMeshes;
+
+	/// Least recently used cache of the polygon corridors.
+	std::vector<CachedPath> m_pathCache;
+	unsigned int m_pathCacheClock;
+	CM_ThreadSpinLock m_pathCacheLock;
+
+	/// Pool of the tasks building the navigation mesh and finding the requested paths.
+	TaskPool *m_taskPool;
+	/// Data of the navigation mesh built in a task, nullptr if no build is pending.
+	BuildData *m_buildData;
+	/// Path requests of the current frame.
+	std::vector<PathRequestPtr> m_pathRequests;
+
+	bool BuildVertIndArrays(float *&vertices, int& nverts,
+	                        unsigned short * &polys, int& npolys, unsigned short *&dmeshes,
+	                        float *&dvertices, int &ndvertsuniq, unsigned short * &dtris,
+	                        int& ndtris, int &vertsPerPoly);
+
+	/// Convert the mesh to the build data, return nullptr on failure.
+	BuildData *CreateBuildData();
+	/// Use the navigation mesh of a finished build.
+	void SetNavMesh(dtStatNavMesh *navMesh);
+	/// Ask the scene to call UpdateTasks at the next logic frame.
+	void ScheduleUpdate();
+	TaskPool *GetTaskPool();
+	/// Wait for the pending tasks and use the navigation mesh of a pending build.
+	void WaitBuild();
+
+	/** Find the polygon corridor between two polygons using the cache.
+	 * \return The number of polygons written.
+	 */
+	unsigned int FindPolyPath(dtStatNavMesh *navMesh, dtStatPolyRef startRef, dtStatPolyRef endRef, const float *from,
+	                          const float *to, dtStatPolyRef *polys, unsigned int maxPathLen);
+	/** Find a straight path in the navigation mesh space, thread safe as long as each
+	 * thread uses its own navigation mesh.
+	 * \param points The path points, using maxPathLen points.
+	 * \return The number of points written.
+	 */
+	unsigned int FindLocalPath(dtStatNavMesh *navMesh, const mt::vec3& localfrom, const mt::vec3& localto,
+	                           float *points, unsigned int maxPathLen);
+
+public:
 	KX_NavMeshObject(void *sgReplicationInfo, SG_Callbacks callbacks);
 	virtual ~KX_NavMeshObject();
 
@@ -62,12 +138,23 @@ public:
 	virtual int GetGameObjectType() const;
 
 	bool BuildNavMesh();
-	dtStatNavMesh *GetNavMesh() const;
-
-	PathType FindPath(const mt::vec3& from, const mt::vec3& to, unsigned int maxPathLen) const;
-	float Raycast(const mt::vec3& from, const mt::vec3& to) const;
-
-	void DrawNavMesh(NavMeshRenderMode mode) const;
+	/** Build the navigation mesh in a worker thread, the navigation mesh and its
+	 * obstacles are added at the next logic frame or at the first use.
+	 */
+	void BuildNavMeshAsync();
+	dtStatNavMesh *GetNavMesh();
+
+	/// Wait for the pending tasks, finish the navigation mesh build and complete the path requests.
+	void UpdateTasks();
+
+	PathType FindPath(const mt::vec3& from, const mt::vec3& to, unsigned int maxPathLen);
+	/// Queue a path query processed by a worker thread, the request is done at the next logic frame.
+	PathRequestPtr RequestPath(const mt::vec3& from, const mt::vec3& to, unsigned int maxPathLen);
+	/// Find the path of a request, called by the tasks.
+	void FindRequestedPath(PathRequest *request, int threadid);
+	float Raycast(const mt::vec3& from, const mt::vec3& to);
+
+	void DrawNavMesh(NavMeshRenderMode mode);
 	void DrawPath(const PathType& path, const mt::vec4& color) const;
 
 	mt::vec3 TransformToLocalCoords(const mt::vec3& wpos) const;
@@ -76,6 +163,7 @@ public:
 #ifdef WITH_PYTHON
 
 	EXP_PYMETHOD_DOC(KX_NavMeshObject, findPath);
+	EXP_PYMETHOD_DOC(KX_NavMeshObject, findPathAsync);
 	EXP_PYMETHOD_DOC(KX_NavMeshObject, raycast);
 	EXP_PYMETHOD_DOC(KX_NavMeshObject, draw);
 	EXP_PYMETHOD_DOC_NOARGS(KX_NavMeshObject, rebuild);
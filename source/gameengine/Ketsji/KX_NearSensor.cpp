@@ -157,6 +157,12 @@ void KX_NearSensor::SetPhysCtrlRadius()
 	}
 }
 
+bool KX_NearSensor::IsEventDriven() const
+{
+	// The near and radar sensors update their shape every frame.
+	return false;
+}
+
 bool KX_NearSensor::Evaluate()
 {
 	bool result = false;
@@ -71,6 +71,7 @@ public:
 	virtual void ProcessReplica();
 	virtual void SetPhysCtrlRadius();
 	virtual bool Evaluate();
+	virtual bool IsEventDriven() const;
 
 	virtual void ReParent(SCA_IObject* parent);
 
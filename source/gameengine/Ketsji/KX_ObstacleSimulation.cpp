@@ -28,9 +28,18 @@
 
 #include "KX_ObstacleSimulation.h"
 #include "KX_NavMeshObject.h"
+#include "KX_SteeringActuator.h"
 #include "KX_Globals.h"
 #include "DNA_object_types.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
+
+#include <algorithm>
+
+/// Maximum number of cells of the obstacle grid per axis.
+static const int maxGridSize = 256;
+/// Minimum number of velocity requests to process them in parallel.
+static const unsigned int parallelRequests = 16;
 
 namespace
 {
@@ -169,8 +178,52 @@ static float interpolateToi(float a, const float* dir, const float* toi, const i
 	return 0;
 }
 
+static mt::vec3 nearestPointToObstacle(mt::vec3& pos ,KX_Obstacle* obstacle)
+{
+	switch (obstacle->m_shape)
+	{
+	case KX_OBSTACLE_SEGMENT :
+	{
+		mt::vec3 ab = obstacle->m_pos2 - obstacle->m_pos;
+		if (!mt::FuzzyZero(ab))
+		{
+			const float dist = ab.Length();
+			mt::vec3 abdir = ab.Normalized();
+			mt::vec3  v = pos - obstacle->m_pos;
+			float proj = mt::dot(abdir, v);
+			CLAMP(proj, 0, dist);
+			mt::vec3 res = obstacle->m_pos + abdir*proj;
+			return res;
+		}
+		ATTR_FALLTHROUGH;
+	}
+	case KX_OBSTACLE_CIRCLE :
+	default:
+		return obstacle->m_pos;
+	}
+}
+
+static bool filterObstacle(KX_Obstacle* activeObst, KX_NavMeshObject* activeNavMeshObj, KX_Obstacle* otherObst,
+							float levelHeight)
+{
+	//filter obstacles by type
+	if ( (otherObst == activeObst) ||
+		(otherObst->m_type==KX_OBSTACLE_NAV_MESH && otherObst->m_gameObj!=activeNavMeshObj)	)
+		return false;
+
+	//filter obstacles by position
+	mt::vec3 p = nearestPointToObstacle(activeObst->m_pos, otherObst);
+	if ( fabsf(activeObst->m_pos.z - p.z) > levelHeight)
+		return false;
+
+	return true;
+}
+
 KX_ObstacleSimulation::KX_ObstacleSimulation(float levelHeight, bool enableVisualization)
-:	m_levelHeight(levelHeight)
+:	m_gridValid(false)
+,	m_maxCircleRadius(0.0f)
+,	m_maxCircleSpeed(0.0f)
+,	m_levelHeight(levelHeight)
 ,	m_enableVisualization(enableVisualization)
 {
 
@@ -199,6 +252,10 @@ KX_Obstacle* KX_ObstacleSimulation::CreateObstacle(KX_GameObject* gameobj)
 	obstacle->hhead = 0;
 
 	m_obstacles.push_back(obstacle);
+	// Keep the first obstacle of an object, the navigation meshes own several segments.
+	m_objectObstacles.emplace(gameobj, obstacle);
+	m_gridValid = false;
+
 	return obstacle;
 }
 
@@ -209,6 +266,7 @@ void KX_ObstacleSimulation::AddObstacleForObj(KX_GameObject* gameobj)
 	obstacle->m_type = KX_OBSTACLE_OBJ;
 	obstacle->m_shape = KX_OBSTACLE_CIRCLE;
 	obstacle->m_rad = blenderobject->obstacleRad;
+	obstacle->m_pos = gameobj->NodeGetWorldPosition();
 }
 
 void KX_ObstacleSimulation::AddObstaclesForNavMesh(KX_NavMeshObject* navmeshobj)
@@ -240,6 +298,16 @@ void KX_ObstacleSimulation::AddObstaclesForNavMesh(KX_NavMeshObject* navmeshobj)
 
 void KX_ObstacleSimulation::DestroyObstacleForObj(KX_GameObject* gameobj)
 {
+	if (m_objectObstacles.erase(gameobj) == 0) {
+		return;
+	}
+
+	m_velocityRequests.erase(std::remove_if(m_velocityRequests.begin(), m_velocityRequests.end(),
+		[gameobj](const KX_ObstacleVelocityRequest& request) { return request.m_obstacle->m_gameObj == gameobj; }),
+		m_velocityRequests.end());
+
+	m_gridValid = false;
+
 	for (size_t i=0; i<m_obstacles.size(); )
 	{
 		if (m_obstacles[i]->m_gameObj == gameobj)
@@ -274,22 +342,242 @@ void KX_ObstacleSimulation::UpdateObstacles()
 			add_v2_v2v2(obs->pvel, obs->pvel, &obs->hvel[j * 2]);
 		mul_v2_fl(obs->pvel, 1.0f / VEL_HIST_SIZE);
 	}
+
+	// The grid is rebuilt at the first velocity adjustment of the frame.
+	m_gridValid = false;
+}
+
+static void obstacleBounds(const KX_Obstacle *obstacle, float min[2], float max[2])
+{
+	if (obstacle->m_shape == KX_OBSTACLE_SEGMENT) {
+		min[0] = std::min(obstacle->m_worldPos.x, obstacle->m_worldPos2.x) - obstacle->m_rad;
+		min[1] = std::min(obstacle->m_worldPos.y, obstacle->m_worldPos2.y) - obstacle->m_rad;
+		max[0] = std::max(obstacle->m_worldPos.x, obstacle->m_worldPos2.x) + obstacle->m_rad;
+		max[1] = std::max(obstacle->m_worldPos.y, obstacle->m_worldPos2.y) + obstacle->m_rad;
+	}
+	else {
+		// The circle radius is added to the queries.
+		min[0] = max[0] = obstacle->m_pos.x;
+		min[1] = max[1] = obstacle->m_pos.y;
+	}
+}
+
+void KX_ObstacleSimulation::BuildGrid()
+{
+	m_gridValid = true;
+	m_maxCircleRadius = 0.0f;
+	m_maxCircleSpeed = 0.0f;
+
+	m_grid.m_width = 0;
+	m_grid.m_height = 0;
+	m_grid.m_cellStart.assign(1, 0);
+	m_grid.m_cellObstacles.clear();
+
+	if (m_obstacles.empty()) {
+		return;
+	}
+
+	float gridMin[2] = {FLT_MAX, FLT_MAX};
+	float gridMax[2] = {-FLT_MAX, -FLT_MAX};
+	for (KX_Obstacle *obs : m_obstacles) {
+		if (obs->m_shape == KX_OBSTACLE_SEGMENT) {
+			if (obs->m_type == KX_OBSTACLE_NAV_MESH) {
+				KX_NavMeshObject *navmeshobj = static_cast<KX_NavMeshObject *>(obs->m_gameObj);
+				obs->m_worldPos = navmeshobj->TransformToWorldCoords(obs->m_pos);
+				obs->m_worldPos2 = navmeshobj->TransformToWorldCoords(obs->m_pos2);
+			}
+			else {
+				obs->m_worldPos = obs->m_pos;
+				obs->m_worldPos2 = obs->m_pos2;
+			}
+		}
+		else {
+			m_maxCircleRadius = std::max(m_maxCircleRadius, obs->m_rad);
+			m_maxCircleSpeed = std::max(m_maxCircleSpeed, len_v2(obs->vel));
+		}
+
+		float min[2], max[2];
+		obstacleBounds(obs, min, max);
+		gridMin[0] = std::min(gridMin[0], min[0]);
+		gridMin[1] = std::min(gridMin[1], min[1]);
+		gridMax[0] = std::max(gridMax[0], max[0]);
+		gridMax[1] = std::max(gridMax[1], max[1]);
+	}
+
+	/* Use about one cell per obstacle without splitting the circles,
+	 * the grid size is limited for sparse obstacles. */
+	const float sizeX = gridMax[0] - gridMin[0];
+	const float sizeY = gridMax[1] - gridMin[1];
+	float cellSize = std::max(sqrtf(sizeX * sizeY / (float)m_obstacles.size()), m_maxCircleRadius * 2.0f);
+	cellSize = std::max(cellSize, std::max(sizeX, sizeY) / (float)(maxGridSize - 1));
+	cellSize = std::max(cellSize, 0.01f);
+
+	m_grid.m_min[0] = gridMin[0];
+	m_grid.m_min[1] = gridMin[1];
+	m_grid.m_cellSize = cellSize;
+	m_grid.m_width = std::min((int)(sizeX / cellSize) + 1, maxGridSize);
+	m_grid.m_height = std::min((int)(sizeY / cellSize) + 1, maxGridSize);
+
+	const unsigned int numCells = m_grid.m_width * m_grid.m_height;
+	std::vector<unsigned int>& cellStart = m_grid.m_cellStart;
+	cellStart.assign(numCells + 1, 0);
+
+	// Count the obstacles per cell, then fill the cells from their end.
+	for (unsigned short pass = 0; pass < 2; ++pass) {
+		for (unsigned int i = 0, size = m_obstacles.size(); i < size; ++i) {
+			float min[2], max[2];
+			obstacleBounds(m_obstacles[i], min, max);
+			const int x0 = std::min((int)((min[0] - gridMin[0]) / cellSize), m_grid.m_width - 1);
+			const int y0 = std::min((int)((min[1] - gridMin[1]) / cellSize), m_grid.m_height - 1);
+			const int x1 = std::min((int)((max[0] - gridMin[0]) / cellSize), m_grid.m_width - 1);
+			const int y1 = std::min((int)((max[1] - gridMin[1]) / cellSize), m_grid.m_height - 1);
+
+			for (int y = y0; y <= y1; ++y) {
+				for (int x = x0; x <= x1; ++x) {
+					const unsigned int cell = y * m_grid.m_width + x;
+					if (pass == 0) {
+						++cellStart[cell + 1];
+					}
+					else {
+						m_grid.m_cellObstacles[--cellStart[cell + 1]] = i;
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			// Turn the counts into the end index of each cell.
+			for (unsigned int cell = 1; cell <= numCells; ++cell) {
+				cellStart[cell] += cellStart[cell - 1];
+			}
+			m_grid.m_cellObstacles.resize(cellStart[numCells]);
+		}
+	}
+
+	// Filling from the end moved the end index of each cell to its start, one index further.
+	cellStart.erase(cellStart.begin());
+	cellStart.push_back(m_grid.m_cellObstacles.size());
+}
+
+void KX_ObstacleSimulation::FindNeighbors(KX_Obstacle *activeObst, KX_NavMeshObject *activeNavMeshObj, float radius,
+                                          KX_Obstacles& neighbors) const
+{
+	if (m_grid.m_width == 0) {
+		return;
+	}
+
+	radius += m_maxCircleRadius;
+	const float cellSize = m_grid.m_cellSize;
+	const int x0 = (int)floorf((activeObst->m_pos.x - radius - m_grid.m_min[0]) / cellSize);
+	const int y0 = (int)floorf((activeObst->m_pos.y - radius - m_grid.m_min[1]) / cellSize);
+	const int x1 = (int)floorf((activeObst->m_pos.x + radius - m_grid.m_min[0]) / cellSize);
+	const int y1 = (int)floorf((activeObst->m_pos.y + radius - m_grid.m_min[1]) / cellSize);
+
+	if (x1 < 0 || y1 < 0 || x0 >= m_grid.m_width || y0 >= m_grid.m_height) {
+		return;
+	}
+
+	std::vector<unsigned int> indices;
+	for (int y = std::max(y0, 0), ymax = std::min(y1, m_grid.m_height - 1); y <= ymax; ++y) {
+		for (int x = std::max(x0, 0), xmax = std::min(x1, m_grid.m_width - 1); x <= xmax; ++x) {
+			const unsigned int cell = y * m_grid.m_width + x;
+			indices.insert(indices.end(), m_grid.m_cellObstacles.begin() + m_grid.m_cellStart[cell],
+			               m_grid.m_cellObstacles.begin() + m_grid.m_cellStart[cell + 1]);
+		}
+	}
+
+	// The segments can be stored in several cells.
+	std::sort(indices.begin(), indices.end());
+	indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+	for (unsigned int index : indices) {
+		KX_Obstacle *obstacle = m_obstacles[index];
+		if (filterObstacle(activeObst, activeNavMeshObj, obstacle, m_levelHeight)) {
+			neighbors.push_back(obstacle);
+		}
+	}
 }
 
 KX_Obstacle* KX_ObstacleSimulation::GetObstacle(KX_GameObject* gameobj)
 {
-	for (size_t i=0; i<m_obstacles.size(); i++)
-	{
-		if (m_obstacles[i]->m_gameObj == gameobj)
-			return m_obstacles[i];
+	const auto it = m_objectObstacles.find(gameobj);
+	if (it == m_objectObstacles.end()) {
+		return nullptr;
 	}
 
-	return nullptr;
+	return it->second;
+}
+
+void KX_ObstacleSimulation::ComputeObstacleVelocity(KX_Obstacle *activeObst, KX_NavMeshObject *activeNavMeshObj,
+                                                    float velocity[2], float maxDeltaSpeed, float maxDeltaAngle)
+{
+	copy_v2_v2(velocity, activeObst->dvel);
 }
 
-void KX_ObstacleSimulation::AdjustObstacleVelocity(KX_Obstacle* activeObst, KX_NavMeshObject* activeNavMeshObj, 
+void KX_ObstacleSimulation::AdjustObstacleVelocity(KX_Obstacle* activeObst, KX_NavMeshObject* activeNavMeshObj,
 										mt::vec3& velocity, float maxDeltaSpeed,float maxDeltaAngle)
 {
+	vset(activeObst->dvel, velocity.x, velocity.y);
+
+	if (!m_gridValid) {
+		BuildGrid();
+	}
+
+	float vel[2];
+	ComputeObstacleVelocity(activeObst, activeNavMeshObj, vel, maxDeltaSpeed, maxDeltaAngle);
+
+	velocity.x = vel[0];
+	velocity.y = vel[1];
+}
+
+void KX_ObstacleSimulation::RequestObstacleVelocity(KX_SteeringActuator *actuator, KX_Obstacle *activeObst,
+                                                    KX_NavMeshObject *activeNavMeshObj, const mt::vec3& velocity,
+                                                    float maxDeltaSpeed, float maxDeltaAngle)
+{
+	vset(activeObst->dvel, velocity.x, velocity.y);
+
+	KX_ObstacleVelocityRequest request;
+	request.m_actuator = actuator;
+	request.m_obstacle = activeObst;
+	request.m_navmesh = activeNavMeshObj;
+	request.m_maxDeltaSpeed = maxDeltaSpeed;
+	request.m_maxDeltaAngle = maxDeltaAngle;
+	m_velocityRequests.push_back(request);
+}
+
+void KX_ObstacleSimulation::ProcessVelocityRequests()
+{
+	if (m_velocityRequests.empty()) {
+		return;
+	}
+
+	if (!m_gridValid) {
+		BuildGrid();
+	}
+
+	// The grid and the other obstacles are read only, each request modifies its own obstacle.
+	const unsigned int numRequests = m_velocityRequests.size();
+	if (numRequests >= parallelRequests) {
+		BLI_task_parallel_range(0, numRequests, this, [](void *userdata, const int iter) {
+			KX_ObstacleSimulation *self = (KX_ObstacleSimulation *)userdata;
+			KX_ObstacleVelocityRequest& request = self->m_velocityRequests[iter];
+			self->ComputeObstacleVelocity(request.m_obstacle, request.m_navmesh, request.m_velocity,
+			                              request.m_maxDeltaSpeed, request.m_maxDeltaAngle);
+		}, true);
+	}
+	else {
+		for (KX_ObstacleVelocityRequest& request : m_velocityRequests) {
+			ComputeObstacleVelocity(request.m_obstacle, request.m_navmesh, request.m_velocity,
+			                        request.m_maxDeltaSpeed, request.m_maxDeltaAngle);
+		}
+	}
+
+	// Apply the velocities in the request order.
+	for (const KX_ObstacleVelocityRequest& request : m_velocityRequests) {
+		request.m_actuator->ApplyObstacleVelocity(mt::vec2(request.m_velocity));
+	}
+
+	m_velocityRequests.clear();
 }
 
 void KX_ObstacleSimulation::DrawObstacles()
@@ -330,47 +618,6 @@ void KX_ObstacleSimulation::DrawObstacles()
 	}
 }
 
-static mt::vec3 nearestPointToObstacle(mt::vec3& pos ,KX_Obstacle* obstacle)
-{
-	switch (obstacle->m_shape)
-	{
-	case KX_OBSTACLE_SEGMENT :
-	{
-		mt::vec3 ab = obstacle->m_pos2 - obstacle->m_pos;
-		if (!mt::FuzzyZero(ab))
-		{
-			const float dist = ab.Length();
-			mt::vec3 abdir = ab.Normalized();
-			mt::vec3  v = pos - obstacle->m_pos;
-			float proj = mt::dot(abdir, v);
-			CLAMP(proj, 0, dist);
-			mt::vec3 res = obstacle->m_pos + abdir*proj;
-			return res;
-		}
-		ATTR_FALLTHROUGH;
-	}
-	case KX_OBSTACLE_CIRCLE :
-	default:
-		return obstacle->m_pos;
-	}
-}
-
-static bool filterObstacle(KX_Obstacle* activeObst, KX_NavMeshObject* activeNavMeshObj, KX_Obstacle* otherObst,
-							float levelHeight)
-{
-	//filter obstacles by type
-	if ( (otherObst == activeObst) ||
-		(otherObst->m_type==KX_OBSTACLE_NAV_MESH && otherObst->m_gameObj!=activeNavMeshObj)	)
-		return false;
-
-	//filter obstacles by position
-	mt::vec3 p = nearestPointToObstacle(activeObst->m_pos, otherObst);
-	if ( fabsf(activeObst->m_pos.z - p.z) > levelHeight)
-		return false;
-
-	return true;
-}
-
 ///////////*********TOI_rays**********/////////////////
 KX_ObstacleSimulationTOI::KX_ObstacleSimulationTOI(float levelHeight, bool enableVisualization)
 :	KX_ObstacleSimulation(levelHeight, enableVisualization),
@@ -385,30 +632,26 @@ KX_ObstacleSimulationTOI::KX_ObstacleSimulationTOI(float levelHeight, bool enabl
 }
 
 
-void KX_ObstacleSimulationTOI::AdjustObstacleVelocity(KX_Obstacle* activeObst, KX_NavMeshObject* activeNavMeshObj, 
-                                                      mt::vec3& velocity, float maxDeltaSpeed, float maxDeltaAngle)
+float KX_ObstacleSimulationTOI::GetNeighborRadius(KX_Obstacle *activeObst, float relativeSpeed) const
 {
-	int nobs = m_obstacles.size();
-	int obstidx = std::find(m_obstacles.begin(), m_obstacles.end(), activeObst) - m_obstacles.begin();
-	if (obstidx == nobs)
-		return;
-
-	vset(activeObst->dvel, velocity.x, velocity.y);
+	/* An obstacle further than the distance covered at the relative speed during the max TOI
+	 * has a time of impact greater than the max TOI and is ignored by the sampling. */
+	return (relativeSpeed + m_maxCircleSpeed) * m_maxToi + std::max(activeObst->m_rad, 0.01f);
+}
 
+void KX_ObstacleSimulationTOI::ComputeObstacleVelocity(KX_Obstacle *activeObst, KX_NavMeshObject *activeNavMeshObj,
+                                                       float velocity[2], float maxDeltaSpeed, float maxDeltaAngle)
+{
 	//apply RVO
 	sampleRVO(activeObst, activeNavMeshObj, maxDeltaAngle);
 
 	// Fake dynamic constraint.
 	float dv[2];
-	float vel[2];
 	sub_v2_v2v2(dv, activeObst->nvel, activeObst->vel);
 	float ds = len_v2(dv);
 	if (ds > maxDeltaSpeed || ds<-maxDeltaSpeed)
 		mul_v2_fl(dv, fabs(maxDeltaSpeed / ds));
-	add_v2_v2v2(vel, activeObst->vel, dv);
-
-	velocity.x = vel[0];
-	velocity.y = vel[1];
+	add_v2_v2v2(velocity, activeObst->vel, dv);
 }
 
 ///////////*********TOI_rays**********/////////////////
@@ -457,7 +700,11 @@ void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle* activeObst, KX_NavMes
 	const int iforw = m_maxSamples/2;
 	const float aoff = (float)iforw / (float)m_maxSamples;
 
-	size_t nobs = m_obstacles.size();
+	// The relative velocity of a moving obstacle is at most 2 * svel - vel.
+	KX_Obstacles neighbors;
+	FindNeighbors(activeObst, activeNavMeshObj, GetNeighborRadius(activeObst, 3.0f * vmax), neighbors);
+
+	size_t nobs = neighbors.size();
 	for (int iter = 0; iter < m_maxSamples; ++iter)
 	{
 		// Calculate sample velocity
@@ -472,11 +719,7 @@ void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle* activeObst, KX_NavMes
 		float tmine = 0.0f;
 		for (int i = 0; i < nobs; ++i)
 		{
-			KX_Obstacle* ob = m_obstacles[i];
-			bool res = filterObstacle(activeObst, activeNavMeshObj, ob, m_levelHeight);
-			if (!res)
-				continue;
-
+			KX_Obstacle* ob = neighbors[i];
 			float htmin,htmax;
 
 			if (ob->m_shape == KX_OBSTACLE_CIRCLE)
@@ -500,18 +743,8 @@ void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle* activeObst, KX_NavMes
 			}
 			else if (ob->m_shape == KX_OBSTACLE_SEGMENT)
 			{
-				mt::vec3 p1 = ob->m_pos;
-				mt::vec3 p2 = ob->m_pos2;
-				//apply world transform
-				if (ob->m_type == KX_OBSTACLE_NAV_MESH)
-				{
-					KX_NavMeshObject* navmeshobj = static_cast<KX_NavMeshObject*>(ob->m_gameObj);
-					p1 = navmeshobj->TransformToWorldCoords(p1);
-					p2 = navmeshobj->TransformToWorldCoords(p2);
-				}
-
 				if (!sweepCircleSegment(activeObst->m_pos.xy(), activeObst->m_rad, svel,
-				                        p1.xy(), p2.xy(), ob->m_rad, htmin, htmax))
+				                        ob->m_worldPos.xy(), ob->m_worldPos2.xy(), ob->m_rad, htmin, htmax))
 				{
 					continue;
 				}
@@ -582,8 +815,7 @@ void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle* activeObst, KX_NavMes
 
 ///////////********* TOI_cells**********/////////////////
 
-static void processSamples(KX_Obstacle* activeObst, KX_NavMeshObject* activeNavMeshObj, 
-                           KX_Obstacles& obstacles,  float levelHeight, const float vmax,
+static void processSamples(KX_Obstacle* activeObst, const KX_Obstacles& obstacles, const float vmax,
                            const float* spos, const float cs, const int nspos, float* res,
                            float maxToi, float velWeight, float curVelWeight, float sideWeight,
                            float toiWeight)
@@ -616,9 +848,6 @@ static void processSamples(KX_Obstacle* activeObst, KX_NavMeshObject* activeNavM
 		for (int i = 0; i < obstacles.size(); ++i)
 		{
 			KX_Obstacle* ob = obstacles[i];
-			bool found = filterObstacle(activeObst, activeNavMeshObj, ob, levelHeight);
-			if (!found)
-				continue;
 			float htmin, htmax;
 
 			if (ob->m_shape==KX_OBSTACLE_CIRCLE)
@@ -672,18 +901,9 @@ static void processSamples(KX_Obstacle* activeObst, KX_NavMeshObject* activeNavM
 			}
 			else if (ob->m_shape == KX_OBSTACLE_SEGMENT)
 			{
-				mt::vec3 p1 = ob->m_pos;
-				mt::vec3 p2 = ob->m_pos2;
-				//apply world transform
-				if (ob->m_type == KX_OBSTACLE_NAV_MESH)
-				{
-					KX_NavMeshObject* navmeshobj = static_cast<KX_NavMeshObject*>(ob->m_gameObj);
-					p1 = navmeshobj->TransformToWorldCoords(p1);
-					p2 = navmeshobj->TransformToWorldCoords(p2);
-				}
 				float p[2], q[2];
-				vset(p, p1.x, p1.y);
-				vset(q, p2.x, p2.y);
+				vset(p, ob->m_worldPos.x, ob->m_worldPos.y);
+				vset(q, ob->m_worldPos2.x, ob->m_worldPos2.y);
 
 				// NOTE: the segments are assumed to come from a navmesh which is shrunken by
 				// the agent radius, hence the use of really small radius.
@@ -751,6 +971,12 @@ void KX_ObstacleSimulationTOI_cells::sampleRVO(KX_Obstacle* activeObst, KX_NavMe
 	float* spos = new float[2*m_maxSamples];
 	int nspos = 0;
 
+	/* The samples are at most 2 * vmax, their relative velocity to a moving obstacle is
+	 * 2 * sample - vel - obstacle vel. */
+	KX_Obstacles neighbors;
+	FindNeighbors(activeObst, activeNavMeshObj, GetNeighborRadius(activeObst, 4.0f * vmax + len_v2(activeObst->vel)),
+	              neighbors);
+
 	if (!m_adaptive)
 	{
 		const float cvx = activeObst->dvel[0]*m_bias;
@@ -773,7 +999,7 @@ void KX_ObstacleSimulationTOI_cells::sampleRVO(KX_Obstacle* activeObst, KX_NavMe
 				}
 			}
 		}
-		processSamples(activeObst, activeNavMeshObj, m_obstacles, m_levelHeight, vmax, spos, cs/2, 
+		processSamples(activeObst, neighbors, vmax, spos, cs/2, 
 			nspos,  activeObst->nvel, m_maxToi, m_velWeight, m_curVelWeight, m_collisionWeight, m_toiWeight);
 	}
 	else
@@ -808,7 +1034,7 @@ void KX_ObstacleSimulationTOI_cells::sampleRVO(KX_Obstacle* activeObst, KX_NavMe
 				}
 			}
 
-			processSamples(activeObst, activeNavMeshObj, m_obstacles, m_levelHeight, vmax, spos, cs/2,
+			processSamples(activeObst, neighbors, vmax, spos, cs/2,
 			               nspos,  res, m_maxToi, m_velWeight, m_curVelWeight, m_collisionWeight, m_toiWeight);
 
 			cs *= 0.5f;
@@ -27,10 +27,12 @@
 #define __KX_OBSTACLESIMULATION_H__
 
 #include <vector>
+#include <unordered_map>
 #include "mathfu.h"
 
 class KX_GameObject;
 class KX_NavMeshObject;
+class KX_SteeringActuator;
 
 enum KX_OBSTACLE_TYPE
 {
@@ -51,6 +53,9 @@ struct KX_Obstacle : mt::SimdClassAllocator
 	KX_OBSTACLE_SHAPE m_shape;
 	mt::vec3 m_pos;
 	mt::vec3 m_pos2;
+	/// World space end points of a segment, updated with the obstacle grid.
+	mt::vec3 m_worldPos;
+	mt::vec3 m_worldPos2;
 	float m_rad;
 	
 	float vel[2];
@@ -65,15 +70,69 @@ struct KX_Obstacle : mt::SimdClassAllocator
 };
 typedef std::vector<KX_Obstacle*> KX_Obstacles;
 
+/// Velocity adjustment requested by a steering actuator during the logic.
+struct KX_ObstacleVelocityRequest
+{
+	KX_SteeringActuator *m_actuator;
+	KX_Obstacle *m_obstacle;
+	KX_NavMeshObject *m_navmesh;
+	float m_maxDeltaSpeed;
+	float m_maxDeltaAngle;
+	/// The adjusted velocity.
+	float m_velocity[2];
+};
+
 class KX_ObstacleSimulation
 {
 protected:
+	/** Uniform grid over the XY plane storing the obstacle indices per cell.
+	 * A circle is stored in the cell of its center and a segment in all the cells
+	 * overlapping its bounding box.
+	 */
+	struct Grid
+	{
+		float m_min[2];
+		float m_cellSize;
+		int m_width;
+		int m_height;
+		/// Index of the first obstacle of each cell in m_cellObstacles, plus the end index.
+		std::vector<unsigned int> m_cellStart;
+		std::vector<unsigned int> m_cellObstacles;
+	};
+
 	KX_Obstacles m_obstacles;
+	/// The first obstacle of each game object.
+	std::unordered_map<KX_GameObject *, KX_Obstacle *> m_objectObstacles;
+
+	Grid m_grid;
+	/// False when the obstacles were updated, added or removed since the last grid build.
+	bool m_gridValid;
+	/// Maximum radius and speed of the circle obstacles, used to extend the neighbor queries.
+	float m_maxCircleRadius;
+	float m_maxCircleSpeed;
+
+	std::vector<KX_ObstacleVelocityRequest> m_velocityRequests;
 
 	float m_levelHeight;
 	bool m_enableVisualization;
 
 	KX_Obstacle* CreateObstacle(KX_GameObject* gameobj);
+
+	/// Rebuild the obstacle grid from the current obstacle positions.
+	void BuildGrid();
+	/** Find the obstacles which are not filtered for an active obstacle in a radius
+	 * around it, the radius is extended by the biggest circle radius.
+	 * The neighbors are sorted in the obstacle list order.
+	 */
+	void FindNeighbors(KX_Obstacle *activeObst, KX_NavMeshObject *activeNavMeshObj, float radius,
+	                   KX_Obstacles& neighbors) const;
+
+	/** Compute the steering velocity of an obstacle from its desired velocity.
+	 * Called in parallel for the velocity requests, it must only modify the active obstacle.
+	 */
+	virtual void ComputeObstacleVelocity(KX_Obstacle *activeObst, KX_NavMeshObject *activeNavMeshObj,
+	                                     float velocity[2], float maxDeltaSpeed, float maxDeltaAngle);
+
 public:
 	KX_ObstacleSimulation(float levelHeight, bool enableVisualization);
 	virtual ~KX_ObstacleSimulation();
@@ -86,9 +145,20 @@ public:
 	void AddObstaclesForNavMesh(KX_NavMeshObject* navmesh);
 	KX_Obstacle* GetObstacle(KX_GameObject* gameobj);
 	void UpdateObstacles();
-	virtual void AdjustObstacleVelocity(KX_Obstacle* activeObst, KX_NavMeshObject* activeNavMeshObj, 
-	                                    mt::vec3& velocity, float maxDeltaSpeed,float maxDeltaAngle);
-
+	/// Adjust immediately the velocity of a single obstacle.
+	void AdjustObstacleVelocity(KX_Obstacle* activeObst, KX_NavMeshObject* activeNavMeshObj,
+	                            mt::vec3& velocity, float maxDeltaSpeed,float maxDeltaAngle);
+
+	/** Request the adjustment of the velocity of an obstacle, the desired velocity of
+	 * the obstacle is set immediately and the adjusted velocity is given to the actuator
+	 * in ProcessVelocityRequests.
+	 */
+	void RequestObstacleVelocity(KX_SteeringActuator *actuator, KX_Obstacle *activeObst, KX_NavMeshObject *activeNavMeshObj,
+	                             const mt::vec3& velocity, float maxDeltaSpeed, float maxDeltaAngle);
+	/** Adjust the velocities of all the requests in parallel and apply them to the actuators.
+	 * All the obstacles see the desired velocities of the others of the current frame.
+	 */
+	void ProcessVelocityRequests();
 };
 class KX_ObstacleSimulationTOI: public KX_ObstacleSimulation
 {
@@ -101,12 +171,15 @@ protected:
 	float m_toiWeight;				// Sample selection TOI weight
 	float m_collisionWeight;		// Sample selection collision weight
 
+	/// Return the radius containing the obstacles reachable before the max TOI with a relative speed.
+	float GetNeighborRadius(KX_Obstacle *activeObst, float relativeSpeed) const;
+
 	virtual void sampleRVO(KX_Obstacle* activeObst, KX_NavMeshObject* activeNavMeshObj, 
 							const float maxDeltaAngle) = 0;
+	virtual void ComputeObstacleVelocity(KX_Obstacle *activeObst, KX_NavMeshObject *activeNavMeshObj,
+	                                     float velocity[2], float maxDeltaSpeed, float maxDeltaAngle);
 public:
 	KX_ObstacleSimulationTOI(float levelHeight, bool enableVisualization);
-	virtual void AdjustObstacleVelocity(KX_Obstacle* activeObst, KX_NavMeshObject* activeNavMeshObj, 
-		mt::vec3& velocity, float maxDeltaSpeed,float maxDeltaAngle);
 };
 
 class KX_ObstacleSimulationTOI_rays: public KX_ObstacleSimulationTOI
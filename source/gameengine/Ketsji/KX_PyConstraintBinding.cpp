@@ -124,6 +124,14 @@ PyDoc_STRVAR(gPySetSolverType__doc__,
 "setSolverType(int solverType)\n"
 "Very experimental, not recommended"
 );
+PyDoc_STRVAR(gPySetUseParallelPhysics__doc__,
+"setUseParallelPhysics(bool parallel)\n"
+"Process the collision pairs and the simulation islands concurrently"
+);
+PyDoc_STRVAR(gPyGetUseParallelPhysics__doc__,
+"getUseParallelPhysics()\n"
+"Return True if the collision pairs and the simulation islands are processed concurrently"
+);
 
 PyDoc_STRVAR(gPyCreateConstraint__doc__,
 "createConstraint(ob1,ob2,float restLength,float restitution,float damping)\n"
@@ -433,6 +441,34 @@ static PyObject *gPySetSolverType(PyObject *self,
 	Py_RETURN_NONE;
 }
 
+static PyObject *gPySetUseParallelPhysics(PyObject *self,
+                                          PyObject *args,
+                                          PyObject *kwds)
+{
+	int parallel;
+	if (PyArg_ParseTuple(args, "p:setUseParallelPhysics", &parallel))
+	{
+		if (PHY_GetActiveEnvironment())
+		{
+			PHY_GetActiveEnvironment()->SetUseParallelPhysics(parallel);
+		}
+	}
+	else {
+		return nullptr;
+	}
+	Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetUseParallelPhysics(PyObject *self,
+                                          PyObject *args,
+                                          PyObject *kwds)
+{
+	if (PHY_GetActiveEnvironment())
+	{
+		return PyBool_FromLong(PHY_GetActiveEnvironment()->GetUseParallelPhysics());
+	}
+	Py_RETURN_FALSE;
+}
 
 
 static PyObject *gPyGetVehicleConstraint(PyObject *self,
@@ -682,6 +718,10 @@ static struct PyMethodDef physicsconstraints_methods[] = {
 	 METH_VARARGS, (const char *)gPySetUseEpa__doc__},
 	{"setSolverType",(PyCFunction) gPySetSolverType,
 	 METH_VARARGS, (const char *)gPySetSolverType__doc__},
+	{"setUseParallelPhysics",(PyCFunction) gPySetUseParallelPhysics,
+	 METH_VARARGS, (const char *)gPySetUseParallelPhysics__doc__},
+	{"getUseParallelPhysics",(PyCFunction) gPyGetUseParallelPhysics,
+	 METH_NOARGS, (const char *)gPyGetUseParallelPhysics__doc__},
 
 
 	{"createConstraint",(PyCFunction) gPyCreateConstraint,
@@ -108,6 +108,7 @@ extern "C" {
 #include "EXP_InputParser.h"
 #include "KX_Scene.h"
 #include "KX_Globals.h"
+#include "KX_TraceProfiler.h"
 
 #include "KX_NetworkMessageScene.h" //Needed for sendMessage()
 
@@ -299,6 +300,47 @@ static PyObject *gPyGetProfileInfo(PyObject *)
 	return KX_GetActiveEngine()->GetPyProfileDict();
 }
 
+PyDoc_STRVAR(gPyStartProfile_doc,
+"startProfile()\n"
+"Starts recording a trace of the engine events, a previous recording is discarded"
+);
+static PyObject *gPyStartProfile(PyObject *)
+{
+	KX_TraceProfiler::Start();
+
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPyStopProfile_doc,
+"stopProfile(path)\n"
+"Stops the recording and writes the trace in the Chrome trace event format"
+" path = Trace file path, relative to the blend file if starting with //"
+);
+static PyObject *gPyStopProfile(PyObject *, PyObject *args)
+{
+	char expanded[FILE_MAX];
+	char *filename;
+
+	if (!PyArg_ParseTuple(args, "s:stopProfile", &filename)) {
+		return nullptr;
+	}
+
+	if (!KX_TraceProfiler::IsRecording()) {
+		PyErr_SetString(PyExc_RuntimeError, "stopProfile(path): profiling is not started");
+		return nullptr;
+	}
+
+	BLI_strncpy(expanded, filename, FILE_MAX);
+	BLI_path_abs(expanded, KX_GetMainPath().c_str());
+
+	if (!KX_TraceProfiler::Stop(expanded)) {
+		PyErr_Format(PyExc_RuntimeError, "stopProfile(path): cannot write \"%s\"", expanded);
+		return nullptr;
+	}
+
+	Py_RETURN_NONE;
+}
+
 PyDoc_STRVAR(gPySendMessage_doc,
 "sendMessage(subject, [body, to, from])\n"
 "sends a message in same manner as a message actuator"
@@ -463,6 +505,38 @@ static PyObject *gPySetUseExternalClock(PyObject *, PyObject *args)
 	Py_RETURN_NONE;
 }
 
+static PyObject *gPyGetUseParallelScenes(PyObject *)
+{
+	return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PARALLEL_SCENES));
+}
+
+static PyObject *gPySetUseParallelScenes(PyObject *, PyObject *args)
+{
+	int useParallelScenes;
+
+	if (!PyArg_ParseTuple(args, "p:setUseParallelScenes", &useParallelScenes))
+		return nullptr;
+
+	KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::PARALLEL_SCENES, (bool)useParallelScenes);
+	Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetUseParallelSceneGraph(PyObject *)
+{
+	return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PARALLEL_SCENEGRAPH));
+}
+
+static PyObject *gPySetUseParallelSceneGraph(PyObject *, PyObject *args)
+{
+	int useParallelSceneGraph;
+
+	if (!PyArg_ParseTuple(args, "p:setUseParallelSceneGraph", &useParallelSceneGraph))
+		return nullptr;
+
+	KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::PARALLEL_SCENEGRAPH, (bool)useParallelSceneGraph);
+	Py_RETURN_NONE;
+}
+
 static PyObject *gPyGetClockTime(PyObject *)
 {
 	return PyFloat_FromDouble(KX_GetActiveEngine()->GetClockTime());
@@ -625,14 +699,20 @@ static PyObject *gLibLoad(PyObject *, PyObject *args, PyObject *kwds)
 
 	short options=0;
 	int load_actions=0, verbose=0, load_scripts=1, async=0;
+	float merge_budget = 0.0f;
 
-	if (!EXP_ParseTupleArgsAndKeywords(args, kwds, "ss|y*iiIiO:LibLoad",
-			{"path", "group", "buffer", "load_actions", "verbose", "load_scripts", "async", "scene", 0},
-			&path, &group, &py_buffer, &load_actions, &verbose, &load_scripts, &async, &pyscene))
+	if (!EXP_ParseTupleArgsAndKeywords(args, kwds, "ss|y*iiIiOf:LibLoad",
+			{"path", "group", "buffer", "load_actions", "verbose", "load_scripts", "async", "scene", "merge_budget", 0},
+			&path, &group, &py_buffer, &load_actions, &verbose, &load_scripts, &async, &pyscene, &merge_budget))
 	{
 		return nullptr;
 	}
 
+	if (merge_budget < 0.0f) {
+		PyErr_SetString(PyExc_ValueError, "LibLoad(...): merge_budget must be positive or zero");
+		return nullptr;
+	}
+
 	if (!ConvertPythonToScene(pyscene, &kx_scene, true, "invalid scene")) {
 		return nullptr;
 	}
@@ -660,6 +740,8 @@ static PyObject *gLibLoad(PyObject *, PyObject *args, PyObject *kwds)
 		BLI_path_abs(abs_path, KX_GetMainPath().c_str());
 
 		if ((status=converter->LinkBlendFilePath(abs_path, group, kx_scene, &err_str, options))) {
+			// The merge of async libraries is done by the main thread, after this call.
+			status->SetMergeBudget(merge_budget);
 			return status->GetProxy();
 		}
 	}
@@ -667,6 +749,7 @@ static PyObject *gLibLoad(PyObject *, PyObject *args, PyObject *kwds)
 	{
 
 		if ((status=converter->LinkBlendFileMemory(py_buffer.buf, py_buffer.len, path, group, kx_scene, &err_str, options)))	{
+			status->SetMergeBudget(merge_budget);
 			PyBuffer_Release(&py_buffer);
 			return status->GetProxy();
 		}
@@ -810,6 +893,10 @@ static struct PyMethodDef game_methods[] = {
 	{"getRender", (PyCFunction) gPyGetRender, METH_NOARGS, (const char *)"get the global render flag value"},
 	{"getUseExternalClock", (PyCFunction) gPyGetUseExternalClock, METH_NOARGS, (const char *)"Get if we use the time provided by an external clock"},
 	{"setUseExternalClock", (PyCFunction) gPySetUseExternalClock, METH_VARARGS, (const char *)"Set if we use the time provided by an external clock"},
+	{"getUseParallelScenes", (PyCFunction) gPyGetUseParallelScenes, METH_NOARGS, (const char *)"Get if the scenes physics is proceeded in parallel"},
+	{"setUseParallelScenes", (PyCFunction) gPySetUseParallelScenes, METH_VARARGS, (const char *)"Set if the scenes physics is proceeded in parallel"},
+	{"getUseParallelSceneGraph", (PyCFunction) gPyGetUseParallelSceneGraph, METH_NOARGS, (const char *)"Get if the scene graph hierarchies are updated in parallel"},
+	{"setUseParallelSceneGraph", (PyCFunction) gPySetUseParallelSceneGraph, METH_VARARGS, (const char *)"Set if the scene graph hierarchies are updated in parallel"},
 	{"getClockTime", (PyCFunction) gPyGetClockTime, METH_NOARGS, (const char *)"Get the last BGE render time. "
 	"The BGE render time is the simulated time corresponding to the next scene that will be renderered"},
 	{"setClockTime", (PyCFunction) gPySetClockTime, METH_VARARGS, (const char *)"Set the BGE render time. "
@@ -826,6 +913,8 @@ static struct PyMethodDef game_methods[] = {
 	{"PrintMemInfo", (PyCFunction)pyPrintStats, METH_NOARGS, (const char *)"Print engine statistics"},
 	{"NextFrame", (PyCFunction)gPyNextFrame, METH_NOARGS, (const char *)"Render next frame (if Python has control)"},
 	{"getProfileInfo", (PyCFunction)gPyGetProfileInfo, METH_NOARGS, gPyGetProfileInfo_doc},
+	{"startProfile", (PyCFunction)gPyStartProfile, METH_NOARGS, gPyStartProfile_doc},
+	{"stopProfile", (PyCFunction)gPyStopProfile, METH_VARARGS, gPyStopProfile_doc},
 	/* library functions */
 	{"LibLoad", (PyCFunction)gLibLoad, METH_VARARGS|METH_KEYWORDS, (const char *)""},
 	{"LibNew", (PyCFunction)gLibNew, METH_VARARGS, (const char *)""},
@@ -1148,6 +1237,11 @@ static PyObject *gPySetAnisotropicFiltering(PyObject *, PyObject *args)
 		return nullptr;
 	}
 
+	if (!KX_GetActiveEngine()->GetRasterizer()) {
+		PyErr_SetString(PyExc_RuntimeError, "Rasterizer.setAnisotropicFiltering(level), Rasterizer not available");
+		return nullptr;
+	}
+
 	KX_GetActiveEngine()->GetRasterizer()->SetAnisotropicFiltering(level);
 
 	Py_RETURN_NONE;
@@ -1155,6 +1249,11 @@ static PyObject *gPySetAnisotropicFiltering(PyObject *, PyObject *args)
 
 static PyObject *gPyGetAnisotropicFiltering(PyObject *, PyObject *args)
 {
+	if (!KX_GetActiveEngine()->GetRasterizer()) {
+		PyErr_SetString(PyExc_RuntimeError, "Rasterizer.getAnisotropicFiltering(), Rasterizer not available");
+		return nullptr;
+	}
+
 	return PyLong_FromLong(KX_GetActiveEngine()->GetRasterizer()->GetAnisotropicFiltering());
 }
 
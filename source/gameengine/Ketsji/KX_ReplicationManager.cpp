@@ -0,0 +1,837 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_ReplicationManager.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_ReplicationManager.h"
+#include "KX_NetworkStream.h"
+#include "KX_Scene.h"
+#include "KX_GameObject.h"
+#include "KX_Camera.h"
+
+#include "PHY_IPhysicsController.h"
+
+#include "EXP_ListValue.h"
+#include "EXP_IntValue.h"
+#include "EXP_FloatValue.h"
+#include "EXP_BoolValue.h"
+#include "EXP_StringValue.h"
+
+#include "CM_Message.h"
+
+#include "PIL_time.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+namespace {
+
+enum PacketType {
+	PACKET_SNAPSHOT = 0,
+	PACKET_ACK,
+	PACKET_DISCONNECT
+};
+
+const uint16_t PROTOCOL_MAGIC = 0x4B58;
+const unsigned char PROTOCOL_VERSION = 2;
+/// Seconds without datagram before a client is removed.
+const double CLIENT_TIMEOUT = 5.0;
+
+/// Return the replicated type of a property value type or -1.
+int GetPropertyType(int valueType)
+{
+	switch (valueType) {
+		case VALUE_INT_TYPE:
+		{
+			return KX_ReplicationCodec::PROPERTY_INT;
+		}
+		case VALUE_FLOAT_TYPE:
+		{
+			return KX_ReplicationCodec::PROPERTY_FLOAT;
+		}
+		case VALUE_BOOL_TYPE:
+		{
+			return KX_ReplicationCodec::PROPERTY_BOOL;
+		}
+		case VALUE_STRING_TYPE:
+		{
+			return KX_ReplicationCodec::PROPERTY_STRING;
+		}
+	}
+
+	return -1;
+}
+
+}
+
+KX_ReplicationManager::KX_ReplicationManager(KX_Scene *scene)
+	:m_scene(scene),
+	m_role(ROLE_SERVER),
+	m_interestRadius(0.0f),
+	m_sendInterval(1),
+	m_frame(0),
+	m_session(0),
+	m_snapshotId(0),
+	m_lastEntityId(0),
+	m_serverSession(0),
+	m_lastReceivedId(0),
+	m_pendingId(0),
+	m_pendingBaselineId(0),
+	m_serverRoundTripTime(0.0f),
+	m_bandwidthTime(0.0),
+	m_bandwidthSent(0),
+	m_bandwidthReceived(0)
+{
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+
+KX_ReplicationManager::~KX_ReplicationManager()
+{
+	Stop();
+}
+
+bool KX_ReplicationManager::StartServer(unsigned short port, float interestRadius, unsigned int sendInterval)
+{
+	Stop();
+
+	if (!m_socket.Open(port)) {
+		return false;
+	}
+
+	m_role = ROLE_SERVER;
+	// The clients detect a restarted server by its session.
+	std::random_device random;
+	do {
+		m_session = random();
+	} while (m_session == 0);
+	m_interestRadius = interestRadius;
+	m_sendInterval = std::max(1u, sendInterval);
+	m_bandwidthTime = PIL_check_seconds_timer();
+
+	CM_Message("replication server listening on port " << m_socket.GetPort());
+
+	return true;
+}
+
+bool KX_ReplicationManager::StartClient(const std::string& host, unsigned short port, unsigned short localPort)
+{
+	Stop();
+
+	if (!KX_NetworkAddress::Resolve(host, port, m_serverAddress)) {
+		CM_Error("failed to resolve the replication server \"" << host << "\"");
+		return false;
+	}
+
+	if (!m_socket.Open(localPort)) {
+		return false;
+	}
+
+	m_role = ROLE_CLIENT;
+	m_bandwidthTime = PIL_check_seconds_timer();
+
+	return true;
+}
+
+void KX_ReplicationManager::Stop()
+{
+	if (m_socket.IsOpen()) {
+		m_datagram.clear();
+		KX_NetworkWriter writer(m_datagram);
+		WriteHeader(writer, PACKET_DISCONNECT);
+		if (m_role == ROLE_SERVER) {
+			for (const std::unique_ptr<Client>& client : m_clients) {
+				Send(client->address, m_datagram);
+			}
+		}
+		else {
+			Send(m_serverAddress, m_datagram);
+		}
+	}
+
+	// Release the objects, the objects added by the replication are kept in the scene.
+	for (const auto& pair : m_serverEntities) {
+		pair.second.object->SetReplicationId(0);
+	}
+	for (const auto& pair : m_clientEntities) {
+		const ClientEntity& entity = pair.second;
+		if (!entity.object) {
+			continue;
+		}
+		entity.object->SetReplicationId(0);
+		if (entity.suspendedDynamics) {
+			entity.object->GetPhysicsController()->RestoreDynamics();
+		}
+	}
+
+	m_socket.Close();
+
+	m_frame = 0;
+	m_session = 0;
+	m_snapshotId = 0;
+	m_lastEntityId = 0;
+	m_serverEntities.clear();
+	m_clients.clear();
+	m_currentStates.clear();
+
+	m_clientEntities.clear();
+	m_receivedSnapshots.Clear();
+	m_serverSession = 0;
+	m_lastReceivedId = 0;
+	m_pendingId = 0;
+	m_pendingBaselineId = 0;
+	m_pendingParts.clear();
+	m_pendingRecords.clear();
+	m_serverRoundTripTime = 0.0f;
+
+	memset(&m_stats, 0, sizeof(m_stats));
+	m_bandwidthSent = 0;
+	m_bandwidthReceived = 0;
+}
+
+KX_ReplicationManager::Role KX_ReplicationManager::GetRole() const
+{
+	return m_role;
+}
+
+unsigned short KX_ReplicationManager::GetPort() const
+{
+	return m_socket.GetPort();
+}
+
+const KX_ReplicationManager::Stats& KX_ReplicationManager::GetStats() const
+{
+	return m_stats;
+}
+
+void KX_ReplicationManager::Update()
+{
+	if (!m_socket.IsOpen()) {
+		return;
+	}
+
+	const double time = PIL_check_seconds_timer();
+
+	ReceivePackets(time);
+
+	if (m_role == ROLE_SERVER) {
+		RemoveTimedOutClients(time);
+
+		if (++m_frame >= m_sendInterval) {
+			m_frame = 0;
+			// The objects get their ids once a client is connected.
+			if (!m_clients.empty()) {
+				++m_snapshotId;
+				GatherStates();
+				for (const std::unique_ptr<Client>& client : m_clients) {
+					SendSnapshot(*client, time);
+				}
+			}
+		}
+
+		float roundTripTime = 0.0f;
+		for (const std::unique_ptr<Client>& client : m_clients) {
+			roundTripTime += client->roundTripTime;
+		}
+		m_stats.numClients = m_clients.size();
+		m_stats.numEntities = m_currentStates.size();
+		m_stats.roundTripTime = m_clients.empty() ? 0.0f : roundTripTime / m_clients.size();
+	}
+	else {
+		// The acknowledgment is also used as connection request and keep alive.
+		SendAck();
+
+		m_stats.numClients = 0;
+		m_stats.numEntities = m_clientEntities.size();
+		m_stats.roundTripTime = m_serverRoundTripTime;
+	}
+
+	UpdateBandwidth(time);
+}
+
+void KX_ReplicationManager::RemoveObject(KX_GameObject *gameobj)
+{
+	const unsigned int id = gameobj->GetReplicationId();
+	// Recycled objects get a new id.
+	gameobj->SetReplicationId(0);
+
+	if (m_role == ROLE_SERVER) {
+		// The object is sent as removed in the next snapshots.
+		m_serverEntities.erase(id);
+	}
+	else {
+		const auto it = m_clientEntities.find(id);
+		if (it != m_clientEntities.end() && it->second.object == gameobj) {
+			it->second.object = nullptr;
+		}
+	}
+}
+
+void KX_ReplicationManager::Send(const KX_NetworkAddress& to, const std::vector<unsigned char>& data)
+{
+	if (m_socket.Send(to, data.data(), data.size())) {
+		++m_stats.packetsSent;
+		m_stats.bytesSent += data.size();
+		m_bandwidthSent += data.size();
+	}
+}
+
+void KX_ReplicationManager::WriteHeader(KX_NetworkWriter& writer, unsigned char type)
+{
+	writer.WriteUInt16(PROTOCOL_MAGIC);
+	writer.WriteByte(PROTOCOL_VERSION);
+	writer.WriteByte(type);
+}
+
+void KX_ReplicationManager::ReceivePackets(double time)
+{
+	unsigned char buffer[KX_ReplicationCodec::MAX_DATAGRAM_SIZE];
+	KX_NetworkAddress from;
+	int size;
+	while ((size = m_socket.Receive(buffer, sizeof(buffer), from)) >= 0) {
+		++m_stats.packetsReceived;
+		m_stats.bytesReceived += size;
+		m_bandwidthReceived += size;
+
+		KX_NetworkReader reader(buffer, size);
+		uint16_t magic;
+		unsigned char version;
+		unsigned char type;
+		if (!reader.ReadUInt16(magic) || !reader.ReadByte(version) || !reader.ReadByte(type) ||
+		    magic != PROTOCOL_MAGIC || version != PROTOCOL_VERSION)
+		{
+			continue;
+		}
+
+		if (m_role == ROLE_SERVER) {
+			if (type == PACKET_ACK) {
+				ReceiveAck(from, reader, time);
+			}
+			else if (type == PACKET_DISCONNECT) {
+				ReceiveDisconnect(from);
+			}
+		}
+		else if (from == m_serverAddress) {
+			if (type == PACKET_SNAPSHOT) {
+				ReceiveSnapshot(reader);
+			}
+			else if (type == PACKET_DISCONNECT) {
+				CM_Message("replication server " << from.GetText() << " disconnected");
+			}
+		}
+	}
+}
+
+void KX_ReplicationManager::UpdateBandwidth(double time)
+{
+	const double elapsed = time - m_bandwidthTime;
+	if (elapsed < 1.0) {
+		return;
+	}
+
+	m_stats.sendBandwidth = m_bandwidthSent / elapsed;
+	m_stats.receiveBandwidth = m_bandwidthReceived / elapsed;
+	m_bandwidthSent = 0;
+	m_bandwidthReceived = 0;
+	m_bandwidthTime = time;
+}
+
+KX_ReplicationManager::Client *KX_ReplicationManager::FindClient(const KX_NetworkAddress& address)
+{
+	for (const std::unique_ptr<Client>& client : m_clients) {
+		if (client->address == address) {
+			return client.get();
+		}
+	}
+	return nullptr;
+}
+
+void KX_ReplicationManager::ReceiveAck(const KX_NetworkAddress& from, KX_NetworkReader& reader, double time)
+{
+	uint32_t ackedId;
+	float position[3];
+	if (!reader.ReadUInt32(ackedId) || !reader.ReadFloat(position[0]) || !reader.ReadFloat(position[1]) ||
+	    !reader.ReadFloat(position[2]))
+	{
+		return;
+	}
+
+	Client *client = FindClient(from);
+	if (!client) {
+		if (m_clients.size() >= MAX_CLIENTS) {
+			return;
+		}
+
+		client = new Client();
+		client->address = from;
+		client->ackedId = 0;
+		client->roundTripTime = 0.0f;
+		m_clients.emplace_back(client);
+
+		CM_Message("replication client " << from.GetText() << " connected");
+	}
+
+	client->interestPosition = mt::vec3(position);
+	client->lastReceiveTime = time;
+
+	const unsigned int newAckedId = KX_ReplicationCodec::UpdateAck(client->history, client->ackedId, ackedId);
+	if (newAckedId != client->ackedId && newAckedId != 0) {
+		const float sample = time - client->history.Find(newAckedId)->time;
+		client->roundTripTime = (client->roundTripTime == 0.0f) ? sample : client->roundTripTime * 0.9f + sample * 0.1f;
+	}
+	client->ackedId = newAckedId;
+}
+
+void KX_ReplicationManager::ReceiveDisconnect(const KX_NetworkAddress& from)
+{
+	for (std::vector<std::unique_ptr<Client> >::iterator it = m_clients.begin(), end = m_clients.end(); it != end; ++it) {
+		if ((*it)->address == from) {
+			CM_Message("replication client " << from.GetText() << " disconnected");
+			m_clients.erase(it);
+			return;
+		}
+	}
+}
+
+void KX_ReplicationManager::RemoveTimedOutClients(double time)
+{
+	for (std::vector<std::unique_ptr<Client> >::iterator it = m_clients.begin(); it != m_clients.end();) {
+		if ((time - (*it)->lastReceiveTime) > CLIENT_TIMEOUT) {
+			CM_Message("replication client " << (*it)->address.GetText() << " timed out");
+			it = m_clients.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+void KX_ReplicationManager::UpdateLayout(ServerEntity& entity)
+{
+	KX_GameObject *gameobj = entity.object;
+	const unsigned int version = gameobj->GetPropertiesVersion();
+	const std::string name = gameobj->GetName();
+	if (entity.layout && entity.propertiesVersion == version && entity.layout->name == name) {
+		return;
+	}
+
+	std::shared_ptr<EntityLayout> layout = std::make_shared<EntityLayout>();
+	layout->name = name;
+	entity.propertyIndices.clear();
+	for (int i = 0, count = gameobj->GetPropertyCount(); i < count; ++i) {
+		const int type = GetPropertyType(gameobj->GetProperty(i)->GetValueType());
+		if (type != -1 && layout->propertyNames.size() < KX_ReplicationCodec::MAX_PROPERTIES) {
+			layout->propertyNames.push_back(gameobj->GetPropertyName(i));
+			layout->propertyTypes.push_back(type);
+			entity.propertyIndices.push_back(i);
+		}
+	}
+
+	// A new layout makes the next snapshots send the full object.
+	if (!entity.layout || entity.layout->name != layout->name || entity.layout->propertyNames != layout->propertyNames ||
+	    entity.layout->propertyTypes != layout->propertyTypes)
+	{
+		entity.layout = layout;
+	}
+	entity.propertiesVersion = version;
+}
+
+void KX_ReplicationManager::GatherStates()
+{
+	m_currentStates.clear();
+
+	for (KX_GameObject *gameobj : *m_scene->GetObjectList()) {
+		if (!gameobj->IsReplicated()) {
+			continue;
+		}
+
+		unsigned int id = gameobj->GetReplicationId();
+		if (id == 0) {
+			id = ++m_lastEntityId;
+			gameobj->SetReplicationId(id);
+		}
+
+		ServerEntity& entity = m_serverEntities[id];
+		if (entity.object != gameobj) {
+			entity.object = gameobj;
+			entity.layout.reset();
+		}
+		UpdateLayout(entity);
+
+		m_currentStates.emplace_back();
+		EntityState& state = m_currentStates.back();
+		state.id = id;
+		KX_ReplicationCodec::QuantizeVector(gameobj->NodeGetLocalPosition(), state.position);
+		state.orientation = KX_ReplicationCodec::QuantizeOrientation(gameobj->NodeGetLocalOrientation());
+		KX_ReplicationCodec::QuantizeVector(gameobj->NodeGetLocalScaling(), state.scale);
+		state.worldPosition = gameobj->NodeGetWorldPosition();
+		state.layout = entity.layout;
+
+		const EntityLayout& layout = *entity.layout;
+		state.properties.resize(layout.propertyTypes.size());
+		for (unsigned int i = 0, size = state.properties.size(); i < size; ++i) {
+			EXP_Value *prop = gameobj->GetProperty(entity.propertyIndices[i]);
+			PropertyValue& value = state.properties[i];
+			switch (layout.propertyTypes[i]) {
+				case KX_ReplicationCodec::PROPERTY_INT:
+				{
+					value.number = static_cast<EXP_IntValue *>(prop)->GetInt();
+					break;
+				}
+				case KX_ReplicationCodec::PROPERTY_FLOAT:
+				{
+					// Floats are sent unquantized as their bits.
+					const float number = static_cast<EXP_FloatValue *>(prop)->GetFloat();
+					uint32_t bits;
+					memcpy(&bits, &number, sizeof(bits));
+					value.number = bits;
+					break;
+				}
+				case KX_ReplicationCodec::PROPERTY_BOOL:
+				{
+					value.number = static_cast<EXP_BoolValue *>(prop)->GetBool();
+					break;
+				}
+				case KX_ReplicationCodec::PROPERTY_STRING:
+				{
+					value.text = static_cast<EXP_StringValue *>(prop)->GetString();
+					break;
+				}
+			}
+		}
+	}
+
+	std::sort(m_currentStates.begin(), m_currentStates.end(), [](const EntityState& a, const EntityState& b) {
+		return a.id < b.id;
+	});
+}
+
+void KX_ReplicationManager::SendSnapshot(Client& client, double time)
+{
+	const Snapshot *baseline = KX_ReplicationCodec::SelectBaseline(client.history, client.ackedId, m_snapshotId);
+
+	// The history stores the states as received by the client to encode the next deltas.
+	Snapshot& snapshot = client.history.Add(m_snapshotId, time);
+	m_codec.Encode(m_currentStates, baseline, client.interestPosition, m_interestRadius, snapshot);
+
+	std::vector<std::vector<unsigned char> >& packets = m_codec.GetPackets();
+
+	KX_ReplicationCodec::Header snapshotHeader;
+	snapshotHeader.id = m_snapshotId;
+	snapshotHeader.baselineId = baseline ? baseline->id : 0;
+	snapshotHeader.session = m_session;
+	snapshotHeader.count = packets.size();
+	snapshotHeader.roundTripTime = std::min(65535u, (unsigned int)(client.roundTripTime * 1000.0f));
+
+	std::vector<unsigned char> header;
+	for (unsigned int part = 0, count = packets.size(); part < count; ++part) {
+		header.clear();
+		KX_NetworkWriter writer(header);
+		WriteHeader(writer, PACKET_SNAPSHOT);
+		snapshotHeader.part = part;
+		KX_ReplicationCodec::WriteHeader(writer, snapshotHeader);
+
+		std::vector<unsigned char>& packet = packets[part];
+		std::copy(header.begin(), header.end(), packet.begin());
+		Send(client.address, packet);
+	}
+
+	++m_stats.snapshotsSent;
+}
+
+void KX_ReplicationManager::SendAck()
+{
+	m_datagram.clear();
+	KX_NetworkWriter writer(m_datagram);
+	WriteHeader(writer, PACKET_ACK);
+	writer.WriteUInt32(m_lastReceivedId);
+
+	// The active camera is the point of interest of the client.
+	KX_Camera *camera = m_scene->GetActiveCamera();
+	const mt::vec3 position = camera ? camera->NodeGetWorldPosition() : mt::zero3;
+	for (unsigned short i = 0; i < 3; ++i) {
+		writer.WriteFloat(position[i]);
+	}
+
+	Send(m_serverAddress, m_datagram);
+}
+
+void KX_ReplicationManager::ReceiveSnapshot(KX_NetworkReader& reader)
+{
+	KX_ReplicationCodec::Header header;
+	if (!KX_ReplicationCodec::ReadHeader(reader, header)) {
+		return;
+	}
+
+	/* A restarted server sends its first snapshots without baseline, the snapshots
+	 * of another session with a baseline are late datagrams of the previous session. */
+	if (header.session != m_serverSession) {
+		if (header.baselineId != 0) {
+			return;
+		}
+		if (m_serverSession != 0) {
+			CM_Message("replication server " << m_serverAddress.GetText() << " restarted");
+			ResetClient();
+		}
+		m_serverSession = header.session;
+	}
+
+	const unsigned int id = header.id;
+	const unsigned int baselineId = header.baselineId;
+
+	// Late snapshots are ignored.
+	if (id <= m_lastReceivedId || id < m_pendingId) {
+		return;
+	}
+
+	if (id != m_pendingId) {
+		if (m_pendingId > m_lastReceivedId) {
+			++m_stats.snapshotsDropped;
+		}
+		m_pendingId = id;
+		m_pendingBaselineId = baselineId;
+		m_pendingParts.assign(header.count, false);
+		m_pendingRecords.clear();
+	}
+
+	// Invalid snapshots clear the received parts to ignore their other parts.
+	if (header.count != m_pendingParts.size() || baselineId != m_pendingBaselineId || m_pendingParts[header.part]) {
+		return;
+	}
+
+	const Snapshot *baseline = nullptr;
+	if (baselineId != 0) {
+		baseline = m_receivedSnapshots.Find(baselineId);
+		if (!baseline) {
+			m_pendingParts.clear();
+			m_pendingRecords.clear();
+			return;
+		}
+	}
+
+	m_serverRoundTripTime = header.roundTripTime / 1000.0f;
+
+	if (!KX_ReplicationCodec::DecodeRecords(reader, baseline, m_pendingRecords)) {
+		m_pendingParts.clear();
+		m_pendingRecords.clear();
+		return;
+	}
+
+	m_pendingParts[header.part] = true;
+	if (std::find(m_pendingParts.begin(), m_pendingParts.end(), false) == m_pendingParts.end()) {
+		CompleteSnapshot(baseline);
+	}
+}
+
+void KX_ReplicationManager::CompleteSnapshot(const Snapshot *baseline)
+{
+	KX_ReplicationCodec::SortRecords(m_pendingRecords);
+
+	// Apply the changes to the scene.
+	std::unordered_map<std::string, std::vector<KX_GameObject *> > candidates;
+	bool candidatesValid = false;
+	for (const Record& record : m_pendingRecords) {
+		if (record.removed) {
+			RemoveEntity(record.state.id);
+		}
+		else {
+			ApplyEntity(record.state, candidates, candidatesValid);
+		}
+	}
+
+	// Merge the records with the baseline to decode the next snapshots.
+	std::vector<EntityState> entities;
+	KX_ReplicationCodec::MergeRecords(m_pendingRecords, baseline, entities);
+
+	Snapshot& snapshot = m_receivedSnapshots.Add(m_pendingId, 0.0);
+	snapshot.entities.swap(entities);
+
+	m_lastReceivedId = m_pendingId;
+	m_pendingParts.clear();
+	m_pendingRecords.clear();
+
+	++m_stats.snapshotsReceived;
+}
+
+void KX_ReplicationManager::ApplyEntity(const EntityState& state,
+                                        std::unordered_map<std::string, std::vector<KX_GameObject *> >& candidates,
+                                        bool& candidatesValid)
+{
+	const EntityLayout& layout = *state.layout;
+
+	std::unordered_map<unsigned int, ClientEntity>::iterator it = m_clientEntities.find(state.id);
+	if (it == m_clientEntities.end()) {
+		ClientEntity entity = {nullptr, false, false};
+
+		// Bind an object of the same name, the first objects of the scene first.
+		if (!candidatesValid) {
+			EXP_ListValue<KX_GameObject> *objects = m_scene->GetObjectList();
+			for (int i = objects->GetCount() - 1; i >= 0; --i) {
+				KX_GameObject *gameobj = objects->GetValue(i);
+				if (gameobj->GetReplicationId() == 0) {
+					candidates[gameobj->GetName()].push_back(gameobj);
+				}
+			}
+			candidatesValid = true;
+		}
+
+		std::vector<KX_GameObject *>& objects = candidates[layout.name];
+		if (!objects.empty()) {
+			entity.object = objects.back();
+			objects.pop_back();
+		}
+		else {
+			KX_GameObject *templateobj = m_scene->GetInactiveList()->FindValue(layout.name);
+			if (templateobj) {
+				entity.object = m_scene->AddReplicaObject(templateobj, nullptr);
+				entity.object->Release();
+				entity.spawned = true;
+			}
+		}
+
+		if (entity.object) {
+			entity.object->SetReplicationId(state.id);
+			// The server simulates the replicated objects.
+			PHY_IPhysicsController *ctrl = entity.object->GetPhysicsController();
+			if (ctrl && ctrl->IsDynamic()) {
+				ctrl->SuspendDynamics();
+				entity.suspendedDynamics = true;
+			}
+		}
+		else {
+			CM_Warning("no object named \"" << layout.name << "\" to replicate");
+		}
+
+		it = m_clientEntities.emplace(state.id, entity).first;
+	}
+
+	KX_GameObject *gameobj = it->second.object;
+	if (!gameobj) {
+		return;
+	}
+
+	gameobj->NodeSetLocalPosition(KX_ReplicationCodec::DequantizeVector(state.position));
+	gameobj->NodeSetLocalOrientation(KX_ReplicationCodec::DequantizeOrientation(state.orientation));
+	gameobj->NodeSetLocalScale(KX_ReplicationCodec::DequantizeVector(state.scale));
+
+	for (unsigned int i = 0, size = state.properties.size(); i < size; ++i) {
+		const std::string& name = layout.propertyNames[i];
+		const unsigned char type = layout.propertyTypes[i];
+		const PropertyValue& value = state.properties[i];
+
+		EXP_Value *prop = gameobj->GetProperty(name);
+		// Properties of the same type are set in place to keep the references to them.
+		const bool inplace = (prop && GetPropertyType(prop->GetValueType()) == type);
+		EXP_Value *newprop = nullptr;
+
+		switch (type) {
+			case KX_ReplicationCodec::PROPERTY_INT:
+			{
+				if (inplace) {
+					static_cast<EXP_IntValue *>(prop)->SetInt(value.number);
+				}
+				else {
+					newprop = new EXP_IntValue(value.number);
+				}
+				break;
+			}
+			case KX_ReplicationCodec::PROPERTY_FLOAT:
+			{
+				const uint32_t bits = value.number;
+				float number;
+				memcpy(&number, &bits, sizeof(number));
+				if (inplace) {
+					static_cast<EXP_FloatValue *>(prop)->SetFloat(number);
+				}
+				else {
+					newprop = new EXP_FloatValue(number);
+				}
+				break;
+			}
+			case KX_ReplicationCodec::PROPERTY_BOOL:
+			{
+				if (inplace) {
+					static_cast<EXP_BoolValue *>(prop)->SetBool(value.number);
+				}
+				else {
+					newprop = new EXP_BoolValue(value.number);
+				}
+				break;
+			}
+			case KX_ReplicationCodec::PROPERTY_STRING:
+			{
+				if (inplace) {
+					static_cast<EXP_StringValue *>(prop)->SetString(value.text);
+				}
+				else {
+					newprop = new EXP_StringValue(value.text, "");
+				}
+				break;
+			}
+		}
+
+		if (newprop) {
+			gameobj->SetProperty(name, newprop);
+			newprop->Release();
+		}
+	}
+
+	gameobj->NotifyPropertyChange();
+}
+
+void KX_ReplicationManager::RemoveEntity(unsigned int id)
+{
+	const std::unordered_map<unsigned int, ClientEntity>::iterator it = m_clientEntities.find(id);
+	if (it == m_clientEntities.end()) {
+		return;
+	}
+
+	const ClientEntity& entity = it->second;
+	if (entity.object) {
+		entity.object->SetReplicationId(0);
+		if (entity.spawned) {
+			m_scene->DelayedRemoveObject(entity.object);
+		}
+		else if (entity.suspendedDynamics) {
+			entity.object->GetPhysicsController()->RestoreDynamics();
+		}
+	}
+
+	m_clientEntities.erase(it);
+}
+
+void KX_ReplicationManager::ResetClient()
+{
+	// The entity ids of the new session are unrelated to the previous ones.
+	while (!m_clientEntities.empty()) {
+		RemoveEntity(m_clientEntities.begin()->first);
+	}
+
+	m_receivedSnapshots.Clear();
+	m_lastReceivedId = 0;
+	m_pendingId = 0;
+	m_pendingBaselineId = 0;
+	m_pendingParts.clear();
+	m_pendingRecords.clear();
+}
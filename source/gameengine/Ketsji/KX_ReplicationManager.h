@@ -0,0 +1,218 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_ReplicationManager.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __KX_REPLICATIONMANAGER_H__
+#define __KX_REPLICATIONMANAGER_H__
+
+#include "KX_NetworkSocket.h"
+#include "KX_ReplicationCodec.h"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+
+class KX_Scene;
+class KX_GameObject;
+class KX_NetworkWriter;
+class KX_NetworkReader;
+
+/** Replication of the state of the objects of a scene over UDP. The server periodically
+ * sends a snapshot of the replicated objects to every client, the clients apply the
+ * snapshots to their own scene and acknowledge them.
+ *
+ * The local transform of an object is quantized (1/1024 unit for the position and the
+ * scale, 10 bits per component for the orientation) with its int, float, bool and string
+ * properties. A snapshot is delta encoded against the last snapshot acknowledged by the
+ * client: the unchanged objects are not sent and the changed ones only send the changed
+ * values as variable length deltas. The snapshots are split in datagrams of at most
+ * MAX_DATAGRAM_SIZE bytes and are only applied once all their datagrams are received.
+ * The encoding is done by KX_ReplicationCodec.
+ *
+ * With an interest radius, the server only sends to a client the objects close to the
+ * position of the active camera of the client, the other objects are removed from the
+ * client snapshots.
+ *
+ * The client matches the objects sent by the server to the unbound objects of the same
+ * name in its scene, or adds a replica of the inactive object of the same name. Their
+ * dynamics are suspended while they are replicated. The snapshots carry a random session
+ * id of the server, the replicated objects are released when the server restarts.
+ */
+class KX_ReplicationManager
+{
+public:
+	enum Role {
+		ROLE_SERVER,
+		ROLE_CLIENT
+	};
+
+	struct Stats
+	{
+		unsigned int numClients;
+		unsigned int numEntities;
+		unsigned long long bytesSent;
+		unsigned long long bytesReceived;
+		unsigned int packetsSent;
+		unsigned int packetsReceived;
+		/// Bytes per second over the last second.
+		float sendBandwidth;
+		float receiveBandwidth;
+		/// Smoothed round trip time in seconds, the average of the clients for a server.
+		float roundTripTime;
+		unsigned int snapshotsSent;
+		unsigned int snapshotsReceived;
+		/// Snapshots received incompletely or without their baseline.
+		unsigned int snapshotsDropped;
+	};
+
+	enum {
+		MAX_CLIENTS = 64
+	};
+
+private:
+	typedef KX_ReplicationCodec::EntityLayout EntityLayout;
+	typedef KX_ReplicationCodec::EntityState EntityState;
+	typedef KX_ReplicationCodec::PropertyValue PropertyValue;
+	typedef KX_ReplicationCodec::Snapshot Snapshot;
+	typedef KX_ReplicationCodec::Record Record;
+
+	struct ServerEntity
+	{
+		KX_GameObject *object;
+		std::shared_ptr<EntityLayout> layout;
+		/// Properties version of the object when the layout was computed.
+		unsigned int propertiesVersion;
+		/// Index of the replicated properties in the object.
+		std::vector<int> propertyIndices;
+	};
+
+	struct Client
+	{
+		KX_NetworkAddress address;
+		unsigned int ackedId;
+		mt::vec3 interestPosition;
+		double lastReceiveTime;
+		float roundTripTime;
+		KX_ReplicationCodec::History history;
+	};
+
+	struct ClientEntity
+	{
+		KX_GameObject *object;
+		/// The object was added by the replication and is removed with the entity.
+		bool spawned;
+		bool suspendedDynamics;
+	};
+
+	KX_Scene *m_scene;
+	Role m_role;
+	KX_NetworkSocket m_socket;
+	KX_ReplicationCodec m_codec;
+	std::vector<unsigned char> m_datagram;
+
+	// Server data.
+	float m_interestRadius;
+	unsigned int m_sendInterval;
+	unsigned int m_frame;
+	unsigned int m_session;
+	unsigned int m_snapshotId;
+	unsigned int m_lastEntityId;
+	std::unordered_map<unsigned int, ServerEntity> m_serverEntities;
+	std::vector<std::unique_ptr<Client> > m_clients;
+	std::vector<EntityState> m_currentStates;
+
+	// Client data.
+	KX_NetworkAddress m_serverAddress;
+	std::unordered_map<unsigned int, ClientEntity> m_clientEntities;
+	KX_ReplicationCodec::History m_receivedSnapshots;
+	/// Session of the server, 0 before the first snapshot.
+	unsigned int m_serverSession;
+	unsigned int m_lastReceivedId;
+	unsigned int m_pendingId;
+	unsigned int m_pendingBaselineId;
+	std::vector<bool> m_pendingParts;
+	std::vector<Record> m_pendingRecords;
+	float m_serverRoundTripTime;
+
+	Stats m_stats;
+	double m_bandwidthTime;
+	unsigned int m_bandwidthSent;
+	unsigned int m_bandwidthReceived;
+
+	void Send(const KX_NetworkAddress& to, const std::vector<unsigned char>& data);
+	void WriteHeader(KX_NetworkWriter& writer, unsigned char type);
+	void ReceivePackets(double time);
+	void UpdateBandwidth(double time);
+
+	// Server functions.
+	Client *FindClient(const KX_NetworkAddress& address);
+	void ReceiveAck(const KX_NetworkAddress& from, KX_NetworkReader& reader, double time);
+	void ReceiveDisconnect(const KX_NetworkAddress& from);
+	void RemoveTimedOutClients(double time);
+	void UpdateLayout(ServerEntity& entity);
+	void GatherStates();
+	void SendSnapshot(Client& client, double time);
+
+	// Client functions.
+	void SendAck();
+	void ReceiveSnapshot(KX_NetworkReader& reader);
+	void CompleteSnapshot(const Snapshot *baseline);
+	void ApplyEntity(const EntityState& state, std::unordered_map<std::string, std::vector<KX_GameObject *> >& candidates,
+	                 bool& candidatesValid);
+	void RemoveEntity(unsigned int id);
+	/// Release the replicated objects and the received snapshots of a previous server session.
+	void ResetClient();
+
+public:
+	KX_ReplicationManager(KX_Scene *scene);
+	~KX_ReplicationManager();
+
+	/** Start a server.
+	 * \param port The UDP port.
+	 * \param interestRadius The distance to the client camera of the replicated objects, 0 for no limit.
+	 * \param sendInterval The number of logic frames between two snapshots.
+	 * \return False if the port can't be opened.
+	 */
+	bool StartServer(unsigned short port, float interestRadius, unsigned int sendInterval);
+	/** Start a client connected to a server.
+	 * \param localPort The local UDP port, 0 for any port.
+	 * \return False if the host can't be resolved or the port opened.
+	 */
+	bool StartClient(const std::string& host, unsigned short port, unsigned short localPort);
+	/// Disconnect and release the replicated objects.
+	void Stop();
+
+	Role GetRole() const;
+	unsigned short GetPort() const;
+	const Stats& GetStats() const;
+
+	/// Receive and send the snapshots, called at the end of each logic frame.
+	void Update();
+	/// Forget an object removed from the scene.
+	void RemoveObject(KX_GameObject *gameobj);
+};
+
+#endif  // __KX_REPLICATIONMANAGER_H__
@@ -39,6 +39,7 @@
 #include "KX_Globals.h"
 #include "BLI_utildefines.h"
 #include "KX_KetsjiEngine.h"
+#include "KX_TraceProfiler.h"
 #include "KX_BlenderMaterial.h"
 #include "KX_TextMaterial.h"
 #include "KX_FontObject.h"
@@ -91,6 +92,9 @@
 #include "BL_ShapeDeformer.h"
 #include "BL_DeformableGameObject.h"
 #include "KX_ObstacleSimulation.h"
+#include "KX_NavMeshObject.h"
+#include "KX_SceneSnapshot.h"
+#include "KX_ReplicationManager.h"
 
 #ifdef WITH_BULLET
 #  include "KX_SoftBodyDeformer.h"
@@ -103,10 +107,13 @@
 #include "KX_LightObject.h"
 
 #include "BLI_task.h"
+#include "BLI_threads.h"
 
 #include "CM_Message.h"
 #include "CM_List.h"
 
+#include <algorithm>
+
 static void *KX_SceneReplicationFunc(SG_Node *node, void *gameobj, void *scene)
 {
 	KX_GameObject *replica = ((KX_Scene *)scene)->AddNodeReplicaObject(node, (KX_GameObject *)gameobj);
@@ -172,6 +179,21 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
 	m_cameralist = new EXP_ListValue<KX_Camera>();
 	m_fontlist = new EXP_ListValue<KX_FontObject>();
 
+	// The lists exposed to python are often accessed by name.
+	m_objectlist->SetUseNameIndex(true);
+	m_lightlist->SetUseNameIndex(true);
+	m_inactivelist->SetUseNameIndex(true);
+	m_cameralist->SetUseNameIndex(true);
+	m_fontlist->SetUseNameIndex(true);
+
+	// Many objects can be added and ended in a frame, avoid linear searches on removal.
+	m_objectlist->SetUsePositionIndex(true);
+	m_parentlist->SetUsePositionIndex(true);
+	m_lightlist->SetUsePositionIndex(true);
+	m_inactivelist->SetUsePositionIndex(true);
+	m_cameralist->SetUsePositionIndex(true);
+	m_fontlist->SetUsePositionIndex(true);
+
 	m_filterManager = new KX_2DFilterManager();
 	m_logicmgr = new SCA_LogicManager();
 
@@ -192,6 +214,7 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
 	m_logicmgr->RegisterEventManager(joymgr);
 
 	m_networkScene = new KX_NetworkMessageScene(messageManager);
+	m_replicationManager = nullptr;
 
 	m_rendererManager = new KX_TextureRendererManager(this);
 	KX_TextMaterial *textMaterial = new KX_TextMaterial();
@@ -199,6 +222,7 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
 	m_boundingBoxManager = new RAS_BoundingBoxManager();
 
 	m_animationPool = BLI_task_pool_create(KX_GetActiveEngine()->GetTaskScheduler(), &m_animationPoolData);
+	m_sceneGraphPool = BLI_task_pool_create(KX_GetActiveEngine()->GetTaskScheduler(), &m_sceneGraphNodes);
 
 #ifdef WITH_PYTHON
 	m_attrDict = nullptr;
@@ -217,8 +241,20 @@ KX_Scene::~KX_Scene()
 	 */
 	RemoveAllDebugProperties();
 
+	// Disconnect and release the replicated objects before their removal.
+	if (m_replicationManager) {
+		delete m_replicationManager;
+		m_replicationManager = nullptr;
+	}
+
+	// Give back the pooled objects to the root parent list.
+	while (!m_objectPools.empty()) {
+		ClearObjectPool(m_objectPools.begin()->first);
+	}
+
+	// Remove from the back to not shift the whole list at each removal.
 	while (GetRootParentList()->GetCount() > 0) {
-		KX_GameObject *parentobj = GetRootParentList()->GetValue(0);
+		KX_GameObject *parentobj = GetRootParentList()->GetBack();
 		this->RemoveObject(parentobj);
 	}
 
@@ -230,6 +266,10 @@ KX_Scene::~KX_Scene()
 		BLI_task_pool_free(m_animationPool);
 	}
 
+	if (m_sceneGraphPool) {
+		BLI_task_pool_free(m_sceneGraphPool);
+	}
+
 	if (m_objectlist) {
 		m_objectlist->Release();
 	}
@@ -350,6 +390,35 @@ EXP_ListValue<KX_FontObject> *KX_Scene::GetFontList() const
 	return m_fontlist;
 }
 
+void KX_Scene::NotifyObjectRenamed(KX_GameObject *gameobj)
+{
+	// Objects out of the lists, like the temporary cameras of the render, don't invalidate any index.
+	m_objectlist->NotifyNameChanged(gameobj);
+	m_inactivelist->NotifyNameChanged(gameobj);
+
+	switch (gameobj->GetGameObjectType()) {
+		case SCA_IObject::OBJ_CAMERA:
+		{
+			m_cameralist->NotifyNameChanged(gameobj);
+			break;
+		}
+		case SCA_IObject::OBJ_LIGHT:
+		{
+			m_lightlist->NotifyNameChanged(gameobj);
+			break;
+		}
+		case SCA_IObject::OBJ_TEXT:
+		{
+			m_fontlist->NotifyNameChanged(gameobj);
+			break;
+		}
+		default:
+		{
+			break;
+		}
+	}
+}
+
 SCA_LogicManager *KX_Scene::GetLogicManager() const
 {
 	return m_logicmgr;
@@ -815,14 +884,36 @@ KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobj, KX_GameObj
 
 	m_ueberExecutionPriority++;
 
-	// Lets create a replica.
-	KX_GameObject *replica = AddNodeReplicaObject(nullptr, originalobj);
+	KX_GameObject *replica = nullptr;
+	bool reused = false;
+
+	std::map<KX_GameObject *, ObjectPool>::iterator poolit = m_objectPools.find(originalobj);
+	if (poolit != m_objectPools.end()) {
+		ObjectPool& pool = poolit->second;
+		if (!pool.m_objects.empty()) {
+			replica = ReuseObject(originalobj, pool);
+			reused = true;
+			++pool.m_hits;
+		}
+		else {
+			++pool.m_misses;
+		}
+	}
+
+	if (!replica) {
+		// Lets create a replica.
+		replica = AddNodeReplicaObject(nullptr, originalobj);
+
+		if (poolit != m_objectPools.end()) {
+			m_pooledReplicas[replica] = originalobj;
+		}
+	}
 
 	/* Add a timebomb to this object
 	 * lifespan of zero means 'this object lives forever'. */
 	if (lifespan > 0.0f) {
 		// For now, convert between so called frames and realtime.
-		m_tempObjectList.push_back(replica);
+		m_tempObjectList.Add(replica);
 		/* This convert the life from frames to sort-of seconds, hard coded 0.02 that assumes we have 50 frames per second
 		 * if you change this value, make sure you change it in KX_GameObject::pyattr_get_life property too. */
 		EXP_Value *fval = new EXP_FloatValue(lifespan * 0.02f);
@@ -864,9 +955,11 @@ KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobj, KX_GameObj
 	// The size is correct, we can add the graphic controller to the physic engine.
 	replica->ActivateGraphicController(true);
 
-	// Now replicate logic.
-	for (KX_GameObject *gameobj : m_logicHierarchicalGameObjects) {
-		gameobj->ReParentLogic();
+	// Now replicate logic, the logic bricks of a reused object are already owned by it.
+	if (!reused) {
+		for (KX_GameObject *gameobj : m_logicHierarchicalGameObjects) {
+			gameobj->ReParentLogic();
+		}
 	}
 
 	// Relink any pointers as necessary, sort of a temporary solution.
@@ -904,8 +997,247 @@ KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobj, KX_GameObj
 	return replica;
 }
 
+bool KX_Scene::SetObjectPool(KX_GameObject *templateobj, unsigned int size)
+{
+	if (size == 0) {
+		ClearObjectPool(templateobj);
+		return true;
+	}
+
+	/* The recycling doesn't support hierarchies and objects registered in specific lists,
+	 * only the plain game objects have no specialized type. */
+	if ((templateobj->GetGameObjectType() != -1) || !templateobj->GetSGNode()->GetSGChildren().empty() ||
+	    templateobj->IsDupliGroup() || templateobj->GetComponents())
+	{
+		return false;
+	}
+
+	ObjectPool& pool = m_objectPools[templateobj];
+	pool.m_maxSize = size;
+
+	// Release the replicas exceeding the new size.
+	while (pool.m_objects.size() > size) {
+		KX_GameObject *gameobj = pool.m_objects.back();
+		pool.m_objects.pop_back();
+		m_pooledReplicas.erase(gameobj);
+		// Give back the pool reference to the parent list to destruct the object as any other.
+		m_parentlist->Add(gameobj);
+		RemoveObject(gameobj);
+	}
+
+	return true;
+}
+
+const KX_Scene::ObjectPool *KX_Scene::GetObjectPool(KX_GameObject *templateobj) const
+{
+	std::map<KX_GameObject *, ObjectPool>::const_iterator it = m_objectPools.find(templateobj);
+	return (it != m_objectPools.end()) ? &it->second : nullptr;
+}
+
+void KX_Scene::GetObjectPoolStats(unsigned int& pooled, unsigned int& hits, unsigned int& misses) const
+{
+	for (const std::pair<KX_GameObject * const, ObjectPool>& pair : m_objectPools) {
+		const ObjectPool& pool = pair.second;
+		pooled += pool.m_objects.size();
+		hits += pool.m_hits;
+		misses += pool.m_misses;
+	}
+}
+
+void KX_Scene::ClearObjectPool(KX_GameObject *templateobj)
+{
+	std::map<KX_GameObject *, ObjectPool>::iterator poolit = m_objectPools.find(templateobj);
+	if (poolit == m_objectPools.end()) {
+		return;
+	}
+
+	// Erase the pool first to never recycle the objects again.
+	const std::vector<KX_GameObject *> objects = poolit->second.m_objects;
+	m_objectPools.erase(poolit);
+
+	for (std::unordered_map<KX_GameObject *, KX_GameObject *>::iterator it = m_pooledReplicas.begin();
+	     it != m_pooledReplicas.end();)
+	{
+		if (it->second == templateobj) {
+			it = m_pooledReplicas.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+
+	for (KX_GameObject *gameobj : objects) {
+		// Give back the pool reference to the parent list to destruct the object as any other.
+		m_parentlist->Add(gameobj);
+		RemoveObject(gameobj);
+	}
+}
+
+void KX_Scene::SaveState(std::vector<char>& buffer)
+{
+	KX_SceneSnapshot::Save(this, buffer);
+}
+
+int KX_Scene::RestoreState(const char *data, unsigned int size)
+{
+	return KX_SceneSnapshot::Restore(this, data, size);
+}
+
+bool KX_Scene::RecycleObject(KX_GameObject *gameobj)
+{
+	std::unordered_map<KX_GameObject *, KX_GameObject *>::iterator it = m_pooledReplicas.find(gameobj);
+	if (it == m_pooledReplicas.end()) {
+		return false;
+	}
+
+	ObjectPool& pool = m_objectPools[it->second];
+	SG_Node *node = gameobj->GetSGNode();
+	// Objects parented at runtime are destructed with their hierarchy.
+	if (pool.m_objects.size() >= pool.m_maxSize || !node || node->GetSGParent() ||
+	    !node->GetSGChildren().empty() || gameobj->GetDupliGroupObject())
+	{
+		return false;
+	}
+
+	KX_TRACE_SCOPE("KX_Scene::RecycleObject");
+
+	RemoveObjectDebugProperties(gameobj);
+
+	// Python references to the ended object are invalidated as for a deleted object.
+	gameobj->InvalidateProxy();
+
+	// The actuators and objects targeting this object must not find it again when reused.
+	gameobj->UnlinkRegistered();
+
+	// Clear the state to deactivate the controllers, the initial state is set back when reused.
+	gameobj->SetState(0);
+
+	for (SCA_ISensor *sensor : gameobj->GetSensors()) {
+		m_logicmgr->RemoveSensor(sensor);
+	}
+	for (SCA_IController *controller : gameobj->GetControllers()) {
+		m_logicmgr->RemoveController(controller);
+	}
+	for (SCA_IActuator *actuator : gameobj->GetActuators()) {
+		m_logicmgr->RemoveActuator(actuator);
+	}
+
+	for (unsigned short i = 0, numprops = gameobj->GetPropertyCount(); i < numprops; ++i) {
+		EXP_Value *propval = gameobj->GetProperty(i);
+		if (propval->GetProperty("timer")) {
+			m_timemgr->RemoveTimeProperty(propval);
+		}
+	}
+
+	if (m_obstacleSimulation) {
+		m_obstacleSimulation->DestroyObstacleForObj(gameobj);
+	}
+
+	if (m_replicationManager && gameobj->GetReplicationId() != 0) {
+		m_replicationManager->RemoveObject(gameobj);
+	}
+
+	m_rendererManager->InvalidateViewpoint(gameobj);
+
+	// The playing actions are stopped, armatures stay in the animated list as new replicas.
+	gameobj->RemoveActionManager();
+	if (gameobj->GetGameObjectType() != SCA_IObject::OBJ_ARMATURE) {
+		m_animatedlist.Remove(gameobj);
+	}
+
+	PHY_IPhysicsController *physicsCtrl = gameobj->GetPhysicsController();
+	if (physicsCtrl && !physicsCtrl->IsPhysicsSuspended()) {
+		physicsCtrl->SuspendPhysics(true);
+	}
+
+	PHY_IGraphicController *graphicCtrl = gameobj->GetGraphicController();
+	if (graphicCtrl) {
+		graphicCtrl->Activate(false);
+	}
+
+	// The reference of the parent list is transferred to the pool.
+	if (m_objectlist->RemoveValue(gameobj)) {
+		gameobj->Release();
+	}
+	m_parentlist->RemoveValue(gameobj);
+
+	m_euthanasyobjects.Remove(gameobj);
+	m_tempObjectList.Remove(gameobj);
+
+	pool.m_objects.push_back(gameobj);
+
+	return true;
+}
+
+KX_GameObject *KX_Scene::ReuseObject(KX_GameObject *templateobj, ObjectPool& pool)
+{
+	KX_TRACE_SCOPE("KX_Scene::ReuseObject");
+
+	KX_GameObject *replica = pool.m_objects.back();
+	pool.m_objects.pop_back();
+
+	m_map_gameobject_to_replica[templateobj] = replica;
+
+	// Reset the properties to the ones of the template.
+	replica->ClearProperties();
+	for (const std::string& name : templateobj->GetPropertyNames()) {
+		EXP_Value *prop = templateobj->GetProperty(name)->GetReplica();
+		replica->SetProperty(name, prop);
+		if (prop->GetProperty("timer")) {
+			m_timemgr->AddTimeProperty(prop);
+		}
+		prop->Release();
+	}
+
+	// Reset the state changed at runtime before the physics is restored with the template collision filter.
+	replica->ResetReplica(templateobj);
+
+	// Reset the transform as for a new replica, the physics controller is updated too.
+	SG_Node *orgnode = templateobj->GetSGNode();
+	replica->NodeSetLocalScale(orgnode->GetLocalScale());
+	replica->NodeSetLocalPosition(orgnode->GetLocalPosition());
+	replica->NodeSetLocalOrientation(orgnode->GetLocalOrientation());
+	replica->SetVisible(templateobj->GetVisible(), false);
+
+	PHY_IPhysicsController *physicsCtrl = replica->GetPhysicsController();
+	if (physicsCtrl) {
+		physicsCtrl->RestorePhysics();
+		if (physicsCtrl->IsDynamicsSuspended()) {
+			physicsCtrl->RestoreDynamics();
+		}
+		physicsCtrl->SetLinearVelocity(mt::zero3, false);
+		physicsCtrl->SetAngularVelocity(mt::zero3, false);
+	}
+
+	if (m_obstacleSimulation && templateobj->GetBlenderObject()->gameflag & OB_HASOBSTACLE) {
+		m_obstacleSimulation->AddObstacleForObj(replica);
+	}
+
+	// The logic could be suspended by the activity culling.
+	replica->ResumeLogic();
+
+	/* Restore the links of the controllers from the template ones, they are mapped
+	 * to the bricks of the replica in ReplicateLogic. */
+	const SCA_ControllerList& controllers = replica->GetControllers();
+	const SCA_ControllerList& orgcontrollers = templateobj->GetControllers();
+	for (unsigned short i = 0, size = controllers.size(); i < size; ++i) {
+		controllers[i]->GetLinkedSensors() = orgcontrollers[i]->GetLinkedSensors();
+		controllers[i]->GetLinkedActuators() = orgcontrollers[i]->GetLinkedActuators();
+	}
+
+	// The reference owned by the pool is returned as for a new replica.
+	m_objectlist->Add(CM_AddRef(replica));
+	m_logicHierarchicalGameObjects.push_back(replica);
+
+	return replica;
+}
+
 void KX_Scene::RemoveObject(KX_GameObject *gameobj)
 {
+	if (RecycleObject(gameobj)) {
+		return;
+	}
+
 	// Disconnect child from parent.
 	SG_Node *node = gameobj->GetSGNode();
 
@@ -930,7 +1262,7 @@ void KX_Scene::DelayedRemoveObject(KX_GameObject *gameobj)
 {
 	RemoveDupliGroup(gameobj);
 
-	CM_ListAddIfNotFound(m_euthanasyobjects, gameobj);
+	m_euthanasyobjects.Add(gameobj);
 }
 
 bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
@@ -1000,8 +1332,20 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
 		m_obstacleSimulation->DestroyObstacleForObj(gameobj);
 	}
 
+	if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_NAVMESH) {
+		CM_ListRemoveIfFound(m_navMeshUpdateList, static_cast<KX_NavMeshObject *>(gameobj));
+	}
+
+	if (m_replicationManager && gameobj->GetReplicationId() != 0) {
+		m_replicationManager->RemoveObject(gameobj);
+	}
+
 	m_componentManager.UnregisterObject(gameobj);
 
+	m_pooledReplicas.erase(gameobj);
+	// The template of a pool is removed, release the pooled replicas.
+	ClearObjectPool(gameobj);
+
 	gameobj->RemoveMeshes();
 
 	m_rendererManager->InvalidateViewpoint(gameobj);
@@ -1027,9 +1371,9 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
 	}
 
 	// WARNING: 'gameobj' maybe be freed now, only compare, don't access.
-	CM_ListRemoveIfFound(m_animatedlist, gameobj);
-	CM_ListRemoveIfFound(m_euthanasyobjects, gameobj);
-	CM_ListRemoveIfFound(m_tempObjectList, gameobj);
+	m_animatedlist.Remove(gameobj);
+	m_euthanasyobjects.Remove(gameobj);
+	m_tempObjectList.Remove(gameobj);
 
 	if (gameobj == m_activeCamera) {
 		m_activeCamera = nullptr;
@@ -1104,6 +1448,8 @@ void KX_Scene::CalculateVisibleMeshes(std::vector<KX_GameObject *>& objects, KX_
 
 void KX_Scene::CalculateVisibleMeshes(std::vector<KX_GameObject *>& objects, const SG_Frustum& frustum, int layer)
 {
+	KX_TRACE_SCOPE("KX_Scene::CalculateVisibleMeshes");
+
 	m_boundingBoxManager->Update(false);
 
 	bool dbvt_culling = false;
@@ -1146,9 +1492,11 @@ void KX_Scene::CalculateVisibleMeshes(std::vector<KX_GameObject *>& objects, con
 				// Update the object bounding volume box.
 				gameobj->UpdateBounds(false);
 
-				handler.Process(gameobj);
+				handler.Add(gameobj);
 			}
 		}
+
+		handler.Process();
 	}
 
 	m_boundingBoxManager->ClearModified();
@@ -1242,6 +1590,18 @@ void KX_Scene::RenderDebugProperties(RAS_DebugDraw& debugDraw, int xindent, int
 
 void KX_Scene::LogicBeginFrame(double curtime, double framestep)
 {
+	KX_TRACE_SCOPE("KX_Scene::LogicBeginFrame");
+
+	// Complete the navigation mesh builds and path requests of the previous frame.
+	if (!m_navMeshUpdateList.empty()) {
+		// The path callbacks can request new paths.
+		std::vector<KX_NavMeshObject *> navmeshes;
+		navmeshes.swap(m_navMeshUpdateList);
+		for (KX_NavMeshObject *navmesh : navmeshes) {
+			navmesh->UpdateTasks();
+		}
+	}
+
 	// Have a look at temp objects.
 	for (KX_GameObject *gameobj : m_tempObjectList) {
 		EXP_FloatValue *propval = static_cast<EXP_FloatValue *>(gameobj->GetProperty("::timebomb"));
@@ -1267,7 +1627,7 @@ void KX_Scene::LogicBeginFrame(double curtime, double framestep)
 
 void KX_Scene::AddAnimatedObject(KX_GameObject *gameobj)
 {
-	CM_ListAddIfNotFound(m_animatedlist, gameobj);
+	m_animatedlist.Add(gameobj);
 }
 
 static void update_anim_thread_func(TaskPool *pool, void *taskdata, int UNUSED(threadid))
@@ -1277,6 +1637,8 @@ static void update_anim_thread_func(TaskPool *pool, void *taskdata, int UNUSED(t
 
 	KX_GameObject *gameobj = (KX_GameObject *)taskdata;
 
+	KX_TRACE_SCOPE("Animation task");
+
 	// Non-armature updates are fast enough, so just update them
 	bool needs_update = gameobj->GetGameObjectType() != SCA_IObject::OBJ_ARMATURE;
 
@@ -1347,6 +1709,8 @@ void KX_Scene::UpdateAnimations(double curtime, bool restrict)
 		m_previousAnimTime = curtime;
 	}
 
+	KX_TRACE_SCOPE("KX_Scene::UpdateAnimations");
+
 	m_animationPoolData.curtime = curtime;
 
 	for (KX_GameObject *gameobj : m_animatedlist) {
@@ -1360,13 +1724,25 @@ void KX_Scene::UpdateAnimations(double curtime, bool restrict)
 
 void KX_Scene::LogicUpdateFrame(double curtime)
 {
-	m_componentManager.UpdateComponents();
+	KX_TRACE_SCOPE("KX_Scene::LogicUpdateFrame");
+
+	{
+		KX_TRACE_SCOPE("KX_PythonComponentManager::UpdateComponents");
+		m_componentManager.UpdateComponents();
+	}
 
 	m_logicmgr->UpdateFrame(curtime);
+
+	// Apply the velocities requested by the steering actuators.
+	if (m_obstacleSimulation) {
+		m_obstacleSimulation->ProcessVelocityRequests();
+	}
 }
 
 void KX_Scene::LogicEndFrame()
 {
+	KX_TRACE_SCOPE("KX_Scene::LogicEndFrame");
+
 	m_logicmgr->EndFrame();
 
 	/* Don't remove the objects from the euthanasy list here as the child objects of a deleted
@@ -1375,8 +1751,13 @@ void KX_Scene::LogicEndFrame()
 	 * euthanasy list to avoid double deletion in case the user ask to delete the child object
 	 * explicitly. NewRemoveObject is the place to do it.
 	 */
-	while (!m_euthanasyobjects.empty()) {
-		RemoveObject(m_euthanasyobjects.front());
+	while (!m_euthanasyobjects.Empty()) {
+		RemoveObject(m_euthanasyobjects.Front());
+	}
+
+	// Send or apply the replicated states once the logic of the frame is done.
+	if (m_replicationManager) {
+		m_replicationManager->Update();
 	}
 
 	//prepare obstacle simulation for new frame
@@ -1389,9 +1770,78 @@ void KX_Scene::LogicEndFrame()
 	}
 }
 
+static void update_parents_thread_func(TaskPool *pool, void *taskdata, int UNUSED(threadid))
+{
+	const std::vector<SG_Node *>& nodes = *(std::vector<SG_Node *> *)BLI_task_pool_userdata(pool);
+	KX_Scene::SceneGraphTaskRange *range = (KX_Scene::SceneGraphTaskRange *)taskdata;
+
+	KX_TRACE_SCOPE("Scene graph task");
+
+	for (unsigned int i = range->begin; i < range->end; ++i) {
+		nodes[i]->UpdateScheduledWorldDataThread(range->updatedNodes);
+	}
+}
+
+bool KX_Scene::UpdateParentsParallel()
+{
+	// Minimum number of scheduled nodes updated by a task.
+	static const unsigned int taskNodes = 64;
+
+	m_sceneGraphNodes.clear();
+	SG_DList::iterator<SG_Node> it(m_sghead);
+	for (it.begin(); !it.end(); ++it) {
+		m_sceneGraphNodes.push_back(*it);
+	}
+
+	if (m_sceneGraphNodes.size() < (taskNodes * 2)) {
+		return false;
+	}
+
+	/* Nodes of the same hierarchy share the same familly, group them to update each hierarchy
+	 * in a single task. The order of the scheduled list is kept inside a hierarchy. */
+	std::stable_sort(m_sceneGraphNodes.begin(), m_sceneGraphNodes.end(), [](SG_Node *node1, SG_Node *node2) {
+		return node1->GetFamilly().get() < node2->GetFamilly().get();
+	});
+
+	m_sceneGraphRanges.clear();
+	unsigned int begin = 0;
+	for (unsigned int i = 1, size = m_sceneGraphNodes.size(); i <= size; ++i) {
+		if (i == size || ((i - begin) >= taskNodes &&
+		                  m_sceneGraphNodes[i]->GetFamilly() != m_sceneGraphNodes[i - 1]->GetFamilly()))
+		{
+			m_sceneGraphRanges.push_back({begin, i, {}});
+			begin = i;
+		}
+	}
+
+	for (SceneGraphTaskRange& range : m_sceneGraphRanges) {
+		BLI_task_pool_push(m_sceneGraphPool, update_parents_thread_func, &range, false, TASK_PRIORITY_HIGH);
+	}
+
+	BLI_task_pool_work_and_wait(m_sceneGraphPool);
+
+	/* The transform callbacks update the physics and culling trees shared by all the
+	 * hierarchies, they are called from the main thread in the order of the updates. */
+	for (const SceneGraphTaskRange& range : m_sceneGraphRanges) {
+		for (SG_Node *node : range.updatedNodes) {
+			node->ActivateUpdateTransformCallback();
+		}
+	}
+
+	return true;
+}
+
 void KX_Scene::UpdateParents()
 {
-	// We use the SG dynamic list
+	KX_TRACE_SCOPE("KX_Scene::UpdateParents");
+
+	/* The scene graph tasks are not nested into the tasks of scenes proceeded in parallel,
+	 * the scenes are already using the worker threads. */
+	if (KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PARALLEL_SCENEGRAPH) && BLI_thread_is_main()) {
+		UpdateParentsParallel();
+	}
+
+	// We use the SG dynamic list, it contains the remaining nodes or nodes scheduled during a parallel update.
 	SG_Node *node;
 
 	while ((node = SG_Node::GetNextScheduled(m_sghead))) {
@@ -1414,6 +1864,8 @@ RAS_MaterialBucket *KX_Scene::FindBucket(RAS_IPolyMaterial *polymat, bool &bucke
 void KX_Scene::RenderBuckets(const std::vector<KX_GameObject *>& objects, RAS_Rasterizer::DrawType drawingMode, const mt::mat3x4& cameratransform,
                              RAS_Rasterizer *rasty, RAS_OffScreen *offScreen)
 {
+	KX_TRACE_SCOPE("KX_Scene::RenderBuckets");
+
 	for (KX_GameObject *gameobj : objects) {
 		/* This function update all mesh slot info (e.g culling, color, matrix) from the game object.
 		 * It's done just before the render to be sure of the object color and visibility. */
@@ -1549,122 +2001,147 @@ Scene *KX_Scene::GetBlenderScene() const
 	return m_blenderScene;
 }
 
-static void MergeScene_LogicBrick(SCA_ILogicBrick *brick, KX_Scene *from, KX_Scene *to)
+static void MergeScene_LogicBrick(SCA_ILogicBrick *brick, KX_Scene *to)
 {
-	SCA_LogicManager *logicmgr = to->GetLogicManager();
-
 	brick->Replace_IScene(to);
 	brick->Replace_NetworkScene(to->GetNetworkMessageScene());
 	brick->SetLogicManager(to->GetLogicManager());
 
-	/* If we end up replacing a KX_CollisionEventManager, we need to make sure
-	 * physics controllers are properly in place. In other words, do this
-	 * after merging physics controllers.
-	 */
-	SCA_ISensor *sensor = dynamic_cast<SCA_ISensor *>(brick);
-	if (sensor) {
-		sensor->Replace_EventManager(logicmgr);
-	}
-
 	SCA_2DFilterActuator *filter_actuator = dynamic_cast<SCA_2DFilterActuator *>(brick);
 	if (filter_actuator) {
 		filter_actuator->SetScene(to, to->Get2DFilterManager());
 	}
 }
 
-static void MergeScene_GameObject(KX_GameObject *gameobj, KX_Scene *to, KX_Scene *from)
+bool KX_Scene::CanMergeScene(KX_Scene *other) const
 {
-	const SCA_ActuatorList& actuators = gameobj->GetActuators();
-	for (SCA_IActuator *actuator : actuators) {
-		MergeScene_LogicBrick(actuator, from, to);
-	}
-
-	const SCA_SensorList& sensors = gameobj->GetSensors();
-	for (SCA_ISensor *sensor : sensors) {
-		MergeScene_LogicBrick(sensor, from, to);
-	}
-
-	const SCA_ControllerList& controllers = gameobj->GetControllers();
-	for (SCA_IController *controller : controllers) {
-		MergeScene_LogicBrick(controller, from, to);
-	}
+	PHY_IPhysicsEnvironment *env = m_physicsEnvironment;
+	PHY_IPhysicsEnvironment *env_other = other->GetPhysicsEnvironment();
 
-	// Graphics controller.
-	PHY_IGraphicController *graphicCtrl = gameobj->GetGraphicController();
-	if (graphicCtrl) {
-		// Should update the m_cullingTree.
-		graphicCtrl->SetPhysicsEnvironment(to->GetPhysicsEnvironment());
+	if ((env == nullptr) != (env_other == nullptr)) {
+		// TODO - even when both scenes have NONE physics, the other is loaded with bullet enabled, ???
+		CM_FunctionError("physics scenes type differ, aborting\n\tsource " << (int)(env != nullptr) << ", target " << (int)(env_other != nullptr));
+		return false;
 	}
 
-	PHY_IPhysicsController *physicsCtrl = gameobj->GetPhysicsController();
-	if (physicsCtrl) {
-		physicsCtrl->SetPhysicsEnvironment(to->GetPhysicsEnvironment());
-	}
+	return true;
+}
 
+void KX_Scene::MergeSceneObject(KX_GameObject *gameobj, KX_Scene *other)
+{
 	// SG_Node can hold a scene reference.
 	SG_Node *sg = gameobj->GetSGNode();
 	if (sg) {
-		if (sg->GetSGClientInfo() == from) {
-			sg->SetSGClientInfo(to);
+		if (sg->GetSGClientInfo() == other) {
+			sg->SetSGClientInfo(this);
 
 			// Make sure to grab the children too since they might not be tied to a game object.
 			const NodeList& children = sg->GetSGChildren();
 			for (SG_Node *child : children) {
-				child->SetSGClientInfo(to);
+				child->SetSGClientInfo(this);
 			}
 		}
 	}
 	// If the object is a light, update it's scene.
 	if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_LIGHT) {
-		static_cast<KX_LightObject *>(gameobj)->UpdateScene(to);
+		static_cast<KX_LightObject *>(gameobj)->UpdateScene(this);
 	}
+}
 
-	// All armatures should be in the animated object list to be umpdated.
-	if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
-		to->AddAnimatedObject(gameobj);
+void KX_Scene::MergeSceneLogic(KX_GameObject *gameobj)
+{
+	const SCA_ActuatorList& actuators = gameobj->GetActuators();
+	for (SCA_IActuator *actuator : actuators) {
+		MergeScene_LogicBrick(actuator, this);
+	}
+
+	const SCA_SensorList& sensors = gameobj->GetSensors();
+	for (SCA_ISensor *sensor : sensors) {
+		MergeScene_LogicBrick(sensor, this);
+	}
+
+	const SCA_ControllerList& controllers = gameobj->GetControllers();
+	for (SCA_IController *controller : controllers) {
+		MergeScene_LogicBrick(controller, this);
 	}
 
 	// Add the object to the scene's logic manager.
-	to->GetLogicManager()->RegisterGameObjectName(gameobj->GetName(), gameobj);
-	to->GetLogicManager()->RegisterGameObj(gameobj->GetBlenderObject(), gameobj);
+	m_logicmgr->RegisterGameObjectName(gameobj->GetName(), gameobj);
+	m_logicmgr->RegisterGameObj(gameobj->GetBlenderObject(), gameobj);
 
 	for (KX_Mesh *meshobj : gameobj->GetMeshList()) {
 		// Register the mesh object by name and blender object.
-		to->GetLogicManager()->RegisterGameMeshName(meshobj->GetName(), gameobj->GetBlenderObject());
-		to->GetLogicManager()->RegisterMeshName(meshobj->GetName(), meshobj);
+		m_logicmgr->RegisterGameMeshName(meshobj->GetName(), gameobj->GetBlenderObject());
+		m_logicmgr->RegisterMeshName(meshobj->GetName(), meshobj);
 	}
 }
 
-bool KX_Scene::MergeScene(KX_Scene *other)
+static void MergeScene_Physics(KX_GameObject *gameobj, PHY_IPhysicsEnvironment *env)
 {
-	PHY_IPhysicsEnvironment *env = this->GetPhysicsEnvironment();
-	PHY_IPhysicsEnvironment *env_other = other->GetPhysicsEnvironment();
+	// Graphics controller.
+	PHY_IGraphicController *graphicCtrl = gameobj->GetGraphicController();
+	if (graphicCtrl) {
+		// Should update the m_cullingTree.
+		graphicCtrl->SetPhysicsEnvironment(env);
+	}
 
-	if ((env == nullptr) != (env_other == nullptr)) {
-		// TODO - even when both scenes have NONE physics, the other is loaded with bullet enabled, ???
-		CM_FunctionError("physics scenes type differ, aborting\n\tsource " << (int)(env != nullptr) << ", target " << (int)(env_other != nullptr));
-		return false;
+	PHY_IPhysicsController *physicsCtrl = gameobj->GetPhysicsController();
+	if (physicsCtrl) {
+		physicsCtrl->SetPhysicsEnvironment(env);
+	}
+}
+
+static void MergeScene_Sensors(KX_GameObject *gameobj, SCA_LogicManager *logicmgr)
+{
+	/* If we end up replacing a KX_CollisionEventManager, we need to make sure
+	 * physics controllers are properly in place. In other words, do this
+	 * after merging physics controllers.
+	 */
+	for (SCA_ISensor *sensor : gameobj->GetSensors()) {
+		sensor->Replace_EventManager(logicmgr);
+	}
+}
+
+void KX_Scene::MergeSceneFinish(KX_Scene *other)
+{
+	/* The physics controllers are moved with the rest of the live data to never expose
+	 * to the collisions and the culling an object missing in the scene lists.
+	 */
+	for (EXP_ListValue<KX_GameObject> *list : {other->GetObjectList(), other->GetInactiveList()}) {
+		for (KX_GameObject *gameobj : list) {
+			MergeScene_Physics(gameobj, m_physicsEnvironment);
+		}
 	}
 
 	GetBucketManager()->MergeBucketManager(other->GetBucketManager(), this);
 	GetBoundingBoxManager()->Merge(other->GetBoundingBoxManager());
 	GetTextureRendererManager()->Merge(other->GetTextureRendererManager());
 
+	const bool debugProperties = KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::AUTO_ADD_DEBUG_PROPERTIES);
 	for (KX_GameObject *gameobj : *other->GetObjectList()) {
-		MergeScene_GameObject(gameobj, this, other);
+		MergeScene_Sensors(gameobj, m_logicmgr);
+
+		// All armatures should be in the animated object list to be umpdated.
+		if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
+			AddAnimatedObject(gameobj);
+		}
 
 		// Add properties to debug list for LibLoad objects.
-		if (KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::AUTO_ADD_DEBUG_PROPERTIES)) {
+		if (debugProperties) {
 			AddObjectDebugProperties(gameobj);
 		}
 	}
 
 	for (KX_GameObject *gameobj : *other->GetInactiveList()) {
-		MergeScene_GameObject(gameobj, this, other);
+		MergeScene_Sensors(gameobj, m_logicmgr);
+
+		if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
+			AddAnimatedObject(gameobj);
+		}
 	}
 
-	if (env) {
-		env->MergeEnvironment(env_other);
+	if (m_physicsEnvironment) {
+		m_physicsEnvironment->MergeEnvironment(other->GetPhysicsEnvironment());
 		EXP_ListValue<KX_GameObject> *otherObjects = other->GetObjectList();
 
 		// List of all physics objects to merge (needed by ReplicateConstraints).
@@ -1706,6 +2183,22 @@ bool KX_Scene::MergeScene(KX_Scene *other)
 	for (EXP_Value *time : times) {
 		m_timemgr->AddTimeProperty(time);
 	}
+}
+
+bool KX_Scene::MergeScene(KX_Scene *other)
+{
+	if (!CanMergeScene(other)) {
+		return false;
+	}
+
+	for (EXP_ListValue<KX_GameObject> *list : {other->GetObjectList(), other->GetInactiveList()}) {
+		for (KX_GameObject *gameobj : list) {
+			MergeSceneObject(gameobj, other);
+			MergeSceneLogic(gameobj);
+		}
+	}
+
+	MergeSceneFinish(other);
 
 	return true;
 }
@@ -1725,6 +2218,21 @@ KX_ObstacleSimulation *KX_Scene::GetObstacleSimulation()
 	return m_obstacleSimulation;
 }
 
+void KX_Scene::ScheduleNavMeshUpdate(KX_NavMeshObject *navmesh)
+{
+	if (std::find(m_navMeshUpdateList.begin(), m_navMeshUpdateList.end(), navmesh) == m_navMeshUpdateList.end()) {
+		m_navMeshUpdateList.push_back(navmesh);
+	}
+}
+
+KX_ReplicationManager *KX_Scene::GetReplicationManager()
+{
+	if (!m_replicationManager) {
+		m_replicationManager = new KX_ReplicationManager(this);
+	}
+	return m_replicationManager;
+}
+
 void KX_Scene::SetObstacleSimulation(KX_ObstacleSimulation *obstacleSimulation)
 {
 	m_obstacleSimulation = obstacleSimulation;
@@ -1781,6 +2289,14 @@ PyMethodDef KX_Scene::Methods[] = {
 	EXP_PYMETHODTABLE(KX_Scene, suspend),
 	EXP_PYMETHODTABLE(KX_Scene, resume),
 	EXP_PYMETHODTABLE(KX_Scene, drawObstacleSimulation),
+	EXP_PYMETHODTABLE(KX_Scene, setObjectPool),
+	EXP_PYMETHODTABLE(KX_Scene, getObjectPool),
+	EXP_PYMETHODTABLE(KX_Scene, saveState),
+	EXP_PYMETHODTABLE(KX_Scene, restoreState),
+	EXP_PYMETHODTABLE(KX_Scene, startReplicationServer),
+	EXP_PYMETHODTABLE(KX_Scene, startReplicationClient),
+	EXP_PYMETHODTABLE_NOARGS(KX_Scene, stopReplication),
+	EXP_PYMETHODTABLE_NOARGS(KX_Scene, getReplicationStats),
 
 	// Sict style access.
 	EXP_PYMETHODTABLE(KX_Scene, get),
@@ -2210,6 +2726,254 @@ EXP_PYMETHODDEF_DOC(KX_Scene, drawObstacleSimulation,
 	Py_RETURN_NONE;
 }
 
+EXP_PYMETHODDEF_DOC(KX_Scene, setObjectPool,
+                    "setObjectPool(object, size)\n"
+                    "Recycle up to size ended replicas of object, 0 to disable the pool.\n")
+{
+	PyObject *pyob;
+	KX_GameObject *ob;
+	int size;
+
+	if (!PyArg_ParseTuple(args, "Oi:setObjectPool", &pyob, &size)) {
+		return nullptr;
+	}
+
+	if (!ConvertPythonToGameObject(m_logicmgr, pyob, &ob, false, "scene.setObjectPool(object, size): KX_Scene (first argument)")) {
+		return nullptr;
+	}
+
+	if (!m_inactivelist->SearchValue(ob)) {
+		PyErr_SetString(PyExc_ValueError, "scene.setObjectPool(object, size): KX_Scene (first argument): object must be in an inactive layer");
+		return nullptr;
+	}
+
+	if (size < 0) {
+		PyErr_SetString(PyExc_ValueError, "scene.setObjectPool(object, size): KX_Scene (second argument): size must be positive or zero");
+		return nullptr;
+	}
+
+	if (!SetObjectPool(ob, size)) {
+		PyErr_Format(PyExc_ValueError, "scene.setObjectPool(object, size): KX_Scene: object \"%s\" can't be pooled, "
+		             "it must be a mesh or an empty without children, dupli group or components", ob->GetName().c_str());
+		return nullptr;
+	}
+
+	Py_RETURN_NONE;
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene, getObjectPool,
+                    "getObjectPool(object)\n"
+                    "Return the statistics of the pool of object or None.\n")
+{
+	PyObject *pyob;
+	KX_GameObject *ob;
+
+	if (!PyArg_ParseTuple(args, "O:getObjectPool", &pyob)) {
+		return nullptr;
+	}
+
+	if (!ConvertPythonToGameObject(m_logicmgr, pyob, &ob, false, "scene.getObjectPool(object): KX_Scene (first argument)")) {
+		return nullptr;
+	}
+
+	const ObjectPool *pool = GetObjectPool(ob);
+	if (!pool) {
+		Py_RETURN_NONE;
+	}
+
+	const unsigned int requests = pool->m_hits + pool->m_misses;
+	const float hitRate = (requests > 0) ? (float)pool->m_hits / (float)requests : 0.0f;
+
+	PyObject *dict = PyDict_New();
+	PyObject *item;
+
+	PyDict_SetItemString(dict, "size", item = PyLong_FromLong(pool->m_objects.size()));
+	Py_DECREF(item);
+	PyDict_SetItemString(dict, "maxSize", item = PyLong_FromLong(pool->m_maxSize));
+	Py_DECREF(item);
+	PyDict_SetItemString(dict, "hits", item = PyLong_FromLong(pool->m_hits));
+	Py_DECREF(item);
+	PyDict_SetItemString(dict, "misses", item = PyLong_FromLong(pool->m_misses));
+	Py_DECREF(item);
+	PyDict_SetItemString(dict, "hitRate", item = PyFloat_FromDouble(hitRate));
+	Py_DECREF(item);
+
+	return dict;
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene, saveState,
+                    "saveState(buffer=None)\n"
+                    "Save the state of the objects in a binary snapshot, return it as bytes\n"
+                    "or write it in a writable buffer and return the number of bytes written.\n")
+{
+	PyObject *pybuffer = nullptr;
+
+	if (!PyArg_ParseTuple(args, "|O:saveState", &pybuffer)) {
+		return nullptr;
+	}
+
+	SaveState(m_snapshotBuffer);
+	const unsigned int size = m_snapshotBuffer.size();
+
+	if (!pybuffer || pybuffer == Py_None) {
+		return PyBytes_FromStringAndSize(m_snapshotBuffer.data(), size);
+	}
+
+	Py_buffer view;
+	if (PyObject_GetBuffer(pybuffer, &view, PyBUF_WRITABLE) == -1) {
+		return nullptr;
+	}
+
+	if (view.len < (Py_ssize_t)size) {
+		PyBuffer_Release(&view);
+		PyErr_Format(PyExc_ValueError, "scene.saveState(buffer): KX_Scene: buffer too small, %u bytes required", size);
+		return nullptr;
+	}
+
+	memcpy(view.buf, m_snapshotBuffer.data(), size);
+	PyBuffer_Release(&view);
+
+	return PyLong_FromLong(size);
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene, restoreState,
+                    "restoreState(buffer)\n"
+                    "Restore in place a snapshot returned by saveState, return the number of restored objects.\n")
+{
+	PyObject *pybuffer;
+
+	if (!PyArg_ParseTuple(args, "O:restoreState", &pybuffer)) {
+		return nullptr;
+	}
+
+	Py_buffer view;
+	if (PyObject_GetBuffer(pybuffer, &view, PyBUF_SIMPLE) == -1) {
+		return nullptr;
+	}
+
+	const int restored = RestoreState((const char *)view.buf, view.len);
+	PyBuffer_Release(&view);
+
+	if (restored == -1) {
+		PyErr_SetString(PyExc_ValueError, "scene.restoreState(buffer): KX_Scene: invalid or incompatible snapshot");
+		return nullptr;
+	}
+
+	return PyLong_FromLong(restored);
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene, startReplicationServer,
+                    "startReplicationServer(port, interestRadius=0.0, sendInterval=1)\n"
+                    "Send the state of the replicated objects to the clients connecting on the UDP port.\n")
+{
+	int port;
+	float interestRadius = 0.0f;
+	int sendInterval = 1;
+
+	if (!PyArg_ParseTuple(args, "i|fi:startReplicationServer", &port, &interestRadius, &sendInterval)) {
+		return nullptr;
+	}
+
+	if (port < 0 || port > 65535 || interestRadius < 0.0f || sendInterval < 1) {
+		PyErr_SetString(PyExc_ValueError, "scene.startReplicationServer(port, interestRadius, sendInterval): KX_Scene, "
+		                "expected a port in [0, 65535], a positive radius and an interval of at least 1");
+		return nullptr;
+	}
+
+	if (!GetReplicationManager()->StartServer(port, interestRadius, sendInterval)) {
+		PyErr_Format(PyExc_RuntimeError, "scene.startReplicationServer(port, interestRadius, sendInterval): KX_Scene, "
+		             "failed to open the port %i", port);
+		return nullptr;
+	}
+
+	return PyLong_FromLong(m_replicationManager->GetPort());
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene, startReplicationClient,
+                    "startReplicationClient(address, port, localPort=0)\n"
+                    "Receive the state of the replicated objects from a server.\n")
+{
+	const char *address;
+	int port;
+	int localPort = 0;
+
+	if (!PyArg_ParseTuple(args, "si|i:startReplicationClient", &address, &port, &localPort)) {
+		return nullptr;
+	}
+
+	if (port < 0 || port > 65535 || localPort < 0 || localPort > 65535) {
+		PyErr_SetString(PyExc_ValueError, "scene.startReplicationClient(address, port, localPort): KX_Scene, "
+		                "expected ports in [0, 65535]");
+		return nullptr;
+	}
+
+	if (!GetReplicationManager()->StartClient(address, port, localPort)) {
+		PyErr_Format(PyExc_RuntimeError, "scene.startReplicationClient(address, port, localPort): KX_Scene, "
+		             "failed to connect to %s:%i", address, port);
+		return nullptr;
+	}
+
+	return PyLong_FromLong(m_replicationManager->GetPort());
+}
+
+EXP_PYMETHODDEF_DOC_NOARGS(KX_Scene, stopReplication,
+                           "stopReplication()\n"
+                           "Disconnect the replication server or client.\n")
+{
+	if (m_replicationManager) {
+		m_replicationManager->Stop();
+	}
+
+	Py_RETURN_NONE;
+}
+
+EXP_PYMETHODDEF_DOC_NOARGS(KX_Scene, getReplicationStats,
+                           "getReplicationStats()\n"
+                           "Return the replication statistics or None if the replication is not started.\n")
+{
+	if (!m_replicationManager || m_replicationManager->GetPort() == 0) {
+		Py_RETURN_NONE;
+	}
+
+	const KX_ReplicationManager::Stats& stats = m_replicationManager->GetStats();
+
+	const bool server = (m_replicationManager->GetRole() == KX_ReplicationManager::ROLE_SERVER);
+
+	PyObject *dict = PyDict_New();
+	PyObject *item;
+
+	PyDict_SetItemString(dict, "server", item = PyBool_FromLong(server));
+	Py_DECREF(item);
+	PyDict_SetItemString(dict, "port", item = PyLong_FromLong(m_replicationManager->GetPort()));
+	Py_DECREF(item);
+	PyDict_SetItemString(dict, "clients", item = PyLong_FromLong(stats.numClients));
+	Py_DECREF(item);
+	PyDict_SetItemString(dict, "objects", item = PyLong_FromLong(stats.numEntities));
+	Py_DECREF(item);
+	PyDict_SetItemString(dict, "bytesSent", item = PyLong_FromUnsignedLongLong(stats.bytesSent));
+	Py_DECREF(item);
+	PyDict_SetItemString(dict, "bytesReceived", item = PyLong_FromUnsignedLongLong(stats.bytesReceived));
+	Py_DECREF(item);
+	PyDict_SetItemString(dict, "packetsSent", item = PyLong_FromUnsignedLong(stats.packetsSent));
+	Py_DECREF(item);
+	PyDict_SetItemString(dict, "packetsReceived", item = PyLong_FromUnsignedLong(stats.packetsReceived));
+	Py_DECREF(item);
+	PyDict_SetItemString(dict, "sendBandwidth", item = PyFloat_FromDouble(stats.sendBandwidth));
+	Py_DECREF(item);
+	PyDict_SetItemString(dict, "receiveBandwidth", item = PyFloat_FromDouble(stats.receiveBandwidth));
+	Py_DECREF(item);
+	PyDict_SetItemString(dict, "roundTripTime", item = PyFloat_FromDouble(stats.roundTripTime));
+	Py_DECREF(item);
+	PyDict_SetItemString(dict, "snapshotsSent", item = PyLong_FromUnsignedLong(stats.snapshotsSent));
+	Py_DECREF(item);
+	PyDict_SetItemString(dict, "snapshotsReceived", item = PyLong_FromUnsignedLong(stats.snapshotsReceived));
+	Py_DECREF(item);
+	PyDict_SetItemString(dict, "snapshotsDropped", item = PyLong_FromUnsignedLong(stats.snapshotsDropped));
+	Py_DECREF(item);
+
+	return dict;
+}
+
 EXP_PYMETHODDEF_DOC(KX_Scene, get, "")
 {
 	PyObject *key;
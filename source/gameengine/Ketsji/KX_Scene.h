@@ -49,7 +49,11 @@
 #include "EXP_PyObjectPlus.h"
 #include "EXP_Value.h"
 
+#include "CM_IndexedSet.h"
+
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 template <class T>
 class EXP_ListValue;
@@ -62,8 +66,10 @@ class SCA_IInputDevice;
 class SCA_JoystickManager;
 class KX_NetworkMessageScene;
 class KX_NetworkMessageManager;
+class KX_ReplicationManager;
 class KX_2DFilterManager;
 class KX_ObstacleSimulation;
+class KX_NavMeshObject;
 class KX_WorldInfo;
 class KX_Camera;
 class KX_FontObject;
@@ -101,6 +107,28 @@ public:
 		double curtime;
 	};
 
+	/// Range of scheduled nodes updated by a scene graph task.
+	struct SceneGraphTaskRange
+	{
+		unsigned int begin;
+		unsigned int end;
+		/// Nodes updated by the task, their transform callbacks are called after the tasks.
+		std::vector<SG_Node *> updatedNodes;
+	};
+
+	/// Ended replicas of a template object kept to be reused by AddReplicaObject.
+	struct ObjectPool
+	{
+		/// The deactivated replicas, a reference is owned for each.
+		std::vector<KX_GameObject *> m_objects;
+		/// Maximum number of deactivated replicas.
+		unsigned int m_maxSize;
+		/// Number of added objects reusing a deactivated replica.
+		unsigned int m_hits;
+		/// Number of added objects replicated from the template.
+		unsigned int m_misses;
+	};
+
 	static SG_Callbacks m_callbacks;
 
 private:
@@ -129,14 +157,15 @@ private:
 	/// Manager used to update all the mesh bounding box.
 	RAS_BoundingBoxManager *m_boundingBoxManager;
 
-	std::vector<KX_GameObject *> m_tempObjectList;
+	/// Objects with a limited life time.
+	CM_IndexedSet<KX_GameObject *> m_tempObjectList;
 
 	/**
 	 * The list of objects which have been removed during the
 	 * course of one frame. They are actually destroyed in
 	 * LogicEndFrame() via a call to RemoveObject().
 	 */
-	std::vector<KX_GameObject *> m_euthanasyobjects;
+	CM_IndexedSet<KX_GameObject *> m_euthanasyobjects;
 
 	EXP_ListValue<KX_GameObject> *m_objectlist;
 	/// All 'root' parents.
@@ -145,7 +174,7 @@ private:
 	/// All objects that are not in the active layer.
 	EXP_ListValue<KX_GameObject> *m_inactivelist;
 	/// All animated objects, no need of EXP_ListValue because the list isn't exposed in python.
-	std::vector<KX_GameObject *> m_animatedlist;
+	CM_IndexedSet<KX_GameObject *> m_animatedlist;
 
 	/// The list of cameras for this scene.
 	EXP_ListValue<KX_Camera> *m_cameralist;
@@ -179,6 +208,8 @@ private:
 
 	/// Network scene.
 	KX_NetworkMessageScene *m_networkScene;
+	/// State replication over UDP, created on demand.
+	KX_ReplicationManager *m_replicationManager;
 
 	/// The active camera for the scene.
 	KX_Camera *m_activeCamera;
@@ -213,6 +244,14 @@ private:
 	/// The execution priority of replicated object actuators.
 	int m_ueberExecutionPriority;
 
+	/// Object pools per template object.
+	std::map<KX_GameObject *, ObjectPool> m_objectPools;
+	/// Template object of each replica which can be recycled in a pool.
+	std::unordered_map<KX_GameObject *, KX_GameObject *> m_pooledReplicas;
+
+	/// Buffer of the snapshots saved from python, kept to not reallocate it.
+	std::vector<char> m_snapshotBuffer;
+
 	/**
 	 * Activity 'bubble' settings :
 	 * Suspend (freeze) the entire scene.
@@ -246,11 +285,19 @@ private:
 	KX_2DFilterManager *m_filterManager;
 
 	KX_ObstacleSimulation *m_obstacleSimulation;
+	/// Navigation meshes with pending build or path requests, updated at the next logic frame.
+	std::vector<KX_NavMeshObject *> m_navMeshUpdateList;
 
 	AnimationPoolData m_animationPoolData;
 	TaskPool *m_animationPool;
 	double m_previousAnimTime;
 
+	/// Scheduled nodes sorted by hierarchy, updated in parallel by m_sceneGraphPool.
+	std::vector<SG_Node *> m_sceneGraphNodes;
+	/// Ranges of m_sceneGraphNodes updated by each task, a hierarchy is never split.
+	std::vector<SceneGraphTaskRange> m_sceneGraphRanges;
+	TaskPool *m_sceneGraphPool;
+
 	/// LOD Hysteresis settings.
 	bool m_isActivedHysteresis;
 	int m_lodHysteresisValue;
@@ -277,6 +324,10 @@ public:
 	static bool KX_ScenegraphRescheduleFunc(SG_Node *node, void *gameobj, void *scene);
 	/// SceneGraph transformation update.
 	void UpdateParents();
+	/** Update the scheduled nodes by independent hierarchies on the engine task scheduler.
+	 * \return False if there is not enough nodes to benefit from the threads.
+	 */
+	bool UpdateParentsParallel();
 
 	void DupliGroupRecurse(KX_GameObject *groupobj, int level);
 	bool IsObjectInGroup(KX_GameObject *gameobj) const;
@@ -284,6 +335,30 @@ public:
 	KX_GameObject *AddReplicaObject(KX_GameObject *gameobj, KX_GameObject *locationobj, float lifespan = 0.0f);
 	KX_GameObject *AddNodeReplicaObject(SG_Node *node, KX_GameObject *gameobj);
 
+	/** Enable recycling of the ended replicas of a template object, only the objects without
+	 * children, dupli group, components and of mesh or empty type can be pooled.
+	 * \param size The maximum number of deactivated replicas, 0 to disable the pool.
+	 * \return False if the object can't be pooled.
+	 */
+	bool SetObjectPool(KX_GameObject *templateobj, unsigned int size);
+	/// Return the pool of a template object or nullptr.
+	const ObjectPool *GetObjectPool(KX_GameObject *templateobj) const;
+	/// Accumulate the statistics of all the pools.
+	void GetObjectPoolStats(unsigned int& pooled, unsigned int& hits, unsigned int& misses) const;
+	/// Release the deactivated replicas of a template and disable the pool.
+	void ClearObjectPool(KX_GameObject *templateobj);
+
+	/// Write a binary snapshot of the objects state, see KX_SceneSnapshot.
+	void SaveState(std::vector<char>& buffer);
+	/// Restore a snapshot in place, return the number of restored objects or -1 for an invalid snapshot.
+	int RestoreState(const char *data, unsigned int size);
+	/** Deactivate an ended replica and put it in its pool.
+	 * \return False if the object is not recycled and must be destructed.
+	 */
+	bool RecycleObject(KX_GameObject *gameobj);
+	/// Take a deactivated replica from a pool and reset it to the state of the template.
+	KX_GameObject *ReuseObject(KX_GameObject *templateobj, ObjectPool& pool);
+
 	void RemoveNodeDestructObject(KX_GameObject *gameobj);
 	void RemoveObject(KX_GameObject *gameobj);
 	void RemoveDupliGroup(KX_GameObject *gameobj);
@@ -308,6 +383,8 @@ public:
 	EXP_ListValue<KX_LightObject> *GetLightList() const;
 	EXP_ListValue<KX_Camera> *GetCameraList() const;
 	EXP_ListValue<KX_FontObject> *GetFontList() const;
+	/// Update the name index of the lists containing a renamed object.
+	void NotifyObjectRenamed(KX_GameObject *gameobj);
 
 	SCA_LogicManager *GetLogicManager() const;
 	SCA_TimeEventManager *GetTimeEventManager() const;
@@ -412,7 +489,20 @@ public:
 	/// Returns the Blender scene this was made from.
 	Scene *GetBlenderScene() const;
 
+	/** Merge all the data of an other scene in this scene, the steps used are also
+	 * called separately by the converter to spread an async merge over several frames.
+	 */
 	bool MergeScene(KX_Scene *other);
+	/// Return true if the physics environments of both scenes are compatible.
+	bool CanMergeScene(KX_Scene *other) const;
+	/// Move the scene graph nodes and the lights of an object to this scene.
+	void MergeSceneObject(KX_GameObject *gameobj, KX_Scene *other);
+	/// Retarget the logic bricks of an object and register its names in the logic manager.
+	void MergeSceneLogic(KX_GameObject *gameobj);
+	/** Make the merged objects alive: move the physics controllers and the constraints, merge
+	 * the managers and the object lists and register the sensors in the event managers.
+	 */
+	void MergeSceneFinish(KX_Scene *other);
 
 	/// 2D Filters.
 	KX_2DFilterManager *Get2DFilterManager() const;
@@ -420,6 +510,11 @@ public:
 
 	KX_ObstacleSimulation *GetObstacleSimulation();
 	void SetObstacleSimulation(KX_ObstacleSimulation *obstacleSimulation);
+	/// Update the tasks of a navigation mesh at the next logic frame.
+	void ScheduleNavMeshUpdate(KX_NavMeshObject *navmesh);
+
+	/// Return the replication manager, created if needed.
+	KX_ReplicationManager *GetReplicationManager();
 
 	virtual std::string GetName();
 	virtual void SetName(const std::string& name);
@@ -434,6 +529,14 @@ public:
 	EXP_PYMETHOD_DOC(KX_Scene, resume);
 	EXP_PYMETHOD_DOC(KX_Scene, get);
 	EXP_PYMETHOD_DOC(KX_Scene, drawObstacleSimulation);
+	EXP_PYMETHOD_DOC(KX_Scene, setObjectPool);
+	EXP_PYMETHOD_DOC(KX_Scene, getObjectPool);
+	EXP_PYMETHOD_DOC(KX_Scene, saveState);
+	EXP_PYMETHOD_DOC(KX_Scene, restoreState);
+	EXP_PYMETHOD_DOC(KX_Scene, startReplicationServer);
+	EXP_PYMETHOD_DOC(KX_Scene, startReplicationClient);
+	EXP_PYMETHOD_DOC_NOARGS(KX_Scene, stopReplication);
+	EXP_PYMETHOD_DOC_NOARGS(KX_Scene, getReplicationStats);
 
 	// Attributes.
 	static PyObject *pyattr_get_name(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
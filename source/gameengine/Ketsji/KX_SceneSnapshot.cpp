@@ -0,0 +1,587 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_SceneSnapshot.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_SceneSnapshot.h"
+#include "KX_Scene.h"
+#include "KX_GameObject.h"
+
+#include "PHY_IPhysicsController.h"
+
+#include "EXP_ListValue.h"
+#include "EXP_IntValue.h"
+#include "EXP_FloatValue.h"
+#include "EXP_BoolValue.h"
+#include "EXP_StringValue.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+const char snapshotMagic[4] = {'B', 'G', 'E', 'S'};
+
+enum ObjectFlag {
+	OBJECT_PHYSICS_STATE = (1 << 0)
+};
+
+/// Binary stream appending to a buffer.
+class Writer
+{
+private:
+	std::vector<char>& m_buffer;
+
+public:
+	Writer(std::vector<char>& buffer)
+		:m_buffer(buffer)
+	{
+	}
+
+	unsigned int GetOffset() const
+	{
+		return m_buffer.size();
+	}
+
+	void WriteData(const void *data, unsigned int size)
+	{
+		const char *bytes = (const char *)data;
+		m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+	}
+
+	template <class Type>
+	void Write(const Type& value)
+	{
+		WriteData(&value, sizeof(Type));
+	}
+
+	/// Overwrite a value written previously at an offset.
+	template <class Type>
+	void WriteAt(unsigned int offset, const Type& value)
+	{
+		memcpy(&m_buffer[offset], &value, sizeof(Type));
+	}
+
+	void WriteString(const std::string& str)
+	{
+		Write<unsigned short>(str.size());
+		WriteData(str.data(), str.size());
+	}
+};
+
+/// Bounds checked binary stream reading a buffer, all the reads fail after a read past the end.
+class Reader
+{
+private:
+	const char *m_data;
+	const char *m_end;
+	bool m_valid;
+
+public:
+	Reader(const char *data, unsigned int size)
+		:m_data(data),
+		m_end(data + size),
+		m_valid(true)
+	{
+	}
+
+	bool IsValid() const
+	{
+		return m_valid;
+	}
+
+	bool ReadData(void *data, unsigned int size)
+	{
+		if (!m_valid || (unsigned int)(m_end - m_data) < size) {
+			m_valid = false;
+			return false;
+		}
+		memcpy(data, m_data, size);
+		m_data += size;
+		return true;
+	}
+
+	template <class Type>
+	bool Read(Type& value)
+	{
+		return ReadData(&value, sizeof(Type));
+	}
+
+	bool ReadString(std::string& str)
+	{
+		unsigned short size;
+		if (!Read(size) || (unsigned int)(m_end - m_data) < size) {
+			m_valid = false;
+			return false;
+		}
+		str.assign(m_data, size);
+		m_data += size;
+		return true;
+	}
+
+	/// Return a reader of the next bytes and skip them.
+	Reader Sub(unsigned int size)
+	{
+		if (!m_valid || (unsigned int)(m_end - m_data) < size) {
+			m_valid = false;
+			return Reader(m_data, 0);
+		}
+		Reader sub(m_data, size);
+		m_data += size;
+		return sub;
+	}
+};
+
+void SaveProperties(Writer& writer, KX_GameObject *gameobj)
+{
+	const unsigned int countOffset = writer.GetOffset();
+	unsigned short count = 0;
+	writer.Write(count);
+
+	for (int i = 0, size = gameobj->GetPropertyCount(); i < size; ++i) {
+		EXP_Value *prop = gameobj->GetProperty(i);
+		const int type = prop->GetValueType();
+
+		switch (type) {
+			case VALUE_INT_TYPE:
+			{
+				writer.WriteString(gameobj->GetPropertyName(i));
+				writer.Write<unsigned char>(type);
+				writer.Write(static_cast<EXP_IntValue *>(prop)->GetInt());
+				break;
+			}
+			case VALUE_FLOAT_TYPE:
+			{
+				writer.WriteString(gameobj->GetPropertyName(i));
+				writer.Write<unsigned char>(type);
+				writer.Write(static_cast<EXP_FloatValue *>(prop)->GetFloat());
+				break;
+			}
+			case VALUE_BOOL_TYPE:
+			{
+				writer.WriteString(gameobj->GetPropertyName(i));
+				writer.Write<unsigned char>(type);
+				writer.Write<unsigned char>(static_cast<EXP_BoolValue *>(prop)->GetBool());
+				break;
+			}
+			case VALUE_STRING_TYPE:
+			{
+				writer.WriteString(gameobj->GetPropertyName(i));
+				writer.Write<unsigned char>(type);
+				writer.WriteString(static_cast<EXP_StringValue *>(prop)->GetString());
+				break;
+			}
+			default:
+			{
+				// Other values (objects, lists...) are not saved.
+				continue;
+			}
+		}
+		++count;
+	}
+
+	writer.WriteAt(countOffset, count);
+}
+
+void SaveActions(Writer& writer, KX_GameObject *gameobj, std::vector<short>& layers)
+{
+	layers.clear();
+	gameobj->GetActionLayers(layers);
+
+	writer.Write<unsigned short>(layers.size());
+	for (short layer : layers) {
+		writer.Write(layer);
+		writer.WriteString(gameobj->GetActionName(layer));
+		writer.Write(gameobj->GetActionFrame(layer));
+	}
+}
+
+bool IsSavedProperty(EXP_Value *prop)
+{
+	const int type = prop->GetValueType();
+	return (type == VALUE_INT_TYPE || type == VALUE_FLOAT_TYPE || type == VALUE_BOOL_TYPE || type == VALUE_STRING_TYPE);
+}
+
+/// Property read from a snapshot, the bool values are stored in the int value.
+struct PropertyRecord
+{
+	std::string name;
+	unsigned char type;
+	cInt intValue;
+	float floatValue;
+	std::string stringValue;
+};
+
+struct ActionRecord
+{
+	short layer;
+	std::string name;
+	float frame;
+};
+
+/// Object read from a snapshot, applied once the whole snapshot is read.
+struct ObjectRecord
+{
+	std::string name;
+	unsigned short rank;
+	unsigned int state;
+	float position[3];
+	float orientation[9];
+	float scale[3];
+	bool hasPhysicsState;
+	PHY_PhysicsState physicsState;
+	std::vector<PropertyRecord> properties;
+	std::vector<ActionRecord> actions;
+};
+
+bool ReadProperties(Reader& reader, std::vector<PropertyRecord>& properties)
+{
+	unsigned short count;
+	if (!reader.Read(count)) {
+		return false;
+	}
+
+	properties.resize(count);
+	for (PropertyRecord& prop : properties) {
+		if (!reader.ReadString(prop.name) || !reader.Read(prop.type)) {
+			return false;
+		}
+
+		switch (prop.type) {
+			case VALUE_INT_TYPE:
+			{
+				if (!reader.Read(prop.intValue)) {
+					return false;
+				}
+				break;
+			}
+			case VALUE_FLOAT_TYPE:
+			{
+				if (!reader.Read(prop.floatValue)) {
+					return false;
+				}
+				break;
+			}
+			case VALUE_BOOL_TYPE:
+			{
+				unsigned char value;
+				if (!reader.Read(value)) {
+					return false;
+				}
+				prop.intValue = value;
+				break;
+			}
+			case VALUE_STRING_TYPE:
+			{
+				if (!reader.ReadString(prop.stringValue)) {
+					return false;
+				}
+				break;
+			}
+			default:
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool ReadActions(Reader& reader, std::vector<ActionRecord>& actions)
+{
+	unsigned short count;
+	if (!reader.Read(count)) {
+		return false;
+	}
+
+	actions.resize(count);
+	for (ActionRecord& action : actions) {
+		if (!reader.Read(action.layer) || !reader.ReadString(action.name) || !reader.Read(action.frame)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool ReadObject(Reader& reader, ObjectRecord& object)
+{
+	unsigned int recordSize;
+	if (!reader.ReadString(object.name) || !reader.Read(object.rank) || !reader.Read(recordSize)) {
+		return false;
+	}
+
+	Reader record = reader.Sub(recordSize);
+	unsigned char flag;
+	if (!record.Read(object.state) || !record.ReadData(object.position, sizeof(object.position)) ||
+	    !record.ReadData(object.orientation, sizeof(object.orientation)) ||
+	    !record.ReadData(object.scale, sizeof(object.scale)) || !record.Read(flag))
+	{
+		return false;
+	}
+
+	object.hasPhysicsState = (flag & OBJECT_PHYSICS_STATE);
+	if (object.hasPhysicsState && !record.Read(object.physicsState)) {
+		return false;
+	}
+
+	return (ReadProperties(record, object.properties) && ReadActions(record, object.actions));
+}
+
+void RestoreProperties(KX_GameObject *gameobj, const std::vector<PropertyRecord>& properties)
+{
+	for (const PropertyRecord& record : properties) {
+		EXP_Value *prop = gameobj->GetProperty(record.name);
+		// Properties of the same type are restored in place to keep the references to them (timers, compiled expressions).
+		const bool inplace = (prop && prop->GetValueType() == record.type);
+		EXP_Value *newprop = nullptr;
+
+		switch (record.type) {
+			case VALUE_INT_TYPE:
+			{
+				if (inplace) {
+					static_cast<EXP_IntValue *>(prop)->SetInt(record.intValue);
+				}
+				else {
+					newprop = new EXP_IntValue(record.intValue);
+				}
+				break;
+			}
+			case VALUE_FLOAT_TYPE:
+			{
+				if (inplace) {
+					static_cast<EXP_FloatValue *>(prop)->SetFloat(record.floatValue);
+				}
+				else {
+					newprop = new EXP_FloatValue(record.floatValue);
+				}
+				break;
+			}
+			case VALUE_BOOL_TYPE:
+			{
+				if (inplace) {
+					static_cast<EXP_BoolValue *>(prop)->SetBool(record.intValue);
+				}
+				else {
+					newprop = new EXP_BoolValue(record.intValue);
+				}
+				break;
+			}
+			case VALUE_STRING_TYPE:
+			{
+				if (inplace) {
+					static_cast<EXP_StringValue *>(prop)->SetString(record.stringValue);
+				}
+				else {
+					newprop = new EXP_StringValue(record.stringValue, "");
+				}
+				break;
+			}
+		}
+
+		if (newprop) {
+			gameobj->SetProperty(record.name, newprop);
+			newprop->Release();
+		}
+	}
+
+	/* Remove the saved types properties added since the snapshot, the timers are kept
+	 * as they are registered in the time manager. */
+	if (gameobj->GetPropertyCount() > (int)properties.size()) {
+		for (int i = gameobj->GetPropertyCount() - 1; i >= 0; --i) {
+			EXP_Value *prop = gameobj->GetProperty(i);
+			if (!IsSavedProperty(prop) || prop->GetProperty("timer")) {
+				continue;
+			}
+
+			const std::string& name = gameobj->GetPropertyName(i);
+			if (std::find_if(properties.begin(), properties.end(), [&name](const PropertyRecord& record) {
+				return record.name == name;
+			}) == properties.end())
+			{
+				gameobj->RemoveProperty(std::string(name));
+			}
+		}
+	}
+
+	gameobj->NotifyPropertyChange();
+}
+
+void RestoreActions(KX_GameObject *gameobj, const std::vector<ActionRecord>& actions, std::vector<short>& layers)
+{
+	layers.clear();
+	gameobj->GetActionLayers(layers);
+
+	for (const ActionRecord& action : actions) {
+		// Only the frame of an action still playing is restored, stopped actions are not replayed.
+		if (std::find(layers.begin(), layers.end(), action.layer) != layers.end() && gameobj->GetActionName(action.layer) == action.name) {
+			gameobj->SetActionFrame(action.layer, action.frame);
+		}
+	}
+}
+
+}
+
+void KX_SceneSnapshot::Save(KX_Scene *scene, std::vector<char>& buffer)
+{
+	buffer.clear();
+	Writer writer(buffer);
+
+	EXP_ListValue<KX_GameObject> *objects = scene->GetObjectList();
+
+	writer.WriteData(snapshotMagic, sizeof(snapshotMagic));
+	writer.Write<unsigned int>(SNAPSHOT_VERSION);
+	writer.Write<unsigned int>(objects->GetCount());
+
+	// Number of objects already written for each name.
+	std::unordered_map<std::string, unsigned short> ranks;
+	std::vector<short> layers;
+	PHY_PhysicsState physicsState;
+
+	for (KX_GameObject *gameobj : *objects) {
+		const std::string& name = gameobj->GetName();
+		writer.WriteString(name);
+		writer.Write(ranks[name]++);
+
+		const unsigned int sizeOffset = writer.GetOffset();
+		writer.Write<unsigned int>(0);
+
+		writer.Write<unsigned int>(gameobj->GetState());
+
+		float data[9];
+		gameobj->NodeGetLocalPosition().Pack(data);
+		writer.WriteData(data, sizeof(float) * 3);
+		gameobj->NodeGetLocalOrientation().Pack(data);
+		writer.WriteData(data, sizeof(float) * 9);
+		gameobj->NodeGetLocalScaling().Pack(data);
+		writer.WriteData(data, sizeof(float) * 3);
+
+		PHY_IPhysicsController *ctrl = gameobj->GetPhysicsController();
+		const bool hasPhysicsState = (ctrl && ctrl->GetPhysicsState(physicsState));
+		writer.Write<unsigned char>(hasPhysicsState ? OBJECT_PHYSICS_STATE : 0);
+		if (hasPhysicsState) {
+			writer.Write(physicsState);
+		}
+
+		SaveProperties(writer, gameobj);
+		SaveActions(writer, gameobj, layers);
+
+		writer.WriteAt<unsigned int>(sizeOffset, writer.GetOffset() - sizeOffset - sizeof(unsigned int));
+	}
+}
+
+int KX_SceneSnapshot::Restore(KX_Scene *scene, const char *data, unsigned int size)
+{
+	Reader reader(data, size);
+
+	char magic[sizeof(snapshotMagic)];
+	unsigned int version;
+	unsigned int numObjects;
+	if (!reader.ReadData(magic, sizeof(magic)) || memcmp(magic, snapshotMagic, sizeof(magic)) != 0 ||
+	    !reader.Read(version) || version != SNAPSHOT_VERSION || !reader.Read(numObjects))
+	{
+		return -1;
+	}
+
+	/* The whole snapshot is read before modifying the scene to never leave it
+	 * half restored with a truncated or malformed snapshot. */
+	std::vector<ObjectRecord> records;
+	for (unsigned int i = 0; i < numObjects; ++i) {
+		records.emplace_back();
+		if (!ReadObject(reader, records.back())) {
+			return -1;
+		}
+	}
+
+	// Objects of each name in the object list order.
+	std::unordered_map<std::string, std::vector<KX_GameObject *> > objectsByName;
+	for (KX_GameObject *gameobj : *scene->GetObjectList()) {
+		objectsByName[gameobj->GetName()].push_back(gameobj);
+	}
+
+	struct PhysicsRestore
+	{
+		PHY_IPhysicsController *ctrl;
+		const PHY_PhysicsState *state;
+	};
+	std::vector<PhysicsRestore> physicsRestores;
+
+	std::vector<short> layers;
+	int restored = 0;
+
+	for (const ObjectRecord& record : records) {
+		const auto it = objectsByName.find(record.name);
+		if (it == objectsByName.end() || record.rank >= it->second.size()) {
+			// The object was removed since the snapshot.
+			continue;
+		}
+
+		KX_GameObject *gameobj = it->second[record.rank];
+
+		if (gameobj->GetState() != record.state) {
+			gameobj->SetState(record.state);
+		}
+
+		/* Only modify the changed transforms, setting the transform of an object
+		 * with a physics controller activates the body or turns a static one kinematic. */
+		float current[9];
+		gameobj->NodeGetLocalPosition().Pack(current);
+		if (memcmp(current, record.position, sizeof(record.position)) != 0) {
+			gameobj->NodeSetLocalPosition(mt::vec3(record.position));
+		}
+		gameobj->NodeGetLocalOrientation().Pack(current);
+		if (memcmp(current, record.orientation, sizeof(record.orientation)) != 0) {
+			gameobj->NodeSetLocalOrientation(mt::mat3(record.orientation));
+		}
+		gameobj->NodeGetLocalScaling().Pack(current);
+		if (memcmp(current, record.scale, sizeof(record.scale)) != 0) {
+			gameobj->NodeSetLocalScale(mt::vec3(record.scale));
+		}
+
+		PHY_IPhysicsController *ctrl = gameobj->GetPhysicsController();
+		if (record.hasPhysicsState && ctrl) {
+			physicsRestores.push_back({ctrl, &record.physicsState});
+		}
+
+		RestoreProperties(gameobj, record.properties);
+		RestoreActions(gameobj, record.actions, layers);
+
+		++restored;
+	}
+
+	// Update the world transforms of the hierarchies once all the local transforms are restored.
+	for (KX_GameObject *gameobj : *scene->GetRootParentList()) {
+		gameobj->NodeUpdateGS();
+	}
+
+	// The rigid bodies are restored last to override the transform and activation changes of the node setters.
+	for (const PhysicsRestore& physicsRestore : physicsRestores) {
+		physicsRestore.ctrl->SetPhysicsState(*physicsRestore.state);
+	}
+
+	return restored;
+}
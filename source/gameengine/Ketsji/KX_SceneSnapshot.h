@@ -0,0 +1,60 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_SceneSnapshot.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __KX_SCENESNAPSHOT_H__
+#define __KX_SCENESNAPSHOT_H__
+
+#include <vector>
+
+class KX_Scene;
+
+/** Compact binary snapshot of the dynamic state of the objects of a scene, used
+ * for rollback and fast save games. Each object stores its logic state, local
+ * transform, rigid body state, int/float/bool/string properties and action frames.
+ *
+ * The snapshot is written in native byte order behind a magic and a version. The
+ * objects are matched at restore by name and rank among the objects of the same
+ * name, the objects added since the snapshot are left unchanged and the removed
+ * objects are not recreated. Each object record is prefixed by its size to skip
+ * the objects missing at restore.
+ */
+class KX_SceneSnapshot
+{
+public:
+	enum {
+		SNAPSHOT_VERSION = 1
+	};
+
+	/// Write the snapshot of a scene, the buffer is resized to the snapshot size.
+	static void Save(KX_Scene *scene, std::vector<char>& buffer);
+
+	/** Restore in place a snapshot of a scene, the whole snapshot is read before modifying the scene.
+	 * \return The number of restored objects or -1 for an invalid or incompatible snapshot, the scene is then unchanged.
+	 */
+	static int Restore(KX_Scene *scene, const char *data, unsigned int size);
+};
+
+#endif  // __KX_SCENESNAPSHOT_H__
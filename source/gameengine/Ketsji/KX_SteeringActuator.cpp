@@ -60,7 +60,9 @@ KX_SteeringActuator::KX_SteeringActuator(SCA_IObject *gameobj, int mode, KX_Game
 	m_pathUpdatePeriod(pathUpdatePeriod),
 	m_lockzvel(lockzvel),
 	m_wayPointIdx(-1),
-	m_steerVec(mt::zero3)
+	m_steerVec(mt::zero3),
+	m_steerVelocity(mt::zero3),
+	m_steerDelta(0.0f)
 {
 	m_navmesh = static_cast<KX_NavMeshObject *>(navmesh);
 	if (m_navmesh) {
@@ -108,6 +110,7 @@ void KX_SteeringActuator::ProcessReplica()
 	if (m_navmesh) {
 		m_navmesh->RegisterActuator(this);
 	}
+	m_pathRequest.reset();
 	SCA_IActuator::ProcessReplica();
 }
 
@@ -127,6 +130,7 @@ bool KX_SteeringActuator::UnlinkObject(SCA_IObject *clientobj)
 	}
 	else if (clientobj == m_navmesh) {
 		m_navmesh = nullptr;
+		m_pathRequest.reset();
 		return true;
 	}
 	return false;
@@ -150,6 +154,7 @@ void KX_SteeringActuator::Relink(std::map<SCA_IObject *, SCA_IObject *>& obj_map
 		}
 		m_navmesh = navobj;
 		m_navmesh->RegisterActuator(this);
+		m_pathRequest.reset();
 	}
 }
 
@@ -217,12 +222,26 @@ bool KX_SteeringActuator::Update(double curtime)
 
 				static const float WAYPOINT_RADIUS(0.25f);
 
-				if (m_pathUpdateTime < 0 || (m_pathUpdatePeriod >= 0 &&
-					curtime - m_pathUpdateTime > ((double)m_pathUpdatePeriod / 1000.0)))
-				{
+				// Use the path requested at the previous update.
+				if (m_pathRequest && m_pathRequest->m_done) {
+					m_path = std::move(m_pathRequest->m_path);
+					m_wayPointIdx = m_path.size() > 1 ? 1 : -1;
+					m_pathRequest.reset();
+				}
+
+				if (m_pathUpdateTime < 0) {
+					// The first path is needed immediately.
 					m_pathUpdateTime = curtime;
 					m_path = m_navmesh->FindPath(mypos, targpos, MAX_PATH_LENGTH);
 					m_wayPointIdx = m_path.size() > 1 ? 1 : -1;
+					m_pathRequest.reset();
+				}
+				else if (!m_pathRequest && m_pathUpdatePeriod >= 0 &&
+				         curtime - m_pathUpdateTime > ((double)m_pathUpdatePeriod / 1000.0))
+				{
+					// The current path is followed until the new path is found by a worker thread.
+					m_pathUpdateTime = curtime;
+					m_pathRequest = m_navmesh->RequestPath(mypos, targpos, MAX_PATH_LENGTH);
 				}
 
 				if (m_wayPointIdx > 0) {
@@ -260,35 +279,18 @@ bool KX_SteeringActuator::Update(double curtime)
 		m_steerVec.SafeNormalize();
 		mt::vec3 newvel = m_velocity * m_steerVec;
 
-		// Adjust velocity to avoid obstacles.
+		// Adjust velocity to avoid obstacles, the velocity is applied after the logic of all the actuators.
 		if (m_simulation && m_obstacle) {
 			if (m_enableVisualization) {
 				KX_RasterizerDrawDebugLine(mypos, mypos + newvel, mt::vec4(1.0f, 0.0f, 0.0f, 1.0f));
 			}
-			m_simulation->AdjustObstacleVelocity(m_obstacle, m_mode != KX_STEERING_PATHFOLLOWING ? m_navmesh : nullptr,
-			                                     newvel, m_acceleration * (float)delta, m_turnspeed / (180.0f * (float)(M_PI * delta)));
-			if (m_enableVisualization) {
-				KX_RasterizerDrawDebugLine(mypos, mypos + newvel, mt::vec4(0.0f, 1.0f, 0.0f, 1.0f));
-			}
-		}
-
-		HandleActorFace(newvel);
-		if (isdyna) {
-			// Temporary solution: set 2D steering velocity directly to obj correct way is to apply physical force.
-			const mt::vec3 curvel = obj->GetLinearVelocity();
-
-			if (m_lockzvel) {
-				newvel.z = 0.0f;
-			}
-			else {
-				newvel.z = curvel.z;
-			}
-
-			obj->setLinearVelocity(newvel, false);
+			m_steerVelocity = newvel;
+			m_steerDelta = (float)delta;
+			m_simulation->RequestObstacleVelocity(this, m_obstacle, m_mode != KX_STEERING_PATHFOLLOWING ? m_navmesh : nullptr,
+			                                      newvel, m_acceleration * (float)delta, m_turnspeed / (180.0f * (float)(M_PI * delta)));
 		}
 		else {
-			const mt::vec3 movement = ((float)delta) * newvel;
-			obj->ApplyMovement(movement, false);
+			ApplySteeringVelocity(newvel, (float)delta);
 		}
 	}
 	else {
@@ -305,6 +307,44 @@ bool KX_SteeringActuator::Update(double curtime)
 	return true;
 }
 
+void KX_SteeringActuator::ApplySteeringVelocity(mt::vec3 velocity, float delta)
+{
+	KX_GameObject *obj = static_cast<KX_GameObject *>(GetParent());
+
+	HandleActorFace(velocity);
+	if (obj->IsDynamic()) {
+		// Temporary solution: set 2D steering velocity directly to obj correct way is to apply physical force.
+		const mt::vec3 curvel = obj->GetLinearVelocity();
+
+		if (m_lockzvel) {
+			velocity.z = 0.0f;
+		}
+		else {
+			velocity.z = curvel.z;
+		}
+
+		obj->setLinearVelocity(velocity, false);
+	}
+	else {
+		const mt::vec3 movement = delta * velocity;
+		obj->ApplyMovement(movement, false);
+	}
+}
+
+void KX_SteeringActuator::ApplyObstacleVelocity(const mt::vec2& velocity)
+{
+	mt::vec3 newvel = m_steerVelocity;
+	newvel.x = velocity.x;
+	newvel.y = velocity.y;
+
+	if (m_enableVisualization) {
+		const mt::vec3& mypos = static_cast<KX_GameObject *>(GetParent())->NodeGetWorldPosition();
+		KX_RasterizerDrawDebugLine(mypos, mypos + newvel, mt::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+	}
+
+	ApplySteeringVelocity(newvel, m_steerDelta);
+}
+
 const mt::vec3& KX_SteeringActuator::GetSteeringVec() const
 {
 	if (m_isActive) {
@@ -605,6 +645,7 @@ int KX_SteeringActuator::pyattr_set_navmesh(EXP_PyObjectPlus *self, const struct
 	}
 
 	actuator->m_navmesh = static_cast<KX_NavMeshObject *>(gameobj);
+	actuator->m_pathRequest.reset();
 
 	if (actuator->m_navmesh) {
 		actuator->m_navmesh->RegisterActuator(actuator);
@@ -60,14 +60,20 @@ class KX_SteeringActuator : public SCA_IActuator, public mt::SimdClassAllocator
 	short m_facingMode;
 	bool m_normalUp;
 	KX_NavMeshObject::PathType m_path;
+	/// Path being found by the navigation mesh, replacing m_path once done.
+	KX_NavMeshObject::PathRequestPtr m_pathRequest;
 	int m_pathUpdatePeriod;
 	double m_pathUpdateTime;
 	bool m_lockzvel;
 	int m_wayPointIdx;
 	mt::mat3 m_parentlocalmat;
 	mt::vec3 m_steerVec;
+	/// Steering velocity and time step waiting for the obstacle avoidance.
+	mt::vec3 m_steerVelocity;
+	float m_steerDelta;
 
 	void HandleActorFace(const mt::vec3& velocity);
+	void ApplySteeringVelocity(mt::vec3 velocity, float delta);
 
 public:
 	enum KX_STEERINGACT_MODE
@@ -93,6 +99,9 @@ public:
 	virtual bool UnlinkObject(SCA_IObject *clientobj);
 	const mt::vec3& GetSteeringVec() const;
 
+	/// Apply the steering velocity adjusted by the obstacle simulation.
+	void ApplyObstacleVelocity(const mt::vec2& velocity);
+
 #ifdef WITH_PYTHON
 
 	static PyObject *pyattr_get_target(EXP_PyObjectPlus *self, const struct EXP_PYATTRIBUTE_DEF *attrdef);
@@ -31,6 +31,7 @@
 
 
 #include "KX_TimeCategoryLogger.h"
+#include "KX_TraceProfiler.h"
 
 KX_TimeCategoryLogger::KX_TimeCategoryLogger(unsigned int maxNumMeasurements)
 	:m_maxNumMeasurements(maxNumMeasurements),
@@ -55,11 +56,12 @@ unsigned int KX_TimeCategoryLogger::GetMaxNumMeasurements() const
 	return m_maxNumMeasurements;
 }
 
-void KX_TimeCategoryLogger::AddCategory(TimeCategory tc)
+void KX_TimeCategoryLogger::AddCategory(TimeCategory tc, const std::string& name)
 {
 	// Only add if not already present
 	if (m_loggers.find(tc) == m_loggers.end()) {
 		m_loggers.emplace(TimeLoggerMap::value_type(tc, KX_TimeLogger(m_maxNumMeasurements)));
+		m_names[tc] = name;
 	}
 }
 
@@ -70,6 +72,10 @@ void KX_TimeCategoryLogger::StartLog(TimeCategory tc, double now)
 	}
 	m_loggers[tc].StartLog(now);
 	m_lastCategory = tc;
+
+	if (KX_TraceProfiler::IsRecording()) {
+		KX_TraceProfiler::SetCategory(m_names[tc].c_str());
+	}
 }
 
 void KX_TimeCategoryLogger::EndLog(TimeCategory tc, double now)
@@ -81,6 +87,8 @@ void KX_TimeCategoryLogger::EndLog(double now)
 {
 	m_loggers[m_lastCategory].EndLog(now);
 	m_lastCategory = -1;
+
+	KX_TraceProfiler::SetCategory(nullptr);
 }
 
 void KX_TimeCategoryLogger::NextMeasurement(double now)
@@ -37,6 +37,7 @@
 #endif
 
 #include <map>
+#include <string>
 
 #include "KX_TimeLogger.h"
 
@@ -76,8 +77,9 @@ public:
 	/**
 	 * Adds a category.
 	 * \param category	The new category.
+	 * \param name		The category name used in the recorded traces.
 	 */
-	void AddCategory(TimeCategory tc);
+	void AddCategory(TimeCategory tc, const std::string& name);
 
 	/**
 	 * Starts logging in current measurement for the given category.
@@ -119,6 +121,8 @@ public:
 protected:
 	/// Storage for the loggers.
 	TimeLoggerMap m_loggers;
+	/// Category names for the trace profiler.
+	std::map<TimeCategory, std::string> m_names;
 	/// Maximum number of measurements.
 	unsigned int m_maxNumMeasurements;
 
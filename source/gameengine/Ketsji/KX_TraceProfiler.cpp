@@ -0,0 +1,312 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_TraceProfiler.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_TraceProfiler.h"
+
+#include "CM_Thread.h"
+#include "CM_Message.h"
+
+#include "PIL_time.h"
+
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+struct TraceEvent
+{
+	const char *name;
+	double begin;
+	/// Negative while the event is opened.
+	double end;
+};
+
+struct ThreadBuffer
+{
+	/// Track identifier in the trace file.
+	int tid;
+	std::string name;
+
+	std::vector<TraceEvent> events;
+	/// Indices of the opened events.
+	std::vector<unsigned int> stack;
+
+	/// Only contended when the recording is started or stopped.
+	CM_ThreadSpinLock lock;
+};
+
+struct FrameMark
+{
+	int frame;
+	double time;
+};
+
+}
+
+static std::atomic<bool> g_recording(false);
+static double g_startTime = 0.0;
+
+/// All the thread buffers, they are never freed as a thread keeps a pointer to its buffer.
+static std::vector<std::unique_ptr<ThreadBuffer> > g_buffers;
+static CM_ThreadMutex g_buffersMutex;
+static thread_local ThreadBuffer *t_buffer = nullptr;
+
+/// Track of the profiling categories, only used by the main thread.
+static ThreadBuffer g_categories;
+static std::vector<FrameMark> g_frameMarks;
+static int g_frame = 0;
+
+/// Scheduled recording.
+static int g_scheduledStart = -1;
+static int g_scheduledEnd = -1;
+static std::string g_scheduledPath;
+
+static ThreadBuffer *get_thread_buffer()
+{
+	if (!t_buffer) {
+		ThreadBuffer *buffer = new ThreadBuffer();
+
+		g_buffersMutex.Lock();
+		// The track 0 is used for the categories.
+		buffer->tid = g_buffers.size() + 1;
+		buffer->name = BLI_thread_is_main() ? "Main thread" : "Thread " + std::to_string(buffer->tid);
+		g_buffers.emplace_back(buffer);
+		g_buffersMutex.Unlock();
+
+		t_buffer = buffer;
+	}
+
+	return t_buffer;
+}
+
+/// Timestamp in microseconds since the start of the recording.
+static double trace_time(double time)
+{
+	return (time - g_startTime) * 1.0e6;
+}
+
+static void write_escaped(std::ofstream& file, const char *str)
+{
+	for (const char *c = str; *c; ++c) {
+		if (*c == '"' || *c == '\\') {
+			file << '\\';
+		}
+		file << *c;
+	}
+}
+
+static void write_buffer(std::ofstream& file, const ThreadBuffer& buffer, double stopTime)
+{
+	file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer.tid
+		 << ",\"args\":{\"name\":\"" << buffer.name << "\"}},\n";
+	file << "{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer.tid
+		 << ",\"args\":{\"sort_index\":" << buffer.tid << "}},\n";
+
+	for (const TraceEvent& event : buffer.events) {
+		// Events still opened are closed at the end of the recording.
+		const double end = (event.end < 0.0) ? stopTime : event.end;
+		file << "{\"name\":\"";
+		write_escaped(file, event.name);
+		file << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer.tid << ",\"ts\":" << trace_time(event.begin)
+			 << ",\"dur\":" << (end - event.begin) * 1.0e6 << "},\n";
+	}
+}
+
+static void clear_buffer(ThreadBuffer& buffer)
+{
+	buffer.events.clear();
+	buffer.stack.clear();
+}
+
+void KX_TraceProfiler::Start()
+{
+	g_recording = false;
+
+	g_buffersMutex.Lock();
+	for (std::unique_ptr<ThreadBuffer>& buffer : g_buffers) {
+		buffer->lock.Lock();
+		clear_buffer(*buffer);
+		buffer->lock.Unlock();
+	}
+	g_buffersMutex.Unlock();
+
+	clear_buffer(g_categories);
+	g_frameMarks.clear();
+
+	g_startTime = PIL_check_seconds_timer();
+	g_recording = true;
+}
+
+bool KX_TraceProfiler::Stop(const std::string& path)
+{
+	g_recording = false;
+
+	const double stopTime = PIL_check_seconds_timer();
+
+	std::ofstream file(path);
+	if (file) {
+		file.precision(3);
+		file << std::fixed;
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+		g_categories.tid = 0;
+		g_categories.name = "Categories";
+		write_buffer(file, g_categories, stopTime);
+
+		g_buffersMutex.Lock();
+		for (std::unique_ptr<ThreadBuffer>& buffer : g_buffers) {
+			buffer->lock.Lock();
+			write_buffer(file, *buffer, stopTime);
+			buffer->lock.Unlock();
+		}
+		g_buffersMutex.Unlock();
+
+		for (const FrameMark& mark : g_frameMarks) {
+			file << "{\"name\":\"Frame " << mark.frame << "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"ts\":"
+				 << trace_time(mark.time) << "},\n";
+		}
+
+		// Terminate the list with an event to avoid a trailing comma.
+		file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"Game Engine\"}}\n]}\n";
+	}
+
+	g_buffersMutex.Lock();
+	for (std::unique_ptr<ThreadBuffer>& buffer : g_buffers) {
+		buffer->lock.Lock();
+		clear_buffer(*buffer);
+		buffer->lock.Unlock();
+	}
+	g_buffersMutex.Unlock();
+
+	clear_buffer(g_categories);
+	g_frameMarks.clear();
+
+	if (!file) {
+		CM_Error("cannot write trace file \"" << path << "\"");
+		return false;
+	}
+
+	CM_Message("trace written to \"" << path << "\"");
+	return true;
+}
+
+bool KX_TraceProfiler::IsRecording()
+{
+	return g_recording;
+}
+
+void KX_TraceProfiler::ScheduleRecording(int firstFrame, int numFrames, const std::string& path)
+{
+	// The frame counter is incremented at the beginning of a frame.
+	g_scheduledStart = g_frame + firstFrame + 1;
+	g_scheduledEnd = g_scheduledStart + numFrames;
+	g_scheduledPath = path;
+}
+
+void KX_TraceProfiler::NextFrame()
+{
+	++g_frame;
+
+	if (g_frame == g_scheduledStart) {
+		Start();
+	}
+	else if (g_frame == g_scheduledEnd) {
+		// The recording could be stopped from python.
+		if (g_recording) {
+			Stop(g_scheduledPath);
+		}
+		g_scheduledStart = g_scheduledEnd = -1;
+	}
+
+	if (g_recording) {
+		g_frameMarks.push_back({g_frame, PIL_check_seconds_timer()});
+	}
+}
+
+void KX_TraceProfiler::Finish()
+{
+	if (g_recording) {
+		if (g_scheduledEnd != -1) {
+			Stop(g_scheduledPath);
+		}
+		else {
+			CM_Warning("game ended during profiling, the trace is discarded");
+			g_recording = false;
+		}
+	}
+
+	g_scheduledStart = g_scheduledEnd = -1;
+}
+
+void KX_TraceProfiler::BeginEvent(const char *name)
+{
+	if (!g_recording) {
+		return;
+	}
+
+	ThreadBuffer *buffer = get_thread_buffer();
+	buffer->lock.Lock();
+	buffer->stack.push_back(buffer->events.size());
+	buffer->events.push_back({name, PIL_check_seconds_timer(), -1.0});
+	buffer->lock.Unlock();
+}
+
+void KX_TraceProfiler::EndEvent()
+{
+	if (!g_recording) {
+		return;
+	}
+
+	ThreadBuffer *buffer = get_thread_buffer();
+	buffer->lock.Lock();
+	/* The stack is empty when the event was opened before the start of the recording,
+	 * as the events are nested no event opened after the start can remain. */
+	if (!buffer->stack.empty()) {
+		buffer->events[buffer->stack.back()].end = PIL_check_seconds_timer();
+		buffer->stack.pop_back();
+	}
+	buffer->lock.Unlock();
+}
+
+void KX_TraceProfiler::SetCategory(const char *name)
+{
+	if (!g_recording) {
+		return;
+	}
+
+	const double now = PIL_check_seconds_timer();
+	if (!g_categories.stack.empty()) {
+		g_categories.events[g_categories.stack.back()].end = now;
+		g_categories.stack.pop_back();
+	}
+
+	if (name) {
+		g_categories.stack.push_back(g_categories.events.size());
+		g_categories.events.push_back({name, now, -1.0});
+	}
+}
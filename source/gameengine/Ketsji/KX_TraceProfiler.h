@@ -0,0 +1,92 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_TraceProfiler.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __KX_TRACEPROFILER_H__
+#define __KX_TRACEPROFILER_H__
+
+#include <string>
+
+/** Records timestamped and nested events of every thread and writes them
+ * in the Chrome trace event format (chrome://tracing, Perfetto).
+ *
+ * Each thread records in its own buffer, the events of a thread are nested
+ * by their scope. The profiling categories of KX_TimeCategoryLogger are
+ * recorded in a separate track to keep a view similar to the overlay.
+ *
+ * The event names must be static strings, only their pointers are stored.
+ */
+class KX_TraceProfiler
+{
+public:
+	/// Start a new recording, the previous unsaved events are discarded.
+	static void Start();
+	/** Stop the recording and write the recorded events.
+	 * \param path The trace file path.
+	 * \return False if the file can't be written.
+	 */
+	static bool Stop(const std::string& path);
+	static bool IsRecording();
+
+	/** Record a range of frames, the recording starts and stops in NextFrame.
+	 * \param firstFrame The number of frames to skip before the recording.
+	 * \param numFrames The number of frames to record.
+	 * \param path The trace file path.
+	 */
+	static void ScheduleRecording(int firstFrame, int numFrames, const std::string& path);
+	/// Mark the beginning of a new engine frame and start or stop the scheduled recording.
+	static void NextFrame();
+	/// Write the scheduled recording or discard the current one, when the engine stops.
+	static void Finish();
+
+	/// Open an event in the current thread.
+	static void BeginEvent(const char *name);
+	/// Close the last opened event of the current thread.
+	static void EndEvent();
+
+	/** Close the current profiling category event and open a new one.
+	 * \param name The category name, nullptr to not open a new category.
+	 */
+	static void SetCategory(const char *name);
+};
+
+/// Record an event for the lifetime of the scope.
+class KX_TraceScope
+{
+public:
+	KX_TraceScope(const char *name)
+	{
+		KX_TraceProfiler::BeginEvent(name);
+	}
+
+	~KX_TraceScope()
+	{
+		KX_TraceProfiler::EndEvent();
+	}
+};
+
+#define KX_TRACE_SCOPE(name) KX_TraceScope _traceScope(name)
+
+#endif  // __KX_TRACEPROFILER_H__
@@ -0,0 +1,126 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Launcher/LA_HeadlessLauncher.cpp
+ *  \ingroup launcher
+ */
+
+#include "LA_HeadlessLauncher.h"
+#include "LA_SystemCommandLine.h"
+
+#include "GPG_HeadlessCanvas.h"
+
+#include "KX_KetsjiEngine.h"
+#include "KX_ISystem.h"
+
+#include "CM_Message.h"
+
+extern "C" {
+#  include "PIL_time.h"
+}
+
+#include <cmath>
+
+LA_HeadlessLauncher::LA_HeadlessLauncher(Main *maggie, Scene *scene, GlobalSettings *gs, int width, int height,
+										 int maxFrames, int argc, char **argv, const std::string& pythonMainLoop)
+	:LA_PlayerLauncher(nullptr, nullptr, maggie, scene, gs, RAS_Rasterizer::RAS_STEREO_NOSTEREO, 0, argc, argv, pythonMainLoop),
+	m_width(width),
+	m_height(height),
+	m_maxFrames(maxFrames),
+	m_frame(0),
+	m_realTime(true),
+	m_nextFrameTime(0.0),
+	m_deform(false)
+{
+}
+
+LA_HeadlessLauncher::~LA_HeadlessLauncher()
+{
+}
+
+RAS_Rasterizer *LA_HeadlessLauncher::CreateRasterizer()
+{
+	return nullptr;
+}
+
+RAS_ICanvas *LA_HeadlessLauncher::CreateCanvas(RAS_Rasterizer *rasty)
+{
+	return (new GPG_HeadlessCanvas(m_width, m_height));
+}
+
+void LA_HeadlessLauncher::RenderEngine()
+{
+	m_ketsjiEngine->UpdateHeadlessFrame(m_deform);
+}
+
+void LA_HeadlessLauncher::InitEngine()
+{
+	LA_PlayerLauncher::InitEngine();
+
+	const SYS_SystemHandle syshandle = SYS_GetSystem();
+	m_realTime = (SYS_GetCommandLineInt(syshandle, "headless_realtime", 1) != 0);
+	m_deform = (SYS_GetCommandLineInt(syshandle, "headless_deform", 0) != 0);
+
+	/* Without real time the clock is advanced of one logic frame before each
+	 * call to NextFrame, the game is then proceeded as fast as possible. */
+	m_ketsjiEngine->SetFlag(KX_KetsjiEngine::USE_EXTERNAL_CLOCK, !m_realTime);
+
+	m_frame = 0;
+	m_nextFrameTime = m_kxsystem->GetTimeInSeconds();
+
+	CM_Message("running headless " << (m_realTime ? "in real time" : "with a simulated clock")
+		<< " at " << m_ketsjiEngine->GetTicRate() << " logic frames per second");
+}
+
+bool LA_HeadlessLauncher::EngineNextFrame()
+{
+	// The tic rate can be changed from python at any time.
+	const double period = 1.0 / m_ketsjiEngine->GetTicRate();
+
+	if (m_realTime) {
+		m_nextFrameTime += period;
+		const double delay = m_nextFrameTime - m_kxsystem->GetTimeInSeconds();
+		if (delay > 0.0) {
+			// Round up to never wake up before the next logic frame.
+			PIL_sleep_ms((int)std::ceil(delay * 1000.0));
+		}
+		else if (delay < -period) {
+			// Too late, the engine skips the frames, don't try to catch up.
+			m_nextFrameTime = m_kxsystem->GetTimeInSeconds();
+		}
+	}
+	else {
+		m_ketsjiEngine->SetClockTime(m_ketsjiEngine->GetClockTime() + period * m_ketsjiEngine->GetTimeScale());
+	}
+
+	if (!LA_PlayerLauncher::EngineNextFrame()) {
+		return false;
+	}
+
+	if (m_maxFrames > 0 && ++m_frame >= m_maxFrames) {
+		m_exitRequested = KX_ExitRequest::OUTSIDE;
+		m_exitString = "headless frame limit reached";
+		return false;
+	}
+
+	return true;
+}
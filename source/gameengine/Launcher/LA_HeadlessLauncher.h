@@ -0,0 +1,71 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file LA_HeadlessLauncher.h
+ *  \ingroup launcher
+ */
+
+#ifndef __LA_HEADLESSLAUNCHER_H__
+#define __LA_HEADLESSLAUNCHER_H__
+
+#include "LA_PlayerLauncher.h"
+
+/** Launcher running the game without window, GHOST system and rasterizer.
+ * The logic, physics, animations and python are proceeded at the logic tic rate,
+ * either in real time or as fast as possible using a simulated clock.
+ */
+class LA_HeadlessLauncher : public LA_PlayerLauncher
+{
+protected:
+	/// Size of the virtual canvas.
+	int m_width;
+	int m_height;
+
+	/// Number of frames to proceed before exiting, 0 for no limit.
+	int m_maxFrames;
+	/// Number of frames proceeded.
+	int m_frame;
+
+	/// Wait between the frames to follow the real time, else use a simulated clock.
+	bool m_realTime;
+	/// Real time of the next frame.
+	double m_nextFrameTime;
+	/// Pose armatures and deform meshes even if nothing is visible.
+	bool m_deform;
+
+	virtual RAS_Rasterizer *CreateRasterizer();
+	virtual RAS_ICanvas *CreateCanvas(RAS_Rasterizer *rasty);
+
+	/// Update the animations only, nothing is rendered.
+	virtual void RenderEngine();
+
+public:
+	LA_HeadlessLauncher(Main *maggie, Scene *scene, GlobalSettings *gs, int width, int height, int maxFrames,
+						int argc, char **argv, const std::string& pythonMainLoop);
+	virtual ~LA_HeadlessLauncher();
+
+	virtual void InitEngine();
+
+	virtual bool EngineNextFrame();
+};
+
+#endif  // __LA_HEADLESSLAUNCHER_H__
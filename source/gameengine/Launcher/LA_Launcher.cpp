@@ -39,6 +39,7 @@
 #include "KX_KetsjiEngine.h"
 #include "KX_Scene.h"
 #include "KX_Globals.h"
+#include "KX_TraceProfiler.h"
 #include "KX_PythonInit.h"
 #include "KX_PythonMain.h"
 #include "KX_PyConstraintBinding.h"
@@ -154,12 +155,16 @@ void LA_Launcher::InitEngine()
 	short showShadowFrustum = SYS_GetCommandLineInt(syshandle, "show_shadow_frustum", gm.showShadowFrustum);
 	bool nodepwarnings = (SYS_GetCommandLineInt(syshandle, "ignore_deprecation_warnings", 1) != 0);
 	bool restrictAnimFPS = (gm.flag & GAME_RESTRICT_ANIM_UPDATES) != 0;
+	bool parallelScenes = (SYS_GetCommandLineInt(syshandle, "parallel_scenes", (gm.flag & GAME_PARALLEL_SCENES)) != 0);
+	bool parallelSceneGraph = (SYS_GetCommandLineInt(syshandle, "parallel_scenegraph", (gm.flag & GAME_PARALLEL_SCENEGRAPH)) != 0);
 
 	const KX_KetsjiEngine::FlagType flags = (KX_KetsjiEngine::FlagType)
 		((fixed_framerate ? KX_KetsjiEngine::FIXED_FRAMERATE : 0) |
 		(frameRate ? KX_KetsjiEngine::SHOW_FRAMERATE : 0) |
 		(renderQueries ? KX_KetsjiEngine::SHOW_RENDER_QUERIES : 0) |
 		(restrictAnimFPS ? KX_KetsjiEngine::RESTRICT_ANIMATION : 0) |
+		(parallelScenes ? KX_KetsjiEngine::PARALLEL_SCENES : 0) |
+		(parallelSceneGraph ? KX_KetsjiEngine::PARALLEL_SCENEGRAPH : 0) |
 		(properties ? KX_KetsjiEngine::SHOW_DEBUG_PROPERTIES : 0) |
 		(profile ? KX_KetsjiEngine::SHOW_PROFILE : 0));
 
@@ -171,17 +176,19 @@ void LA_Launcher::InitEngine()
 	}
 	m_pythonConsole.use = (gm.flag & GAME_PYTHON_CONSOLE);
 
-	m_rasterizer = new RAS_Rasterizer();
+	m_rasterizer = CreateRasterizer();
 
-	// Stereo parameters - Eye Separation from the UI - stereomode from the command-line/UI
-	m_rasterizer->SetStereoMode(m_stereoMode);
-	m_rasterizer->SetEyeSeparation(m_startScene->gm.eyeseparation);
-	m_rasterizer->SetDrawingMode(GetRasterizerDrawMode());
-
-	// Copy current anisotropic level to restore it at the game end.
-	m_savedData.anisotropic = m_rasterizer->GetAnisotropicFiltering();
-	// Copy current mipmap mode to restore at the game end.
-	m_savedData.mipmap = m_rasterizer->GetMipmapping();
+	if (m_rasterizer) {
+		// Stereo parameters - Eye Separation from the UI - stereomode from the command-line/UI
+		m_rasterizer->SetStereoMode(m_stereoMode);
+		m_rasterizer->SetEyeSeparation(m_startScene->gm.eyeseparation);
+		m_rasterizer->SetDrawingMode(GetRasterizerDrawMode());
+
+		// Copy current anisotropic level to restore it at the game end.
+		m_savedData.anisotropic = m_rasterizer->GetAnisotropicFiltering();
+		// Copy current mipmap mode to restore at the game end.
+		m_savedData.mipmap = m_rasterizer->GetMipmapping();
+	}
 
 	// Create the canvas, rasterizer and rendertools.
 	m_canvas = CreateCanvas(m_rasterizer);
@@ -229,8 +236,11 @@ void LA_Launcher::InitEngine()
 
 	// Create the inputdevices.
 	m_inputDevice = new DEV_InputDevice();
-	m_eventConsumer = new DEV_EventConsumer(m_system, m_inputDevice, m_canvas);
-	m_system->addEventConsumer(m_eventConsumer);
+	// Without GHOST system (headless) the inputs are only set from python.
+	if (m_system) {
+		m_eventConsumer = new DEV_EventConsumer(m_system, m_inputDevice, m_canvas);
+		m_system->addEventConsumer(m_eventConsumer);
+	}
 
 	// Create a ketsjisystem (only needed for timing and stuff).
 	m_kxsystem = new LA_System();
@@ -244,7 +254,9 @@ void LA_Launcher::InitEngine()
 	// Set the devices.
 	m_ketsjiEngine->SetInputDevice(m_inputDevice);
 	m_ketsjiEngine->SetCanvas(m_canvas);
-	m_ketsjiEngine->SetRasterizer(m_rasterizer);
+	if (m_rasterizer) {
+		m_ketsjiEngine->SetRasterizer(m_rasterizer);
+	}
 	m_ketsjiEngine->SetNetworkMessageManager(m_networkMessageManager);
 
 	DEV_Joystick::Init();
@@ -268,6 +280,13 @@ void LA_Launcher::InitEngine()
 	m_ketsjiEngine->SetMaxPhysicsFrame(gm.maxphystep);
 	m_ketsjiEngine->SetTimeScale(gm.timeScale);
 
+	// Record a trace of a range of frames.
+	const std::string traceFile = SYS_GetCommandLineString(syshandle, "trace_file", "");
+	if (!traceFile.empty()) {
+		KX_TraceProfiler::ScheduleRecording(SYS_GetCommandLineInt(syshandle, "trace_start", 0),
+		                                    SYS_GetCommandLineInt(syshandle, "trace_frames", 100), traceFile);
+	}
+
 	// Set the global settings (carried over if restart/load new files).
 	m_ketsjiEngine->SetGlobalSettings(m_globalSettings);
 
@@ -304,7 +323,9 @@ void LA_Launcher::InitEngine()
 	m_ketsjiEngine->AddScene(m_kxStartScene);
 	m_kxStartScene->Release();
 
-	m_rasterizer->Init();
+	if (m_rasterizer) {
+		m_rasterizer->Init();
+	}
 	m_ketsjiEngine->StartEngine();
 
 	/* Set the animation playback rate for ipo's and actions the 
@@ -331,11 +352,13 @@ void LA_Launcher::ExitEngine()
 		m_canvas->SetMouseState(RAS_ICanvas::MOUSE_NORMAL);
 	}
 
-	// Set anisotropic settign back to its original value.
-	m_rasterizer->SetAnisotropicFiltering(m_savedData.anisotropic);
+	if (m_rasterizer) {
+		// Set anisotropic settign back to its original value.
+		m_rasterizer->SetAnisotropicFiltering(m_savedData.anisotropic);
 
-	// Set mipmap setting back to its original value.
-	m_rasterizer->SetMipmapping(m_savedData.mipmap);
+		// Set mipmap setting back to its original value.
+		m_rasterizer->SetMipmapping(m_savedData.mipmap);
+	}
 
 	// Set vsync mode back to original value.
 	m_canvas->SetSwapInterval(m_savedData.vsync);
@@ -442,6 +465,11 @@ int LA_Launcher::PythonEngineNextFrame(void *state)
 
 #endif
 
+RAS_Rasterizer *LA_Launcher::CreateRasterizer()
+{
+	return (new RAS_Rasterizer());
+}
+
 void LA_Launcher::RenderEngine()
 {
 	// Render the frame.
@@ -491,8 +519,10 @@ bool LA_Launcher::EngineNextFrame()
 		}
 	}
 
-	m_system->processEvents(false);
-	m_system->dispatchEvents();
+	if (m_system) {
+		m_system->processEvents(false);
+		m_system->dispatchEvents();
+	}
 
 	if (m_inputDevice->GetInput((SCA_IInputDevice::SCA_EnumInputs)m_ketsjiEngine->GetExitKey()).Find(SCA_InputEvent::ACTIVE) &&
 		!m_inputDevice->GetHookExitKey())
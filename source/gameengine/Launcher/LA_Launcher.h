@@ -61,7 +61,7 @@ protected:
 	std::string m_exitString;
 	GlobalSettings *m_globalSettings;
 
-	/// GHOST system abstraction.
+	/// GHOST system abstraction, null when running without window.
 	GHOST_ISystem *m_system;
 
 	/// The gameengine itself.
@@ -123,6 +123,8 @@ protected:
 	virtual void RunPythonMainLoop(const std::string& pythonCode);
 #endif  // WITH_PYTHON
 
+	/// Create the rasterizer, a null rasterizer disables all the rendering.
+	virtual RAS_Rasterizer *CreateRasterizer();
 	virtual RAS_ICanvas *CreateCanvas(RAS_Rasterizer *rasty) = 0;
 	virtual RAS_Rasterizer::DrawType GetRasterizerDrawMode() = 0;
 	virtual bool GetUseAlwaysExpandFraming() = 0;
@@ -126,7 +126,9 @@ void LA_PlayerLauncher::InitCamera()
 
 void LA_PlayerLauncher::SetWindowOrder(short order)
 {
-	m_mainWindow->setOrder((order == 0) ? GHOST_kWindowOrderBottom : GHOST_kWindowOrderTop);
+	if (m_mainWindow) {
+		m_mainWindow->setOrder((order == 0) ? GHOST_kWindowOrderBottom : GHOST_kWindowOrderTop);
+	}
 }
 
 void LA_PlayerLauncher::InitEngine()
@@ -134,7 +136,9 @@ void LA_PlayerLauncher::InitEngine()
 	BKE_sound_init(m_maggie);
 	LA_Launcher::InitEngine();
 
-	m_rasterizer->PrintHardwareInfo();
+	if (m_rasterizer) {
+		m_rasterizer->PrintHardwareInfo();
+	}
 }
 
 void LA_PlayerLauncher::ExitEngine()
@@ -29,6 +29,9 @@
  *  \ingroup launcher
  */
 
+#ifndef __LA_PLAYERLAUNCHER_H__
+#define __LA_PLAYERLAUNCHER_H__
+
 #ifdef WIN32
 #include <wtypes.h>
 #endif
@@ -70,3 +73,5 @@ public:
 
 	virtual bool EngineNextFrame();
 };
+
+#endif  // __LA_PLAYERLAUNCHER_H__
@@ -0,0 +1,588 @@
+/** \file gameengine/Physics/Bullet/CcdParallelDynamics.cpp
+ *  \ingroup physbullet
+ */
+/*
+   Bullet Continuous Collision Detection and Physics Library
+   Copyright (c) 2003-2006 Erwin Coumans  http://continuousphysics.com/Bullet/
+
+   This software is provided 'as-is', without any express or implied warranty.
+   In no event will the authors be held liable for any damages arising from the use of this software.
+   Permission is granted to anyone to use this software for any purpose,
+   including commercial applications, and to alter it and redistribute it freely,
+   subject to the following restrictions:
+
+   1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+   2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "CcdParallelDynamics.h"
+
+#include "btBulletDynamicsCommon.h"
+#include "BulletCollision/CollisionDispatch/btSimulationIslandManager.h"
+#include "BulletDynamics/ConstraintSolver/btNNCGConstraintSolver.h"
+#include "BulletDynamics/MLCPSolvers/btMLCPSolver.h"
+#include "BulletDynamics/MLCPSolvers/btDantzigSolver.h"
+#include "BulletDynamics/MLCPSolvers/btLemkeSolver.h"
+#include "LinearMath/btQuickprof.h"
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+extern "C" {
+	#include "BLI_utildefines.h"
+	#include "BLI_task.h"
+	#include "BLI_threads.h"
+}
+
+btConstraintSolver *CcdCreateConstraintSolver(PHY_SolverType solverType)
+{
+	switch (solverType) {
+		case PHY_SOLVER_SEQUENTIAL:
+		{
+			return new btSequentialImpulseConstraintSolver();
+		}
+		case PHY_SOLVER_NNCG:
+		{
+			return new btNNCGConstraintSolver();
+		}
+		case PHY_SOLVER_MLCP_DANTZIG:
+		{
+			return new btMLCPSolver(new btDantzigSolver());
+		}
+		case PHY_SOLVER_MLCP_LEMKE:
+		{
+			return new btMLCPSolver(new btLemkeSolver());
+		}
+		default:
+		{
+			BLI_assert(false);
+		}
+	}
+
+	return nullptr;
+}
+
+CcdConvexConvexAlgorithm::CcdConvexConvexAlgorithm(btPersistentManifold *mf, const btCollisionAlgorithmConstructionInfo& ci,
+		const btCollisionObjectWrapper *body0Wrap, const btCollisionObjectWrapper *body1Wrap,
+		btConvexPenetrationDepthSolver *pdSolver, int numPerturbationIterations, int minimumPointsPerturbationThreshold)
+	// The base class only stores the simplex solver pointer.
+	:btConvexConvexAlgorithm(mf, ci, body0Wrap, body1Wrap, &m_ownSimplexSolver, pdSolver,
+			numPerturbationIterations, minimumPointsPerturbationThreshold)
+{
+}
+
+CcdConvexConvexAlgorithm::CreateFunc::CreateFunc(btSimplexSolverInterface *simplexSolver, btConvexPenetrationDepthSolver *pdSolver)
+	:btConvexConvexAlgorithm::CreateFunc(simplexSolver, pdSolver)
+{
+}
+
+btCollisionAlgorithm *CcdConvexConvexAlgorithm::CreateFunc::CreateCollisionAlgorithm(btCollisionAlgorithmConstructionInfo& ci,
+		const btCollisionObjectWrapper *body0Wrap, const btCollisionObjectWrapper *body1Wrap)
+{
+	void *mem = ci.m_dispatcher1->allocateCollisionAlgorithm(sizeof(CcdConvexConvexAlgorithm));
+	return new(mem) CcdConvexConvexAlgorithm(ci.m_manifold, ci, body0Wrap, body1Wrap, m_pdSolver,
+			m_numPerturbationIterations, m_minimumPointsPerturbationThreshold);
+}
+
+static btDefaultCollisionConstructionInfo getCollisionConstructionInfo()
+{
+	btDefaultCollisionConstructionInfo info;
+	// Make room for the simplex solver owned by the convex algorithms.
+	info.m_customCollisionAlgorithmMaxElementSize = sizeof(CcdConvexConvexAlgorithm);
+	return info;
+}
+
+CcdCollisionConfiguration::CcdCollisionConfiguration()
+	:btSoftBodyRigidBodyCollisionConfiguration(getCollisionConstructionInfo())
+{
+	void *mem = btAlignedAlloc(sizeof(CcdConvexConvexAlgorithm::CreateFunc), 16);
+	m_parallelConvexConvexCreateFunc = new(mem) CcdConvexConvexAlgorithm::CreateFunc(m_simplexSolver, m_pdSolver);
+
+	const btConvexConvexAlgorithm::CreateFunc *defaultFunc = static_cast<btConvexConvexAlgorithm::CreateFunc *>(m_convexConvexCreateFunc);
+	m_parallelConvexConvexCreateFunc->m_numPerturbationIterations = defaultFunc->m_numPerturbationIterations;
+	m_parallelConvexConvexCreateFunc->m_minimumPointsPerturbationThreshold = defaultFunc->m_minimumPointsPerturbationThreshold;
+}
+
+CcdCollisionConfiguration::~CcdCollisionConfiguration()
+{
+	m_parallelConvexConvexCreateFunc->~CreateFunc();
+	btAlignedFree(m_parallelConvexConvexCreateFunc);
+}
+
+btCollisionAlgorithmCreateFunc *CcdCollisionConfiguration::getCollisionAlgorithmCreateFunc(int proxyType0, int proxyType1)
+{
+	btCollisionAlgorithmCreateFunc *func = btSoftBodyRigidBodyCollisionConfiguration::getCollisionAlgorithmCreateFunc(proxyType0, proxyType1);
+	if (func == m_convexConvexCreateFunc) {
+		return m_parallelConvexConvexCreateFunc;
+	}
+	return func;
+}
+
+/// Return true if the collision algorithms of a pair can be processed in a task.
+static bool isParallelPair(const btBroadphasePair& pair)
+{
+	for (const btBroadphaseProxy *proxy : {pair.m_pProxy0, pair.m_pProxy1}) {
+		const btCollisionObject *object = static_cast<btCollisionObject *>(proxy->m_clientObject);
+		// Soft bodies share their contacts between all the pairs.
+		if (object->getInternalType() == btCollisionObject::CO_SOFT_BODY ||
+			object->getCollisionShape()->getShapeType() == GIMPACT_SHAPE_PROXYTYPE)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/// Task processing pairs in the current thread.
+static thread_local CcdParallelDispatcher::TaskData *t_taskData = nullptr;
+
+CcdParallelDispatcher::CcdParallelDispatcher(btCollisionConfiguration *collisionConfiguration)
+	:btCollisionDispatcher(collisionConfiguration),
+	m_taskScheduler(nullptr),
+	m_taskPool(nullptr),
+	m_batchUpdating(false)
+{
+}
+
+CcdParallelDispatcher::~CcdParallelDispatcher()
+{
+	if (m_taskPool) {
+		BLI_task_pool_free(m_taskPool);
+	}
+}
+
+void CcdParallelDispatcher::SetTaskScheduler(TaskScheduler *scheduler)
+{
+	if (m_taskScheduler == scheduler) {
+		return;
+	}
+
+	if (m_taskPool) {
+		BLI_task_pool_free(m_taskPool);
+		m_taskPool = nullptr;
+	}
+
+	m_taskScheduler = scheduler;
+	if (m_taskScheduler) {
+		m_taskPool = BLI_task_pool_create(m_taskScheduler, this);
+	}
+}
+
+TaskScheduler *CcdParallelDispatcher::GetTaskScheduler() const
+{
+	return m_taskScheduler;
+}
+
+btPersistentManifold *CcdParallelDispatcher::getNewManifold(const btCollisionObject *b0, const btCollisionObject *b1)
+{
+	if (!m_batchUpdating) {
+		return btCollisionDispatcher::getNewManifold(b0, b1);
+	}
+
+	m_lock.Lock();
+	btPersistentManifold *manifold = btCollisionDispatcher::getNewManifold(b0, b1);
+	m_lock.Unlock();
+
+	// The manifolds are added in the order of the tasks afterward.
+	t_taskData->newManifolds.push_back(manifold);
+
+	return manifold;
+}
+
+void CcdParallelDispatcher::releaseManifold(btPersistentManifold *manifold)
+{
+	if (!m_batchUpdating) {
+		btCollisionDispatcher::releaseManifold(manifold);
+		return;
+	}
+
+	// Releasing swaps the manifolds in the list, it's delayed after the tasks.
+	t_taskData->releasedManifolds.push_back(manifold);
+}
+
+void *CcdParallelDispatcher::allocateCollisionAlgorithm(int size)
+{
+	if (!m_batchUpdating) {
+		return btCollisionDispatcher::allocateCollisionAlgorithm(size);
+	}
+
+	m_lock.Lock();
+	void *ptr = btCollisionDispatcher::allocateCollisionAlgorithm(size);
+	m_lock.Unlock();
+
+	return ptr;
+}
+
+void CcdParallelDispatcher::freeCollisionAlgorithm(void *ptr)
+{
+	if (!m_batchUpdating) {
+		btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+		return;
+	}
+
+	m_lock.Lock();
+	btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+	m_lock.Unlock();
+}
+
+void CcdParallelDispatcher::ProcessPairsTask(TaskPool *pool, void *taskdata, int UNUSED(threadid))
+{
+	CcdParallelDispatcher *dispatcher = (CcdParallelDispatcher *)BLI_task_pool_userdata(pool);
+	TaskData *data = (TaskData *)taskdata;
+	btNearCallback callback = dispatcher->getNearCallback();
+
+	t_taskData = data;
+	for (int i = 0; i < data->numPairs; ++i) {
+		btBroadphasePair& pair = data->pairs[i];
+		if (isParallelPair(pair)) {
+			callback(pair, *dispatcher, *data->info);
+		}
+	}
+	t_taskData = nullptr;
+}
+
+void CcdParallelDispatcher::dispatchAllCollisionPairs(btOverlappingPairCache *pairCache, const btDispatcherInfo& dispatchInfo,
+		btDispatcher *dispatcher)
+{
+	const int numPairs = pairCache->getNumOverlappingPairs();
+
+	/* Nested task pools are avoided when the physics of the scenes are already
+	 * updated in parallel, see KX_KetsjiEngine::ProceedScenesPhysics. */
+	if (!m_taskPool || dispatchInfo.m_dispatchFunc != btDispatcherInfo::DISPATCH_DISCRETE ||
+		numPairs < (PairsPerTask * 2) || !BLI_thread_is_main())
+	{
+		btCollisionDispatcher::dispatchAllCollisionPairs(pairCache, dispatchInfo, dispatcher);
+		return;
+	}
+
+	BT_PROFILE("dispatchAllCollisionPairs");
+
+	btBroadphasePair *pairs = pairCache->getOverlappingPairArrayPtr();
+
+	m_serialPairs.clear();
+	for (int i = 0; i < numPairs; ++i) {
+		if (!isParallelPair(pairs[i])) {
+			m_serialPairs.push_back(&pairs[i]);
+		}
+	}
+
+	m_taskData.clear();
+	for (int i = 0; i < numPairs; i += PairsPerTask) {
+		m_taskData.push_back({&pairs[i], std::min(PairsPerTask, numPairs - i), &dispatchInfo, {}, {}});
+	}
+
+	const int numManifolds = getNumManifolds();
+
+	m_batchUpdating = true;
+	for (TaskData& data : m_taskData) {
+		BLI_task_pool_push(m_taskPool, ProcessPairsTask, &data, false, TASK_PRIORITY_HIGH);
+	}
+	BLI_task_pool_work_and_wait(m_taskPool);
+	m_batchUpdating = false;
+
+	/* The new manifolds were appended by the threads in any order, add them again
+	 * in the order of the tasks independently of the threads. */
+	m_manifoldsPtr.resize(numManifolds);
+	for (const TaskData& data : m_taskData) {
+		for (btPersistentManifold *manifold : data.newManifolds) {
+			manifold->m_index1a = m_manifoldsPtr.size();
+			m_manifoldsPtr.push_back(manifold);
+		}
+	}
+
+	for (const TaskData& data : m_taskData) {
+		for (btPersistentManifold *manifold : data.releasedManifolds) {
+			btCollisionDispatcher::releaseManifold(manifold);
+		}
+	}
+
+	btNearCallback callback = getNearCallback();
+	for (btBroadphasePair *pair : m_serialPairs) {
+		callback(*pair, *this, dispatchInfo);
+	}
+}
+
+static int getConstraintIslandId(const btTypedConstraint *constraint)
+{
+	const btCollisionObject& colObj0 = constraint->getRigidBodyA();
+	const btCollisionObject& colObj1 = constraint->getRigidBodyB();
+	return (colObj0.getIslandTag() >= 0) ? colObj0.getIslandTag() : colObj1.getIslandTag();
+}
+
+/// Same order as btDiscreteDynamicsWorld::solveConstraints.
+class CcdSortConstraintOnIslandPredicate
+{
+public:
+	bool operator()(const btTypedConstraint *lhs, const btTypedConstraint *rhs) const
+	{
+		return getConstraintIslandId(lhs) < getConstraintIslandId(rhs);
+	}
+};
+
+/// Copy the bodies, manifolds and constraints of every awake island.
+struct CcdIslandCollector : public btSimulationIslandManager::IslandCallback
+{
+	struct Island
+	{
+		int islandId;
+		int firstBody;
+		int numBodies;
+		int firstManifold;
+		int numManifolds;
+		int firstConstraint;
+		int numConstraints;
+	};
+
+	btTypedConstraint **m_sortedConstraints;
+	int m_numConstraints;
+	int m_constraintCursor;
+
+	std::vector<btCollisionObject *> m_bodies;
+	std::vector<btPersistentManifold *> m_manifolds;
+	std::vector<Island> m_islands;
+
+	CcdIslandCollector(btTypedConstraint **sortedConstraints, int numConstraints)
+		:m_sortedConstraints(sortedConstraints),
+		m_numConstraints(numConstraints),
+		m_constraintCursor(0)
+	{
+	}
+
+	virtual void processIsland(btCollisionObject **bodies, int numBodies, btPersistentManifold **manifolds, int numManifolds, int islandId)
+	{
+		// The islands are processed by increasing id, as the sorted constraints.
+		while (m_constraintCursor < m_numConstraints && getConstraintIslandId(m_sortedConstraints[m_constraintCursor]) < islandId) {
+			++m_constraintCursor;
+		}
+		const int firstConstraint = m_constraintCursor;
+		while (m_constraintCursor < m_numConstraints && getConstraintIslandId(m_sortedConstraints[m_constraintCursor]) == islandId) {
+			++m_constraintCursor;
+		}
+
+		m_islands.push_back({islandId, (int)m_bodies.size(), numBodies, (int)m_manifolds.size(), numManifolds,
+				firstConstraint, m_constraintCursor - firstConstraint});
+		m_bodies.insert(m_bodies.end(), bodies, bodies + numBodies);
+		m_manifolds.insert(m_manifolds.end(), manifolds, manifolds + numManifolds);
+	}
+};
+
+/// Return true if the solver writes to the body.
+static bool isSolverBody(const btCollisionObject *object)
+{
+	const btRigidBody *body = btRigidBody::upcast(object);
+	return (body && (body->getInvMass() != 0.0f || body->isKinematicObject()));
+}
+
+static int findRoot(std::vector<int>& parents, int index)
+{
+	while (parents[index] != index) {
+		parents[index] = parents[parents[index]];
+		index = parents[index];
+	}
+	return index;
+}
+
+CcdParallelDynamicsWorld::CcdParallelDynamicsWorld(btDispatcher *dispatcher, btBroadphaseInterface *pairCache,
+		btConstraintSolver *constraintSolver, btCollisionConfiguration *collisionConfiguration)
+	:btSoftRigidDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration),
+	m_taskScheduler(nullptr),
+	m_taskPool(nullptr),
+	m_solverType(PHY_SOLVER_NONE)
+{
+}
+
+CcdParallelDynamicsWorld::~CcdParallelDynamicsWorld()
+{
+	ClearBatchSolvers();
+
+	if (m_taskPool) {
+		BLI_task_pool_free(m_taskPool);
+	}
+}
+
+void CcdParallelDynamicsWorld::ClearBatchSolvers()
+{
+	for (btConstraintSolver *solver : m_batchSolvers) {
+		delete solver;
+	}
+	m_batchSolvers.clear();
+}
+
+void CcdParallelDynamicsWorld::SetTaskScheduler(TaskScheduler *scheduler)
+{
+	if (m_taskScheduler == scheduler) {
+		return;
+	}
+
+	if (m_taskPool) {
+		BLI_task_pool_free(m_taskPool);
+		m_taskPool = nullptr;
+	}
+
+	m_taskScheduler = scheduler;
+	if (m_taskScheduler) {
+		m_taskPool = BLI_task_pool_create(m_taskScheduler, this);
+	}
+	else {
+		ClearBatchSolvers();
+	}
+}
+
+void CcdParallelDynamicsWorld::SetSolverType(PHY_SolverType solverType)
+{
+	if (m_solverType == solverType) {
+		return;
+	}
+
+	ClearBatchSolvers();
+	m_solverType = solverType;
+}
+
+void CcdParallelDynamicsWorld::SolveBatchTask(TaskPool *pool, void *taskdata, int UNUSED(threadid))
+{
+	CcdParallelDynamicsWorld *world = (CcdParallelDynamicsWorld *)BLI_task_pool_userdata(pool);
+	Batch *batch = (Batch *)taskdata;
+
+	batch->solver->prepareSolve(batch->bodies.size(), batch->manifolds.size());
+	batch->solver->solveGroup(batch->bodies.data(), batch->bodies.size(), batch->manifolds.data(), batch->manifolds.size(),
+			batch->constraints.data(), batch->constraints.size(), world->getSolverInfo(), world->getDebugDrawer(), world->getDispatcher());
+}
+
+void CcdParallelDynamicsWorld::solveConstraints(btContactSolverInfo& solverInfo)
+{
+	if (!m_taskPool || m_solverType == PHY_SOLVER_NONE || !m_islandManager->getSplitIslands() || !BLI_thread_is_main()) {
+		btSoftRigidDynamicsWorld::solveConstraints(solverInfo);
+		return;
+	}
+
+	BT_PROFILE("solveConstraints");
+
+	const int numConstraints = m_constraints.size();
+	m_sortedConstraints.resize(numConstraints);
+	for (int i = 0; i < numConstraints; ++i) {
+		m_sortedConstraints[i] = m_constraints[i];
+	}
+	m_sortedConstraints.quickSort(CcdSortConstraintOnIslandPredicate());
+
+	btTypedConstraint **constraints = numConstraints ? &m_sortedConstraints[0] : nullptr;
+	CcdIslandCollector collector(constraints, numConstraints);
+	m_islandManager->buildAndProcessIslands(getDispatcher(), this, &collector);
+
+	const unsigned int numIslands = collector.m_islands.size();
+	if (numIslands == 0) {
+		m_constraintSolver->allSolved(solverInfo, m_debugDrawer);
+		return;
+	}
+
+	/* Islands sharing a body written by the solver (kinematic body, disabled
+	 * constraint between two islands) must be solved by the same solver. */
+	std::vector<int> parents(numIslands);
+	std::iota(parents.begin(), parents.end(), 0);
+	std::unordered_map<const btCollisionObject *, int> owners;
+
+	auto linkBody = [&parents, &owners](const btCollisionObject *object, int index) {
+		if (!isSolverBody(object)) {
+			return;
+		}
+		const std::pair<std::unordered_map<const btCollisionObject *, int>::iterator, bool> result = owners.emplace(object, index);
+		if (!result.second) {
+			const int root1 = findRoot(parents, result.first->second);
+			const int root2 = findRoot(parents, index);
+			// Keep the lowest index as root for a stable order.
+			parents[std::max(root1, root2)] = std::min(root1, root2);
+		}
+	};
+
+	for (unsigned int i = 0; i < numIslands; ++i) {
+		const CcdIslandCollector::Island& island = collector.m_islands[i];
+		for (int j = island.firstBody, end = island.firstBody + island.numBodies; j < end; ++j) {
+			linkBody(collector.m_bodies[j], i);
+		}
+		for (int j = island.firstManifold, end = island.firstManifold + island.numManifolds; j < end; ++j) {
+			const btPersistentManifold *manifold = collector.m_manifolds[j];
+			for (const btCollisionObject *object : {manifold->getBody0(), manifold->getBody1()}) {
+				if (object->getIslandTag() != island.islandId) {
+					linkBody(object, i);
+				}
+			}
+		}
+		for (int j = island.firstConstraint, end = island.firstConstraint + island.numConstraints; j < end; ++j) {
+			const btTypedConstraint *constraint = constraints[j];
+			for (const btCollisionObject *object : {(const btCollisionObject *)&constraint->getRigidBodyA(),
+													(const btCollisionObject *)&constraint->getRigidBodyB()})
+			{
+				if (object->getIslandTag() != island.islandId) {
+					linkBody(object, i);
+				}
+			}
+		}
+	}
+
+	// Group the islands by root, the groups are ordered by their first island.
+	std::vector<std::vector<int> > groups;
+	std::vector<int> groupIndices(numIslands, -1);
+	for (unsigned int i = 0; i < numIslands; ++i) {
+		const int root = findRoot(parents, i);
+		if (groupIndices[root] == -1) {
+			groupIndices[root] = groups.size();
+			groups.emplace_back();
+		}
+		groups[groupIndices[root]].push_back(i);
+	}
+
+	// Merge the groups in batches as btDiscreteDynamicsWorld does with the islands.
+	unsigned int numBatches = 0;
+	for (const std::vector<int>& group : groups) {
+		if (numBatches == 0 || (int)(m_batches[numBatches - 1].constraints.size() + m_batches[numBatches - 1].manifolds.size()) >
+			solverInfo.m_minimumSolverBatchSize)
+		{
+			if (m_batches.size() == numBatches) {
+				m_batches.emplace_back();
+			}
+			Batch& batch = m_batches[numBatches++];
+			batch.bodies.clear();
+			batch.manifolds.clear();
+			batch.constraints.clear();
+		}
+
+		Batch& batch = m_batches[numBatches - 1];
+		for (int index : group) {
+			const CcdIslandCollector::Island& island = collector.m_islands[index];
+			batch.bodies.insert(batch.bodies.end(), collector.m_bodies.begin() + island.firstBody,
+					collector.m_bodies.begin() + island.firstBody + island.numBodies);
+			batch.manifolds.insert(batch.manifolds.end(), collector.m_manifolds.begin() + island.firstManifold,
+					collector.m_manifolds.begin() + island.firstManifold + island.numManifolds);
+			batch.constraints.insert(batch.constraints.end(), constraints + island.firstConstraint,
+					constraints + island.firstConstraint + island.numConstraints);
+		}
+	}
+
+	// The first batch uses the world solver, the others their own solver.
+	while (m_batchSolvers.size() < (numBatches - 1)) {
+		m_batchSolvers.push_back(CcdCreateConstraintSolver(m_solverType));
+	}
+	m_batches[0].solver = m_constraintSolver;
+	for (unsigned int i = 1; i < numBatches; ++i) {
+		m_batches[i].solver = m_batchSolvers[i - 1];
+	}
+
+	if (numBatches == 1) {
+		Batch& batch = m_batches[0];
+		m_constraintSolver->prepareSolve(batch.bodies.size(), batch.manifolds.size());
+		m_constraintSolver->solveGroup(batch.bodies.data(), batch.bodies.size(), batch.manifolds.data(), batch.manifolds.size(),
+				batch.constraints.data(), batch.constraints.size(), solverInfo, m_debugDrawer, getDispatcher());
+	}
+	else {
+		for (unsigned int i = 0; i < numBatches; ++i) {
+			BLI_task_pool_push(m_taskPool, SolveBatchTask, &m_batches[i], false, TASK_PRIORITY_HIGH);
+		}
+		BLI_task_pool_work_and_wait(m_taskPool);
+	}
+
+	for (unsigned int i = 0; i < numBatches; ++i) {
+		m_batches[i].solver->allSolved(solverInfo, m_debugDrawer);
+	}
+}
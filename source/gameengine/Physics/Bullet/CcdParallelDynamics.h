@@ -0,0 +1,177 @@
+/*
+   Bullet Continuous Collision Detection and Physics Library
+   Copyright (c) 2003-2006 Erwin Coumans  http://continuousphysics.com/Bullet/
+
+   This software is provided 'as-is', without any express or implied warranty.
+   In no event will the authors be held liable for any damages arising from the use of this software.
+   Permission is granted to anyone to use this software for any purpose,
+   including commercial applications, and to alter it and redistribute it freely,
+   subject to the following restrictions:
+
+   1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+   2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+   3. This notice may not be removed or altered from any source distribution.
+ */
+
+/** \file CcdParallelDynamics.h
+ *  \ingroup physbullet
+ *
+ * Multithreaded narrowphase and constraint solving on top of the Bullet
+ * dispatcher and dynamics world, the work is distributed on the engine task scheduler.
+ */
+
+#ifndef __CCDPARALLELDYNAMICS_H__
+#define __CCDPARALLELDYNAMICS_H__
+
+#include "PHY_DynamicTypes.h"
+
+#include "CM_Thread.h"
+
+#include "BulletCollision/CollisionDispatch/btCollisionDispatcher.h"
+#include "BulletCollision/CollisionDispatch/btConvexConvexAlgorithm.h"
+#include "BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h"
+#include "BulletSoftBody/btSoftRigidDynamicsWorld.h"
+#include "BulletSoftBody/btSoftBodyRigidBodyCollisionConfiguration.h"
+
+#include <vector>
+
+struct TaskScheduler;
+struct TaskPool;
+
+/// Create a constraint solver of the given type.
+btConstraintSolver *CcdCreateConstraintSolver(PHY_SolverType solverType);
+
+/** Convex collision algorithm owning its simplex solver. The default algorithm
+ * shares the simplex solver of the collision configuration which can't be used
+ * by several threads at the same time.
+ */
+class CcdConvexConvexAlgorithm : public btConvexConvexAlgorithm
+{
+private:
+	btVoronoiSimplexSolver m_ownSimplexSolver;
+
+public:
+	CcdConvexConvexAlgorithm(btPersistentManifold *mf, const btCollisionAlgorithmConstructionInfo& ci,
+			const btCollisionObjectWrapper *body0Wrap, const btCollisionObjectWrapper *body1Wrap,
+			btConvexPenetrationDepthSolver *pdSolver, int numPerturbationIterations, int minimumPointsPerturbationThreshold);
+
+	struct CreateFunc : public btConvexConvexAlgorithm::CreateFunc
+	{
+		CreateFunc(btSimplexSolverInterface *simplexSolver, btConvexPenetrationDepthSolver *pdSolver);
+
+		virtual btCollisionAlgorithm *CreateCollisionAlgorithm(btCollisionAlgorithmConstructionInfo& ci,
+				const btCollisionObjectWrapper *body0Wrap, const btCollisionObjectWrapper *body1Wrap);
+	};
+};
+
+/// Collision configuration creating only thread safe convex algorithms.
+class CcdCollisionConfiguration : public btSoftBodyRigidBodyCollisionConfiguration
+{
+private:
+	CcdConvexConvexAlgorithm::CreateFunc *m_parallelConvexConvexCreateFunc;
+
+public:
+	CcdCollisionConfiguration();
+	virtual ~CcdCollisionConfiguration();
+
+	virtual btCollisionAlgorithmCreateFunc *getCollisionAlgorithmCreateFunc(int proxyType0, int proxyType1);
+};
+
+/** Collision dispatcher processing the overlapping pairs in parallel tasks.
+ * The manifolds created or released during the tasks are collected per task and
+ * added or released afterward in the order of the tasks, which is the order of the
+ * overlapping pairs, the result doesn't depend on the number of threads.
+ */
+class CcdParallelDispatcher : public btCollisionDispatcher
+{
+private:
+	TaskScheduler *m_taskScheduler;
+	TaskPool *m_taskPool;
+
+	/// True while the pairs are processed in the tasks.
+	bool m_batchUpdating;
+	CM_ThreadSpinLock m_lock;
+	/// Pairs not supporting a parallel processing (soft bodies, gimpact).
+	std::vector<btBroadphasePair *> m_serialPairs;
+
+	static void ProcessPairsTask(TaskPool *pool, void *taskdata, int threadid);
+
+public:
+	/// Minimum number of pairs processed by a task.
+	static const int PairsPerTask = 64;
+
+	struct TaskData
+	{
+		btBroadphasePair *pairs;
+		int numPairs;
+		const btDispatcherInfo *info;
+		/// Manifolds created and released by the task, in the order of the pairs.
+		std::vector<btPersistentManifold *> newManifolds;
+		std::vector<btPersistentManifold *> releasedManifolds;
+	};
+
+private:
+	std::vector<TaskData> m_taskData;
+
+public:
+	CcdParallelDispatcher(btCollisionConfiguration *collisionConfiguration);
+	virtual ~CcdParallelDispatcher();
+
+	/// Enable the parallel processing with the given scheduler, nullptr disables it.
+	void SetTaskScheduler(TaskScheduler *scheduler);
+	TaskScheduler *GetTaskScheduler() const;
+
+	virtual btPersistentManifold *getNewManifold(const btCollisionObject *b0, const btCollisionObject *b1);
+	virtual void releaseManifold(btPersistentManifold *manifold);
+
+	virtual void *allocateCollisionAlgorithm(int size);
+	virtual void freeCollisionAlgorithm(void *ptr);
+
+	virtual void dispatchAllCollisionPairs(btOverlappingPairCache *pairCache, const btDispatcherInfo& dispatchInfo, btDispatcher *dispatcher);
+};
+
+/** Dynamics world solving the simulation islands in parallel tasks.
+ * The islands sharing a kinematic body are solved together, the islands
+ * are then merged in batches of a minimum size using their own solver.
+ * The batches only depend on the islands, not on the number of threads.
+ */
+class CcdParallelDynamicsWorld : public btSoftRigidDynamicsWorld
+{
+public:
+	/// Range of bodies, manifolds and constraints solved together.
+	struct Batch
+	{
+		std::vector<btCollisionObject *> bodies;
+		std::vector<btPersistentManifold *> manifolds;
+		std::vector<btTypedConstraint *> constraints;
+		btConstraintSolver *solver;
+	};
+
+private:
+	TaskScheduler *m_taskScheduler;
+	TaskPool *m_taskPool;
+
+	PHY_SolverType m_solverType;
+	/// Solvers of the batches after the first one, the first batch uses the world solver.
+	std::vector<btConstraintSolver *> m_batchSolvers;
+	std::vector<Batch> m_batches;
+
+	static void SolveBatchTask(TaskPool *pool, void *taskdata, int threadid);
+
+	void ClearBatchSolvers();
+
+protected:
+	virtual void solveConstraints(btContactSolverInfo& solverInfo);
+
+public:
+	CcdParallelDynamicsWorld(btDispatcher *dispatcher, btBroadphaseInterface *pairCache, btConstraintSolver *constraintSolver,
+			btCollisionConfiguration *collisionConfiguration);
+	virtual ~CcdParallelDynamicsWorld();
+
+	/// Enable the parallel solving with the given scheduler, nullptr disables it.
+	void SetTaskScheduler(TaskScheduler *scheduler);
+	/// Set the type of the solvers used for the batches.
+	void SetSolverType(PHY_SolverType solverType);
+};
+
+#endif  // __CCDPARALLELDYNAMICS_H__
@@ -1088,6 +1088,14 @@ void CcdPhysicsController::SetTransform()
 		object->setActivationState(ACTIVE_TAG);
 		object->setCollisionFlags(object->getCollisionFlags() | btCollisionObject::CF_KINEMATIC_OBJECT);
 	}
+
+	/* The static controllers are not synchronized at each physics step,
+	 * update here the scale changed by a parent. */
+	btCollisionShape *shape = GetCollisionShape();
+	const btVector3 scale = ToBullet(m_MotionState->GetWorldScaling());
+	if (shape && shape->getLocalScaling() != scale && !IsPhysicsSuspended()) {
+		shape->setLocalScaling(scale);
+	}
 }
 
 float CcdPhysicsController::GetMass()
@@ -1391,6 +1399,81 @@ mt::vec3 CcdPhysicsController::GetLocalInertia()
 	return inertia;
 }
 
+static void PackTransform(const btTransform& trans, float mat[12])
+{
+	const btMatrix3x3& basis = trans.getBasis();
+	for (unsigned short i = 0; i < 3; ++i) {
+		const btVector3& row = basis.getRow(i);
+		mat[i * 3] = row.x();
+		mat[i * 3 + 1] = row.y();
+		mat[i * 3 + 2] = row.z();
+	}
+	const btVector3& origin = trans.getOrigin();
+	mat[9] = origin.x();
+	mat[10] = origin.y();
+	mat[11] = origin.z();
+}
+
+static btTransform UnpackTransform(const float mat[12])
+{
+	return btTransform(btMatrix3x3(mat[0], mat[1], mat[2], mat[3], mat[4], mat[5], mat[6], mat[7], mat[8]),
+	                   btVector3(mat[9], mat[10], mat[11]));
+}
+
+static void PackVector(const btVector3& vec, float data[3])
+{
+	data[0] = vec.x();
+	data[1] = vec.y();
+	data[2] = vec.z();
+}
+
+bool CcdPhysicsController::GetPhysicsState(PHY_PhysicsState& state)
+{
+	btRigidBody *body = GetRigidBody();
+	if (!body || !m_cci.m_bDyna) {
+		return false;
+	}
+
+	PackTransform(body->getWorldTransform(), state.m_transform);
+	PackTransform(body->getInterpolationWorldTransform(), state.m_interpolationTransform);
+	PackVector(body->getLinearVelocity(), state.m_linearVelocity);
+	PackVector(body->getAngularVelocity(), state.m_angularVelocity);
+	PackVector(body->getInterpolationLinearVelocity(), state.m_interpolationLinearVelocity);
+	PackVector(body->getInterpolationAngularVelocity(), state.m_interpolationAngularVelocity);
+	state.m_activationState = body->getActivationState();
+	state.m_deactivationTime = body->getDeactivationTime();
+
+	return true;
+}
+
+void CcdPhysicsController::SetPhysicsState(const PHY_PhysicsState& state)
+{
+	btRigidBody *body = GetRigidBody();
+	if (!body) {
+		return;
+	}
+
+	const btTransform trans = UnpackTransform(state.m_transform);
+	body->setCenterOfMassTransform(trans);
+	body->setInterpolationWorldTransform(UnpackTransform(state.m_interpolationTransform));
+	body->setLinearVelocity(btVector3(state.m_linearVelocity[0], state.m_linearVelocity[1], state.m_linearVelocity[2]));
+	body->setAngularVelocity(btVector3(state.m_angularVelocity[0], state.m_angularVelocity[1], state.m_angularVelocity[2]));
+	body->setInterpolationLinearVelocity(btVector3(state.m_interpolationLinearVelocity[0],
+	                                               state.m_interpolationLinearVelocity[1],
+	                                               state.m_interpolationLinearVelocity[2]));
+	body->setInterpolationAngularVelocity(btVector3(state.m_interpolationAngularVelocity[0],
+	                                                state.m_interpolationAngularVelocity[1],
+	                                                state.m_interpolationAngularVelocity[2]));
+	body->clearForces();
+	body->forceActivationState(state.m_activationState);
+	body->setDeactivationTime(state.m_deactivationTime);
+
+	// Keep the motion state in sync for the objects not updated by the next step.
+	if (body->getMotionState()) {
+		body->getMotionState()->setWorldTransform(trans);
+	}
+}
+
 // dyna's that are rigidbody are free in orientation, dyna's with non-rigidbody are restricted
 void CcdPhysicsController::SetRigidBody(bool rigid)
 {
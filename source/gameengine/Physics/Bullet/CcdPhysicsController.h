@@ -727,6 +727,9 @@ public:
 	// dyna's that are rigidbody are free in orientation, dyna's with non-rigidbody are restricted
 	virtual void SetRigidBody(bool rigid);
 
+	virtual bool GetPhysicsState(PHY_PhysicsState& state);
+	virtual void SetPhysicsState(const PHY_PhysicsState& state);
+
 	virtual void RefreshCollisions();
 	virtual void SuspendPhysics(bool freeConstraints);
 	virtual void RestorePhysics();
@@ -21,6 +21,7 @@
 #include "CcdGraphicController.h"
 #include "CcdConstraint.h"
 #include "CcdMathUtils.h"
+#include "CcdParallelDynamics.h"
 
 #include <algorithm>
 #include "btBulletDynamicsCommon.h"
@@ -31,10 +32,6 @@
 #include "BulletSoftBody/btSoftBodyRigidBodyCollisionConfiguration.h"
 #include "BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h"
 #include "BulletCollision/NarrowPhaseCollision/btRaycastCallback.h"
-#include "BulletDynamics/ConstraintSolver/btNNCGConstraintSolver.h"
-#include "BulletDynamics/MLCPSolvers/btMLCPSolver.h"
-#include "BulletDynamics/MLCPSolvers/btDantzigSolver.h"
-#include "BulletDynamics/MLCPSolvers/btLemkeSolver.h"
 #include "BulletDynamics/MLCPSolvers/btPATHSolver.h"
 
 //profiling/timings
@@ -402,6 +399,8 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool use
 	m_linearDeactivationThreshold(0.8f),
 	m_angularDeactivationThreshold(1.0f),
 	m_contactBreakingThreshold(0.02f),
+	m_numCollData(0),
+	m_dynamicsWorld(nullptr),
 	m_solver(nullptr),
 	m_filterCallback(nullptr),
 	m_ghostPairCallback(nullptr),
@@ -411,9 +410,9 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool use
 		m_triggerCallbacks[i] = nullptr;
 	}
 
-	m_collisionConfiguration = new btSoftBodyRigidBodyCollisionConfiguration();
+	m_collisionConfiguration = new CcdCollisionConfiguration();
 
-	btCollisionDispatcher *dispatcher = new btCollisionDispatcher(m_collisionConfiguration);
+	CcdParallelDispatcher *dispatcher = new CcdParallelDispatcher(m_collisionConfiguration);
 	btGImpactCollisionAlgorithm::registerAlgorithm(dispatcher);
 	m_ownDispatcher = dispatcher;
 
@@ -431,7 +430,9 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool use
 
 	SetSolverType(solverType);
 
-	m_dynamicsWorld = new btSoftRigidDynamicsWorld(dispatcher, m_broadphase, m_solver, m_collisionConfiguration);
+	CcdParallelDynamicsWorld *world = new CcdParallelDynamicsWorld(dispatcher, m_broadphase, m_solver, m_collisionConfiguration);
+	world->SetSolverType(m_solverType);
+	m_dynamicsWorld = world;
 	m_dynamicsWorld->setInternalTickCallback(&CcdPhysicsEnvironment::StaticSimulationSubtickCallback, this);
 
 	SetGravity(0.0f, 0.0f, -9.81f);
@@ -440,10 +441,12 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool use
 void CcdPhysicsEnvironment::AddCcdPhysicsController(CcdPhysicsController *ctrl)
 {
 	// the controller is already added we do nothing
-	if (!m_controllers.insert(ctrl).second) {
+	if (!m_controllers.Add(ctrl)) {
 		return;
 	}
 
+	UpdateMovingController(ctrl);
+
 	btRigidBody *body = ctrl->GetRigidBody();
 	btCollisionObject *obj = ctrl->GetCollisionObject();
 
@@ -576,10 +579,12 @@ void CcdPhysicsEnvironment::RestoreConstraint(CcdPhysicsController *ctrl, btType
 bool CcdPhysicsEnvironment::RemoveCcdPhysicsController(CcdPhysicsController *ctrl, bool freeConstraints)
 {
 	// if the physics controller is already removed we do nothing
-	if (!m_controllers.erase(ctrl)) {
+	if (!m_controllers.Remove(ctrl)) {
 		return false;
 	}
 
+	m_movingControllers.Remove(ctrl);
+
 	//also remove constraint
 	btRigidBody *body = ctrl->GetRigidBody();
 	if (body) {
@@ -646,6 +651,21 @@ void CcdPhysicsEnvironment::UpdateCcdPhysicsController(CcdPhysicsController *ctr
 	ctrl->m_cci.m_collisionFilterGroup = newCollisionGroup;
 	ctrl->m_cci.m_collisionFilterMask = newCollisionMask;
 	ctrl->m_cci.m_collisionFlags = newCollisionFlags;
+
+	if (m_controllers.Contains(ctrl)) {
+		UpdateMovingController(ctrl);
+	}
+}
+
+void CcdPhysicsEnvironment::UpdateMovingController(CcdPhysicsController *ctrl)
+{
+	btRigidBody *body = ctrl->GetRigidBody();
+	if (ctrl->GetSoftBody() || (body && !body->isStaticObject())) {
+		m_movingControllers.Add(ctrl);
+	}
+	else {
+		m_movingControllers.Remove(ctrl);
+	}
 }
 
 void CcdPhysicsEnvironment::RefreshCcdPhysicsController(CcdPhysicsController *ctrl)
@@ -661,7 +681,7 @@ void CcdPhysicsEnvironment::RefreshCcdPhysicsController(CcdPhysicsController *ct
 
 bool CcdPhysicsEnvironment::IsActiveCcdPhysicsController(CcdPhysicsController *ctrl)
 {
-	return (m_controllers.find(ctrl) != m_controllers.end());
+	return m_controllers.Contains(ctrl);
 }
 
 void CcdPhysicsEnvironment::AddCcdGraphicController(CcdGraphicController *ctrl)
@@ -721,24 +741,27 @@ void CcdPhysicsEnvironment::StaticSimulationSubtickCallback(btDynamicsWorld *wor
 
 void CcdPhysicsEnvironment::SimulationSubtickCallback(btScalar timeStep)
 {
-	std::set<CcdPhysicsController *>::iterator it;
-
-	for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-		(*it)->SimulationTick(timeStep);
+	// Static controllers don't clamp their velocity.
+	for (CcdPhysicsController *ctrl : m_movingControllers) {
+		ctrl->SimulationTick(timeStep);
 	}
 }
 
 bool CcdPhysicsEnvironment::ProceedDeltaTime(double curTime, float timeStep, float interval)
 {
-	std::set<CcdPhysicsController *>::iterator it;
 	int i;
 
 	// Update Bullet global variables.
 	gDeactivationTime = m_deactivationTime;
 	gContactBreakingThreshold = m_contactBreakingThreshold;
 
-	for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-		(*it)->SynchronizeMotionStates(timeStep);
+	/* Static controllers are never synchronized and the sleeping bodies are skipped
+	 * like in btDiscreteDynamicsWorld::synchronizeMotionStates as they didn't move. */
+	for (CcdPhysicsController *ctrl : m_movingControllers) {
+		btRigidBody *body = ctrl->GetRigidBody();
+		if (!body || body->getActivationState() != ISLAND_SLEEPING) {
+			ctrl->SynchronizeMotionStates(timeStep);
+		}
 	}
 
 	float subStep = timeStep / float(m_numTimeSubSteps);
@@ -748,8 +771,11 @@ bool CcdPhysicsEnvironment::ProceedDeltaTime(double curTime, float timeStep, flo
 
 	ProcessFhSprings(curTime, i * subStep);
 
-	for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-		(*it)->SynchronizeMotionStates(timeStep);
+	for (CcdPhysicsController *ctrl : m_movingControllers) {
+		btRigidBody *body = ctrl->GetRigidBody();
+		if (!body || body->getActivationState() != ISLAND_SLEEPING) {
+			ctrl->SynchronizeMotionStates(timeStep);
+		}
 	}
 
 	for (i = 0; i < m_wrapperVehicles.size(); i++) {
@@ -790,12 +816,10 @@ public:
 
 void CcdPhysicsEnvironment::ProcessFhSprings(double curTime, float interval)
 {
-	std::set<CcdPhysicsController *>::iterator it;
-
 	const float step = interval * KX_GetActiveEngine()->GetTicRate();
 
-	for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-		CcdPhysicsController *ctrl = (*it);
+	// Static and kinematic objects are skipped.
+	for (CcdPhysicsController *ctrl : m_movingControllers) {
 		btRigidBody *body = ctrl->GetRigidBody();
 
 		if (body && (ctrl->GetConstructionInfo().m_do_fh || ctrl->GetConstructionInfo().m_do_rot_fh)) {
@@ -947,9 +971,10 @@ void CcdPhysicsEnvironment::SetDeactivationAngularTreshold(float angTresh)
 	m_angularDeactivationThreshold = angTresh;
 
 	// Update from all controllers.
-	for (std::set<CcdPhysicsController *>::iterator it = m_controllers.begin(); it != m_controllers.end(); it++) {
-		if ((*it)->GetRigidBody())
-			(*it)->GetRigidBody()->setSleepingThresholds(m_linearDeactivationThreshold, m_angularDeactivationThreshold);
+	for (CcdPhysicsController *ctrl : m_controllers) {
+		if (ctrl->GetRigidBody()) {
+			ctrl->GetRigidBody()->setSleepingThresholds(m_linearDeactivationThreshold, m_angularDeactivationThreshold);
+		}
 	}
 }
 
@@ -993,36 +1018,35 @@ void CcdPhysicsEnvironment::SetSolverType(PHY_SolverType solverType)
 		return;
 	}
 
-	switch (solverType)
-	{
-		case PHY_SOLVER_SEQUENTIAL:
-		{
-			m_solver = new btSequentialImpulseConstraintSolver();
-			break;
-		}
-		case PHY_SOLVER_NNCG:
-		{
-			m_solver = new btNNCGConstraintSolver();
-			break;
-		}
-		case PHY_SOLVER_MLCP_DANTZIG:
-		{
-			m_solver = new btMLCPSolver(new btDantzigSolver());
-			break;
-		}
-		case PHY_SOLVER_MLCP_LEMKE:
-		{
-			m_solver = new btMLCPSolver(new btLemkeSolver());
-			break;
-		}
-		default:
-		{
-			BLI_assert(false);
-		}
-	};
+	btConstraintSolver *solver = CcdCreateConstraintSolver(solverType);
+	if (!solver) {
+		return;
+	}
+
+	// Replace the solver of the existing world.
+	if (m_dynamicsWorld) {
+		CcdParallelDynamicsWorld *world = static_cast<CcdParallelDynamicsWorld *>(m_dynamicsWorld);
+		world->setConstraintSolver(solver);
+		world->SetSolverType(solverType);
+		delete m_solver;
+	}
+
+	m_solver = solver;
 	m_solverType = solverType;
 }
 
+void CcdPhysicsEnvironment::SetUseParallelPhysics(bool parallel)
+{
+	TaskScheduler *scheduler = parallel ? KX_GetActiveEngine()->GetTaskScheduler() : nullptr;
+	static_cast<CcdParallelDispatcher *>(m_ownDispatcher)->SetTaskScheduler(scheduler);
+	static_cast<CcdParallelDynamicsWorld *>(m_dynamicsWorld)->SetTaskScheduler(scheduler);
+}
+
+bool CcdPhysicsEnvironment::GetUseParallelPhysics() const
+{
+	return (static_cast<CcdParallelDispatcher *>(m_ownDispatcher)->GetTaskScheduler() != nullptr);
+}
+
 void CcdPhysicsEnvironment::GetGravity(mt::vec3& grav)
 {
 	const btVector3& gravity = m_dynamicsWorld->getGravity();
@@ -1110,6 +1134,54 @@ struct  FilterClosestRayResultCallback : public btCollisionWorld::ClosestRayResu
 	}
 };
 
+/** Broadphase ray test callable from several threads. btDbvtBroadphase::rayTest uses
+ * a stack shared by all the ray tests, the static btDbvt::rayTest uses its own stack.
+ */
+struct ConcurrentRayTester : public btDbvt::ICollide
+{
+	btTransform m_rayFromTrans;
+	btTransform m_rayToTrans;
+	btCollisionWorld::RayResultCallback& m_resultCallback;
+	CM_ThreadSpinLock& m_lock;
+
+	ConcurrentRayTester(const btVector3& rayFrom, const btVector3& rayTo, btCollisionWorld::RayResultCallback& resultCallback,
+			CM_ThreadSpinLock& lock)
+		:m_rayFromTrans(btMatrix3x3::getIdentity(), rayFrom),
+		m_rayToTrans(btMatrix3x3::getIdentity(), rayTo),
+		m_resultCallback(resultCallback),
+		m_lock(lock)
+	{
+	}
+
+	void Process(const btDbvtNode *leaf)
+	{
+		// Same as btSingleRayCallback::process.
+		if (m_resultCallback.m_closestHitFraction == 0.0f) {
+			return;
+		}
+
+		btBroadphaseProxy *proxy = (btBroadphaseProxy *)leaf->data;
+		btCollisionObject *object = (btCollisionObject *)proxy->m_clientObject;
+		if (!m_resultCallback.needsCollision(object->getBroadphaseHandle())) {
+			return;
+		}
+
+		// Soft bodies and gimpact shapes modify their data during a ray test.
+		const bool locked = (object->getInternalType() == btCollisionObject::CO_SOFT_BODY ||
+		                     object->getCollisionShape()->getShapeType() == GIMPACT_SHAPE_PROXYTYPE);
+		if (locked) {
+			m_lock.Lock();
+		}
+
+		btSoftRigidDynamicsWorld::rayTestSingle(m_rayFromTrans, m_rayToTrans, object, object->getCollisionShape(),
+				object->getWorldTransform(), m_resultCallback);
+
+		if (locked) {
+			m_lock.Unlock();
+		}
+	}
+};
+
 static bool GetHitTriangle(btCollisionShape *shape, CcdShapeConstructionInfo *shapeInfo, int hitTriangleIndex, btVector3 triangle[])
 {
 	// this code is copied from Bullet
@@ -1170,7 +1242,15 @@ PHY_IPhysicsController *CcdPhysicsEnvironment::RayTest(PHY_IRayCastFilterCallbac
 	rayCallback.m_flags |= btTriangleRaycastCallback::kF_UseSubSimplexConvexCastRaytest;
 	//, ,filterCallback.m_faceNormal);
 
-	m_dynamicsWorld->rayTest(rayFrom, rayTo, rayCallback);
+	if (filterCallback.m_concurrent) {
+		ConcurrentRayTester tester(rayFrom, rayTo, rayCallback, m_rayTestLock);
+		btDbvtBroadphase *broadphase = static_cast<btDbvtBroadphase *>(m_broadphase);
+		btDbvt::rayTest(broadphase->m_sets[0].m_root, rayFrom, rayTo, tester);
+		btDbvt::rayTest(broadphase->m_sets[1].m_root, rayFrom, rayTo, tester);
+	}
+	else {
+		m_dynamicsWorld->rayTest(rayFrom, rayTo, rayCallback);
+	}
 	if (rayCallback.hasHit()) {
 		CcdPhysicsController *controller = static_cast<CcdPhysicsController *>(rayCallback.m_collisionObject->getUserPointer());
 		result.m_controller = controller;
@@ -1937,11 +2017,8 @@ void CcdPhysicsEnvironment::MergeEnvironment(PHY_IPhysicsEnvironment *other_env)
 		return;
 	}
 
-	std::set<CcdPhysicsController *>::iterator it;
-
-	while (other->m_controllers.begin() != other->m_controllers.end()) {
-		it = other->m_controllers.begin();
-		CcdPhysicsController *ctrl = (*it);
+	while (!other->m_controllers.Empty()) {
+		CcdPhysicsController *ctrl = other->m_controllers.Front();
 
 		other->RemoveCcdPhysicsController(ctrl, true);
 		this->AddCcdPhysicsController(ctrl);
@@ -2065,11 +2142,29 @@ void CcdPhysicsEnvironment::CallbackTriggers()
 			continue;
 		}
 
-		const CcdCollData *coll_data = new CcdCollData(manifold);
+		const CcdCollData *coll_data = NewCollData(manifold);
 		m_triggerCallbacks[PHY_OBJECT_RESPONSE](m_triggerCallbacksUserPtrs[PHY_OBJECT_RESPONSE], ctrl0, ctrl1, coll_data, first);
 	}
 }
 
+const CcdCollData *CcdPhysicsEnvironment::NewCollData(const btPersistentManifold *manifold)
+{
+	if (m_numCollData < m_collDataPool.size()) {
+		CcdCollData& collData = m_collDataPool[m_numCollData++];
+		collData.SetManifold(manifold);
+		return &collData;
+	}
+
+	m_collDataPool.emplace_back(manifold);
+	++m_numCollData;
+	return &m_collDataPool.back();
+}
+
+void CcdPhysicsEnvironment::ReleaseCollisionData()
+{
+	m_numCollData = 0;
+}
+
 PHY_CollisionTestResult CcdPhysicsEnvironment::CheckCollision(PHY_IPhysicsController *ctrl0, PHY_IPhysicsController *ctrl1)
 {
 	PHY_CollisionTestResult result{false, false, nullptr};
@@ -2646,6 +2741,7 @@ CcdPhysicsEnvironment *CcdPhysicsEnvironment::Create(Scene *blenderscene, bool v
 	ccdPhysEnv->SetDeactivationLinearTreshold(blenderscene->gm.lineardeactthreshold);
 	ccdPhysEnv->SetDeactivationAngularTreshold(blenderscene->gm.angulardeactthreshold);
 	ccdPhysEnv->SetDeactivationTime(blenderscene->gm.deactivationtime);
+	ccdPhysEnv->SetUseParallelPhysics((blenderscene->gm.flag & GAME_PARALLEL_PHYSICS) != 0);
 
 	if (visualizePhysics) {
 		ccdPhysEnv->SetDebugMode(btIDebugDraw::DBG_DrawWireframe | btIDebugDraw::DBG_DrawAabb | btIDebugDraw::DBG_DrawContactPoints |
@@ -3228,6 +3324,11 @@ CcdCollData::~CcdCollData()
 {
 }
 
+void CcdCollData::SetManifold(const btPersistentManifold *manifoldPoint)
+{
+	m_manifoldPoint = manifoldPoint;
+}
+
 unsigned int CcdCollData::GetNumContacts() const
 {
 	return m_manifoldPoint->getNumContacts();
@@ -27,7 +27,11 @@
 
 #include "CcdPhysicsController.h"
 
+#include "CM_IndexedSet.h"
+#include "CM_Thread.h"
+
 #include <vector>
+#include <deque>
 #include <set>
 #include <map>
 class CcdGraphicController;
@@ -55,6 +59,27 @@ class CcdShapeConstructionInfo;
 /// Find the id of the closest node to a point in a soft body.
 int Ccd_FindClosestNode(btSoftBody *sb, const btVector3& worldPoint);
 
+/// Collision data reading the contact points of a manifold only when asked.
+class CcdCollData : public PHY_ICollData
+{
+	const btPersistentManifold *m_manifoldPoint;
+public:
+	CcdCollData(const btPersistentManifold *manifoldPoint);
+	virtual ~CcdCollData();
+
+	void SetManifold(const btPersistentManifold *manifoldPoint);
+
+	virtual unsigned int GetNumContacts() const;
+	virtual mt::vec3 GetLocalPointA(unsigned int index, bool first) const;
+	virtual mt::vec3 GetLocalPointB(unsigned int index, bool first) const;
+	virtual mt::vec3 GetWorldPoint(unsigned int index, bool first) const;
+	virtual mt::vec3 GetNormal(unsigned int index, bool first) const;
+	virtual float GetCombinedFriction(unsigned int index, bool first) const;
+	virtual float GetCombinedRollingFriction(unsigned int index, bool first) const;
+	virtual float GetCombinedRestitution(unsigned int index, bool first) const;
+	virtual float GetAppliedImpulse(unsigned int index, bool first) const;
+};
+
 /** CcdPhysicsEnvironment is an experimental mainloop for physics simulation using optional continuous collision detection.
  * Physics Environment takes care of stepping the simulation and is a container for physics entities.
  * It stores rigidbodies,constraints, materials etc.
@@ -130,6 +155,8 @@ public:
 	virtual void SetSolverDamping(float damping);
 	virtual void SetLinearAirDamping(float damping);
 	virtual void SetUseEpa(bool epa);
+	virtual void SetUseParallelPhysics(bool parallel);
+	virtual bool GetUseParallelPhysics() const;
 
 	virtual int GetNumTimeSubSteps()
 	{
@@ -198,6 +225,7 @@ public:
 	virtual bool RequestCollisionCallback(PHY_IPhysicsController *ctrl);
 	virtual bool RemoveCollisionCallback(PHY_IPhysicsController *ctrl);
 	virtual PHY_CollisionTestResult CheckCollision(PHY_IPhysicsController *ctrl0, PHY_IPhysicsController *ctrl1);
+	virtual void ReleaseCollisionData();
 	//These two methods are used *solely* to create controllers for Near/Radar sensor! Don't use for anything else
 	virtual PHY_IPhysicsController *CreateSphereController(float radius, const mt::vec3& position);
 	virtual PHY_IPhysicsController *CreateConeController(float coneradius, float coneheight);
@@ -269,11 +297,32 @@ public:
 	                                    bRigidBodyJointConstraint *dat);
 
 protected:
-	std::set<CcdPhysicsController *> m_controllers;
+	CM_IndexedSet<CcdPhysicsController *> m_controllers;
+	/** Controllers of soft bodies and non static rigid bodies, the only ones needing
+	 * a motion state synchronization at each physics step.
+	 */
+	CM_IndexedSet<CcdPhysicsController *> m_movingControllers;
+
+	/// Add or remove a controller from m_movingControllers depending on its collision flags.
+	void UpdateMovingController(CcdPhysicsController *ctrl);
 
 	PHY_ResponseCallback m_triggerCallbacks[PHY_NUM_RESPONSE];
 	void *m_triggerCallbacksUserPtrs[PHY_NUM_RESPONSE];
 
+	/** Collision data of the PHY_OBJECT_RESPONSE callbacks, the items are reused after
+	 * ReleaseCollisionData instead of allocating new ones at each physics step.
+	 * A deque is used to not move the items already given when growing.
+	 */
+	std::deque<CcdCollData> m_collDataPool;
+	/// Number of items of m_collDataPool used since the last ReleaseCollisionData.
+	unsigned int m_numCollData;
+
+	/// Return a collision data from the pool for the manifold.
+	const CcdCollData *NewCollData(const btPersistentManifold *manifold);
+
+	/// Serialize the concurrent ray tests against soft bodies and gimpact shapes.
+	CM_ThreadSpinLock m_rayTestLock;
+
 	std::vector<WrapperVehicle *>    m_wrapperVehicles;
 
 	/** use explicit btSoftRigidDynamicsWorld/btDiscreteDynamicsWorld* so that we have access to
@@ -283,6 +332,7 @@ protected:
 	 * Ideally we would like to have access to this function from the btDynamicsWorld interface
 	 */
 	// class btDynamicsWorld *m_dynamicsWorld;
+	/// Actually a CcdParallelDynamicsWorld.
 	class btSoftRigidDynamicsWorld *m_dynamicsWorld;
 
 	class btConstraintSolver *m_solver;
@@ -291,27 +341,10 @@ protected:
 
 	class btGhostPairCallback *m_ghostPairCallback;
 
+	/// Actually a CcdParallelDispatcher.
 	class btDispatcher *m_ownDispatcher;
 
 	virtual void ExportFile(const std::string& filename);
 };
 
-class CcdCollData : public PHY_ICollData
-{
-	const btPersistentManifold *m_manifoldPoint;
-public:
-	CcdCollData(const btPersistentManifold *manifoldPoint);
-	virtual ~CcdCollData();
-
-	virtual unsigned int GetNumContacts() const;
-	virtual mt::vec3 GetLocalPointA(unsigned int index, bool first) const;
-	virtual mt::vec3 GetLocalPointB(unsigned int index, bool first) const;
-	virtual mt::vec3 GetWorldPoint(unsigned int index, bool first) const;
-	virtual mt::vec3 GetNormal(unsigned int index, bool first) const;
-	virtual float GetCombinedFriction(unsigned int index, bool first) const;
-	virtual float GetCombinedRollingFriction(unsigned int index, bool first) const;
-	virtual float GetCombinedRestitution(unsigned int index, bool first) const;
-	virtual float GetAppliedImpulse(unsigned int index, bool first) const;
-};
-
 #endif  /* __CCDPHYSICSENVIRONMENT_H__ */
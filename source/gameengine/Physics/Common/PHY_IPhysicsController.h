@@ -42,6 +42,20 @@ class PHY_IPhysicsEnvironment;
 class KX_GameObject;
 class RAS_Mesh;
 
+/// Dynamic state of a rigid body, saved in the scene snapshots.
+struct PHY_PhysicsState
+{
+	/// World and interpolation transforms, rows of the basis followed by the origin.
+	float m_transform[12];
+	float m_interpolationTransform[12];
+	float m_linearVelocity[3];
+	float m_angularVelocity[3];
+	float m_interpolationLinearVelocity[3];
+	float m_interpolationAngularVelocity[3];
+	int m_activationState;
+	float m_deactivationTime;
+};
+
 /**
  * PHY_IPhysicsController is the abstract simplified Interface to a physical object.
  * It contains the IMotionState and IDeformableMesh Interfaces.
@@ -117,6 +131,11 @@ public:
 	// dyna's that are rigidbody are free in orientation, dyna's with non-rigidbody are restricted
 	virtual void SetRigidBody(bool rigid) = 0;
 
+	/// Get the dynamic state of a rigid body, return false for the other objects.
+	virtual bool GetPhysicsState(PHY_PhysicsState& state) = 0;
+	/// Restore exactly a dynamic state returned by GetPhysicsState, the forces are cleared.
+	virtual void SetPhysicsState(const PHY_PhysicsState& state) = 0;
+
 	virtual PHY_IPhysicsController *GetReplica()
 	{
 		return nullptr;
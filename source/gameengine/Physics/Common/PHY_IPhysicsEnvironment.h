@@ -85,6 +85,8 @@ public:
 	PHY_IPhysicsController *m_ignoreController;
 	bool m_faceNormal;
 	bool m_faceUV;
+	/// The ray test can be called from several threads at the same time.
+	bool m_concurrent;
 
 	virtual ~PHY_IRayCastFilterCallback()
 	{
@@ -100,7 +102,8 @@ public:
 	PHY_IRayCastFilterCallback(PHY_IPhysicsController *ignoreController, bool faceNormal = false, bool faceUV = false)
 		: m_ignoreController(ignoreController),
 		m_faceNormal(faceNormal),
-		m_faceUV(faceUV)
+		m_faceUV(faceUV),
+		m_concurrent(false)
 	{
 	}
 };
@@ -188,6 +191,14 @@ public:
 	virtual void SetUseEpa(bool epa)
 	{
 	}
+	/// Process the narrowphase and the constraint solver in parallel tasks.
+	virtual void SetUseParallelPhysics(bool parallel)
+	{
+	}
+	virtual bool GetUseParallelPhysics() const
+	{
+		return false;
+	}
 
 	virtual void SetGravity(float x, float y, float z) = 0;
 	virtual void GetGravity(mt::vec3& grav) = 0;
@@ -224,6 +235,12 @@ public:
 	virtual bool RequestCollisionCallback(PHY_IPhysicsController *ctrl) = 0;
 	virtual bool RemoveCollisionCallback(PHY_IPhysicsController *ctrl) = 0;
 	virtual PHY_CollisionTestResult CheckCollision(PHY_IPhysicsController *ctrl0, PHY_IPhysicsController *ctrl1) = 0;
+	/** Reuse the collision data passed to the PHY_OBJECT_RESPONSE callback for the next physics step,
+	 * called once the collisions are dispatched.
+	 */
+	virtual void ReleaseCollisionData()
+	{
+	}
 	//These two methods are *solely* used to create controllers for sensor! Don't use for anything else
 	virtual PHY_IPhysicsController *CreateSphereController(float radius, const mt::vec3& position) = 0;
 	virtual PHY_IPhysicsController *CreateConeController(float coneradius, float coneheight) = 0;
@@ -80,24 +80,23 @@ public:
 		const unsigned int vertexcount = iarray->GetVertexCount();
 		const unsigned int indexcount = iarray->GetPrimitiveIndexCount();
 
-		const unsigned int startvertex = m_vertexes.size();
-		const unsigned int startindex = m_primitiveIndices.size();
-
-		// Add the part info.
-		Part part;
-		part.m_startVertex = startvertex;
-		part.m_vertexCount = vertexcount;
-		part.m_startIndex = startindex;
-		part.m_indexCount = indexcount;
-		part.m_indexOffset = (void *)(part.m_startIndex * sizeof(unsigned int));
-		m_parts.push_back(part);
-
-		// Pre-allocate vertex list and index list.
-		m_vertexes.resize(startvertex + vertexcount);
-		m_primitiveIndices.resize(startindex + indexcount);
+		// Allocate the part info and its chunks.
+		const unsigned int partIndex = AllocatePart(vertexcount, indexcount);
+		const Part& part = m_parts[partIndex];
+		const unsigned int startvertex = part.m_startVertex;
+		const unsigned int startindex = part.m_startIndex;
+
+		// Grow the vertex list and index list to the allocated chunks.
+		const unsigned int vertexCapacity = m_vertexChunks.GetNumChunks() * ChunkSize;
+		const unsigned int indexCapacity = m_indexChunks.GetNumChunks() * ChunkSize;
+		const bool resized = (m_vertexes.size() != vertexCapacity || m_primitiveIndices.size() != indexCapacity);
+		if (resized) {
+			m_vertexes.resize(vertexCapacity);
+			m_primitiveIndices.resize(indexCapacity);
+		}
 
 #if 0
-		CM_Debug("Add part : " << (m_parts.size() - 1) << ", start index: " << startindex << ", index count: " << indexcount << ", start vertex: " << startvertex << ", vertex count: " << vertexcount);
+		CM_Debug("Add part : " << partIndex << ", start index: " << startindex << ", index count: " << indexcount << ", start vertex: " << startvertex << ", vertex count: " << vertexcount);
 #endif  // DEBUG
 
 		// Normal and tangent matrix.
@@ -119,60 +118,21 @@ public:
 			m_primitiveIndices[startindex + i] = (array->m_primitiveIndices[i] + startvertex);
 		}
 
-		// Update the cache to avoid accessing dangling vertex pointer from GetVertex().
-		UpdateCache();
-		// Request storage update.
-		NotifyUpdate(SIZE_MODIFIED);
-
-		return (m_parts.size() - 1);
-	}
-
-	virtual void Split(unsigned int partIndex)
-	{
-		const Part &part = m_parts[partIndex];
-
-		const unsigned int startindex = part.m_startIndex;
-		const unsigned int startvertex = part.m_startVertex;
-
-		const unsigned int indexcount = part.m_indexCount;
-		const unsigned int vertexcount = part.m_vertexCount;
-
-		const unsigned int endvertex = startvertex + vertexcount;
-
-#ifdef DEBUG
-		CM_Debug("Move indices from " << startindex << " to " << m_primitiveIndices.size() - indexcount << ", shift of " << indexcount);
-#endif  // DEBUG
-
-		// Move the indices after the part to remove before of vertexcount places.
-		for (unsigned int i = startindex, size = m_primitiveIndices.size() - indexcount; i < size; ++i) {
-			m_primitiveIndices[i] = m_primitiveIndices[i + indexcount] - vertexcount;
+		if (resized) {
+			// Update the cache to avoid accessing dangling vertex pointer from GetVertex().
+			UpdateCache();
+			// Request storage update, the whole arrays are uploaded.
+			ClearModifiedRanges();
+			NotifyUpdate(SIZE_MODIFIED);
 		}
-
-		// Erase the end of the index.
-		m_primitiveIndices.erase(m_primitiveIndices.end() - indexcount, m_primitiveIndices.end());
-
-#ifdef DEBUG
-		CM_Debug("Remove vertexes : start vertex: " << startvertex << ", end vertex: " << endvertex);
-#endif  // DEBUG
-
-		// Erase vertex of the part to remove.
-		m_vertexes.erase(m_vertexes.begin() + startvertex, m_vertexes.begin() + endvertex);
-
-		// Reduce start vertex and start index of the part after the removed part.
-		for (unsigned i = partIndex + 1, size = m_parts.size(); i < size; ++i) {
-			Part& nextPart = m_parts[i];
-			nextPart.m_startVertex -= vertexcount;
-			nextPart.m_startIndex -= indexcount;
-			nextPart.m_indexOffset = (void *)(nextPart.m_startIndex * sizeof(unsigned int));
+		else {
+			// Request the upload of the part only.
+			AddModifiedRange(m_modifiedVertexes, startvertex, vertexcount);
+			AddModifiedRange(m_modifiedIndices, startindex, indexcount);
+			NotifyUpdate(RANGE_MODIFIED);
 		}
 
-		// Remove the part info.
-		m_parts.erase(m_parts.begin() + partIndex);
-
-		// Update the cache to avoid accessing dangling vertex pointer from GetVertex().
-		UpdateCache();
-		// Request storage update.
-		NotifyUpdate(SIZE_MODIFIED);
+		return partIndex;
 	}
 };
 
@@ -90,7 +90,6 @@ bool RAS_BatchGroup::MergeMeshSlot(RAS_BatchGroup::Batch& batch, RAS_MeshSlot *s
 
 	// Store original display array bucket.
 	batch.m_originalDisplayArrayBucketList[slot] = origArrayBucket;
-	batch.m_meshSlots.push_back(slot);
 
 	// Merge display array.
 	const unsigned int index = array->Merge(origArray, mat);
@@ -114,28 +113,21 @@ bool RAS_BatchGroup::SplitMeshSlot(RAS_MeshSlot *slot)
 
 	Batch& batch = bit->second;
 
-	RAS_DisplayArrayBucket *origArrayBucket = batch.m_originalDisplayArrayBucketList[slot];
-
-	if (!origArrayBucket) {
+	std::map<RAS_MeshSlot *, RAS_DisplayArrayBucket *>::iterator it = batch.m_originalDisplayArrayBucketList.find(slot);
+	if (it == batch.m_originalDisplayArrayBucketList.end()) {
 		CM_Error("could not restore mesh");
 		return false;
 	}
 
-	slot->SetDisplayArrayBucket(origArrayBucket);
+	slot->SetDisplayArrayBucket(it->second);
 
+	// The other parts keep their index, no mesh slot is renumbered.
 	batch.m_displayArray->Split(slot->m_batchPartIndex);
 
-	batch.m_originalDisplayArrayBucketList.erase(slot);
+	batch.m_originalDisplayArrayBucketList.erase(it);
 
 	slot->m_batchPartIndex = -1;
 
-	// One part is removed and then all the part after must use an index smaller of one.
-	RAS_MeshSlotList::iterator mit = batch.m_meshSlots.erase(std::find(batch.m_meshSlots.begin(), batch.m_meshSlots.end(), slot));
-	for (RAS_MeshSlotList::iterator it = mit, end = batch.m_meshSlots.end(); it != end; ++it) {
-		RAS_MeshSlot *meshSlot = *it;
-		--meshSlot->m_batchPartIndex;
-	}
-
 	return true;
 }
 
@@ -190,8 +182,9 @@ void RAS_BatchGroup::Destruct()
 
 	for (auto& pair : m_batchs) {
 		Batch& batch = pair.second;
-		for (RAS_MeshSlot *slot : batch.m_meshSlots) {
-			RAS_DisplayArrayBucket *origArrayBucket = batch.m_originalDisplayArrayBucketList[slot];
+		for (const auto& slotPair : batch.m_originalDisplayArrayBucketList) {
+			RAS_MeshSlot *slot = slotPair.first;
+			RAS_DisplayArrayBucket *origArrayBucket = slotPair.second;
 
 			slot->SetDisplayArrayBucket(origArrayBucket);
 
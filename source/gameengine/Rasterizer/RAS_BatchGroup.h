@@ -51,8 +51,6 @@ private:
 
 		/// The original display array bucket per mesh slots.
 		std::map<RAS_MeshSlot *, RAS_DisplayArrayBucket *> m_originalDisplayArrayBucketList;
-		/// All the mesh slots sorted by batch index.
-		RAS_MeshSlotList m_meshSlots;
 	};
 
 	/// The batch per material.
@@ -153,6 +153,22 @@ void RAS_DisplayArrayBucket::UpdateActiveMeshSlots(RAS_Rasterizer::DrawType draw
 				m_arrayStorage->UpdateVertexData();
 			}
 
+			if (modifiedFlag & RAS_IDisplayArray::RANGE_MODIFIED) {
+				RAS_IBatchDisplayArray *batchArray = dynamic_cast<RAS_IBatchDisplayArray *>(m_displayArray);
+				// The ranges are already uploaded when the whole storage is updated.
+				if (!(modifiedFlag & (RAS_IDisplayArray::STORAGE_INVALID | RAS_IDisplayArray::SIZE_MODIFIED))) {
+					const RAS_IBatchDisplayArray::Range& vertexRange = batchArray->GetModifiedVertexRange();
+					const RAS_IBatchDisplayArray::Range& indexRange = batchArray->GetModifiedIndexRange();
+					if (vertexRange.m_end > vertexRange.m_start) {
+						m_arrayStorage->UpdateVertexRange(vertexRange.m_start, vertexRange.m_end - vertexRange.m_start);
+					}
+					if (indexRange.m_end > indexRange.m_start) {
+						m_arrayStorage->UpdateIndexRange(indexRange.m_start, indexRange.m_end - indexRange.m_start);
+					}
+				}
+				batchArray->ClearModifiedRanges();
+			}
+
 			if (modifiedFlag & RAS_IDisplayArray::POSITION_MODIFIED) {
 				// Reset polygons center cache to ask update.
 				m_displayArray->InvalidatePolygonCenters();
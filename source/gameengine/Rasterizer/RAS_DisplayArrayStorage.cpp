@@ -29,6 +29,16 @@ void RAS_DisplayArrayStorage::UpdateSize()
 	m_vbo->UpdateSize();
 }
 
+void RAS_DisplayArrayStorage::UpdateVertexRange(unsigned int start, unsigned int count)
+{
+	m_vbo->UpdateVertexRange(start, count);
+}
+
+void RAS_DisplayArrayStorage::UpdateIndexRange(unsigned int start, unsigned int count)
+{
+	m_vbo->UpdateIndexRange(start, count);
+}
+
 unsigned int *RAS_DisplayArrayStorage::GetIndexMap()
 {
 	return m_vbo->GetIndexMap();
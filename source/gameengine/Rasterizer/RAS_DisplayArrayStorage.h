@@ -26,6 +26,10 @@ public:
 
 	void UpdateVertexData();
 	void UpdateSize();
+	/// Upload a range of vertices, the size of the array must be unchanged.
+	void UpdateVertexRange(unsigned int start, unsigned int count);
+	/// Upload a range of indices, the size of the array must be unchanged.
+	void UpdateIndexRange(unsigned int start, unsigned int count);
 	/// Map the index data and return its pointer.
 	unsigned int *GetIndexMap();
 	/// Flush the index data map.
@@ -28,9 +28,91 @@
 
 #include "CM_Template.h"
 
+#include <algorithm>
+
+RAS_IBatchDisplayArray::ChunkAllocator::ChunkAllocator()
+	:m_numChunks(0)
+{
+}
+
+unsigned int RAS_IBatchDisplayArray::ChunkAllocator::Allocate(unsigned int count)
+{
+	if (count == 0) {
+		return 0;
+	}
+
+	// First fit in the free ranges.
+	for (std::vector<FreeRange>::iterator it = m_freeRanges.begin(), end = m_freeRanges.end(); it != end; ++it) {
+		FreeRange& range = *it;
+		if (range.m_count >= count) {
+			const unsigned int start = range.m_start;
+			range.m_start += count;
+			range.m_count -= count;
+			if (range.m_count == 0) {
+				m_freeRanges.erase(it);
+			}
+			return start;
+		}
+	}
+
+	/* Grow the number of chunks, the last free range is extended if it ends
+	 * with the last chunk. The new chunks not used are freed for the next allocations. */
+	unsigned int start = m_numChunks;
+	if (!m_freeRanges.empty()) {
+		const FreeRange& last = m_freeRanges.back();
+		if ((last.m_start + last.m_count) == m_numChunks) {
+			start = last.m_start;
+			m_freeRanges.pop_back();
+		}
+	}
+
+	const unsigned int numChunks = std::max(start + count, m_numChunks * 2);
+	if (numChunks > (start + count)) {
+		m_freeRanges.push_back({start + count, numChunks - start - count});
+	}
+	m_numChunks = numChunks;
+
+	return start;
+}
+
+void RAS_IBatchDisplayArray::ChunkAllocator::Free(unsigned int start, unsigned int count)
+{
+	if (count == 0) {
+		return;
+	}
+
+	std::vector<FreeRange>::iterator it = std::lower_bound(m_freeRanges.begin(), m_freeRanges.end(), start,
+			[](const FreeRange& range, unsigned int start) { return range.m_start < start; });
+
+	// Merge with the next range.
+	if (it != m_freeRanges.end() && (start + count) == it->m_start) {
+		it->m_start = start;
+		it->m_count += count;
+	}
+	else {
+		it = m_freeRanges.insert(it, {start, count});
+	}
+
+	// Merge with the previous range.
+	if (it != m_freeRanges.begin()) {
+		std::vector<FreeRange>::iterator prev = it - 1;
+		if ((prev->m_start + prev->m_count) == it->m_start) {
+			prev->m_count += it->m_count;
+			m_freeRanges.erase(it);
+		}
+	}
+}
+
+unsigned int RAS_IBatchDisplayArray::ChunkAllocator::GetNumChunks() const
+{
+	return m_numChunks;
+}
+
 RAS_IBatchDisplayArray::RAS_IBatchDisplayArray(PrimitiveType type, const RAS_VertexFormat &format,
 		const RAS_VertexDataMemoryFormat& memoryFormat)
-	:RAS_IDisplayArray(type, format, memoryFormat)
+	:RAS_IDisplayArray(type, format, memoryFormat),
+	m_modifiedVertexes({0, 0}),
+	m_modifiedIndices({0, 0})
 {
 }
 
@@ -43,6 +125,69 @@ RAS_IBatchDisplayArray *RAS_IBatchDisplayArray::ConstructArray(RAS_IDisplayArray
 	return CM_InstantiateTemplateSwitch<RAS_IBatchDisplayArray, RAS_BatchDisplayArray, RAS_VertexFormatTuple>(format, type, format);
 }
 
+unsigned int RAS_IBatchDisplayArray::AllocatePart(unsigned int vertexCount, unsigned int indexCount)
+{
+	Part part;
+	part.m_startVertex = m_vertexChunks.Allocate((vertexCount + ChunkSize - 1) / ChunkSize) * ChunkSize;
+	part.m_vertexCount = vertexCount;
+	part.m_startIndex = m_indexChunks.Allocate((indexCount + ChunkSize - 1) / ChunkSize) * ChunkSize;
+	part.m_indexCount = indexCount;
+	part.m_indexOffset = (void *)(part.m_startIndex * sizeof(unsigned int));
+
+	if (m_freeParts.empty()) {
+		m_parts.push_back(part);
+		return (m_parts.size() - 1);
+	}
+
+	const unsigned int partIndex = m_freeParts.back();
+	m_freeParts.pop_back();
+	m_parts[partIndex] = part;
+
+	return partIndex;
+}
+
+void RAS_IBatchDisplayArray::AddModifiedRange(Range& range, unsigned int start, unsigned int count)
+{
+	if (range.m_start == range.m_end) {
+		range = {start, start + count};
+	}
+	else {
+		range.m_start = std::min(range.m_start, start);
+		range.m_end = std::max(range.m_end, start + count);
+	}
+}
+
+void RAS_IBatchDisplayArray::Split(unsigned int partIndex)
+{
+	Part& part = m_parts[partIndex];
+
+	/* The vertices and indices are left in the arrays, they are not drawn
+	 * anymore and will be overwritten by the next part using the chunks. */
+	m_vertexChunks.Free(part.m_startVertex / ChunkSize, (part.m_vertexCount + ChunkSize - 1) / ChunkSize);
+	m_indexChunks.Free(part.m_startIndex / ChunkSize, (part.m_indexCount + ChunkSize - 1) / ChunkSize);
+
+	part.m_vertexCount = 0;
+	part.m_indexCount = 0;
+
+	m_freeParts.push_back(partIndex);
+}
+
+const RAS_IBatchDisplayArray::Range& RAS_IBatchDisplayArray::GetModifiedVertexRange() const
+{
+	return m_modifiedVertexes;
+}
+
+const RAS_IBatchDisplayArray::Range& RAS_IBatchDisplayArray::GetModifiedIndexRange() const
+{
+	return m_modifiedIndices;
+}
+
+void RAS_IBatchDisplayArray::ClearModifiedRanges()
+{
+	m_modifiedVertexes = {0, 0};
+	m_modifiedIndices = {0, 0};
+}
+
 RAS_IDisplayArray::Type RAS_IBatchDisplayArray::GetType() const
 {
 	return BATCHING;
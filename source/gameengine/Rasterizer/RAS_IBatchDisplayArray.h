@@ -29,8 +29,25 @@
 
 #include "RAS_IDisplayArray.h"
 
+/** Display array merging the display arrays of several mesh slots in parts.
+ * The vertices and indices of the parts are allocated by fixed size chunks in
+ * the arrays, a removed part frees its chunks for the next merged parts and keeps
+ * its index for the next part too. Merging or splitting a part then never moves
+ * the other parts and only the modified ranges of the arrays are uploaded.
+ */
 class RAS_IBatchDisplayArray : public virtual RAS_IDisplayArray
 {
+public:
+	/// Number of vertices or indices in an allocation chunk.
+	static const unsigned int ChunkSize = 64;
+
+	/// Range of vertices or indices, empty when start equals end.
+	struct Range
+	{
+		unsigned int m_start;
+		unsigned int m_end;
+	};
+
 protected:
 	/// This struct is dedicated to store all the info of a part.
 	struct Part
@@ -45,8 +62,52 @@ protected:
 		unsigned int m_indexCount;
 	};
 
+	/// Allocator of contiguous chunks, using a list of free chunk ranges.
+	class ChunkAllocator
+	{
+	private:
+		struct FreeRange
+		{
+			unsigned int m_start;
+			unsigned int m_count;
+		};
+
+		/// Free ranges sorted by start chunk, the adjacent ranges are merged.
+		std::vector<FreeRange> m_freeRanges;
+		/// Number of chunks, used or free.
+		unsigned int m_numChunks;
+
+	public:
+		ChunkAllocator();
+
+		/** Allocate contiguous chunks, the number of chunks grows geometrically
+		 * when no free range is big enough.
+		 * \return The first chunk allocated.
+		 */
+		unsigned int Allocate(unsigned int count);
+		void Free(unsigned int start, unsigned int count);
+
+		unsigned int GetNumChunks() const;
+	};
+
 	/// The part's info.
 	std::vector<Part> m_parts;
+	/// The index of the removed parts, reused by the next merged parts.
+	std::vector<unsigned int> m_freeParts;
+
+	ChunkAllocator m_vertexChunks;
+	ChunkAllocator m_indexChunks;
+
+	/// Vertices and indices modified since the last storage update.
+	Range m_modifiedVertexes;
+	Range m_modifiedIndices;
+
+	/** Allocate the vertices and indices of a new part.
+	 * \return The index of the part.
+	 */
+	unsigned int AllocatePart(unsigned int vertexCount, unsigned int indexCount);
+	/// Extend a modified range to include the given range.
+	static void AddModifiedRange(Range& range, unsigned int start, unsigned int count);
 
 public:
 	RAS_IBatchDisplayArray(PrimitiveType type, const RAS_VertexFormat &format,
@@ -76,10 +137,17 @@ public:
 	 */
 	virtual unsigned int Merge(RAS_IDisplayArray *iarray, const mt::mat4& mat) = 0;
 
-	/** Split a part.
+	/** Split a part, its chunks are freed without moving the other parts.
 	 * \param partIndex The index of the part to remove.
 	 */
-	virtual void Split(unsigned int partIndex) = 0;
+	void Split(unsigned int partIndex);
+
+	/// Return the vertices modified since the last call of ClearModifiedRanges.
+	const Range& GetModifiedVertexRange() const;
+	/// Return the indices modified since the last call of ClearModifiedRanges.
+	const Range& GetModifiedIndexRange() const;
+	/// Clear the modified ranges once uploaded to the storage.
+	void ClearModifiedRanges();
 
 	virtual Type GetType() const;
 };
@@ -60,10 +60,11 @@ public:
 		TANGENT_MODIFIED = 1 << 4, // Vertex tangent modified.
 		SIZE_MODIFIED = 1 << 5, // Vertex and index array changed of size.
 		STORAGE_INVALID = 1 << 6, // Storage not yet created.
+		RANGE_MODIFIED = 1 << 7, // Vertex and index ranges of a batch modified.
 		AABB_MODIFIED = POSITION_MODIFIED,
 		MESH_MODIFIED = POSITION_MODIFIED | NORMAL_MODIFIED | UVS_MODIFIED |
 						COLORS_MODIFIED | TANGENT_MODIFIED,
-		ANY_MODIFIED = MESH_MODIFIED | SIZE_MODIFIED | STORAGE_INVALID
+		ANY_MODIFIED = MESH_MODIFIED | SIZE_MODIFIED | STORAGE_INVALID | RANGE_MODIFIED
 	};
 
 protected:
@@ -152,6 +152,11 @@ bool RAS_OpenGLLight::ApplyFixedFunctionLighting(KX_Scene *kxscene, int oblayer,
 
 GPULamp *RAS_OpenGLLight::GetGPULamp()
 {
+	// No GPU data without rasterizer.
+	if (!m_rasterizer) {
+		return nullptr;
+	}
+
 	KX_LightObject *kxlight = (KX_LightObject *)m_light;
 
 	KX_GameObject *groupObj = kxlight->GetDupliGroupObject();
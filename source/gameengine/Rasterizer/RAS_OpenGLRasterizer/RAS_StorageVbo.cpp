@@ -86,6 +86,22 @@ void RAS_StorageVbo::UpdateSize()
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
+void RAS_StorageVbo::UpdateVertexRange(unsigned int start, unsigned int count)
+{
+	const unsigned char *data = (const unsigned char *)m_array->GetVertexPointer();
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+	glBufferSubData(GL_ARRAY_BUFFER, start * m_stride, count * m_stride, data + start * m_stride);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void RAS_StorageVbo::UpdateIndexRange(unsigned int start, unsigned int count)
+{
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
+	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, start * sizeof(GLuint), count * sizeof(GLuint), m_array->GetPrimitiveIndexPointer() + start);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
 unsigned int *RAS_StorageVbo::GetIndexMap()
 {
 	void *buffer = glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, m_indices * sizeof(GLuint), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
@@ -57,6 +57,8 @@ public:
 
 	void UpdateVertexData();
 	void UpdateSize();
+	void UpdateVertexRange(unsigned int start, unsigned int count);
+	void UpdateIndexRange(unsigned int start, unsigned int count);
 	unsigned int *GetIndexMap();
 	void FlushIndexMap();
 
@@ -1,7 +1,15 @@
 #include "SG_CullingNode.h"
 
 SG_CullingNode::SG_CullingNode()
-	:m_culled(true)
+	:m_culled(true),
+	m_aabbModified(true)
+{
+}
+
+SG_CullingNode::SG_CullingNode(const SG_CullingNode& other)
+	:m_aabb(other.m_aabb),
+	m_culled(other.m_culled),
+	m_aabbModified(true)
 {
 }
 
@@ -15,6 +23,39 @@ const SG_BBox& SG_CullingNode::GetAabb() const
 	return m_aabb;
 }
 
+void SG_CullingNode::SetAabb(const mt::vec3& min, const mt::vec3& max)
+{
+	m_aabb.Set(min, max);
+	m_aabbModified = true;
+}
+
+bool SG_CullingNode::GetAabbModified() const
+{
+	return m_aabbModified;
+}
+
+void SG_CullingNode::UpdateWorldBox(const mt::mat3x4& trans)
+{
+	const mt::vec3 halfExtents = (m_aabb.GetMax() - m_aabb.GetMin()) * 0.5f;
+
+	m_worldCenter = trans * m_aabb.GetCenter();
+	for (unsigned short i = 0; i < 3; ++i) {
+		m_worldAxes[i] = trans.GetColumn(i) * halfExtents[i];
+	}
+
+	m_aabbModified = false;
+}
+
+const mt::vec3& SG_CullingNode::GetWorldCenter() const
+{
+	return m_worldCenter;
+}
+
+const mt::vec3& SG_CullingNode::GetWorldAxis(unsigned short axis) const
+{
+	return m_worldAxes[axis];
+}
+
 bool SG_CullingNode::GetCulled() const
 {
 	return m_culled;
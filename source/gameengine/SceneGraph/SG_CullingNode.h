@@ -14,12 +14,31 @@ private:
 	/// The culling state from the last culling pass.
 	bool m_culled;
 
+	/// Center of the bounding box in world space.
+	mt::vec3 m_worldCenter;
+	/// Half axes of the bounding box in world space, the box is oriented and can be sheared.
+	mt::vec3 m_worldAxes[3];
+	/// True when the bounding box changed since the last world box update.
+	bool m_aabbModified;
+
 public:
 	SG_CullingNode();
+	/// The copy needs a world box update as the node transform will be different.
+	SG_CullingNode(const SG_CullingNode& other);
 	~SG_CullingNode() = default;
 
 	SG_BBox& GetAabb();
 	const SG_BBox& GetAabb() const;
+	/// Set the bounding box and request an update of the world box.
+	void SetAabb(const mt::vec3& min, const mt::vec3& max);
+
+	bool GetAabbModified() const;
+	/** Compute the world box from the bounding box and the node transform.
+	 * \param trans The world transform of the scene graph node.
+	 */
+	void UpdateWorldBox(const mt::mat3x4& trans);
+	const mt::vec3& GetWorldCenter() const;
+	const mt::vec3& GetWorldAxis(unsigned short axis) const;
 
 	bool GetCulled() const;
 	void SetCulled(bool culled);
@@ -247,6 +247,23 @@ void SG_Node::UpdateWorldDataThread(bool parentUpdated)
 	famillyMutex.Unlock();
 }
 
+void SG_Node::UpdateScheduledWorldDataThread(std::vector<SG_Node *>& updatedNodes)
+{
+	scheduleMutex.Lock();
+	// The node is removed from the scheduled list once updated.
+	const bool scheduled = !Empty();
+	scheduleMutex.Unlock();
+
+	if (scheduled) {
+		CM_ThreadSpinLock& famillyMutex = m_familly->GetMutex();
+		famillyMutex.Lock();
+
+		UpdateWorldDataThreadDeferred(false, updatedNodes);
+
+		famillyMutex.Unlock();
+	}
+}
+
 void SG_Node::UpdateWorldDataThreadSchedule(bool parentUpdated)
 {
 	UpdateSpatialData(m_SGparent, parentUpdated);
@@ -264,6 +281,23 @@ void SG_Node::UpdateWorldDataThreadSchedule(bool parentUpdated)
 	}
 }
 
+void SG_Node::UpdateWorldDataThreadDeferred(bool parentUpdated, std::vector<SG_Node *>& updatedNodes)
+{
+	UpdateSpatialData(m_SGparent, parentUpdated);
+
+	updatedNodes.push_back(this);
+
+	scheduleMutex.Lock();
+	// The node is updated, remove it from the update list
+	Delink();
+	scheduleMutex.Unlock();
+
+	// update children's worlddata
+	for (SG_Node *childnode : m_children) {
+		childnode->UpdateWorldDataThreadDeferred(parentUpdated, updatedNodes);
+	}
+}
+
 void SG_Node::SetSimulatedTime(double time, bool recurse)
 {
 	// update the controllers of this node.
@@ -189,6 +189,14 @@ public:
 	 */
 	void UpdateWorldData(bool parentUpdated = false);
 	void UpdateWorldDataThread(bool parentUpdated = false);
+	/**
+	 * Update the world data of this node if it wasn't already updated
+	 * by a scheduled parent, used to update independent hierarchies
+	 * of a scheduled list in parallel. The transform callbacks are not
+	 * thread safe, the updated nodes are appended to updatedNodes to call
+	 * ActivateUpdateTransformCallback from the main thread.
+	 */
+	void UpdateScheduledWorldDataThread(std::vector<SG_Node *>& updatedNodes);
 
 	/**
 	 * Update the simulation time of this node. Iterate through
@@ -260,6 +268,7 @@ public:
 	SGControllerList& GetSGControllerList();
 
 	SG_Callbacks& GetCallBackFunctions();
+	void ActivateUpdateTransformCallback();
 
 	/**
 	 * Get the client object associated with this
@@ -355,7 +364,6 @@ protected:
 
 	bool ActivateReplicationCallback(SG_Node *replica);
 	void ActivateDestructionCallback();
-	void ActivateUpdateTransformCallback();
 	bool ActivateScheduleUpdateCallback();
 	void ActivateRecheduleUpdateCallback();
 
@@ -367,6 +375,7 @@ protected:
 
 private:
 	void UpdateWorldDataThreadSchedule(bool parentUpdated = false);
+	void UpdateWorldDataThreadDeferred(bool parentUpdated, std::vector<SG_Node *>& updatedNodes);
 
 	void ProcessSGReplica(SG_Node **replica);
 
@@ -0,0 +1,114 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "atomic_ops.h"
+
+extern "C" {
+#include "BLI_task.h"
+#include "BLI_threads.h"
+#include "BLI_utildefines.h"
+#include "PIL_time_utildefines.h"
+}
+
+/* Run the longest tests! */
+//#define TASK_RUN_BIG
+
+#define NUM_RUNS 10
+
+/* Many tiny tasks pushed from the main thread, each one spawning a few more from its worker thread,
+ * this is where the scheduler overhead (queue locking, thread wake up) is the most visible. */
+
+typedef struct TaskPerfData {
+	uint32_t count;
+	int num_sub_tasks;
+	int work_size;
+} TaskPerfData;
+
+static void task_perf_work(TaskPerfData *data)
+{
+	volatile float value = 0.0f;
+	for (int i = 0; i < data->work_size; i++) {
+		value += (float)i * 0.5f;
+	}
+	atomic_add_and_fetch_uint32(&data->count, 1);
+}
+
+static void task_perf_func(TaskPool *pool, void *UNUSED(taskdata), int UNUSED(threadid))
+{
+	task_perf_work((TaskPerfData *)BLI_task_pool_userdata(pool));
+}
+
+static void task_perf_spawn_func(TaskPool *pool, void *UNUSED(taskdata), int threadid)
+{
+	TaskPerfData *data = (TaskPerfData *)BLI_task_pool_userdata(pool);
+
+	for (int i = 0; i < data->num_sub_tasks; i++) {
+		BLI_task_pool_push_from_thread(pool, task_perf_func, NULL, false, TASK_PRIORITY_LOW, threadid);
+	}
+	task_perf_work(data);
+}
+
+static void task_perf_test(const char *id, const bool use_work_stealing,
+                           const int num_tasks, const int num_sub_tasks, const int work_size)
+{
+	printf("\n========== STARTING %s ==========\n", id);
+
+	BLI_threadapi_init();
+	TaskScheduler *scheduler = BLI_task_scheduler_create_ex(TASK_SCHEDULER_AUTO_THREADS, use_work_stealing);
+	TaskPerfData data = {0, num_sub_tasks, work_size};
+
+	{
+		TIMEIT_START(task_pool_push);
+
+		for (int run = 0; run < NUM_RUNS; run++) {
+			TaskPool *pool = BLI_task_pool_create(scheduler, &data);
+			for (int i = 0; i < num_tasks; i++) {
+				BLI_task_pool_push(pool, task_perf_spawn_func, NULL, false, TASK_PRIORITY_LOW);
+			}
+			BLI_task_pool_work_and_wait(pool);
+			BLI_task_pool_free(pool);
+		}
+
+		TIMEIT_END(task_pool_push);
+	}
+
+	EXPECT_EQ(NUM_RUNS * num_tasks * (num_sub_tasks + 1), data.count);
+	printf("%d threads, %u tasks run\n", BLI_task_scheduler_num_threads(scheduler), data.count);
+
+	BLI_task_scheduler_free(scheduler);
+
+	printf("========== ENDED %s ==========\n\n", id);
+}
+
+TEST(task, TinyTasksWorkStealing)
+{
+	task_perf_test("TinyTasksWorkStealing", true, 10000, 16, 0);
+}
+
+TEST(task, TinyTasksGlobalQueue)
+{
+	task_perf_test("TinyTasksGlobalQueue", false, 10000, 16, 0);
+}
+
+TEST(task, SmallTasksWorkStealing)
+{
+	task_perf_test("SmallTasksWorkStealing", true, 10000, 16, 100);
+}
+
+TEST(task, SmallTasksGlobalQueue)
+{
+	task_perf_test("SmallTasksGlobalQueue", false, 10000, 16, 100);
+}
+
+#ifdef TASK_RUN_BIG
+TEST(task, ManyTasksWorkStealing)
+{
+	task_perf_test("ManyTasksWorkStealing", true, 1000000, 16, 100);
+}
+
+TEST(task, ManyTasksGlobalQueue)
+{
+	task_perf_test("ManyTasksGlobalQueue", false, 1000000, 16, 100);
+}
+#endif
@@ -8,10 +8,12 @@
 extern "C" {
 #include "BLI_mempool.h"
 #include "BLI_task.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 };
 
 #define NUM_ITEMS 10000
+#define NUM_SUB_ITEMS 8
 
 static void task_mempool_iter_func(void *userdata, MempoolIterData *item) {
 	int *data = (int *)item;
@@ -74,3 +76,99 @@ TEST(task, MempoolIter)
 
 	BLI_mempool_destroy(mempool);
 }
+
+/* TaskPool with both work stealing and global queue schedulers. */
+
+typedef struct TaskPoolTestData {
+	TaskScheduler *scheduler;
+	uint32_t count;
+} TaskPoolTestData;
+
+static void task_pool_count_func(TaskPool *pool, void *UNUSED(taskdata), int UNUSED(threadid))
+{
+	TaskPoolTestData *data = (TaskPoolTestData *)BLI_task_pool_userdata(pool);
+	atomic_add_and_fetch_uint32(&data->count, 1);
+}
+
+static void task_pool_push_sub_func(TaskPool *pool, void *UNUSED(taskdata), int threadid)
+{
+	TaskPoolTestData *data = (TaskPoolTestData *)BLI_task_pool_userdata(pool);
+	atomic_add_and_fetch_uint32(&data->count, 1);
+
+	for (int i = 0; i < NUM_SUB_ITEMS; i++) {
+		BLI_task_pool_push_from_thread(pool, task_pool_count_func, NULL, false, TASK_PRIORITY_LOW, threadid);
+	}
+}
+
+static void task_nested_pool_func(TaskPool *pool, void *UNUSED(taskdata), int UNUSED(threadid))
+{
+	TaskPoolTestData *data = (TaskPoolTestData *)BLI_task_pool_userdata(pool);
+	TaskPoolTestData sub_data = {data->scheduler, 0};
+
+	TaskPool *sub_pool = BLI_task_pool_create(data->scheduler, &sub_data);
+	for (int i = 0; i < NUM_SUB_ITEMS; i++) {
+		BLI_task_pool_push(sub_pool, task_pool_count_func, NULL, false, TASK_PRIORITY_LOW);
+	}
+	BLI_task_pool_work_and_wait(sub_pool);
+	BLI_task_pool_free(sub_pool);
+
+	atomic_add_and_fetch_uint32(&data->count, sub_data.count);
+}
+
+static void task_pool_test(const bool use_work_stealing)
+{
+	BLI_threadapi_init();
+
+	TaskPoolTestData data;
+	data.scheduler = BLI_task_scheduler_create_ex(TASK_SCHEDULER_AUTO_THREADS, use_work_stealing);
+
+	/* Simple tasks, more than a thread queue can hold. */
+	data.count = 0;
+	TaskPool *pool = BLI_task_pool_create(data.scheduler, &data);
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		BLI_task_pool_push(pool, task_pool_count_func, NULL, false, TASK_PRIORITY_LOW);
+	}
+	BLI_task_pool_work_and_wait(pool);
+	EXPECT_EQ(NUM_ITEMS, data.count);
+
+	/* Tasks pushing tasks from worker threads, re-using the pool. */
+	data.count = 0;
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		BLI_task_pool_push(pool, task_pool_push_sub_func, NULL, false, TASK_PRIORITY_HIGH);
+	}
+	BLI_task_pool_work_and_wait(pool);
+	EXPECT_EQ(NUM_ITEMS * (NUM_SUB_ITEMS + 1), data.count);
+	BLI_task_pool_free(pool);
+
+	/* Tasks waiting for their own pool. */
+	data.count = 0;
+	pool = BLI_task_pool_create(data.scheduler, &data);
+	for (int i = 0; i < NUM_ITEMS / NUM_SUB_ITEMS; i++) {
+		BLI_task_pool_push(pool, task_nested_pool_func, NULL, false, TASK_PRIORITY_LOW);
+	}
+	BLI_task_pool_work_and_wait(pool);
+	EXPECT_EQ((NUM_ITEMS / NUM_SUB_ITEMS) * NUM_SUB_ITEMS, data.count);
+	BLI_task_pool_free(pool);
+
+	/* Suspended pool. */
+	data.count = 0;
+	pool = BLI_task_pool_create_suspended(data.scheduler, &data);
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		BLI_task_pool_push(pool, task_pool_count_func, NULL, false, TASK_PRIORITY_LOW);
+	}
+	BLI_task_pool_work_and_wait(pool);
+	EXPECT_EQ(NUM_ITEMS, data.count);
+	BLI_task_pool_free(pool);
+
+	BLI_task_scheduler_free(data.scheduler);
+}
+
+TEST(task, PoolWorkStealing)
+{
+	task_pool_test(true);
+}
+
+TEST(task, PoolGlobalQueue)
+{
+	task_pool_test(false);
+}
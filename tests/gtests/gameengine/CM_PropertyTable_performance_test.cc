@@ -0,0 +1,145 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "CM_PropertyTable.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "PIL_time.h"
+}
+
+/* Game object properties lookup and assignment, comparing the previous std::map storage with
+ * the property table looked up by text (python, property sensors) and by interned name (compiled
+ * expressions). The names have a common prefix like usual game properties. */
+
+#define NUM_ITERATIONS 200000
+
+typedef std::map<std::string, int *> PropertyMap;
+typedef CM_PropertyTable<int *> PropertyTable;
+
+static std::vector<std::string> property_names(const int num_props)
+{
+	std::vector<std::string> names(num_props);
+	for (int i = 0; i < num_props; ++i) {
+		names[i] = "property_" + std::to_string((i * 7919) % num_props);
+	}
+	return names;
+}
+
+static void print_timing(const char *id, const double start, const int num_ops)
+{
+	const double time = PIL_check_seconds_timer() - start;
+	printf("%-28s %8.2f ns/op\n", id, time * 1e9 / (double)num_ops);
+}
+
+static void property_table_perf_test(const int num_props)
+{
+	printf("\n========== STARTING %d properties ==========\n", num_props);
+
+	const std::vector<std::string> names = property_names(num_props);
+	std::vector<CM_PropertyName> interned(num_props);
+	std::vector<int> values(num_props);
+
+	PropertyMap map;
+	PropertyTable table;
+	for (int i = 0; i < num_props; ++i) {
+		map[names[i]] = &values[i];
+		table.Set(names[i], &values[i]);
+		interned[i] = CM_PropertyName(names[i]);
+	}
+
+	const int num_ops = NUM_ITERATIONS * num_props;
+	int found;
+
+	{
+		found = 0;
+		const double start = PIL_check_seconds_timer();
+		for (int it = 0; it < NUM_ITERATIONS; ++it) {
+			for (const std::string& name : names) {
+				PropertyMap::iterator mit = map.find(name);
+				found += (mit != map.end() && mit->second) ? 1 : 0;
+			}
+		}
+		print_timing("std::map find", start, num_ops);
+		EXPECT_EQ(num_ops, found);
+	}
+
+	{
+		found = 0;
+		const double start = PIL_check_seconds_timer();
+		for (int it = 0; it < NUM_ITERATIONS; ++it) {
+			for (const std::string& name : names) {
+				found += table.Find(name) ? 1 : 0;
+			}
+		}
+		print_timing("table find by text", start, num_ops);
+		EXPECT_EQ(num_ops, found);
+	}
+
+	{
+		found = 0;
+		const double start = PIL_check_seconds_timer();
+		for (int it = 0; it < NUM_ITERATIONS; ++it) {
+			for (const CM_PropertyName& name : interned) {
+				found += table.Find(name) ? 1 : 0;
+			}
+		}
+		print_timing("table find by interned name", start, num_ops);
+		EXPECT_EQ(num_ops, found);
+	}
+
+	{
+		const double start = PIL_check_seconds_timer();
+		for (int it = 0; it < NUM_ITERATIONS; ++it) {
+			for (int i = 0; i < num_props; ++i) {
+				map[names[i]] = &values[(i + it) % num_props];
+			}
+		}
+		print_timing("std::map set", start, num_ops);
+	}
+
+	{
+		const double start = PIL_check_seconds_timer();
+		for (int it = 0; it < NUM_ITERATIONS; ++it) {
+			for (int i = 0; i < num_props; ++i) {
+				table.Set(names[i], &values[(i + it) % num_props]);
+			}
+		}
+		print_timing("table set", start, num_ops);
+		EXPECT_EQ((unsigned int)num_props, table.Size());
+	}
+
+	/* Both containers iterate in the name order. */
+	PropertyMap::const_iterator mit = map.begin();
+	for (const PropertyTable::Entry& entry : table) {
+		EXPECT_EQ(mit->first, entry.name.GetString());
+		EXPECT_EQ(mit->second, entry.value);
+		++mit;
+	}
+
+	printf("========== ENDED %d properties ==========\n\n", num_props);
+}
+
+TEST(property_table, Properties5)
+{
+	property_table_perf_test(5);
+}
+
+TEST(property_table, Properties10)
+{
+	property_table_perf_test(10);
+}
+
+TEST(property_table, Properties20)
+{
+	property_table_perf_test(20);
+}
+
+TEST(property_table, Properties50)
+{
+	property_table_perf_test(50);
+}
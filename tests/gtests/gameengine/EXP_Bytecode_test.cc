@@ -0,0 +1,249 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "EXP_Bytecode.h"
+#include "EXP_Expression.h"
+#include "EXP_InputParser.h"
+#include "EXP_BoolValue.h"
+#include "EXP_FloatValue.h"
+#include "EXP_IntValue.h"
+
+#include <string>
+#include <vector>
+
+/* Context resolving the identifiers as SCA_ExpressionController: the sensors
+ * first as boolean symbols, then the properties of the owner. */
+class TestContext : public EXP_PropValue, public EXP_IBytecodeContext
+{
+public:
+	std::vector<std::pair<std::string, bool> > m_sensors;
+
+	void SetSensor(const std::string& name, bool state)
+	{
+		for (std::pair<std::string, bool>& sensor : m_sensors) {
+			if (sensor.first == name) {
+				sensor.second = state;
+				return;
+			}
+		}
+		m_sensors.emplace_back(name, state);
+	}
+
+	void SetValue(const std::string& name, EXP_Value *value)
+	{
+		SetProperty(name, value);
+		value->Release();
+	}
+
+	virtual EXP_Value *FindIdentifier(const std::string& name)
+	{
+		for (const std::pair<std::string, bool>& sensor : m_sensors) {
+			if (sensor.first == name) {
+				return new EXP_BoolValue(sensor.second);
+			}
+		}
+		return EXP_Value::FindIdentifier(name);
+	}
+
+	virtual EXP_BytecodeSymbol ResolveSymbol(const std::string& name)
+	{
+		for (unsigned int i = 0, size = m_sensors.size(); i < size; ++i) {
+			if (m_sensors[i].first == name) {
+				return {EXP_BytecodeSymbol::SYMBOL_BOOLEAN, nullptr, i};
+			}
+		}
+		if (name.find('.') != std::string::npos) {
+			return {EXP_BytecodeSymbol::SYMBOL_NONE, nullptr, 0};
+		}
+		return {EXP_BytecodeSymbol::SYMBOL_PROPERTY, this, 0};
+	}
+
+	virtual bool GetBooleanSymbol(unsigned int index)
+	{
+		return m_sensors[index].second;
+	}
+};
+
+enum EvalPath {
+	/* The bytecode returned the result. */
+	EVAL_BYTECODE,
+	/* The bytecode failed at execution, the tree returned the result. */
+	EVAL_FALLBACK,
+	/* The expression is not compiled, the tree returned the result. */
+	EVAL_TREE
+};
+
+class ExpressionTest : public testing::Test
+{
+protected:
+	TestContext *m_context;
+	std::vector<std::pair<EXP_Expression *, EXP_Bytecode *> > m_compiled;
+
+	virtual void SetUp()
+	{
+		m_context = new TestContext();
+		m_context->SetValue("i", new EXP_IntValue(7));
+		m_context->SetValue("zero", new EXP_IntValue(0));
+		m_context->SetValue("big", new EXP_IntValue(16777217));
+		m_context->SetValue("f", new EXP_FloatValue(2.5f));
+		m_context->SetValue("fzero", new EXP_FloatValue(0.0f));
+		m_context->SetValue("tenth", new EXP_FloatValue(0.1f));
+		m_context->SetValue("b", new EXP_BoolValue(true));
+		m_context->SetSensor("s1", true);
+		m_context->SetSensor("s2", false);
+	}
+
+	virtual void TearDown()
+	{
+		for (std::pair<EXP_Expression *, EXP_Bytecode *>& compiled : m_compiled) {
+			delete compiled.second;
+			compiled.first->Release();
+		}
+		m_context->Release();
+	}
+
+	/* Parse and compile an expression as SCA_ExpressionController::Trigger. */
+	unsigned int Compile(const std::string& text)
+	{
+		EXP_Parser parser;
+		parser.SetContext(m_context->AddRef());
+		EXP_Expression *expr = parser.ProcessText(text);
+		EXPECT_NE(expr, nullptr) << text;
+
+		EXP_Bytecode *bytecode = new EXP_Bytecode(m_context);
+		bytecode->Compile(expr);
+		m_compiled.emplace_back(expr, bytecode);
+		return m_compiled.size() - 1;
+	}
+
+	/* Evaluate a compiled expression with the bytecode or its fallback and with the tree
+	 * alone, the results must match, including an error of the tree. */
+	EvalPath Evaluate(unsigned int index, const std::string& text)
+	{
+		EXP_Expression *expr = m_compiled[index].first;
+		EXP_Bytecode *bytecode = m_compiled[index].second;
+
+		EXP_Value *value = expr->Calculate();
+		const bool error = value->IsError();
+		const double expected = error ? 0.0 : value->GetNumber();
+		value->Release();
+
+		double number;
+		if (bytecode->Execute(number)) {
+			EXPECT_FALSE(error) << text;
+			EXPECT_EQ(number, expected) << text;
+			return EVAL_BYTECODE;
+		}
+
+		return bytecode->IsValid() ? EVAL_FALLBACK : EVAL_TREE;
+	}
+
+	EvalPath Evaluate(const std::string& text)
+	{
+		return Evaluate(Compile(text), text);
+	}
+
+	/* Return true if the tree evaluation of an expression is an error. */
+	bool IsTreeError(const std::string& text)
+	{
+		EXP_Value *value = m_compiled[Compile(text)].first->Calculate();
+		const bool error = value->IsError();
+		value->Release();
+		return error;
+	}
+};
+
+TEST_F(ExpressionTest, IntFloatPromotion)
+{
+	const char *expressions[] = {
+		"i + f", "i - f", "i * f", "i / f", "f / i", "i % f", "f % i", "f % 3",
+		"i / 2", "i / 2.0", "7 / 2 * f", "i % 3", "-i + f", "-f", "+i", "(i + 1) * (f - 0.5)",
+		"i == 7.0", "i != 7.0", "i > f", "i < f", "i >= 7", "i <= 6.5", "f == 2.5",
+		/* The int is converted to float as in the tree, not to double. */
+		"big == 16777216.0", "big + 0.0", "big * 1.0 == big",
+		"if(i > f, i, 2)", "if(i < f, f, 0.5)"
+	};
+	for (const char *text : expressions) {
+		EXPECT_EQ(Evaluate(text), EVAL_BYTECODE) << text;
+	}
+}
+
+TEST_F(ExpressionTest, DivisionByZero)
+{
+	const char *expressions[] = {"i / zero", "f / fzero", "i / fzero", "f / zero", "1 + i / zero > 0"};
+	for (const char *text : expressions) {
+		EXPECT_EQ(Evaluate(text), EVAL_FALLBACK) << text;
+		EXPECT_TRUE(IsTreeError(text)) << text;
+	}
+
+	/* The branches are evaluated eagerly by the bytecode, the tree only evaluates the selected one. */
+	EXPECT_EQ(Evaluate("if(zero == 0, 1, i / zero)"), EVAL_FALLBACK);
+	EXPECT_FALSE(IsTreeError("if(zero == 0, 1, i / zero)"));
+
+	/* The divisor changed to zero after compilation. */
+	const unsigned int index = Compile("i / f");
+	EXPECT_EQ(Evaluate(index, "i / f"), EVAL_BYTECODE);
+	static_cast<EXP_FloatValue *>(m_context->GetProperty("f"))->SetFloat(0.0f);
+	EXPECT_EQ(Evaluate(index, "i / f"), EVAL_FALLBACK);
+}
+
+TEST_F(ExpressionTest, FloatLiteral)
+{
+	/* The literals are parsed as doubles and stored as floats as the properties. */
+	const char *expressions[] = {
+		"tenth == 0.1", "tenth != 0.1", "tenth > 0.1", "tenth >= 0.1", "tenth < 0.1", "tenth <= 0.1",
+		"tenth * 3 == 0.3", "tenth + 0.2 == 0.3", "tenth == 1e-1", "tenth - 0.1", "tenth / 0.1"
+	};
+	for (const char *text : expressions) {
+		EXPECT_EQ(Evaluate(text), EVAL_BYTECODE) << text;
+	}
+}
+
+TEST_F(ExpressionTest, BoolOperators)
+{
+	const char *expressions[] = {
+		"s1", "s1 and s2", "s1 or s2", "s1 && s2", "s1 || s2", "not s1", "!s2", "s1 == s2", "s1 != b",
+		"b and not s2", "(s1 or s2) and b", "s1 == true", "s2 != false", "not i", "not zero", "not fzero",
+		"if(s1, i, 2)", "if(s2, f, 0.5)", "if(s1 and b, true, false)"
+	};
+
+	for (bool s1 : {false, true}) {
+		for (bool s2 : {false, true}) {
+			m_context->SetSensor("s1", s1);
+			m_context->SetSensor("s2", s2);
+			for (const char *text : expressions) {
+				EXPECT_EQ(Evaluate(text), EVAL_BYTECODE) << text;
+			}
+		}
+	}
+
+	/* Booleans mixed with numbers and numbers with boolean operators are errors left to the tree. */
+	const char *errors[] = {"s1 and i", "i or f", "b + 1", "s1 == i"};
+	for (const char *text : errors) {
+		EXPECT_EQ(Evaluate(text), EVAL_TREE) << text;
+		EXPECT_TRUE(IsTreeError(text)) << text;
+	}
+}
+
+TEST_F(ExpressionTest, PropertyChange)
+{
+	const unsigned int index = Compile("i * 2 + f");
+	EXPECT_EQ(Evaluate(index, "i * 2 + f"), EVAL_BYTECODE);
+
+	/* A property replaced by a value of the same type is loaded again. */
+	m_context->SetValue("i", new EXP_IntValue(-3));
+	EXPECT_EQ(Evaluate(index, "i * 2 + f"), EVAL_BYTECODE);
+
+	/* A property changed of type is left to the tree. */
+	m_context->SetValue("i", new EXP_FloatValue(1.5f));
+	EXPECT_EQ(Evaluate(index, "i * 2 + f"), EVAL_FALLBACK);
+
+	/* A removed property is left to the tree. */
+	m_context->RemoveProperty("f");
+	EXPECT_EQ(Evaluate(index, "i * 2 + f"), EVAL_FALLBACK);
+	EXPECT_TRUE(IsTreeError("i * 2 + f"));
+
+	/* Strings are not compiled. */
+	EXPECT_EQ(Evaluate("\"text\" == \"text\""), EVAL_TREE);
+}
@@ -0,0 +1,114 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "KX_NetworkSocket.h"
+#include "KX_NetworkStream.h"
+
+#include <vector>
+
+extern "C" {
+#include "PIL_time.h"
+}
+
+/* Receive a datagram from a non-blocking socket, waiting at most one second. */
+static int receive_datagram(KX_NetworkSocket& socket, unsigned char *data, unsigned int size, KX_NetworkAddress& from)
+{
+	const double end = PIL_check_seconds_timer() + 1.0;
+	int received;
+	while ((received = socket.Receive(data, size, from)) < 0 && PIL_check_seconds_timer() < end) {
+		PIL_sleep_ms(1);
+	}
+	return received;
+}
+
+TEST(network_stream, VarInt)
+{
+	std::vector<unsigned char> data;
+	KX_NetworkWriter writer(data);
+	writer.WriteVarInt(0);
+	writer.WriteVarInt(127);
+	writer.WriteVarInt(128);
+	writer.WriteVarInt(0xFFFFFFFFFFFFFFFFULL);
+	writer.WriteSignedVarInt(-1);
+	writer.WriteSignedVarInt(63);
+	writer.WriteSignedVarInt(-9000000000LL);
+
+	/* Small values and small signed deltas fit in a byte. */
+	EXPECT_EQ(data[0], 0);
+	EXPECT_EQ(data[1], 127);
+	EXPECT_EQ(data.size(), 1 + 1 + 2 + 10 + 1 + 1 + 5);
+
+	KX_NetworkReader reader(data.data(), data.size());
+	uint64_t value;
+	int64_t svalue;
+	EXPECT_TRUE(reader.ReadVarInt(value) && value == 0);
+	EXPECT_TRUE(reader.ReadVarInt(value) && value == 127);
+	EXPECT_TRUE(reader.ReadVarInt(value) && value == 128);
+	EXPECT_TRUE(reader.ReadVarInt(value) && value == 0xFFFFFFFFFFFFFFFFULL);
+	EXPECT_TRUE(reader.ReadSignedVarInt(svalue) && svalue == -1);
+	EXPECT_TRUE(reader.ReadSignedVarInt(svalue) && svalue == 63);
+	EXPECT_TRUE(reader.ReadSignedVarInt(svalue) && svalue == -9000000000LL);
+	EXPECT_TRUE(reader.IsEnd());
+}
+
+TEST(network_stream, Bounds)
+{
+	std::vector<unsigned char> data;
+	KX_NetworkWriter writer(data);
+	writer.WriteString("replicated");
+	writer.WriteUInt16(0xBEEF);
+
+	KX_NetworkReader reader(data.data(), data.size());
+	std::string str;
+	uint16_t value;
+	uint32_t overflow;
+	EXPECT_TRUE(reader.ReadString(str));
+	EXPECT_EQ(str, "replicated");
+	EXPECT_TRUE(reader.ReadUInt16(value));
+	EXPECT_EQ(value, 0xBEEF);
+	EXPECT_FALSE(reader.ReadUInt32(overflow));
+	EXPECT_FALSE(reader.IsValid());
+
+	/* A string length past the datagram end is rejected. */
+	data[0] = 200;
+	KX_NetworkReader truncated(data.data(), data.size());
+	EXPECT_FALSE(truncated.ReadString(str));
+}
+
+TEST(network_socket, Loopback)
+{
+	KX_NetworkSocket server;
+	KX_NetworkSocket client;
+	ASSERT_TRUE(server.Open(0));
+	ASSERT_TRUE(client.Open(0));
+	EXPECT_NE(server.GetPort(), 0);
+
+	KX_NetworkAddress serverAddress;
+	ASSERT_TRUE(KX_NetworkAddress::Resolve("127.0.0.1", server.GetPort(), serverAddress));
+	EXPECT_EQ(serverAddress.GetText(), "127.0.0.1:" + std::to_string(server.GetPort()));
+
+	unsigned char buffer[1500];
+	KX_NetworkAddress from;
+	EXPECT_EQ(server.Receive(buffer, sizeof(buffer), from), -1);
+
+	std::vector<unsigned char> data;
+	KX_NetworkWriter writer(data);
+	writer.WriteUInt32(42);
+	writer.WriteFloat(1.5f);
+	ASSERT_TRUE(client.Send(serverAddress, data.data(), data.size()));
+
+	ASSERT_EQ(receive_datagram(server, buffer, sizeof(buffer), from), (int)data.size());
+	EXPECT_EQ(from.m_port, client.GetPort());
+
+	KX_NetworkReader reader(buffer, data.size());
+	uint32_t id;
+	float value;
+	EXPECT_TRUE(reader.ReadUInt32(id) && id == 42);
+	EXPECT_TRUE(reader.ReadFloat(value) && value == 1.5f);
+
+	/* Answer to the sender address. */
+	ASSERT_TRUE(server.Send(from, data.data(), data.size()));
+	EXPECT_EQ(receive_datagram(client, buffer, sizeof(buffer), from), (int)data.size());
+	EXPECT_TRUE(from == serverAddress);
+}
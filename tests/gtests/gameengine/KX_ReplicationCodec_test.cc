@@ -0,0 +1,333 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "KX_ReplicationCodec.h"
+#include "KX_NetworkStream.h"
+
+#include <vector>
+#include <string>
+
+typedef KX_ReplicationCodec::EntityLayout EntityLayout;
+typedef KX_ReplicationCodec::EntityState EntityState;
+typedef KX_ReplicationCodec::Snapshot Snapshot;
+typedef KX_ReplicationCodec::Record Record;
+
+static std::shared_ptr<EntityLayout> new_layout(const std::string& name)
+{
+	std::shared_ptr<EntityLayout> layout = std::make_shared<EntityLayout>();
+	layout->name = name;
+	layout->propertyNames = {"health", "speed", "alive", "label"};
+	layout->propertyTypes = {KX_ReplicationCodec::PROPERTY_INT, KX_ReplicationCodec::PROPERTY_FLOAT,
+	                         KX_ReplicationCodec::PROPERTY_BOOL, KX_ReplicationCodec::PROPERTY_STRING};
+	return layout;
+}
+
+static EntityState new_state(unsigned int id, const mt::vec3& position, const std::shared_ptr<EntityLayout>& layout)
+{
+	EntityState state;
+	state.id = id;
+	KX_ReplicationCodec::QuantizeVector(position, state.position);
+	state.orientation = KX_ReplicationCodec::QuantizeOrientation(mt::mat3::RotationZ((float)id * 0.1f));
+	KX_ReplicationCodec::QuantizeVector(mt::one3, state.scale);
+	state.worldPosition = position;
+	state.layout = layout;
+	state.properties.resize(layout->propertyNames.size());
+	state.properties[0].number = 100 + id;
+	state.properties[1].number = 0x3F800000; // 1.0f
+	state.properties[2].number = 1;
+	state.properties[3].text = "entity" + std::to_string(id);
+	return state;
+}
+
+static void expect_equal_states(const std::vector<EntityState>& result, const std::vector<EntityState>& expected)
+{
+	ASSERT_EQ(result.size(), expected.size());
+	for (unsigned int i = 0; i < result.size(); ++i) {
+		const EntityState& a = result[i];
+		const EntityState& b = expected[i];
+		EXPECT_EQ(a.id, b.id);
+		for (unsigned short k = 0; k < 3; ++k) {
+			EXPECT_EQ(a.position[k], b.position[k]);
+			EXPECT_EQ(a.scale[k], b.scale[k]);
+		}
+		EXPECT_EQ(a.orientation, b.orientation);
+		EXPECT_EQ(a.layout->name, b.layout->name);
+		EXPECT_EQ(a.layout->propertyNames, b.layout->propertyNames);
+		EXPECT_EQ(a.layout->propertyTypes, b.layout->propertyTypes);
+		ASSERT_EQ(a.properties.size(), b.properties.size());
+		for (unsigned int k = 0; k < a.properties.size(); ++k) {
+			EXPECT_EQ(a.properties[k].number, b.properties[k].number);
+			EXPECT_EQ(a.properties[k].text, b.properties[k].text);
+		}
+	}
+}
+
+/* Decode all the packets of a snapshot as a client, return false if a packet is rejected. */
+static bool decode_packets(const std::vector<std::vector<unsigned char> >& packets, const Snapshot *baseline,
+                           std::vector<EntityState>& entities)
+{
+	std::vector<Record> records;
+	for (const std::vector<unsigned char>& packet : packets) {
+		KX_NetworkReader reader(packet.data() + KX_ReplicationCodec::HEADER_SIZE,
+		                        packet.size() - KX_ReplicationCodec::HEADER_SIZE);
+		if (!KX_ReplicationCodec::DecodeRecords(reader, baseline, records)) {
+			return false;
+		}
+	}
+
+	KX_ReplicationCodec::SortRecords(records);
+	KX_ReplicationCodec::MergeRecords(records, baseline, entities);
+	return true;
+}
+
+static unsigned int packets_size(const std::vector<std::vector<unsigned char> >& packets)
+{
+	unsigned int size = 0;
+	for (const std::vector<unsigned char>& packet : packets) {
+		size += packet.size();
+	}
+	return size;
+}
+
+TEST(replication_codec, VectorRoundTrip)
+{
+	const mt::vec3 vec(1.5f, -1000.25f, 0.0001f);
+	int quantized[3];
+	KX_ReplicationCodec::QuantizeVector(vec, quantized);
+	const mt::vec3 result = KX_ReplicationCodec::DequantizeVector(quantized);
+
+	for (unsigned short i = 0; i < 3; ++i) {
+		EXPECT_NEAR(result[i], vec[i], 0.5f / 1024.0f);
+	}
+}
+
+TEST(replication_codec, OrientationRoundTrip)
+{
+	const mt::mat3 rotations[] = {
+		mt::mat3::Identity(),
+		mt::mat3::RotationX(M_PI_2),
+		mt::mat3::RotationY(M_PI),
+		mt::mat3::RotationZ(-M_PI_2),
+		mt::mat3::RotationX(0.3f) * mt::mat3::RotationY(-1.2f) * mt::mat3::RotationZ(2.5f),
+		/* The largest quaternion component is negative. */
+		mt::mat3::RotationZ(3.0f) * mt::mat3::RotationX(-2.9f)
+	};
+
+	for (const mt::mat3& rotation : rotations) {
+		const unsigned int packed = KX_ReplicationCodec::QuantizeOrientation(rotation);
+		const mt::mat3 result = KX_ReplicationCodec::DequantizeOrientation(packed);
+		for (unsigned short i = 0; i < 3; ++i) {
+			for (unsigned short j = 0; j < 3; ++j) {
+				EXPECT_NEAR(result(i, j), rotation(i, j), 3.0e-3f);
+			}
+		}
+	}
+}
+
+TEST(replication_codec, DeltaEncode)
+{
+	std::shared_ptr<EntityLayout> layout = new_layout("Cube");
+	std::vector<EntityState> states;
+	for (unsigned int id = 1; id <= 4; ++id) {
+		states.push_back(new_state(id, mt::vec3(id, 0.0f, 0.0f), layout));
+	}
+
+	KX_ReplicationCodec codec;
+	KX_ReplicationCodec::History serverHistory;
+	KX_ReplicationCodec::History clientHistory;
+
+	/* Full snapshot without baseline. */
+	Snapshot& sent1 = serverHistory.Add(1, 0.0);
+	codec.Encode(states, nullptr, mt::zero3, 0.0f, sent1);
+	const unsigned int fullSize = packets_size(codec.GetPackets());
+
+	Snapshot& received1 = clientHistory.Add(1, 0.0);
+	ASSERT_TRUE(decode_packets(codec.GetPackets(), nullptr, received1.entities));
+	expect_equal_states(received1.entities, states);
+	expect_equal_states(sent1.entities, states);
+
+	/* Move an object, change a property of another, remove one and add a new one. */
+	states[0].position[2] += 10;
+	states[1].properties[0].number -= 25;
+	states[1].properties[3].text = "renamed";
+	states.erase(states.begin() + 2);
+	states.push_back(new_state(5, mt::vec3(5.0f, 0.0f, 0.0f), layout));
+
+	Snapshot& sent2 = serverHistory.Add(2, 0.0);
+	codec.Encode(states, serverHistory.Find(1), mt::zero3, 0.0f, sent2);
+	const unsigned int deltaSize = packets_size(codec.GetPackets());
+
+	/* The unchanged object is not sent, the changed ones only send their changes. */
+	EXPECT_LT(deltaSize, fullSize);
+
+	/* The deltas can't be decoded without their baseline. */
+	std::vector<EntityState> entities;
+	EXPECT_FALSE(decode_packets(codec.GetPackets(), nullptr, entities));
+
+	Snapshot& received2 = clientHistory.Add(2, 0.0);
+	ASSERT_TRUE(decode_packets(codec.GetPackets(), clientHistory.Find(1), received2.entities));
+	expect_equal_states(received2.entities, states);
+	expect_equal_states(sent2.entities, states);
+
+	/* An unchanged snapshot only contains the header. */
+	Snapshot& sent3 = serverHistory.Add(3, 0.0);
+	codec.Encode(states, serverHistory.Find(2), mt::zero3, 0.0f, sent3);
+	ASSERT_EQ(codec.GetPackets().size(), 1);
+	EXPECT_EQ(codec.GetPackets()[0].size(), KX_ReplicationCodec::HEADER_SIZE);
+}
+
+TEST(replication_codec, LayoutChange)
+{
+	std::vector<EntityState> states = {new_state(1, mt::zero3, new_layout("Cube"))};
+
+	KX_ReplicationCodec codec;
+	Snapshot baseline;
+	baseline.id = 1;
+	codec.Encode(states, nullptr, mt::zero3, 0.0f, baseline);
+
+	/* A new layout sends the object entirely, decodable without baseline. */
+	std::shared_ptr<EntityLayout> layout = new_layout("Sphere");
+	layout->propertyNames.push_back("score");
+	layout->propertyTypes.push_back(KX_ReplicationCodec::PROPERTY_INT);
+	states[0].layout = layout;
+	states[0].properties.emplace_back();
+	states[0].properties.back().number = -7;
+
+	Snapshot snapshot;
+	codec.Encode(states, &baseline, mt::zero3, 0.0f, snapshot);
+
+	std::vector<EntityState> entities;
+	ASSERT_TRUE(decode_packets(codec.GetPackets(), nullptr, entities));
+	expect_equal_states(entities, states);
+}
+
+TEST(replication_codec, SplitPackets)
+{
+	std::shared_ptr<EntityLayout> layout = new_layout("Cube");
+	std::vector<EntityState> states;
+	for (unsigned int id = 1; id <= 500; ++id) {
+		states.push_back(new_state(id, mt::vec3(id, -(float)id, 0.5f), layout));
+	}
+
+	KX_ReplicationCodec codec;
+	Snapshot snapshot;
+	codec.Encode(states, nullptr, mt::zero3, 0.0f, snapshot);
+
+	const std::vector<std::vector<unsigned char> >& packets = codec.GetPackets();
+	EXPECT_GT(packets.size(), 1);
+	for (const std::vector<unsigned char>& packet : packets) {
+		EXPECT_LE(packet.size(), KX_ReplicationCodec::MAX_DATAGRAM_SIZE);
+	}
+
+	/* The packets are decoded independently, whatever their order of arrival. */
+	std::vector<std::vector<unsigned char> > reversed(packets.rbegin(), packets.rend());
+	std::vector<EntityState> entities;
+	ASSERT_TRUE(decode_packets(reversed, nullptr, entities));
+	expect_equal_states(entities, states);
+	expect_equal_states(snapshot.entities, states);
+
+	/* A truncated packet is rejected. */
+	std::vector<std::vector<unsigned char> > truncated = {packets[0]};
+	truncated[0].resize(truncated[0].size() - 3);
+	EXPECT_FALSE(decode_packets(truncated, nullptr, entities));
+}
+
+TEST(replication_codec, AckAndBaseline)
+{
+	KX_ReplicationCodec::History history;
+	for (unsigned int id = 1; id <= 40; ++id) {
+		history.Add(id, id * 0.1);
+	}
+
+	/* The oldest snapshots are replaced. */
+	EXPECT_EQ(history.Find(0), nullptr);
+	EXPECT_EQ(history.Find(8), nullptr);
+	ASSERT_NE(history.Find(9), nullptr);
+	EXPECT_EQ(history.Find(9)->id, 9);
+	EXPECT_EQ(history.Find(40)->id, 40);
+	EXPECT_EQ(history.Find(41), nullptr);
+
+	/* Newer acknowledgments of sent snapshots are accepted. */
+	EXPECT_EQ(KX_ReplicationCodec::UpdateAck(history, 0, 20), 20);
+	EXPECT_EQ(KX_ReplicationCodec::UpdateAck(history, 20, 25), 25);
+	/* Late, lost or unsent acknowledgments are ignored. */
+	EXPECT_EQ(KX_ReplicationCodec::UpdateAck(history, 25, 20), 25);
+	EXPECT_EQ(KX_ReplicationCodec::UpdateAck(history, 25, 5), 25);
+	EXPECT_EQ(KX_ReplicationCodec::UpdateAck(history, 25, 41), 25);
+	/* A restarted client asks for full snapshots. */
+	EXPECT_EQ(KX_ReplicationCodec::UpdateAck(history, 25, 0), 0);
+
+	/* The next snapshot 41 is delta encoded against the acknowledged one if it is kept. */
+	EXPECT_EQ(KX_ReplicationCodec::SelectBaseline(history, 0, 41), nullptr);
+	EXPECT_EQ(KX_ReplicationCodec::SelectBaseline(history, 40, 41)->id, 40);
+	EXPECT_EQ(KX_ReplicationCodec::SelectBaseline(history, 10, 41)->id, 10);
+	/* The snapshot 9 is still kept but its slot is the one of the snapshot 41. */
+	EXPECT_EQ(KX_ReplicationCodec::SelectBaseline(history, 9, 41), nullptr);
+}
+
+TEST(replication_codec, Interest)
+{
+	std::shared_ptr<EntityLayout> layout = new_layout("Cube");
+	std::vector<EntityState> states = {
+		new_state(1, mt::vec3(5.0f, 0.0f, 0.0f), layout),
+		new_state(2, mt::vec3(20.0f, 0.0f, 0.0f), layout)
+	};
+
+	/* Without radius all the objects are sent. */
+	KX_ReplicationCodec codec;
+	Snapshot all;
+	all.id = 1;
+	codec.Encode(states, nullptr, mt::zero3, 0.0f, all);
+	EXPECT_EQ(all.entities.size(), 2);
+
+	/* The object out of the interest radius is removed from the client. */
+	Snapshot near;
+	codec.Encode(states, &all, mt::zero3, 10.0f, near);
+	ASSERT_EQ(near.entities.size(), 1);
+	EXPECT_EQ(near.entities[0].id, 1);
+
+	std::vector<EntityState> entities;
+	ASSERT_TRUE(decode_packets(codec.GetPackets(), &all, entities));
+	ASSERT_EQ(entities.size(), 1);
+	EXPECT_EQ(entities[0].id, 1);
+
+	/* It is sent again entirely when getting closer to the point of interest. */
+	Snapshot closer;
+	codec.Encode(states, &near, mt::vec3(15.0f, 0.0f, 0.0f), 10.0f, closer);
+	ASSERT_TRUE(decode_packets(codec.GetPackets(), &near, entities));
+	expect_equal_states(entities, states);
+}
+
+TEST(replication_codec, Header)
+{
+	KX_ReplicationCodec::Header header;
+	header.id = 123456;
+	header.baselineId = 123450;
+	header.session = 0xDEADBEEF;
+	header.part = 2;
+	header.count = 3;
+	header.roundTripTime = 42;
+
+	std::vector<unsigned char> data;
+	KX_NetworkWriter writer(data);
+	/* Magic, version and packet type. */
+	writer.WriteUInt32(0);
+	KX_ReplicationCodec::WriteHeader(writer, header);
+	EXPECT_EQ(data.size(), KX_ReplicationCodec::HEADER_SIZE);
+
+	KX_NetworkReader reader(data.data() + 4, data.size() - 4);
+	KX_ReplicationCodec::Header result;
+	ASSERT_TRUE(KX_ReplicationCodec::ReadHeader(reader, result));
+	EXPECT_EQ(result.id, header.id);
+	EXPECT_EQ(result.baselineId, header.baselineId);
+	EXPECT_EQ(result.session, header.session);
+	EXPECT_EQ(result.part, header.part);
+	EXPECT_EQ(result.count, header.count);
+	EXPECT_EQ(result.roundTripTime, header.roundTripTime);
+
+	/* A part out of the part count is invalid. */
+	data[4 + 12] = 3;
+	KX_NetworkReader invalidReader(data.data() + 4, data.size() - 4);
+	EXPECT_FALSE(KX_ReplicationCodec::ReadHeader(invalidReader, result));
+}
@@ -0,0 +1,339 @@
+# ##### BEGIN GPL LICENSE BLOCK #####
+#
+#  This program is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU General Public License
+#  as published by the Free Software Foundation; either version 2
+#  of the License, or (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software Foundation,
+#  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#
+# ##### END GPL LICENSE BLOCK #####
+
+# <pep8 compliant>
+
+# Deterministic frame benchmark of the game engine.
+#
+# Synthetic scenes are generated (rigid bodies, skinned armatures, logic bricks
+# and python components) and each one is run in the headless player with a
+# simulated clock (-g headless_realtime = 0), so every run proceeds exactly the
+# same logic frames whatever the speed of the machine.
+#
+# The average time per frame of each profiling category (bge.logic.getProfileInfo)
+# is reported, and the final object positions are compared between the repeated
+# runs to check that the simulation is deterministic.
+#
+# ./blender.bin --background -noaudio --factory-startup \
+#     --python tests/python/bge_frame_benchmark.py -- \
+#     --blenderplayer=./blenderplayer --output-dir=/tmp --count=500 --frames=600
+
+import bpy
+
+import math
+import os
+import sys
+
+sys.path.append(os.path.dirname(__file__))
+
+from bge_test_utils import (
+    argument_parser,
+    new_cube_mesh,
+    new_scene,
+    parse_arguments,
+    run_main,
+    run_player,
+    write_script,
+)
+
+# Profiling categories reported, the labels are the keys of bge.logic.getProfileInfo().
+CATEGORIES = ("Physics:", "Logic:", "Animations:", "Scenegraph:", "Rasterizer:", "Overhead:")
+
+# Frames skipped before measuring, the profiler averages the last 25 frames.
+WARMUP_FRAMES = 25
+
+# Number of bones of the benchmark armatures, and the rings and segments of their skinned mesh.
+NUM_BONES = 8
+NUM_RINGS = 64
+NUM_SEGMENTS = 16
+
+MAIN_LOOP = '''
+import bge
+import json
+
+frames = 0
+times = {}
+while not bge.logic.NextFrame():
+    frames += 1
+    if frames > %(warmup)d:
+        for name, (ms, _) in bge.logic.getProfileInfo().items():
+            times[name] = times.get(name, 0.0) + ms
+
+measured = max(frames - %(warmup)d, 1)
+checksum = 0.0
+for scene in bge.logic.getSceneList():
+    for ob in scene.objects:
+        checksum += sum(ob.worldPosition) + sum(ob.worldOrientation.to_euler())
+
+print("BGE_TEST " + json.dumps({
+    "frames": frames,
+    "times": {name: total / measured for name, total in times.items()},
+    "checksum": round(checksum, 4),
+}))
+'''
+
+# Imported from the directory of the .blend file, by blender and by the player.
+COMPONENT_MODULE_NAME = "bge_frame_benchmark_component"
+COMPONENT_MODULE = '''
+import bge
+import math
+from collections import OrderedDict
+
+
+class Oscillator(bge.types.KX_PythonComponent):
+    args = OrderedDict([
+        ("Speed", 1.0),
+        ("Amplitude", 0.5),
+    ])
+
+    def start(self, args):
+        self.speed = args["Speed"]
+        self.amplitude = args["Amplitude"]
+        self.origin = self.object.worldPosition.copy()
+        self.frame = 0
+
+    def update(self):
+        self.frame += 1
+        offset = math.sin(self.frame * self.speed * 0.05) * self.amplitude
+        self.object.worldPosition.z = self.origin.z + offset
+        self.object.applyRotation((0.0, 0.0, 0.01 * self.speed), True)
+'''
+
+
+def grid_location(index, count, spacing):
+    side = max(int(math.ceil(math.sqrt(count))), 1)
+    return ((index % side - side / 2) * spacing, (index // side - side / 2) * spacing, 0.0)
+
+
+def link_copies(scene, template, count, spacing):
+    obs = [template]
+    for i in range(1, count):
+        obs.append(template.copy())
+    for i, ob in enumerate(obs):
+        ob.location = grid_location(i, count, spacing)
+        if ob is not template:
+            scene.objects.link(ob)
+    return obs
+
+
+def add_logic(ob, sensor, controller, actuator, sensor_type='ALWAYS', controller_type='LOGIC_AND', actuator_type='MOTION'):
+    bpy.ops.logic.sensor_add(type=sensor_type, name=sensor, object=ob.name)
+    bpy.ops.logic.controller_add(type=controller_type, name=controller, object=ob.name)
+    bpy.ops.logic.actuator_add(type=actuator_type, name=actuator, object=ob.name)
+
+    sens = ob.game.sensors[sensor]
+    cont = ob.game.controllers[controller]
+    act = ob.game.actuators[actuator]
+    sens.use_pulse_true_level = True
+    cont.link(sensor=sens, actuator=act)
+
+    return sens, cont, act
+
+
+def create_rigid_bodies(scene, count):
+    # Columns of boxes falling on each other.
+    columns = max(count // 5, 1)
+    size = math.ceil(math.sqrt(columns)) * 1.5 + 10.0
+
+    ground = bpy.data.objects.new("Ground", new_cube_mesh("Ground"))
+    ground.scale = (size, size, 1.0)
+    ground.location = (0.0, 0.0, -1.0)
+    ground.game.physics_type = 'STATIC'
+    scene.objects.link(ground)
+
+    template = bpy.data.objects.new("Body", new_cube_mesh("Body"))
+    template.game.physics_type = 'RIGID_BODY'
+    template.game.use_collision_bounds = True
+    template.game.collision_bounds_type = 'BOX'
+    scene.objects.link(template)
+
+    for i, ob in enumerate(link_copies(scene, template, count, 1.5)):
+        x, y, z = grid_location(i % columns, columns, 1.5)
+        ob.location = (x, y, 1.0 + (i // columns) * 1.2)
+        # Slightly rotated to make the stacks collapse.
+        ob.rotation_euler = (0.1 * (i % 3), 0.1 * (i % 5), 0.0)
+
+
+def create_armatures(scene, count):
+    arm = bpy.data.objects.new("Armature", bpy.data.armatures.new("Armature"))
+    scene.objects.link(arm)
+    scene.objects.active = arm
+
+    bpy.ops.object.mode_set(mode='EDIT')
+    parent = None
+    for i in range(NUM_BONES):
+        bone = arm.data.edit_bones.new("Bone%d" % i)
+        bone.head = (0.0, float(i), 0.0)
+        bone.tail = (0.0, float(i + 1), 0.0)
+        bone.parent = parent
+        bone.use_connect = parent is not None
+        parent = bone
+    bpy.ops.object.mode_set(mode='OBJECT')
+
+    # Bending animation looped by an action actuator.
+    for frame, angle in ((1, 0.0), (20, 0.3), (40, -0.3), (60, 0.0)):
+        for pchan in arm.pose.bones:
+            pchan.rotation_quaternion = (math.cos(angle / 2.0), 0.0, 0.0, math.sin(angle / 2.0))
+            pchan.keyframe_insert("rotation_quaternion", frame=frame)
+    action = arm.animation_data.action
+
+    sens, cont, act = add_logic(arm, "Always", "And", "Action", actuator_type='ACTION')
+    act.action = action
+    act.frame_start = 1.0
+    act.frame_end = 60.0
+    act.play_mode = 'LOOPEND'
+
+    # Tube along the bones, each vertex is weighted between its two closest bones.
+    verts = []
+    faces = []
+    for r in range(NUM_RINGS):
+        y = r * NUM_BONES / (NUM_RINGS - 1)
+        for s in range(NUM_SEGMENTS):
+            angle = 2.0 * math.pi * s / NUM_SEGMENTS
+            verts.append((math.cos(angle) * 0.3, y, math.sin(angle) * 0.3))
+    for r in range(NUM_RINGS - 1):
+        for s in range(NUM_SEGMENTS):
+            a = r * NUM_SEGMENTS + s
+            b = r * NUM_SEGMENTS + (s + 1) % NUM_SEGMENTS
+            faces.append((a, b, b + NUM_SEGMENTS, a + NUM_SEGMENTS))
+
+    mesh = bpy.data.meshes.new("Skin")
+    mesh.from_pydata(verts, [], faces)
+    mesh.update()
+
+    skin = bpy.data.objects.new("Skin", mesh)
+    scene.objects.link(skin)
+    groups = [skin.vertex_groups.new("Bone%d" % i) for i in range(NUM_BONES)]
+    for index, co in enumerate(verts):
+        pos = min(max(co[1] - 0.5, 0.0), NUM_BONES - 1.0)
+        bone = min(int(pos), NUM_BONES - 2)
+        weight = pos - bone
+        groups[bone].add([index], 1.0 - weight, 'REPLACE')
+        groups[bone + 1].add([index], weight, 'REPLACE')
+
+    skin.parent = arm
+    modifier = skin.modifiers.new("Armature", 'ARMATURE')
+    modifier.object = arm
+
+    arms = link_copies(scene, arm, count, 2.0)
+    skins = link_copies(scene, skin, count, 2.0)
+    for arm_copy, skin_copy in zip(arms, skins):
+        skin_copy.parent = arm_copy
+        skin_copy.location = (0.0, 0.0, 0.0)
+        skin_copy.modifiers["Armature"].object = arm_copy
+
+
+def create_logic_bricks(scene, count):
+    template = bpy.data.objects.new("Logic", new_cube_mesh("Logic"))
+    template.game.physics_type = 'NO_COLLISION'
+    scene.objects.link(template)
+    scene.objects.active = template
+
+    bpy.ops.object.game_property_new(type='INT', name="counter")
+    bpy.ops.object.game_property_new(type='FLOAT', name="total")
+
+    sens, cont, act = add_logic(template, "Always", "And", "Motion")
+    act.offset_rotation = (0.0, 0.0, 0.01)
+    act.use_local_rotation = True
+
+    sens, cont, act = add_logic(template, "Tick", "Counter", "Increment", actuator_type='PROPERTY')
+    act.mode = 'ADD'
+    act.property = "counter"
+    act.value = "1"
+
+    sens, cont, act = add_logic(template, "Check", "Expression", "Accumulate",
+                                controller_type='EXPRESSION', actuator_type='PROPERTY')
+    cont.expression = "counter > 10 and (counter < 100000 or total < 1.0)"
+    act.mode = 'ADD'
+    act.property = "total"
+    act.value = "0.5"
+
+    link_copies(scene, template, count, 1.5)
+
+
+def create_python_components(scene, count):
+    template = bpy.data.objects.new("Component", new_cube_mesh("Component"))
+    template.game.physics_type = 'NO_COLLISION'
+    scene.objects.link(template)
+    scene.objects.active = template
+
+    bpy.ops.logic.add_python_component(component_name=COMPONENT_MODULE_NAME + ".Oscillator")
+    assert(len(template.game.components) == 1)
+
+    link_copies(scene, template, count, 1.5)
+
+
+SCENARIOS = (
+    ("rigid_bodies", create_rigid_bodies),
+    ("armatures", create_armatures),
+    ("logic_bricks", create_logic_bricks),
+    ("python_components", create_python_components),
+)
+
+
+def main():
+    parser = argument_parser("Deterministic frame benchmark of the game engine")
+    parser.add_argument("--count", type=int, default=100, help="Number of objects of each scene")
+    parser.add_argument("--frames", type=int, default=300, help="Number of logic frames to run")
+    parser.add_argument("--repeat", type=int, default=2)
+    parser.add_argument("--scenario", action="append", choices=[name for name, _ in SCENARIOS],
+                        help="Run only the given scenarios")
+    args = parse_arguments(parser)
+
+    assert(args.frames > WARMUP_FRAMES)
+
+    mainloop = write_script(args.output_dir, "bge_frame_benchmark_main.py", MAIN_LOOP % {"warmup": WARMUP_FRAMES})
+    component = write_script(args.output_dir, COMPONENT_MODULE_NAME + ".py", COMPONENT_MODULE)
+
+    print("%-18s" % "Scene" + "".join("%14s" % name.rstrip(":") for name in CATEGORIES) + "  (ms per frame)")
+
+    for name, create in SCENARIOS:
+        if args.scenario and name not in args.scenario:
+            continue
+
+        filepath = os.path.join(args.output_dir, "bge_frame_benchmark_%s.blend" % name)
+
+        # Saved before the creation for the python components to be found in its directory.
+        scene = new_scene(camera_location=(0.0, -50.0, 20.0))
+        scene.game_settings.fps = 60
+        bpy.ops.wm.save_as_mainfile(filepath=filepath, check_existing=False)
+        create(scene, args.count)
+        bpy.ops.wm.save_mainfile()
+
+        results = [run_player(args.blenderplayer, filepath, mainloop, args.frames,
+                              game_properties=(("headless_deform", 1),))
+                   for _ in range(args.repeat)]
+
+        for result in results:
+            assert(result["frames"] == args.frames)
+            if result["checksum"] != results[0]["checksum"]:
+                raise Exception("%s: the simulation is not deterministic (%r != %r)" %
+                                (name, result["checksum"], results[0]["checksum"]))
+
+        # Keep the best run of each category, the least disturbed by the system.
+        times = [min(result["times"].get(category, 0.0) for result in results) for category in CATEGORIES]
+        print("%-18s" % name + "".join("%14.3f" % time for time in times))
+
+        os.remove(filepath)
+
+    os.remove(mainloop)
+    os.remove(component)
+
+
+if __name__ == "__main__":
+    run_main(main)
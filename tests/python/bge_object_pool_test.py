@@ -0,0 +1,157 @@
+# ##### BEGIN GPL LICENSE BLOCK #####
+#
+#  This program is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU General Public License
+#  as published by the Free Software Foundation; either version 2
+#  of the License, or (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software Foundation,
+#  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#
+# ##### END GPL LICENSE BLOCK #####
+
+# <pep8 compliant>
+
+# Recycle and reuse cycle of the object pools (scene.setObjectPool).
+#
+# A replica of a pooled object is modified at runtime (properties, color, mesh,
+# layer, collision filter, python attributes and callbacks, playing action) and
+# ended, the next added replica must reuse it and be in the same state as a new
+# replica of the template.
+#
+# ./blender.bin --background -noaudio --factory-startup \
+#     --python tests/python/bge_object_pool_test.py -- \
+#     --blenderplayer=./blenderplayer --output-dir=/tmp
+
+import bpy
+
+import os
+import sys
+
+sys.path.append(os.path.dirname(__file__))
+
+from bge_test_utils import (
+    argument_parser,
+    new_cube_mesh,
+    new_scene,
+    parse_arguments,
+    run_main,
+    run_player,
+    write_script,
+)
+
+MAIN_LOOP = '''
+import bge
+import json
+
+scene = bge.logic.getCurrentScene()
+template = scene.objectsInactive["Pooled"]
+scene.setObjectPool(template, 1)
+
+
+def state(ob):
+    return {
+        "position": [round(v, 4) for v in ob.worldPosition],
+        "count": ob["count"],
+        "color": [round(v, 4) for v in ob.color],
+        "meshes": [mesh.name for mesh in ob.meshes],
+        "layer": ob.layer,
+        "collisionGroup": ob.collisionGroup,
+        "collisionMask": ob.collisionMask,
+        "attrDict": sorted(ob.attrDict.keys()),
+        "collisionCallbacks": len(ob.collisionCallbacks),
+        "playingAction": ob.isPlayingAction(0),
+    }
+
+
+fresh = scene.addObject(template)
+expected = state(fresh)
+
+fresh.worldPosition = (1.0, 2.0, 3.0)
+fresh["count"] = 5
+fresh.color = (1.0, 0.0, 0.0, 0.5)
+fresh.replaceMesh("Other")
+fresh.layer = 3
+fresh.collisionGroup = 2
+fresh.collisionMask = 4
+fresh.attrDict["runtime"] = object()
+fresh.collisionCallbacks.append(lambda other: None)
+fresh.playAction("PoolAction", 1.0, 20.0, play_mode=bge.logic.KX_ACTION_MODE_LOOP)
+modified = state(fresh)
+fresh.endObject()
+
+# The ended object is removed at the end of the frame.
+bge.logic.NextFrame()
+
+reused = scene.addObject(template)
+
+print("BGE_TEST " + json.dumps({
+    "expected": expected,
+    "modified": modified,
+    "reused": state(reused),
+    "pool": scene.getObjectPool(template),
+}))
+'''
+
+
+def create_scene(filepath):
+    scene = new_scene()
+
+    # The templates are in an inactive layer.
+    inactive_layers = [i == 1 for i in range(20)]
+
+    template = bpy.data.objects.new("Pooled", new_cube_mesh("Pooled", 0.5))
+    template.game.physics_type = 'RIGID_BODY'
+    scene.objects.link(template)
+    template.layers = inactive_layers
+    scene.objects.active = template
+    bpy.ops.object.game_property_new(type='INT', name="count")
+
+    template.animation_data_create()
+    template.animation_data.action = bpy.data.actions.new("PoolAction")
+    for frame, z in ((1, 0.0), (20, 1.0)):
+        template.location.z = z
+        template.keyframe_insert("location", frame=frame)
+    template.location.z = 0.0
+
+    other = bpy.data.objects.new("Other", new_cube_mesh("Other", 1.0))
+    scene.objects.link(other)
+    other.layers = inactive_layers
+
+    bpy.ops.wm.save_as_mainfile(filepath=filepath, check_existing=False)
+
+
+def main():
+    args = parse_arguments(argument_parser("Recycle and reuse cycle of the object pools"))
+
+    filepath = os.path.join(args.output_dir, "bge_object_pool_test.blend")
+    mainloop = write_script(args.output_dir, "bge_object_pool_test_main.py", MAIN_LOOP)
+
+    create_scene(filepath)
+    result = run_player(args.blenderplayer, filepath, mainloop, 10)
+
+    pool = result["pool"]
+    if pool["hits"] != 1 or pool["misses"] != 1:
+        raise Exception("The ended replica was not reused: %r" % pool)
+
+    # Make sure the test really modified every field checked.
+    for key, value in result["expected"].items():
+        if result["modified"][key] == value:
+            raise Exception("%s was not modified by the test: %r" % (key, value))
+
+    for key, value in result["expected"].items():
+        if result["reused"][key] != value:
+            raise Exception("%s of the reused replica is %r instead of %r" % (key, result["reused"][key], value))
+
+    os.remove(filepath)
+    os.remove(mainloop)
+
+
+if __name__ == "__main__":
+    run_main(main)
@@ -0,0 +1,189 @@
+# ##### BEGIN GPL LICENSE BLOCK #####
+#
+#  This program is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU General Public License
+#  as published by the Free Software Foundation; either version 2
+#  of the License, or (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software Foundation,
+#  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#
+# ##### END GPL LICENSE BLOCK #####
+
+# <pep8 compliant>
+
+# Save and restore round trip of the scene snapshots (scene.saveState and scene.restoreState).
+#
+# The state of the objects is modified after a snapshot and must be back to the saved one
+# once the snapshot is restored. Every truncation of the snapshot must be rejected without
+# modifying the scene.
+#
+# ./blender.bin --background -noaudio --factory-startup \
+#     --python tests/python/bge_scene_snapshot_test.py -- \
+#     --blenderplayer=./blenderplayer --output-dir=/tmp
+
+import bpy
+
+import os
+import sys
+
+sys.path.append(os.path.dirname(__file__))
+
+from bge_test_utils import (
+    argument_parser,
+    new_cube_mesh,
+    new_scene,
+    parse_arguments,
+    run_main,
+    run_player,
+    write_script,
+)
+
+MAIN_LOOP = '''
+import bge
+import json
+
+scene = bge.logic.getCurrentScene()
+
+
+def state():
+    objects = {}
+    for ob in scene.objects:
+        objects[ob.name] = {
+            "state": ob.state,
+            "position": [round(v, 4) for v in ob.worldPosition],
+            "orientation": [round(v, 4) for v in ob.worldOrientation.to_euler()],
+            "scale": [round(v, 4) for v in ob.worldScale],
+            "velocity": [round(v, 4) for v in ob.getLinearVelocity()],
+            "properties": {name: ob[name] for name in ob.getPropertyNames()},
+        }
+    return objects
+
+
+def modify():
+    for ob in scene.objects:
+        ob.state = 2
+        ob.worldPosition.x += 1.0
+        ob.applyRotation((0.0, 0.0, 0.5))
+        ob.worldScale = (2.0, 2.0, 2.0)
+        ob["added"] = True
+        for name in ob.getPropertyNames():
+            if isinstance(ob[name], str):
+                ob[name] += "_modified"
+            elif not isinstance(ob[name], bool):
+                ob[name] += 1
+    scene.objects["Body"].setLinearVelocity((0.0, 0.0, 5.0))
+
+
+# Let the rigid body fall.
+for i in range(10):
+    bge.logic.NextFrame()
+
+snapshot = scene.saveState()
+saved = state()
+
+modify()
+modified = state()
+restored = scene.restoreState(snapshot)
+roundtrip = state()
+
+# Restore through a reused buffer.
+buffer = bytearray(len(snapshot))
+size = scene.saveState(buffer)
+
+modify()
+modified_truncated = state()
+rejected = 0
+for end in range(len(snapshot)):
+    try:
+        scene.restoreState(snapshot[:end])
+    except ValueError:
+        rejected += 1
+truncated = state()
+
+print("BGE_TEST " + json.dumps({
+    "saved": saved,
+    "modified": modified,
+    "restored": restored,
+    "roundtrip": roundtrip,
+    "size": size,
+    "snapshotSize": len(snapshot),
+    "rejected": rejected,
+    "modifiedTruncated": modified_truncated,
+    "truncated": truncated,
+}))
+'''
+
+
+def create_scene(filepath):
+    scene = new_scene()
+
+    ground = bpy.data.objects.new("Ground", new_cube_mesh("Ground"))
+    ground.scale = (10.0, 10.0, 1.0)
+    ground.location = (0.0, 0.0, -1.0)
+    ground.game.physics_type = 'STATIC'
+    scene.objects.link(ground)
+
+    body = bpy.data.objects.new("Body", new_cube_mesh("Body"))
+    body.location = (0.0, 0.0, 3.0)
+    body.game.physics_type = 'RIGID_BODY'
+    scene.objects.link(body)
+
+    logic = bpy.data.objects.new("Logic", new_cube_mesh("Logic"))
+    logic.location = (3.0, 0.0, 0.0)
+    logic.game.physics_type = 'NO_COLLISION'
+    scene.objects.link(logic)
+
+    for ob in (body, logic):
+        scene.objects.active = ob
+        for prop_type, name, value in (('INT', "int", 3), ('FLOAT', "float", 0.5),
+                                       ('BOOL', "bool", True), ('STRING', "string", "text")):
+            bpy.ops.object.game_property_new(type=prop_type, name=name)
+            ob.game.properties[name].value = value
+
+    bpy.ops.wm.save_as_mainfile(filepath=filepath, check_existing=False)
+
+
+def compare_states(label, state, expected):
+    if state != expected:
+        for name in sorted(expected):
+            if state.get(name) != expected[name]:
+                raise Exception("%s: %s is %r instead of %r" % (label, name, state.get(name), expected[name]))
+        raise Exception("%s: objects %r instead of %r" % (label, sorted(state), sorted(expected)))
+
+
+def main():
+    args = parse_arguments(argument_parser("Save and restore round trip of the scene snapshots"))
+
+    filepath = os.path.join(args.output_dir, "bge_scene_snapshot_test.blend")
+    mainloop = write_script(args.output_dir, "bge_scene_snapshot_test_main.py", MAIN_LOOP)
+
+    create_scene(filepath)
+    result = run_player(args.blenderplayer, filepath, mainloop, 20)
+
+    if result["modified"] == result["saved"]:
+        raise Exception("The objects were not modified by the test")
+
+    if result["restored"] != len(result["saved"]):
+        raise Exception("%d objects restored instead of %d" % (result["restored"], len(result["saved"])))
+    compare_states("Round trip", result["roundtrip"], result["saved"])
+
+    if result["size"] != result["snapshotSize"]:
+        raise Exception("%d bytes written in the buffer instead of %d" % (result["size"], result["snapshotSize"]))
+
+    if result["rejected"] != result["snapshotSize"]:
+        raise Exception("%d truncated snapshots accepted" % (result["snapshotSize"] - result["rejected"]))
+    compare_states("Truncated snapshot", result["truncated"], result["modifiedTruncated"])
+
+    os.remove(filepath)
+    os.remove(mainloop)
+
+
+if __name__ == "__main__":
+    run_main(main)
@@ -0,0 +1,106 @@
+# ##### BEGIN GPL LICENSE BLOCK #####
+#
+#  This program is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU General Public License
+#  as published by the Free Software Foundation; either version 2
+#  of the License, or (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software Foundation,
+#  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#
+# ##### END GPL LICENSE BLOCK #####
+
+# <pep8 compliant>
+
+# Shared utilities of the game engine tests: the scenes are generated in blender,
+# saved and run in the headless player with a main loop script printing its
+# result as a JSON line prefixed by RESULT_PREFIX.
+
+import bpy
+
+import json
+import os
+import subprocess
+import sys
+
+RESULT_PREFIX = "BGE_TEST "
+
+
+def new_scene(camera_location=(0.0, -10.0, 0.0)):
+    bpy.ops.wm.read_homefile(use_empty=True)
+    scene = bpy.context.scene
+
+    camera = bpy.data.objects.new("Camera", bpy.data.cameras.new("Camera"))
+    camera.location = camera_location
+    scene.objects.link(camera)
+    scene.camera = camera
+
+    return scene
+
+
+def new_cube_mesh(name, size=0.5):
+    mesh = bpy.data.meshes.new(name)
+    verts = [(x, y, z) for x in (-size, size) for y in (-size, size) for z in (-size, size)]
+    faces = [(0, 1, 3, 2), (4, 6, 7, 5), (0, 4, 5, 1), (2, 3, 7, 6), (0, 2, 6, 4), (1, 5, 7, 3)]
+    mesh.from_pydata(verts, [], faces)
+    mesh.update()
+    return mesh
+
+
+def write_script(output_dir, name, text):
+    filepath = os.path.join(output_dir, name)
+    with open(filepath, "w") as f:
+        f.write(text)
+    return filepath
+
+
+def run_player(blenderplayer, filepath, mainloop, frames, game_properties=()):
+    """
+    Run a .blend file in the headless player with a simulated clock (-g headless_realtime = 0),
+    so every run proceeds exactly the same logic frames, and return the result of the main loop.
+    """
+    command = [blenderplayer, "-headless", str(frames), "-g", "headless_realtime", "=", "0"]
+    for name, value in game_properties:
+        command += ["-g", name, "=", str(value)]
+    command += ["-p", mainloop, filepath]
+
+    output = subprocess.check_output(command, stderr=subprocess.STDOUT, universal_newlines=True)
+
+    for line in output.splitlines():
+        if line.startswith(RESULT_PREFIX):
+            return json.loads(line[len(RESULT_PREFIX):])
+
+    print(output)
+    raise Exception("No test result in the output of %r" % filepath)
+
+
+def argument_parser(description):
+    import argparse
+    import tempfile
+
+    parser = argparse.ArgumentParser(description=description)
+    parser.add_argument("--blenderplayer", required=True)
+    parser.add_argument("--output-dir", default=tempfile.gettempdir())
+    return parser
+
+
+def parse_arguments(parser):
+    # The arguments of the test follow "--" in the blender command line.
+    argv = sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else []
+    return parser.parse_args(argv)
+
+
+def run_main(main):
+    # So a python error exits(1)
+    try:
+        main()
+    except:
+        import traceback
+        traceback.print_exc()
+        sys.exit(1)
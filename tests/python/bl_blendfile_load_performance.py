@@ -0,0 +1,147 @@
+# ##### BEGIN GPL LICENSE BLOCK #####
+#
+#  This program is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU General Public License
+#  as published by the Free Software Foundation; either version 2
+#  of the License, or (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software Foundation,
+#  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#
+# ##### END GPL LICENSE BLOCK #####
+
+# <pep8 compliant>
+
+# Time the reading of a synthetic big .blend file, this mostly measures the
+# old to new pointers relinking (OldNewMap in readfile.c).
+#
+# The file is read both as main file (BLO_read_from_file) and as a library
+# (what the game engine LibLoad uses), the loaded data is checked after each read.
+#
+# ./blender.bin --background -noaudio --factory-startup \
+#     --python tests/python/bl_blendfile_load_performance.py -- \
+#     --output-dir=/tmp --scale=10
+
+import bpy
+
+import os
+import sys
+import time
+
+# Numbers of elements for scale 1.
+NUM_OBJECTS = 2000
+NUM_TEXT_LINES = 20000
+NUM_FCURVES = 2000
+NUM_FCURVE_GROUPS = 50
+NUM_SPLINES = 2000
+
+
+def create_data(scale):
+    scene = bpy.context.scene
+
+    # A lot of IDs, all linked together: stresses the lib map.
+    for i in range(NUM_OBJECTS * scale):
+        mesh = bpy.data.meshes.new("Mesh%d" % i)
+        mesh.materials.append(bpy.data.materials.new("Material%d" % i))
+        ob = bpy.data.objects.new("Object%d" % i, mesh)
+        scene.objects.link(ob)
+
+    # A lot of data blocks in single IDs: stresses the data map.
+    text = bpy.data.texts.new("Text")
+    text.from_string("\n".join("line %d" % i for i in range(NUM_TEXT_LINES * scale)))
+
+    # F-Curves point back to their group, these lookups don't follow the file order.
+    action = bpy.data.actions.new("Action")
+    action.use_fake_user = True
+    for i in range(NUM_FCURVES * scale):
+        fcu = action.fcurves.new('["prop%d"]' % i, action_group="Group%d" % (i % NUM_FCURVE_GROUPS))
+        fcu.keyframe_points.insert(1.0, 0.0)
+
+    curve = bpy.data.curves.new("Curve", 'CURVE')
+    curve.use_fake_user = True
+    for i in range(NUM_SPLINES * scale):
+        spline = curve.splines.new('BEZIER')
+        spline.bezier_points.add(3)
+
+
+def check_data(scale):
+    objects = bpy.data.objects
+    assert(len([ob for ob in objects if ob.name.startswith("Object")]) == NUM_OBJECTS * scale)
+    for ob in objects:
+        if ob.name.startswith("Object"):
+            assert(ob.data.materials[0].name == "Material" + ob.name[len("Object"):])
+
+    text = bpy.data.texts["Text"]
+    assert(len(text.lines) == NUM_TEXT_LINES * scale)
+
+    action = bpy.data.actions["Action"]
+    assert(len(action.fcurves) == NUM_FCURVES * scale)
+    assert(len(action.groups) == NUM_FCURVE_GROUPS)
+    for fcu in action.fcurves:
+        # F-Curves are sorted by group, get the index from the path.
+        i = int(fcu.data_path[len('["prop'):-len('"]')])
+        assert(fcu.group.name == "Group%d" % (i % NUM_FCURVE_GROUPS))
+
+    assert(len(bpy.data.curves["Curve"].splines) == NUM_SPLINES * scale)
+
+
+def timeit(name, func, repeat):
+    times = []
+    for _ in range(repeat):
+        start = time.time()
+        func()
+        times.append(time.time() - start)
+    print("%s: best %.4f s, average %.4f s" % (name, min(times), sum(times) / len(times)))
+
+
+def main():
+    import argparse
+    import tempfile
+
+    argv = sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else []
+    parser = argparse.ArgumentParser(description="Time the loading of a big synthetic .blend file")
+    parser.add_argument("--output-dir", default=tempfile.gettempdir())
+    parser.add_argument("--scale", type=int, default=1, help="Multiplier of the amount of generated data")
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args(argv)
+
+    filepath = os.path.join(args.output_dir, "bl_blendfile_load_performance.blend")
+
+    create_data(args.scale)
+    bpy.ops.wm.save_as_mainfile(filepath=filepath, check_existing=False, compress=False)
+    print("Saved %r (%d bytes)" % (filepath, os.path.getsize(filepath)))
+
+    def read_main():
+        bpy.ops.wm.open_mainfile(filepath=filepath, load_ui=False)
+
+    def read_library():
+        bpy.ops.wm.read_homefile(use_empty=True)
+        with bpy.data.libraries.load(filepath, link=True) as (data_from, data_to):
+            data_to.objects = data_from.objects
+            data_to.texts = data_from.texts
+            data_to.actions = data_from.actions
+            data_to.curves = data_from.curves
+
+    timeit("Read main file", read_main, args.repeat)
+    check_data(args.scale)
+
+    timeit("Read library", read_library, args.repeat)
+    check_data(args.scale)
+
+    os.remove(filepath)
+
+
+if __name__ == "__main__":
+    # So a python error exits(1)
+    try:
+        main()
+    except:
+        import traceback
+        traceback.print_exc()
+        sys.exit(1)